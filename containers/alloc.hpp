@@ -1,10 +1,30 @@
 #ifndef ALLOC_HPP
 #define ALLOC_HPP
 
+#include <algorithm>
+  // std::swap()
+
 template <class _Type, class _AllocatorType>
 struct _Alloc_traits
 {
   typedef typename _AllocatorType::template rebind<_Type>::other allocator_type;
+
+  // 할당받은 것을 하나하나 deallocate하지 않고 한 번에 돌려줄 수 있는지.
+  // 일반 할당기는 할 수 없다. (slab_allocator.hpp의 특수화는 할 수 있다.)
+  static bool _S_can_release_all(const allocator_type&) { return false; }
+
+  // __keep이 들어있는 공간을 제외하고, 할당받은 메모리를 모두 한 번에 돌려준다.
+  static void _S_release_all(allocator_type&, void*) {}
+
+  // 컨테이너의 swap()에서 할당기를 맞바꾼다.
+  static void _S_swap(allocator_type& __a, allocator_type& __b) { std::swap(__a, __b); }
+
+  // 병렬 작업에서 스레드 하나가 따로 쓸 할당기(arena).
+  // 일반 할당기는 operator new처럼 여러 스레드에서 함께 써도 된다고 보고, 복사본을 그대로 쓴다.
+  static allocator_type _S_arena(const allocator_type& __a) { return __a; }
+
+  // __arena로 할당한 것을 앞으로 __a로 해제할 수 있게 한다. 일반 할당기는 할 일이 없다.
+  static void _S_adopt(allocator_type&, allocator_type&) {}
 };
 
 #endif // ALLOC_HPP
\ No newline at end of file
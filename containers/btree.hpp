@@ -0,0 +1,944 @@
+#ifndef BTREE_HPP
+#define BTREE_HPP
+
+#include <cstddef>
+  // size_t, ptrdiff_t
+
+#include <memory>
+  // std::allocator
+
+#include <iterator>
+  // std::bidirectional_iterator_tag
+
+#include <algorithm>
+  // std::swap()
+
+#include <functional>
+  // std::less
+
+#include "pair.hpp"
+  // ft::pair
+
+#include "iterator.hpp"
+  // ft::reverse_iterator
+
+#include "alloc.hpp"
+  // _Alloc_traits: 요소 할당기를 노드 할당기로 rebind한다.
+
+#include "construct.hpp"
+  // ft::_Construct()
+
+#include "algorithm.hpp"
+  // ft::equal(), ft::lexicographical_compare()
+
+// FT_BTREE_NODE_BYTES :
+// 노드 하나의 목표 크기(바이트). 기본값은 캐시라인 4개.
+// 노드에 들어가는 요소 수는 이 크기에 맞추어 계산한다. (요소가 아주 크면 노드가 이보다 커질 수 있다.)
+#ifndef FT_BTREE_NODE_BYTES
+#define FT_BTREE_NODE_BYTES 256
+#endif
+
+namespace ft
+{
+
+// _Btree
+// : btree_map, btree_set이 내장하는 B+tree.
+//
+// _Rb_tree는 노드 하나에 요소 하나를 담으므로, 탐색할 때 트리의 높이만큼(천만 개면 약 25번) 서로 의존하는 캐시 미스가 난다.
+// _Btree는 노드 하나에 수십 개의 key를 연속으로 담고 노드 안에서 이진 탐색을 하므로, 같은 크기에서 높이가 5 정도다.
+//
+// - 요소(value)는 모두 leaf에만 있다. inner 노드는 자식 사이의 경계가 되는 key의 복사본(separator)만 가진다.
+//   inner의 i번째 key를 K라고 하면, i번째 자식의 key는 모두 K보다 작고, i+1번째 자식의 key는 모두 K 이상이다.
+//   (요소를 지워도 separator는 그대로 두어도 된다. 위의 조건은 계속 성립한다.)
+// - leaf끼리는 양방향으로 연결되어 있으므로, 반복자는 트리를 오르내리지 않고 leaf를 따라 움직인다.
+// - 노드의 요소는 배열 안에서 옮겨 다닌다. 그래서 map과 달리 insert와 erase는 모든 반복자, 참조, 포인터를 무효화한다.
+//   (map에서 쓰던 m.erase(it++)는 정의되지 않은 동작이다. erase()가 반환하는 반복자만 유효하다: it = m.erase(it))
+//   (옮길 때는 복사 생성 후 원본을 소멸시키므로, value_type과 key_type의 복사 생성자는 예외를 던지지 않아야 한다.)
+
+//------------------     node     ------------------//
+
+// 요소와 key를 담는 날것의 공간. (생성은 _Btree가 필요한 칸에만 한다.)
+template <std::size_t _Size>
+struct _Btree_storage
+{
+  union {
+    char _M_bytes[_Size];
+    void* _M_align_ptr;
+    long long _M_align_ll;
+    long double _M_align_ld;
+  };
+};
+
+struct _Btree_node_base
+{
+  typedef _Btree_node_base* _Base_ptr;
+
+  _Base_ptr _M_parent; // root는 0
+  unsigned int _M_count; // leaf: 요소 수, inner: key 수 (자식은 하나 더 많다.)
+  bool _M_leaf;
+};
+
+// leaf는 _Slots개까지 요소를 담는다. 배열은 한 칸 더 크다. (가득 찬 노드에 일단 넣고 나서 둘로 나누기 위해)
+template <typename _Value, std::size_t _Slots>
+struct _Btree_leaf : public _Btree_node_base
+{
+  typedef _Value value_type;
+
+  _Btree_leaf* _M_prev;
+  _Btree_leaf* _M_next;
+  _Btree_storage<sizeof(_Value) * (_Slots + 1)> _M_storage;
+
+  _Value* _M_values() { return reinterpret_cast<_Value*>(_M_storage._M_bytes); }
+  _Value& _M_value(std::size_t __i) { return _M_values()[__i]; }
+};
+
+// inner는 _Slots개까지 key를, _Slots + 1개까지 자식을 담는다. (leaf와 마찬가지로 한 칸씩 더 크다.)
+template <typename _Key, std::size_t _Slots>
+struct _Btree_inner : public _Btree_node_base
+{
+  _Btree_node_base* _M_child[_Slots + 2];
+  _Btree_storage<sizeof(_Key) * (_Slots + 1)> _M_storage;
+
+  _Key* _M_keys() { return reinterpret_cast<_Key*>(_M_storage._M_bytes); }
+  _Key& _M_key(std::size_t __i) { return _M_keys()[__i]; }
+};
+
+//------------------     iterator     ------------------//
+
+// (leaf, 위치) 쌍. 끝에 닿으면 다음 leaf의 처음으로 넘어간다.
+// end()는 마지막 leaf의 마지막 요소 다음 위치이므로, --end()도 가능하다.
+template <typename _Leaf, typename _Reference, typename _Pointer>
+struct _Btree_iterator
+{
+  typedef std::bidirectional_iterator_tag iterator_category;
+  typedef typename _Leaf::value_type value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef _Reference reference;
+  typedef _Pointer pointer;
+
+  typedef _Btree_iterator<_Leaf, value_type&, value_type*> iterator;
+  typedef _Btree_iterator<_Leaf, _Reference, _Pointer> _Self;
+
+  _Leaf* _M_leaf;
+  std::size_t _M_pos;
+
+  _Btree_iterator() : _M_leaf(0), _M_pos(0) {}
+  _Btree_iterator(_Leaf* __leaf, std::size_t __pos) : _M_leaf(__leaf), _M_pos(__pos) {}
+  _Btree_iterator(const iterator& __it) : _M_leaf(__it._M_leaf), _M_pos(__it._M_pos) {}
+
+  reference operator*() const { return _M_leaf->_M_value(_M_pos); }
+  pointer operator->() const { return &(operator*()); }
+
+  _Self& operator++() {
+    if (++_M_pos == _M_leaf->_M_count && _M_leaf->_M_next != 0) {
+      _M_leaf = _M_leaf->_M_next;
+      _M_pos = 0;
+    }
+    return *this;
+  }
+  _Self operator++(int) { _Self __tmp = *this; ++*this; return __tmp; }
+
+  _Self& operator--() {
+    if (_M_pos == 0) {
+      _M_leaf = _M_leaf->_M_prev;
+      _M_pos = _M_leaf->_M_count;
+    }
+    --_M_pos;
+    return *this;
+  }
+  _Self operator--(int) { _Self __tmp = *this; --*this; return __tmp; }
+};
+
+template <class _Leaf, class _RefL, class _PtrL, class _RefR, class _PtrR>
+bool operator==(const _Btree_iterator<_Leaf, _RefL, _PtrL>& __x,
+                const _Btree_iterator<_Leaf, _RefR, _PtrR>& __y)
+{ return __x._M_leaf == __y._M_leaf && __x._M_pos == __y._M_pos; }
+
+template <class _Leaf, class _RefL, class _PtrL, class _RefR, class _PtrR>
+bool operator!=(const _Btree_iterator<_Leaf, _RefL, _PtrL>& __x,
+                const _Btree_iterator<_Leaf, _RefR, _PtrR>& __y)
+{ return !(__x == __y); }
+
+//------------------     Btree     ------------------//
+
+template <typename _Key, typename _Value, typename _GetKeyOfValue, typename _Compare, typename _Alloc = std::allocator<_Value> >
+class _Btree {
+
+public:
+  typedef _Key key_type;
+  typedef _Value value_type;
+  typedef value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  typedef typename _Alloc_traits<_Value, _Alloc>::allocator_type allocator_type;
+
+private:
+  // 노드 하나가 FT_BTREE_NODE_BYTES에 들어가도록 칸 수를 정한다. (나누기 전에 잠시 쓰는 한 칸을 포함해서)
+  // 너무 작으면 나누고 합치는 규칙이 성립하지 않으므로, 최소 4칸으로 한다.
+  enum {
+    _S_leaf_fit = (FT_BTREE_NODE_BYTES - sizeof(_Btree_node_base) - 2 * sizeof(void*)) / sizeof(_Value),
+    _S_inner_fit = (FT_BTREE_NODE_BYTES - sizeof(_Btree_node_base) - sizeof(void*)) / (sizeof(_Key) + sizeof(void*)),
+    _S_leaf_slots = _S_leaf_fit > 5 ? _S_leaf_fit - 1 : 4,
+    _S_inner_slots = _S_inner_fit > 5 ? _S_inner_fit - 1 : 4,
+    // root가 아닌 노드가 가져야 하는 최소 수. 이보다 적어지면 형제에게서 빌리거나 형제와 합친다.
+    _S_leaf_min = _S_leaf_slots / 2,
+    _S_inner_min = _S_inner_slots / 2
+  };
+
+  typedef _Btree_node_base* _Base_ptr;
+  typedef _Btree_leaf<_Value, _S_leaf_slots> _Leaf;
+  typedef _Btree_inner<_Key, _S_inner_slots> _Inner;
+
+public:
+  typedef _Btree_iterator<_Leaf, value_type&, value_type*> iterator;
+  typedef _Btree_iterator<_Leaf, const value_type&, const value_type*> const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+private:
+  typename _Alloc_traits<_Leaf, _Alloc>::allocator_type _M_leaf_allocator;
+  typename _Alloc_traits<_Inner, _Alloc>::allocator_type _M_inner_allocator;
+
+  _Base_ptr _M_root;
+  _Leaf* _M_leftmost;
+  _Leaf* _M_rightmost;
+  size_type _M_node_count; // 요소 수
+  _Compare _M_key_compare;
+
+                                // 노드 할당/해제
+
+  // 노드는 POD이므로 따로 생성하지 않는다. 안의 요소와 key만 필요할 때 생성한다.
+  _Leaf* _M_get_leaf() {
+    _Leaf* __x = _M_leaf_allocator.allocate(1);
+    __x->_M_parent = 0;
+    __x->_M_count = 0;
+    __x->_M_leaf = true;
+    __x->_M_prev = __x->_M_next = 0;
+    return __x;
+  }
+  void _M_put_leaf(_Leaf* __x) { _M_leaf_allocator.deallocate(__x, 1); }
+
+  _Inner* _M_get_inner() {
+    _Inner* __x = _M_inner_allocator.allocate(1);
+    __x->_M_parent = 0;
+    __x->_M_count = 0;
+    __x->_M_leaf = false;
+    return __x;
+  }
+  void _M_put_inner(_Inner* __x) { _M_inner_allocator.deallocate(__x, 1); }
+
+  static _Leaf* _S_leaf(_Base_ptr __x) { return static_cast<_Leaf*>(__x); }
+  static _Inner* _S_inner(_Base_ptr __x) { return static_cast<_Inner*>(__x); }
+
+  static const _Key& _S_key(_Leaf* __x, size_type __i)
+    { return _GetKeyOfValue()(__x->_M_value(__i)); }
+
+                                // 배열 안에서 옮기기
+
+  // _S_move() :
+  // 생성된 [__first, __first + __n)을 생성되지 않은 __result로 옮긴다. (복사 생성 후 원본 소멸)
+  // 두 범위가 겹쳐도 되도록, 뒤로 옮길 때는 뒤에서부터 옮긴다.
+  template <typename _Type>
+  static void _S_move(_Type* __first, size_type __n, _Type* __result) {
+    if (__result > __first) {
+      for (size_type __i = __n; __i != 0; ) {
+        --__i;
+        ft::_Construct(__result + __i, __first[__i]);
+        __first[__i].~_Type();
+      }
+    }
+    else if (__result < __first) {
+      for (size_type __i = 0; __i != __n; ++__i) {
+        ft::_Construct(__result + __i, __first[__i]);
+        __first[__i].~_Type();
+      }
+    }
+  }
+
+  // separator 교체: key_type에 대입 연산자가 없어도 되도록 소멸 후 다시 생성한다.
+  static void _S_replace_key(_Inner* __x, size_type __i, const key_type& __k) {
+    __x->_M_key(__i).~_Key();
+    ft::_Construct(&__x->_M_key(__i), __k);
+  }
+
+  // __child가 __parent의 몇 번째 자식인지 (자식 수는 수십 개 이하이므로 그냥 훑는다.)
+  static size_type _S_child_index(_Inner* __parent, _Base_ptr __child) {
+    size_type __i = 0;
+    while (__parent->_M_child[__i] != __child)
+      ++__i;
+    return __i;
+  }
+
+                                // 노드 안 탐색 (이진 탐색)
+
+  // __k보다 큰 첫 key의 위치 = 내려갈 자식의 번호
+  size_type _M_inner_upper_bound(_Inner* __x, const key_type& __k) const {
+    size_type __lo = 0, __hi = __x->_M_count;
+    while (__lo < __hi) {
+      size_type __mid = (__lo + __hi) / 2;
+      if (_M_key_compare(__k, __x->_M_key(__mid)))
+        __hi = __mid;
+      else
+        __lo = __mid + 1;
+    }
+    return __lo;
+  }
+
+  // __k 이상인 첫 요소의 위치
+  size_type _M_leaf_lower_bound(_Leaf* __x, const key_type& __k) const {
+    size_type __lo = 0, __hi = __x->_M_count;
+    while (__lo < __hi) {
+      size_type __mid = (__lo + __hi) / 2;
+      if (_M_key_compare(_S_key(__x, __mid), __k))
+        __lo = __mid + 1;
+      else
+        __hi = __mid;
+    }
+    return __lo;
+  }
+
+  // __k보다 큰 첫 요소의 위치
+  size_type _M_leaf_upper_bound(_Leaf* __x, const key_type& __k) const {
+    size_type __lo = 0, __hi = __x->_M_count;
+    while (__lo < __hi) {
+      size_type __mid = (__lo + __hi) / 2;
+      if (_M_key_compare(__k, _S_key(__x, __mid)))
+        __hi = __mid;
+      else
+        __lo = __mid + 1;
+    }
+    return __lo;
+  }
+
+  // __k가 있다면 들어 있을 leaf (트리가 비어 있지 않아야 한다.)
+  _Leaf* _M_find_leaf(const key_type& __k) const {
+    _Base_ptr __x = _M_root;
+    while (!__x->_M_leaf)
+      __x = _S_inner(__x)->_M_child[_M_inner_upper_bound(_S_inner(__x), __k)];
+    return _S_leaf(__x);
+  }
+
+  // leaf의 끝 위치는 (마지막 leaf가 아니라면) 다음 leaf의 처음으로 바꾸어 반환한다.
+  iterator _M_make_iterator(_Leaf* __x, size_type __pos) const {
+    if (__pos == __x->_M_count && __x->_M_next != 0)
+      return iterator(__x->_M_next, 0);
+    return iterator(__x, __pos);
+  }
+
+public:
+  // CONSTRUCTOR
+  _Btree()
+    : _M_leaf_allocator(allocator_type()), _M_inner_allocator(allocator_type()),
+      _M_root(0), _M_leftmost(0), _M_rightmost(0), _M_node_count(0), _M_key_compare() {}
+
+  _Btree(const _Compare& __comp, const allocator_type& __a = allocator_type())
+    : _M_leaf_allocator(__a), _M_inner_allocator(__a),
+      _M_root(0), _M_leftmost(0), _M_rightmost(0), _M_node_count(0), _M_key_compare(__comp) {}
+
+  // 복사 :
+  // 정렬된 순서대로 맨 끝에 붙이므로 탐색 없이 O(n)이고, 노드는 (마지막 노드를 제외하고) 거의 가득 찬다.
+  _Btree(const _Btree& __x)
+    : _M_leaf_allocator(__x._M_leaf_allocator), _M_inner_allocator(__x._M_inner_allocator),
+      _M_root(0), _M_leftmost(0), _M_rightmost(0), _M_node_count(0), _M_key_compare(__x._M_key_compare)
+  {
+    try {
+      _M_append(__x.begin(), __x.end());
+    }
+    catch(...)
+    {
+  clear();
+  throw;
+    }
+  }
+
+  _Btree& operator=(const _Btree& __x) {
+    if (this != &__x) {
+      clear();
+      _M_key_compare = __x._M_key_compare;
+      _M_append(__x.begin(), __x.end());
+    }
+    return *this;
+  }
+
+  // DESTRUCTOR
+  ~_Btree() { clear(); }
+
+                                // accessors:
+
+  _Compare key_comp() const { return _M_key_compare; }
+  allocator_type get_allocator() const { return allocator_type(_M_leaf_allocator); }
+
+  iterator begin() { return iterator(_M_leftmost, 0); }
+  const_iterator begin() const { return const_iterator(_M_leftmost, 0); }
+  iterator end() { return iterator(_M_rightmost, _M_rightmost ? _M_rightmost->_M_count : 0); }
+  const_iterator end() const { return const_iterator(_M_rightmost, _M_rightmost ? _M_rightmost->_M_count : 0); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+  bool empty() const { return _M_node_count == 0; }
+  size_type size() const { return _M_node_count; }
+  size_type max_size() const { return size_type(-1) / sizeof(value_type); }
+
+  // swap() :
+  // 노드는 그 노드를 할당한 할당기와 함께 옮겨가야 하므로, 할당기도 바꾼다.
+  void swap(_Btree& __t) {
+    _Alloc_traits<_Leaf, _Alloc>::_S_swap(_M_leaf_allocator, __t._M_leaf_allocator);
+    _Alloc_traits<_Inner, _Alloc>::_S_swap(_M_inner_allocator, __t._M_inner_allocator);
+    std::swap(_M_root, __t._M_root);
+    std::swap(_M_leftmost, __t._M_leftmost);
+    std::swap(_M_rightmost, __t._M_rightmost);
+    std::swap(_M_node_count, __t._M_node_count);
+    std::swap(_M_key_compare, __t._M_key_compare);
+  }
+
+  // const_iterator를 같은 위치의 iterator로 바꾼다. (set의 반복자는 모두 const_iterator이므로)
+  static iterator _S_const_cast(const_iterator __it) { return iterator(__it._M_leaf, __it._M_pos); }
+
+                                // insert/erase
+
+  pair<iterator, bool> insert_unique(const value_type& __v) {
+    const key_type& __k = _GetKeyOfValue()(__v);
+    if (_M_root == 0)
+      return pair<iterator, bool>(_M_insert_first(__v), true);
+    _Leaf* __x = _M_find_leaf(__k);
+    size_type __pos = _M_leaf_lower_bound(__x, __k);
+    // 내려온 leaf 밖에는 __k와 같은 key가 있을 수 없다. (separator의 조건)
+    if (__pos != __x->_M_count && !_M_key_compare(__k, _S_key(__x, __pos)))
+      return pair<iterator, bool>(iterator(__x, __pos), false);
+    return pair<iterator, bool>(_M_insert_at(__x, __pos, __v), true);
+  }
+
+  // 힌트와 함께 :
+  // __v가 힌트 바로 앞에 들어갈 자리이고 그 자리가 같은 leaf 안이라면, 탐색 없이 넣는다.
+  // 맨 끝(end())과 맨 앞(begin())도 마찬가지다. 그래서 정렬된 입력을 end()를 힌트로 넣으면 요소마다 O(1)이다.
+  iterator insert_unique(iterator __position, const value_type& __v) {
+    const key_type& __k = _GetKeyOfValue()(__v);
+    _Leaf* __x = __position._M_leaf;
+    size_type __pos = __position._M_pos;
+    if (__x != 0) {
+      // __v < *__position (end()라면 생략)
+      bool __before = __pos == __x->_M_count || _M_key_compare(__k, _S_key(__x, __pos));
+      if (__before) {
+        if (__pos != 0) {
+          if (_M_key_compare(_S_key(__x, __pos - 1), __k)) // *(__position - 1) < __v
+            return _M_insert_at(__x, __pos, __v);
+        }
+        else if (__x == _M_leftmost) // begin() 앞
+          return _M_insert_at(__x, 0, __v);
+      }
+    }
+    return insert_unique(__v).first;
+  }
+
+  // 범위 :
+  // end()를 힌트로 하나씩 넣는다. 정렬된 범위라면 탐색 없이 맨 끝에 붙는다.
+  template <class _InputIterator>
+  void insert_unique(_InputIterator __first, _InputIterator __last) {
+    for ( ; __first != __last; ++__first)
+      insert_unique(end(), *__first);
+  }
+
+  // erase() :
+  // 지운 요소의 다음 요소를 가리키는 반복자를 반환한다. (지우면서 요소가 옮겨지므로, 그 위치를 따라간다.)
+  // 다른 반복자는 모두 무효화되므로, 순회하면서 지울 때는 it = erase(it)로만 쓸 수 있다.
+  iterator erase(iterator __position) { return _M_erase_at(__position._M_leaf, __position._M_pos, 1); }
+
+  size_type erase(const key_type& __k) {
+    iterator __i = find(__k);
+    if (__i == end())
+      return 0;
+    erase(__i);
+    return 1;
+  }
+
+  // 범위 :
+  // leaf 단위로 지운다. leaf 하나에 걸친 부분은 한꺼번에 소멸시키고 뒤의 요소를 한 번만 당기며, 모자라게 된 leaf도 한 번만 맞춘다.
+  // 그래서 요소 k개를 지우는 비용은 O(k + 걸친 leaf 수 * log n)이다. (요소마다 지우면 k번 당기고 k번 맞춘다.)
+  iterator erase(iterator __first, iterator __last) {
+    if (__first == begin() && __last == end()) {
+      clear();
+      return end();
+    }
+    // 지울 요소 수는 leaf의 요소 수를 더해서 구한다. (반복자는 마지막 leaf가 아니면 leaf 끝에 있지 않다.)
+    size_type __n = __last._M_pos - __first._M_pos;
+    for (_Leaf* __x = __first._M_leaf; __x != __last._M_leaf; __x = __x->_M_next)
+      __n += __x->_M_count;
+    while (__n != 0) {
+      const size_type __m = std::min(__n, __first._M_leaf->_M_count - __first._M_pos);
+      __first = _M_erase_at(__first._M_leaf, __first._M_pos, __m);
+      __n -= __m;
+    }
+    return __first;
+  }
+
+  void clear() {
+    if (_M_root != 0) {
+      _M_clear(_M_root);
+      _M_root = 0;
+      _M_leftmost = _M_rightmost = 0;
+      _M_node_count = 0;
+    }
+  }
+
+                                // map operations:
+
+  iterator find(const key_type& __k) {
+    iterator __i = lower_bound(__k);
+    return (__i == end() || _M_key_compare(__k, _GetKeyOfValue()(*__i))) ? end() : __i;
+  }
+  const_iterator find(const key_type& __k) const {
+    const_iterator __i = lower_bound(__k);
+    return (__i == end() || _M_key_compare(__k, _GetKeyOfValue()(*__i))) ? end() : __i;
+  }
+
+  size_type count(const key_type& __k) const { return find(__k) == end() ? 0 : 1; }
+
+  iterator lower_bound(const key_type& __k) {
+    if (_M_root == 0)
+      return end();
+    _Leaf* __x = _M_find_leaf(__k);
+    return _M_make_iterator(__x, _M_leaf_lower_bound(__x, __k));
+  }
+  const_iterator lower_bound(const key_type& __k) const
+    { return const_cast<_Btree*>(this)->lower_bound(__k); }
+
+  iterator upper_bound(const key_type& __k) {
+    if (_M_root == 0)
+      return end();
+    _Leaf* __x = _M_find_leaf(__k);
+    return _M_make_iterator(__x, _M_leaf_upper_bound(__x, __k));
+  }
+  const_iterator upper_bound(const key_type& __k) const
+    { return const_cast<_Btree*>(this)->upper_bound(__k); }
+
+  pair<iterator, iterator> equal_range(const key_type& __k)
+    { return pair<iterator, iterator>(lower_bound(__k), upper_bound(__k)); }
+  pair<const_iterator, const_iterator> equal_range(const key_type& __k) const
+    { return pair<const_iterator, const_iterator>(lower_bound(__k), upper_bound(__k)); }
+
+private:
+  template <class _InputIterator>
+  void _M_append(_InputIterator __first, _InputIterator __last) {
+    for ( ; __first != __last; ++__first)
+      insert_unique(end(), *__first);
+  }
+
+  // 빈 트리에 첫 요소를 넣는다. root가 곧 leaf다.
+  iterator _M_insert_first(const value_type& __v) {
+    _Leaf* __x = _M_get_leaf();
+    try {
+      ft::_Construct(&__x->_M_value(0), __v);
+    }
+    catch(...)
+    {
+  _M_put_leaf(__x);
+  throw;
+    }
+    __x->_M_count = 1;
+    _M_root = __x;
+    _M_leftmost = _M_rightmost = __x;
+    _M_node_count = 1;
+    return iterator(__x, 0);
+  }
+
+  iterator _M_insert_at(_Leaf* __x, size_type __pos, const value_type& __v);
+  void _M_split_leaf(_Leaf* __x, size_type __split, _Leaf* __right, int __edge, _Inner*& __spare);
+  void _M_insert_into_parent(_Base_ptr __left, const key_type& __k, _Base_ptr __right, int __edge, _Inner*& __spare);
+
+  iterator _M_erase_at(_Leaf* __x, size_type __pos, size_type __n);
+  void _M_rebalance_inner(_Inner* __x);
+  void _M_merge_leaves(_Inner* __parent, size_type __i);
+  void _M_merge_inners(_Inner* __parent, size_type __i);
+
+  void _M_clear(_Base_ptr __x);
+}; // class _Btree
+
+//------------------     Btree 관련 연산자     ------------------//
+
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+bool
+operator==(const _Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __x,
+           const _Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __y)
+{
+  return __x.size() == __y.size() &&
+         ft::equal(__x.begin(), __x.end(), __y.begin());
+}
+
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+bool
+operator<(const _Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __x,
+          const _Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __y)
+{
+  return ft::lexicographical_compare(__x.begin(), __x.end(), __y.begin(), __y.end());
+}
+
+//------------------     Btree 클래스 멤버함수의 정의     ------------------//
+
+// _M_insert_at() :
+// __x의 __pos 자리에 __v를 넣는다. 넣을 자리는 이미 정해져 있다.
+// 가득 찬 leaf라면 일단 여분의 칸까지 써서 넣은 뒤 둘로 나누고, 오른쪽 노드의 separator를 부모에 넣는다. (부모도 가득 찼다면 위로 반복)
+// 필요한 노드는 모두 먼저 할당해두므로, 할당이 실패해도 트리는 바뀌지 않는다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+typename _Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::iterator
+_Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
+  ::_M_insert_at(_Leaf* __x, size_type __pos, const value_type& __v)
+{
+  const bool __split = __x->_M_count == _S_leaf_slots;
+  _Leaf* __right = 0;
+  _Inner* __spare = 0; // 나눌 때 쓸 inner 노드들. _M_parent로 연결해둔다.
+  if (__split) {
+    // 가득 찬 조상의 수만큼, 그리고 root까지 가득 찼다면 새 root까지 inner 노드가 필요하다.
+    size_type __inners = 0;
+    _Base_ptr __p = __x->_M_parent;
+    for ( ; __p != 0 && __p->_M_count == _S_inner_slots; __p = __p->_M_parent)
+      ++__inners;
+    if (__p == 0)
+      ++__inners;
+    try {
+      __right = _M_get_leaf();
+      while (__inners--) {
+        _Inner* __n = _M_get_inner();
+        __n->_M_parent = __spare;
+        __spare = __n;
+      }
+    }
+    catch(...)
+    {
+  if (__right)
+    _M_put_leaf(__right);
+  while (__spare) {
+    _Inner* __n = __spare;
+    __spare = _S_inner(__spare->_M_parent);
+    _M_put_inner(__n);
+  }
+  throw;
+    }
+  }
+
+  _S_move(&__x->_M_value(__pos), __x->_M_count - __pos, &__x->_M_value(__pos + 1));
+  try {
+    ft::_Construct(&__x->_M_value(__pos), __v);
+  }
+  catch(...)
+  {
+  _S_move(&__x->_M_value(__pos + 1), __x->_M_count - __pos, &__x->_M_value(__pos));
+  if (__split) {
+    _M_put_leaf(__right);
+    while (__spare) {
+      _Inner* __n = __spare;
+      __spare = _S_inner(__spare->_M_parent);
+      _M_put_inner(__n);
+    }
+  }
+  throw;
+  }
+  ++__x->_M_count;
+  ++_M_node_count;
+  if (!__split)
+    return iterator(__x, __pos);
+
+  // 나누는 위치 :
+  // 보통은 반으로 나눈다. 하지만 맨 끝에 붙이는 중이라면 (정렬된 입력) 왼쪽을 가득 채운 채로 두고 새 요소만 오른쪽으로 보낸다.
+  // 맨 앞에 넣는 중이라면 반대로 한다. 그래야 정렬된 입력으로 만든 트리의 노드가 반만 차지 않는다.
+  size_type __at = (_S_leaf_slots + 1) / 2;
+  int __edge = 0;
+  if (__pos == _S_leaf_slots && __x == _M_rightmost) {
+    __at = _S_leaf_slots;
+    __edge = 1;
+  }
+  else if (__pos == 0 && __x == _M_leftmost) {
+    __at = 1;
+    __edge = -1;
+  }
+  _M_split_leaf(__x, __at, __right, __edge, __spare);
+  if (__pos < __at)
+    return iterator(__x, __pos);
+  return iterator(__right, __pos - __at);
+}
+
+// _M_split_leaf() :
+// (한 칸 넘치게 찬) __x의 [__split, 끝)을 새 leaf __right로 옮기고, 부모에 연결한다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+void
+_Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
+  ::_M_split_leaf(_Leaf* __x, size_type __split, _Leaf* __right, int __edge, _Inner*& __spare)
+{
+  _S_move(&__x->_M_value(__split), __x->_M_count - __split, &__right->_M_value(0));
+  __right->_M_count = __x->_M_count - __split;
+  __x->_M_count = __split;
+
+  __right->_M_next = __x->_M_next;
+  __right->_M_prev = __x;
+  if (__x->_M_next)
+    __x->_M_next->_M_prev = __right;
+  else
+    _M_rightmost = __right;
+  __x->_M_next = __right;
+
+  _M_insert_into_parent(__x, _S_key(__right, 0), __right, __edge, __spare);
+}
+
+// _M_insert_into_parent() :
+// 나뉜 노드 __left 바로 오른쪽에 __right를 자식으로, __k를 그 사이의 separator로 넣는다.
+// 부모가 없으면(나뉜 노드가 root였으면) 새 root를 만든다. 부모가 넘치면 부모도 나눈다.
+// __edge는 트리의 오른쪽(1) 또는 왼쪽(-1) 끝에서 나누는 중이라는 뜻이다. 그때는 한쪽을 가득 채운 채로 둔다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+void
+_Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
+  ::_M_insert_into_parent(_Base_ptr __left, const key_type& __k, _Base_ptr __right, int __edge, _Inner*& __spare)
+{
+  _Inner* __p = _S_inner(__left->_M_parent);
+  if (__p == 0) {
+    _Inner* __root = __spare;
+    __spare = _S_inner(__spare->_M_parent);
+    __root->_M_parent = 0;
+    ft::_Construct(&__root->_M_key(0), __k);
+    __root->_M_child[0] = __left;
+    __root->_M_child[1] = __right;
+    __root->_M_count = 1;
+    __left->_M_parent = __right->_M_parent = __root;
+    _M_root = __root;
+    return;
+  }
+
+  const size_type __i = _S_child_index(__p, __left);
+  const size_type __n = __p->_M_count;
+  _S_move(&__p->_M_key(__i), __n - __i, &__p->_M_key(__i + 1));
+  ft::_Construct(&__p->_M_key(__i), __k);
+  for (size_type __j = __n + 1; __j > __i + 1; --__j)
+    __p->_M_child[__j] = __p->_M_child[__j - 1];
+  __p->_M_child[__i + 1] = __right;
+  __right->_M_parent = __p;
+  ++__p->_M_count;
+  if (__p->_M_count <= _S_inner_slots)
+    return;
+
+  // 부모를 나눈다 : key [0, __m)은 남기고, __m번째 key는 위로 올리고, (__m, 끝]은 새 노드로 옮긴다.
+  size_type __m = _S_inner_slots / 2;
+  if (__edge > 0 && __i == __n)
+    __m = _S_inner_slots - 1;
+  else if (__edge < 0 && __i == 0)
+    __m = 1;
+  _Inner* __q = __spare;
+  __spare = _S_inner(__spare->_M_parent);
+  const size_type __total = __p->_M_count; // _S_inner_slots + 1
+  _S_move(&__p->_M_key(__m + 1), __total - __m - 1, &__q->_M_key(0));
+  for (size_type __j = __m + 1; __j <= __total; ++__j) {
+    __q->_M_child[__j - __m - 1] = __p->_M_child[__j];
+    __p->_M_child[__j]->_M_parent = __q;
+  }
+  __q->_M_count = __total - __m - 1;
+  __p->_M_count = __m;
+  _M_insert_into_parent(__p, __p->_M_key(__m), __q, __edge, __spare); // __m번째 key를 위로 올린다.
+  __p->_M_key(__m).~_Key();
+}
+
+// _M_erase_at() :
+// __x의 __pos번째부터 __n개의 요소를 지운다. leaf가 최소 수보다 적어지면, 형제와 합쳐서 한 노드에 들어가면 합치고,
+// 아니면 둘이 반씩 나누어 가지도록 형제에게서 모자란 만큼 옮겨온다. (둘 다 최소 수 이상이 된다.)
+// 합치면 부모의 key가 하나 줄어드므로, 부모도 같은 방법으로 맞춘다. (_M_rebalance_inner())
+// 지운 요소의 다음 요소가 옮겨간 자리를 따라가서 반환한다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+typename _Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::iterator
+_Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
+  ::_M_erase_at(_Leaf* __x, size_type __pos, size_type __n)
+{
+  for (size_type __i = 0; __i < __n; ++__i)
+    __x->_M_value(__pos + __i).~_Value();
+  _S_move(&__x->_M_value(__pos + __n), __x->_M_count - __pos - __n, &__x->_M_value(__pos));
+  __x->_M_count -= __n;
+  _M_node_count -= __n;
+
+  if (__x == _M_root) {
+    if (__x->_M_count == 0) {
+      _M_put_leaf(__x);
+      _M_root = 0;
+      _M_leftmost = _M_rightmost = 0;
+      return end();
+    }
+    return _M_make_iterator(__x, __pos);
+  }
+  if (__x->_M_count >= _S_leaf_min)
+    return _M_make_iterator(__x, __pos);
+
+  _Inner* __p = _S_inner(__x->_M_parent);
+  const size_type __i = _S_child_index(__p, __x);
+
+  // 1. 왼쪽 형제가 있으면 왼쪽 형제와 맞춘다.
+  if (__i > 0) {
+    _Leaf* __l = _S_leaf(__p->_M_child[__i - 1]);
+    if (__l->_M_count + __x->_M_count < 2 * _S_leaf_min) { // 합쳐도 _S_leaf_slots를 넘지 않는다.
+      __pos += __l->_M_count;
+      _M_merge_leaves(__p, __i - 1);
+      _M_rebalance_inner(__p);
+      return _M_make_iterator(__l, __pos);
+    }
+    // 왼쪽 형제의 마지막 __k개를 빌린다.
+    const size_type __k = (__l->_M_count - __x->_M_count) / 2;
+    _S_move(&__x->_M_value(0), __x->_M_count, &__x->_M_value(__k));
+    _S_move(&__l->_M_value(__l->_M_count - __k), __k, &__x->_M_value(0));
+    __l->_M_count -= __k;
+    __x->_M_count += __k;
+    _S_replace_key(__p, __i - 1, _S_key(__x, 0));
+    return _M_make_iterator(__x, __pos + __k);
+  }
+  // 2. 아니면 (맨 왼쪽 자식이므로) 오른쪽 형제와 맞춘다.
+  _Leaf* __r = _S_leaf(__p->_M_child[__i + 1]);
+  if (__r->_M_count + __x->_M_count < 2 * _S_leaf_min) {
+    _M_merge_leaves(__p, __i);
+    _M_rebalance_inner(__p);
+    return _M_make_iterator(__x, __pos);
+  }
+  // 오른쪽 형제의 처음 __k개를 빌린다.
+  const size_type __k = (__r->_M_count - __x->_M_count) / 2;
+  _S_move(&__r->_M_value(0), __k, &__x->_M_value(__x->_M_count));
+  _S_move(&__r->_M_value(__k), __r->_M_count - __k, &__r->_M_value(0));
+  __r->_M_count -= __k;
+  __x->_M_count += __k;
+  _S_replace_key(__p, __i, _S_key(__r, 0));
+  return _M_make_iterator(__x, __pos);
+}
+
+// _M_merge_leaves() :
+// __parent의 __i+1번째 자식(leaf)을 __i번째 자식에 붙이고, 그 사이의 separator와 함께 부모에서 뺀다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+void
+_Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
+  ::_M_merge_leaves(_Inner* __parent, size_type __i)
+{
+  _Leaf* __l = _S_leaf(__parent->_M_child[__i]);
+  _Leaf* __r = _S_leaf(__parent->_M_child[__i + 1]);
+  _S_move(&__r->_M_value(0), __r->_M_count, &__l->_M_value(__l->_M_count));
+  __l->_M_count += __r->_M_count;
+
+  __l->_M_next = __r->_M_next;
+  if (__r->_M_next)
+    __r->_M_next->_M_prev = __l;
+  else
+    _M_rightmost = __l;
+  _M_put_leaf(__r);
+
+  __parent->_M_key(__i).~_Key();
+  _S_move(&__parent->_M_key(__i + 1), __parent->_M_count - __i - 1, &__parent->_M_key(__i));
+  for (size_type __j = __i + 1; __j < __parent->_M_count; ++__j)
+    __parent->_M_child[__j] = __parent->_M_child[__j + 1];
+  --__parent->_M_count;
+}
+
+// _M_merge_inners() :
+// __parent의 __i+1번째 자식(inner)을 __i번째 자식에 붙인다. 그 사이의 separator는 부모에서 내려와 둘 사이의 key가 된다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+void
+_Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
+  ::_M_merge_inners(_Inner* __parent, size_type __i)
+{
+  _Inner* __l = _S_inner(__parent->_M_child[__i]);
+  _Inner* __r = _S_inner(__parent->_M_child[__i + 1]);
+  const size_type __n = __l->_M_count;
+  _S_move(&__parent->_M_key(__i), 1, &__l->_M_key(__n));
+  _S_move(&__r->_M_key(0), __r->_M_count, &__l->_M_key(__n + 1));
+  for (size_type __j = 0; __j <= __r->_M_count; ++__j) {
+    __l->_M_child[__n + 1 + __j] = __r->_M_child[__j];
+    __r->_M_child[__j]->_M_parent = __l;
+  }
+  __l->_M_count += __r->_M_count + 1;
+  _M_put_inner(__r);
+
+  _S_move(&__parent->_M_key(__i + 1), __parent->_M_count - __i - 1, &__parent->_M_key(__i));
+  for (size_type __j = __i + 1; __j < __parent->_M_count; ++__j)
+    __parent->_M_child[__j] = __parent->_M_child[__j + 1];
+  --__parent->_M_count;
+}
+
+// _M_rebalance_inner() :
+// inner 노드의 key가 최소 수보다 적어졌으면, 부모를 거쳐 형제의 key를 하나 돌려받거나 형제와 합친다.
+// 합친 결과 부모도 모자라게 되면 위로 반복한다. root의 key가 0개가 되면 하나 남은 자식이 새 root가 된다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+void
+_Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
+  ::_M_rebalance_inner(_Inner* __x)
+{
+  while (true) {
+    if (__x == _M_root) {
+      if (__x->_M_count == 0) {
+        _M_root = __x->_M_child[0];
+        _M_root->_M_parent = 0;
+        _M_put_inner(__x);
+      }
+      return;
+    }
+    if (__x->_M_count >= _S_inner_min)
+      return;
+
+    _Inner* __p = _S_inner(__x->_M_parent);
+    const size_type __i = _S_child_index(__p, __x);
+    _Inner* __l = __i > 0 ? _S_inner(__p->_M_child[__i - 1]) : 0;
+    _Inner* __r = __i < __p->_M_count ? _S_inner(__p->_M_child[__i + 1]) : 0;
+
+    // 1. 왼쪽 형제의 마지막 자식을 가져온다. (부모의 key는 내려오고, 형제의 마지막 key가 올라간다.)
+    if (__l && __l->_M_count > _S_inner_min) {
+      const size_type __n = __l->_M_count;
+      _S_move(&__x->_M_key(0), __x->_M_count, &__x->_M_key(1));
+      for (size_type __j = __x->_M_count + 1; __j > 0; --__j)
+        __x->_M_child[__j] = __x->_M_child[__j - 1];
+      _S_move(&__p->_M_key(__i - 1), 1, &__x->_M_key(0));
+      _S_move(&__l->_M_key(__n - 1), 1, &__p->_M_key(__i - 1));
+      __x->_M_child[0] = __l->_M_child[__n];
+      __x->_M_child[0]->_M_parent = __x;
+      --__l->_M_count;
+      ++__x->_M_count;
+      return;
+    }
+    // 2. 오른쪽 형제의 첫 자식을 가져온다.
+    if (__r && __r->_M_count > _S_inner_min) {
+      const size_type __n = __x->_M_count;
+      _S_move(&__p->_M_key(__i), 1, &__x->_M_key(__n));
+      _S_move(&__r->_M_key(0), 1, &__p->_M_key(__i));
+      __x->_M_child[__n + 1] = __r->_M_child[0];
+      __x->_M_child[__n + 1]->_M_parent = __x;
+      _S_move(&__r->_M_key(1), __r->_M_count - 1, &__r->_M_key(0));
+      for (size_type __j = 0; __j < __r->_M_count; ++__j)
+        __r->_M_child[__j] = __r->_M_child[__j + 1];
+      --__r->_M_count;
+      ++__x->_M_count;
+      return;
+    }
+    // 3. 형제와 합친다.
+    if (__l)
+      _M_merge_inners(__p, __i - 1);
+    else
+      _M_merge_inners(__p, __i);
+    __x = __p;
+  }
+}
+
+// _M_clear() :
+// 서브트리의 요소와 key를 소멸시키고 노드를 모두 해제한다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+void
+_Btree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
+  ::_M_clear(_Base_ptr __x)
+{
+  if (__x->_M_leaf) {
+    _Leaf* __leaf = _S_leaf(__x);
+    for (size_type __i = 0; __i < __leaf->_M_count; ++__i)
+      __leaf->_M_value(__i).~_Value();
+    _M_put_leaf(__leaf);
+    return;
+  }
+  _Inner* __inner = _S_inner(__x);
+  for (size_type __i = 0; __i <= __inner->_M_count; ++__i)
+    _M_clear(__inner->_M_child[__i]);
+  for (size_type __i = 0; __i < __inner->_M_count; ++__i)
+    __inner->_M_key(__i).~_Key();
+  _M_put_inner(__inner);
+}
+
+} // namespace ft
+
+#endif // BTREE_HPP
@@ -0,0 +1,280 @@
+#ifndef BTREE_MAP_HPP
+#define BTREE_MAP_HPP
+
+#include <stdexcept>
+  // std::out_of_range
+
+#include "btree.hpp"
+  // ft::_Btree
+
+#include "function.hpp"
+  // ft::_Select1st, ft::sorted_unique_t
+
+#include "type_traits.hpp"
+  // ft::has_cheap_swap
+
+namespace ft
+{
+// btree_map
+// map과 같은 인터페이스를 가진, B+tree(_Btree) 기반의 연관 컨테이너.
+// 노드 하나에 요소 수십 개가 연속으로 들어 있어서, 탐색할 때 캐시 미스가 훨씬 적고 순회가 빠르다.
+//
+// 주의: map과 달리 insert와 erase는 모든 반복자, 참조, 포인터를 무효화한다. (요소가 노드 안에서 옮겨 다닌다. btree.hpp 참고)
+// 그래서 map을 그대로 바꾸어 쓸 수는 없다. 특히 순회하면서 지우는 m.erase(it++)는 정의되지 않은 동작이고,
+// erase()가 반환하는 반복자를 받는 it = m.erase(it)만 쓸 수 있다.
+template <
+  typename _KeyType, // 요소를 정렬하고, 고유하게 식별하는 데에 사용된다. 
+  typename _MappedType, // 내가 저장하는 실제 데이터
+  typename _KeyCompare = std::less<_KeyType>, // 요소의 순서를 비교하고, 동일한지 결정할 때 사용한다.
+  typename _Alloc = std::allocator<pair<const _KeyType, _MappedType> >
+// 위의 타입들은 그대로 사용되어, 내장된 tree의 타입을 결정한다.
+> class btree_map {
+public:
+  typedef _KeyType key_type;
+  typedef _MappedType data_type;
+  typedef _MappedType mapped_type;
+  typedef pair<const _KeyType, _MappedType> value_type; // 노드(pair)의 타입
+  typedef _KeyCompare key_compare;
+
+  class value_compare
+  {
+  friend class btree_map<_KeyType, _MappedType, _KeyCompare, _Alloc>;
+
+  protected :
+    _KeyCompare comp;
+    value_compare(_KeyCompare __c) : comp(__c) {}
+
+  public:
+    bool operator()(const value_type& __x, const value_type& __y) const {
+      return comp(__x.first, __y.first);
+    }
+  };
+
+private:
+  typedef _Btree<key_type, value_type, _Select1st<value_type>, key_compare, _Alloc>
+    _Btree_type;
+  _Btree_type _M_tree; // 이것이 실제 btree_map
+public:
+  typedef typename _Btree_type::pointer pointer;
+  typedef typename _Btree_type::const_pointer const_pointer;
+  typedef typename _Btree_type::reference reference;
+  typedef typename _Btree_type::const_reference const_reference;
+  typedef typename _Btree_type::iterator iterator;
+  typedef typename _Btree_type::const_iterator const_iterator;
+  typedef typename _Btree_type::reverse_iterator reverse_iterator;
+  typedef typename _Btree_type::const_reverse_iterator const_reverse_iterator;
+  typedef typename _Btree_type::size_type size_type;
+  typedef typename _Btree_type::difference_type difference_type;
+  typedef typename _Btree_type::allocator_type allocator_type;
+
+  // allocation/deallocation
+
+  btree_map() : _M_tree(_KeyCompare(), allocator_type()) {}
+  explicit btree_map(const _KeyCompare& __comp,
+                     const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) {}
+
+  template <class _InputIterator>
+  btree_map(_InputIterator __first, _InputIterator __last)
+    : _M_tree(_KeyCompare(), allocator_type())
+    { _M_tree.insert_unique(__first, __last); }
+
+  template <class _InputIterator>
+  btree_map(_InputIterator __first, _InputIterator __last, const _KeyCompare& __comp,
+      const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) { _M_tree.insert_unique(__first, __last); }
+  
+  // 정렬된 범위로 생성 :
+  // [__first, __last)가 key 순서대로 정렬되어 있고 중복이 없어야 한다. 모두 맨 끝에 붙으므로 O(n)이다.
+  template <class _InputIterator>
+  btree_map(sorted_unique_t, _InputIterator __first, _InputIterator __last,
+      const _KeyCompare& __comp = _KeyCompare(),
+      const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) { _M_tree.insert_unique(__first, __last); }
+  
+  btree_map(const btree_map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x) : _M_tree(__x._M_tree) {}
+
+  btree_map<_KeyType, _MappedType, _KeyCompare, _Alloc>&
+  operator=(const btree_map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x)
+  {
+    _M_tree = __x._M_tree;
+    return *this; 
+  }
+
+  // accessors:
+
+  key_compare key_comp() const { return _M_tree.key_comp(); }
+  value_compare value_comp() const { return value_compare(_M_tree.key_comp()); }
+  allocator_type get_allocator() const { return _M_tree.get_allocator(); }
+
+  iterator begin() { return _M_tree.begin(); }
+  const_iterator begin() const { return _M_tree.begin(); }
+  iterator end() { return _M_tree.end(); }
+  const_iterator end() const { return _M_tree.end(); }
+  reverse_iterator rbegin() { return _M_tree.rbegin(); }
+  const_reverse_iterator rbegin() const { return _M_tree.rbegin(); }
+  reverse_iterator rend() { return _M_tree.rend(); }
+  const_reverse_iterator rend() const { return _M_tree.rend(); }
+  bool empty() const { return _M_tree.empty(); }
+  size_type size() const { return _M_tree.size(); }
+  size_type max_size() const { return _M_tree.max_size(); }
+
+  // opearator[] :
+  // 해당 키를 이용하여 직접 접근할 수 있다.
+  _MappedType& operator[](const key_type& __k) {
+    iterator __i = lower_bound(__k);
+    // __i->first is greater than or equivalent to __k.
+    if (__i == end() || key_comp()(__k, (*__i).first))
+      __i = insert(__i, value_type(__k, _MappedType()));
+    return (*__i).second;
+  }
+
+  // at():
+  // 해당 키의 값. 키가 없으면 std::out_of_range를 던진다.
+  _MappedType& at(const key_type& __k) {
+    iterator __i = find(__k);
+    if (__i == end())
+      throw std::out_of_range("btree_map");
+    return (*__i).second;
+  }
+
+  const _MappedType& at(const key_type& __k) const {
+    const_iterator __i = find(__k);
+    if (__i == end())
+      throw std::out_of_range("btree_map");
+    return (*__i).second;
+  }
+
+  // swap() :
+  void swap(btree_map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x) { _M_tree.swap(__x._M_tree); }
+
+  // insert() :
+  // 1. 단일요소
+  pair<iterator, bool> insert(const value_type& __x)
+    { return _M_tree.insert_unique(__x); }
+
+  // 2. 힌트와 함께
+  iterator insert(iterator position, const value_type& __x)
+    { return _M_tree.insert_unique(position, __x); }
+
+  // 3. 범위
+  // (정렬된 범위라면 탐색 없이 맨 끝에 붙는다.)
+  template <class _InputIterator>
+  void insert(_InputIterator __first, _InputIterator __last) {
+    _M_tree.insert_unique(__first, __last);
+  }
+
+  // 4. 정렬된 범위
+  // map과 같은 모양으로 쓸 수 있도록 둔다. btree_map에서는 3과 같다.
+  template <class _InputIterator>
+  void insert(sorted_unique_t, _InputIterator __first, _InputIterator __last) {
+    _M_tree.insert_unique(__first, __last);
+  }
+
+  // erase() :
+  // 1. 단일 요소 (반복자로)
+  // (map과 달리, 지운 요소의 다음 요소를 가리키는 반복자를 반환한다. 다른 반복자는 모두 무효화된다.)
+  iterator erase(iterator __position)
+    { return _M_tree.erase(__position); }
+
+  // 2. 단일 요소 (키로)
+  // 지운 요소의 개수를 반환한다.
+  size_type erase(const key_type& __x) 
+    { return _M_tree.erase(__x); }
+  
+  // 3. 범위
+  // leaf 단위로 한꺼번에 지운다. __last가 옮겨간 자리를 반환한다.
+  iterator erase(iterator __first, iterator __last)
+    { return _M_tree.erase(__first, __last); }
+  
+  void clear() { _M_tree.clear(); }
+
+  // map operations:
+  // (설명은 btree.hpp를 참고하자.)
+  
+  iterator find(const key_type& __x) { return _M_tree.find(__x); }
+  const_iterator find(const key_type& __x) const { return _M_tree.find(__x); }
+
+  // count() :
+  // 1과 0 중에서만 반환한다.
+  size_type count(const key_type& __x) const { return _M_tree.count(__x); }
+
+  iterator lower_bound(const key_type& __x) {return _M_tree.lower_bound(__x); }
+  const_iterator lower_bound(const key_type& __x) const {
+    return _M_tree.lower_bound(__x); 
+  }
+
+  iterator upper_bound(const key_type& __x) {return _M_tree.upper_bound(__x); }
+  const_iterator upper_bound(const key_type& __x) const {
+    return _M_tree.upper_bound(__x); 
+  }
+
+  // * lower_bound()와 upper_bound()의 활용
+  // [1245]에서 1부터 4까지의 요소를 포함하는 범위는 [lower_bound(1), upper_bound(4))로 표현할 수 있다.
+  // (upper_bound(4)는 5를 가리키고 있으므로)
+  
+  pair<iterator,iterator> equal_range(const key_type& __x) {
+    return _M_tree.equal_range(__x);
+  }
+  pair<const_iterator,const_iterator> equal_range(const key_type& __x) const {
+    return _M_tree.equal_range(__x);
+  }
+
+  template <class _K1, class _T1, class _C1, class _A1>
+  friend bool operator== (const btree_map<_K1, _T1, _C1, _A1>&,
+                          const btree_map<_K1, _T1, _C1, _A1>&);
+  template <class _K1, class _T1, class _C1, class _A1>
+  friend bool operator< (const btree_map<_K1, _T1, _C1, _A1>&,
+                         const btree_map<_K1, _T1, _C1, _A1>&);
+};
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator==(const btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+                       const btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return __x._M_tree == __y._M_tree;
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator<(const btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+                      const btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return __x._M_tree < __y._M_tree;
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator!=(const btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+                       const btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return !(__x == __y);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator>(const btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+                      const btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return __y < __x;
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator<=(const btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+                       const btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return !(__y < __x);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator>=(const btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+                       const btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return !(__x < __y);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+void swap(btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+                 btree_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 :
+// btree_map의 swap()은 root와 양끝 leaf 포인터만 바꾼다.
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+struct has_cheap_swap<btree_map<_Key,_MappedType,_KeyCompare,_Alloc> > : public true_type {};
+
+} // namespace ft
+
+#endif /* BTREE_MAP_HPP */
@@ -0,0 +1,202 @@
+#ifndef BTREE_SET_HPP
+#define BTREE_SET_HPP
+
+#include "btree.hpp"
+  // ft::_Btree
+
+#include "function.hpp"
+  // ft::_Identity, ft::sorted_unique_t
+
+#include "type_traits.hpp"
+  // ft::has_cheap_swap
+
+namespace ft
+{
+// btree_set
+// 고유한 key만 저장하는, B+tree(_Btree) 기반의 연관 컨테이너.
+// btree_map과 같은 트리를 쓰고, value가 곧 key다. key를 바꾸면 순서가 깨지므로 반복자는 모두 const_iterator다.
+// 주의: btree_map과 마찬가지로 insert와 erase는 모든 반복자를 무효화한다. 순회하면서 지울 때는 it = s.erase(it)만 쓸 수 있다.
+template <
+  typename _KeyType,
+  typename _KeyCompare = std::less<_KeyType>,
+  typename _Alloc = std::allocator<_KeyType>
+> class btree_set {
+public:
+  typedef _KeyType key_type;
+  typedef _KeyType value_type;
+  typedef _KeyCompare key_compare;
+  typedef _KeyCompare value_compare;
+
+private:
+  typedef _Btree<key_type, value_type, _Identity<value_type>, key_compare, _Alloc>
+    _Btree_type;
+  _Btree_type _M_tree; // 이것이 실제 btree_set
+public:
+  typedef typename _Btree_type::const_pointer pointer;
+  typedef typename _Btree_type::const_pointer const_pointer;
+  typedef typename _Btree_type::const_reference reference;
+  typedef typename _Btree_type::const_reference const_reference;
+  typedef typename _Btree_type::const_iterator iterator;
+  typedef typename _Btree_type::const_iterator const_iterator;
+  typedef typename _Btree_type::const_reverse_iterator reverse_iterator;
+  typedef typename _Btree_type::const_reverse_iterator const_reverse_iterator;
+  typedef typename _Btree_type::size_type size_type;
+  typedef typename _Btree_type::difference_type difference_type;
+  typedef typename _Btree_type::allocator_type allocator_type;
+
+  // allocation/deallocation
+
+  btree_set() : _M_tree(_KeyCompare(), allocator_type()) {}
+  explicit btree_set(const _KeyCompare& __comp,
+                     const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) {}
+
+  template <class _InputIterator>
+  btree_set(_InputIterator __first, _InputIterator __last)
+    : _M_tree(_KeyCompare(), allocator_type())
+    { _M_tree.insert_unique(__first, __last); }
+
+  template <class _InputIterator>
+  btree_set(_InputIterator __first, _InputIterator __last, const _KeyCompare& __comp,
+            const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) { _M_tree.insert_unique(__first, __last); }
+
+  // 정렬된 범위로 생성 :
+  // [__first, __last)가 정렬되어 있고 중복이 없어야 한다. 모두 맨 끝에 붙으므로 O(n)이다.
+  template <class _InputIterator>
+  btree_set(sorted_unique_t, _InputIterator __first, _InputIterator __last,
+            const _KeyCompare& __comp = _KeyCompare(),
+            const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) { _M_tree.insert_unique(__first, __last); }
+
+  btree_set(const btree_set<_KeyType, _KeyCompare, _Alloc>& __x) : _M_tree(__x._M_tree) {}
+
+  btree_set<_KeyType, _KeyCompare, _Alloc>&
+  operator=(const btree_set<_KeyType, _KeyCompare, _Alloc>& __x)
+  {
+    _M_tree = __x._M_tree;
+    return *this;
+  }
+
+  // accessors:
+
+  key_compare key_comp() const { return _M_tree.key_comp(); }
+  value_compare value_comp() const { return _M_tree.key_comp(); }
+  allocator_type get_allocator() const { return _M_tree.get_allocator(); }
+
+  iterator begin() const { return _M_tree.begin(); }
+  iterator end() const { return _M_tree.end(); }
+  reverse_iterator rbegin() const { return _M_tree.rbegin(); }
+  reverse_iterator rend() const { return _M_tree.rend(); }
+  bool empty() const { return _M_tree.empty(); }
+  size_type size() const { return _M_tree.size(); }
+  size_type max_size() const { return _M_tree.max_size(); }
+
+  // swap() :
+  void swap(btree_set<_KeyType, _KeyCompare, _Alloc>& __x) { _M_tree.swap(__x._M_tree); }
+
+  // insert() :
+  // 1. 단일요소
+  pair<iterator, bool> insert(const value_type& __x) {
+    pair<typename _Btree_type::iterator, bool> __p = _M_tree.insert_unique(__x);
+    return pair<iterator, bool>(__p.first, __p.second);
+  }
+
+  // 2. 힌트와 함께
+  iterator insert(iterator __position, const value_type& __x)
+    { return _M_tree.insert_unique(_Btree_type::_S_const_cast(__position), __x); }
+
+  // 3. 범위
+  template <class _InputIterator>
+  void insert(_InputIterator __first, _InputIterator __last) {
+    _M_tree.insert_unique(__first, __last);
+  }
+
+  // 4. 정렬된 범위
+  template <class _InputIterator>
+  void insert(sorted_unique_t, _InputIterator __first, _InputIterator __last) {
+    _M_tree.insert_unique(__first, __last);
+  }
+
+  // erase() :
+  // 1. 단일 요소 (반복자로)
+  // 지운 요소의 다음 요소를 가리키는 반복자를 반환한다. 다른 반복자는 모두 무효화된다.
+  iterator erase(iterator __position)
+    { return _M_tree.erase(_Btree_type::_S_const_cast(__position)); }
+
+  // 2. 단일 요소 (키로)
+  size_type erase(const key_type& __x)
+    { return _M_tree.erase(__x); }
+
+  // 3. 범위
+  // leaf 단위로 한꺼번에 지운다. __last가 옮겨간 자리를 반환한다.
+  iterator erase(iterator __first, iterator __last)
+    { return _M_tree.erase(_Btree_type::_S_const_cast(__first), _Btree_type::_S_const_cast(__last)); }
+
+  void clear() { _M_tree.clear(); }
+
+  // set operations:
+
+  iterator find(const key_type& __x) const { return _M_tree.find(__x); }
+  size_type count(const key_type& __x) const { return _M_tree.count(__x); }
+  iterator lower_bound(const key_type& __x) const { return _M_tree.lower_bound(__x); }
+  iterator upper_bound(const key_type& __x) const { return _M_tree.upper_bound(__x); }
+  pair<iterator,iterator> equal_range(const key_type& __x) const { return _M_tree.equal_range(__x); }
+
+  template <class _K1, class _C1, class _A1>
+  friend bool operator== (const btree_set<_K1, _C1, _A1>&,
+                          const btree_set<_K1, _C1, _A1>&);
+  template <class _K1, class _C1, class _A1>
+  friend bool operator< (const btree_set<_K1, _C1, _A1>&,
+                         const btree_set<_K1, _C1, _A1>&);
+};
+
+template <class _Key, class _KeyCompare, class _Alloc>
+bool operator==(const btree_set<_Key,_KeyCompare,_Alloc>& __x,
+                const btree_set<_Key,_KeyCompare,_Alloc>& __y) {
+  return __x._M_tree == __y._M_tree;
+}
+
+template <class _Key, class _KeyCompare, class _Alloc>
+bool operator<(const btree_set<_Key,_KeyCompare,_Alloc>& __x,
+               const btree_set<_Key,_KeyCompare,_Alloc>& __y) {
+  return __x._M_tree < __y._M_tree;
+}
+
+template <class _Key, class _KeyCompare, class _Alloc>
+bool operator!=(const btree_set<_Key,_KeyCompare,_Alloc>& __x,
+                const btree_set<_Key,_KeyCompare,_Alloc>& __y) {
+  return !(__x == __y);
+}
+
+template <class _Key, class _KeyCompare, class _Alloc>
+bool operator>(const btree_set<_Key,_KeyCompare,_Alloc>& __x,
+               const btree_set<_Key,_KeyCompare,_Alloc>& __y) {
+  return __y < __x;
+}
+
+template <class _Key, class _KeyCompare, class _Alloc>
+bool operator<=(const btree_set<_Key,_KeyCompare,_Alloc>& __x,
+                const btree_set<_Key,_KeyCompare,_Alloc>& __y) {
+  return !(__y < __x);
+}
+
+template <class _Key, class _KeyCompare, class _Alloc>
+bool operator>=(const btree_set<_Key,_KeyCompare,_Alloc>& __x,
+                const btree_set<_Key,_KeyCompare,_Alloc>& __y) {
+  return !(__x < __y);
+}
+
+template <class _Key, class _KeyCompare, class _Alloc>
+void swap(btree_set<_Key,_KeyCompare,_Alloc>& __x,
+          btree_set<_Key,_KeyCompare,_Alloc>& __y) {
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 :
+template <class _Key, class _KeyCompare, class _Alloc>
+struct has_cheap_swap<btree_set<_Key,_KeyCompare,_Alloc> > : public true_type {};
+
+} // namespace ft
+
+#endif /* BTREE_SET_HPP */
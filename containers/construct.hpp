@@ -7,6 +7,11 @@ namespace ft
 template <typename _T1, typename _T2>
 	void _Construct(_T1* __p, const _T2& __value)
 	{ new (static_cast<void*>(__p)) _T1(__value); }
+
+// 빈 객체를 기본생성한다.
+template <typename _T1>
+	void _Construct(_T1* __p)
+	{ new (static_cast<void*>(__p)) _T1(); }
   
 }
 
@@ -0,0 +1,671 @@
+#ifndef DEVECTOR_HPP
+#define DEVECTOR_HPP
+
+#include <memory>
+  // std::allocator
+  // std::uninitialized_copy(), std::uninitialized_fill_n()
+
+#include <iterator>
+  // std::distance(), std::advance()
+
+#include <limits>
+  // std::numeric_limits
+
+#include <algorithm>
+  // std::copy_backward(), std::fill(), std::max(), std::min()
+
+#include <stdexcept>
+  // std::out_of_range
+
+#include "iterator.hpp"
+  // ft::__normal_iterator
+  // ft::reverse_iterator
+
+#include "algorithm.hpp"
+  // ft::equal(), ft::lexicographical_compare()
+
+#include "type_traits.hpp"
+  // ft::enable_if
+  // ft::is_integral
+  // ft::has_cheap_swap
+
+#include "construct.hpp"
+  // ft::_Construct(메모리 주소): 빈 객체를 기본생성한다.
+
+#include "alloc.hpp"
+  // _Alloc_traits::_S_swap(): swap()에서 할당기를 맞바꾼다. (slab_allocator는 풀 포인터만 바꾼다.)
+
+namespace ft
+{
+
+// devector
+// : vector처럼 요소를 하나의 연속된 배열에 두지만, 빈 공간을 뒤쪽뿐 아니라 앞쪽에도 남겨두는 시퀀스 컨테이너.
+//
+// vector::insert(begin(), x)는 요소 전체를 한 칸씩 뒤로 민다. (_M_insert_aux의 copy_backward)
+// devector는 앞쪽에도 빈 공간이 있으므로 push_front()가 push_back()과 마찬가지로 amortized O(1)이다.
+// 한쪽 끝의 공간이 떨어졌을 때, 전체의 절반 이상이 비어 있으면 재할당 대신 요소를 가운데로 다시 모은다.(re-center)
+// 그 외에는 vector와 같은 정책(capacity의 2배)으로 재할당하고, 남는 공간을 앞뒤로 나누어 둔다.
+// 중간에 insert/erase할 때는 앞뒤 중 요소가 적은 쪽을 민다.
+//
+// 메모리 배치: [_M_storage ... _M_start(요소들)_M_finish ... _M_end_of_storage)
+
+template <typename _Type, typename _AllocatorType>
+class _Devector_base {
+
+// _Vector_base와 같은 목적이다. 생성자와 소멸자가 공간의 할당/해제를 맡는다. (초기화 제외)
+
+public:
+  typedef _AllocatorType allocator_type;
+
+  allocator_type get_allocator() const { return _M_data_allocator; }
+
+protected:
+  allocator_type _M_data_allocator;
+  _Type* _M_storage; // 할당된 공간의 시작 (앞쪽 빈 공간의 시작)
+  _Type* _M_start; // 첫 data
+  _Type* _M_finish; // 마지막 data의 다음
+  _Type* _M_end_of_storage; // 마지막 저장가능한 공간의 다음
+
+  _Type* _M_allocate(size_t __n)
+  { return _M_data_allocator.allocate(__n); }
+
+  void _M_deallocate(_Type* __p, size_t __n)
+  { if (__p) _M_data_allocator.deallocate(__p, __n); }
+
+public:
+  // CONSTRUCTOR
+  _Devector_base(const allocator_type& __a)
+    : _M_data_allocator(__a), _M_storage(0), _M_start(0), _M_finish(0), _M_end_of_storage(0) {}
+
+  _Devector_base(size_t __n, const allocator_type& __a)
+    : _M_data_allocator(__a), _M_storage(_M_allocate(__n)), _M_start(_M_storage), _M_finish(_M_storage), _M_end_of_storage(_M_storage + __n) {}
+
+  // DESTRUCTOR
+  ~_Devector_base() { _M_deallocate(_M_storage, _M_end_of_storage - _M_storage); }
+}; // class _Devector_base
+
+
+
+template <
+  typename _Type,
+  typename _AllocatorType = std::allocator<_Type>
+> class devector : protected _Devector_base<_Type, _AllocatorType>
+{
+
+private:
+  typedef _Devector_base<_Type, _AllocatorType> _Base;
+  typedef devector<_Type, _AllocatorType> devector_type;
+
+public:
+  // Member types
+
+  typedef _Type  value_type;
+  typedef typename _Base::allocator_type  allocator_type;
+  typedef std::size_t  size_type;
+  typedef std::ptrdiff_t  difference_type;
+
+  typedef value_type& reference;
+  typedef const value_type&  const_reference;
+
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::const_pointer const_pointer;
+
+  typedef __normal_iterator<pointer, devector_type>  iterator;
+  typedef __normal_iterator<const_pointer, devector_type>  const_iterator;
+
+  typedef ft::reverse_iterator<const_iterator>  const_reverse_iterator;
+  typedef ft::reverse_iterator<iterator>  reverse_iterator;
+
+protected:
+  using _Base::_M_allocate;
+  using _Base::_M_deallocate;
+  using _Base::_M_storage;
+  using _Base::_M_start;
+  using _Base::_M_finish;
+  using _Base::_M_end_of_storage;
+
+public:
+  // 멤버함수: 요소 접근
+
+  reference at(size_type __n) {
+    _M_range_check(__n);
+    return (*this)[__n];
+  }
+
+  const_reference at(size_type __n) const {
+    _M_range_check(__n);
+    return (*this)[__n];
+  }
+
+  reference operator[](size_type __n) { return *(begin() + __n); }
+  const_reference operator[](size_type __n) const { return *(begin() + __n); }
+
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+
+  reference back() { return *(end() - 1); }
+  const_reference back() const { return *(end() - 1); }
+
+  // data() :
+  // 첫 요소를 가리키는 포인터. (할당된 공간의 시작이 아닐 수 있다.)
+  value_type* data() { return _M_start; }
+  const value_type* data() const { return _M_start; }
+
+  // 멤버함수: 반복자
+
+  iterator begin() { return iterator(_M_start); }
+  const_iterator begin() const { return const_iterator(_M_start); }
+
+  iterator end() { return iterator(_M_finish); }
+  const_iterator end() const { return const_iterator(_M_finish); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+  // 멤버함수: 용량
+
+  bool empty() const { return _M_start == _M_finish; }
+
+  size_type size() const { return size_type(_M_finish - _M_start); }
+
+  size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(_Type); }
+
+  // capacity() :
+  // 앞뒤 빈 공간을 포함한, 할당된 공간 전체에 저장할 수 있는 요소의 수
+  size_type capacity() const { return size_type(_M_end_of_storage - _M_storage); }
+
+  // front_free_capacity(), back_free_capacity() :
+  // 재배치나 재할당 없이 push_front(), push_back()할 수 있는 요소의 수
+  size_type front_free_capacity() const { return size_type(_M_start - _M_storage); }
+  size_type back_free_capacity() const { return size_type(_M_end_of_storage - _M_finish); }
+
+  // reserve() :
+  // 뒤쪽으로 __n개까지 재할당 없이 늘어날 수 있도록 한다. (vector::reserve()와 같다.)
+  void reserve(size_type __n) {
+    if (__n > size())
+      _M_make_room(0, __n - size());
+  }
+
+  // reserve_front() :
+  // 앞쪽으로 __n개까지 재할당 없이 늘어날 수 있도록 한다.
+  void reserve_front(size_type __n) {
+    if (__n > size())
+      _M_make_room(__n - size(), 0);
+  }
+
+  // 멤버함수: 변환자
+
+  void clear() { erase(begin(), end()); }
+
+  // insert() :
+  // 삽입 위치 앞쪽의 요소가 더 적으면 앞쪽을, 아니면 뒤쪽을 민다.
+  // 재할당이나 재배치가 일어나면 모든 반복자가 무효화된다.
+
+  // insert1. 단일 요소
+  iterator insert(iterator __position, const _Type& __x) {
+    size_type __idx = __position - begin();
+    if (__idx == 0)
+      push_front(__x);
+    else if (__idx == size())
+      push_back(__x);
+    else
+      _M_fill_insert(__idx, 1, __x);
+    return begin() + __idx;
+  }
+
+  // insert2. 채우기
+  void insert(iterator __pos, size_type __n, const _Type& __x)
+    { _M_fill_insert(__pos - begin(), __n, __x); }
+
+  // insert3. 범위
+  template<typename _InputIterator>
+  void insert(
+    iterator __pos,
+    typename ft::enable_if<!ft::is_integral<_InputIterator>::value,
+    _InputIterator>::type __first,
+    _InputIterator __last) {
+    typedef typename iterator_traits<_InputIterator>::iterator_category _IterCategory;
+    _M_range_insert(__pos - begin(), __first, __last, _IterCategory());
+  }
+
+  // erase() :
+  // 지운 구간 앞쪽의 요소가 더 적으면 앞쪽을 뒤로 당기고, 아니면 뒤쪽을 앞으로 당긴다.
+  // 반환값: 지워진 요소 중 마지막 요소의 다음 요소의 새로운 위치를 가리키는 반복자
+
+  // erase1. 단일 요소
+  iterator erase(iterator __position) { return erase(__position, __position + 1); }
+
+  // erase2. 범위
+  iterator erase(iterator __first, iterator __last) {
+    const size_type __n = __last - __first;
+    if (__first - begin() < end() - __last) {
+      // 예) [12AB3456], erase AB → [12123456]: 12를 뒤로 복사 → [123456]: 앞의 12를 소멸
+      iterator __new_begin(std::copy_backward(begin(), __first, __last));
+      _M_destroy(begin(), __new_begin);
+      _M_start += __n;
+      return __last;
+    }
+    iterator __i(std::copy(__last, end(), __first));
+    _M_destroy(__i, end());
+    _M_finish -= __n;
+    return __first;
+  }
+
+  // push_back(), push_front() :
+  // 해당 쪽 끝에 빈 공간이 없을 때만 _M_make_room()으로 재배치하거나 재할당한다.
+  void push_back(const _Type& __x) {
+    if (_M_finish != _M_end_of_storage) {
+      get_allocator().construct(_M_finish, __x);
+      ++_M_finish;
+    }
+    else {
+      _Type __x_copy = __x; // (__x가 이 devector의 요소라면 재배치 후에는 다른 값을 가리킨다.)
+      _M_make_room(0, 1);
+      get_allocator().construct(_M_finish, __x_copy);
+      ++_M_finish;
+    }
+  }
+
+  void push_front(const _Type& __x) {
+    if (_M_start != _M_storage) {
+      get_allocator().construct(_M_start - 1, __x);
+      --_M_start;
+    }
+    else {
+      _Type __x_copy = __x;
+      _M_make_room(1, 0);
+      get_allocator().construct(_M_start - 1, __x_copy);
+      --_M_start;
+    }
+  }
+
+  void pop_back() {
+    --_M_finish;
+    get_allocator().destroy(_M_finish);
+  }
+
+  void pop_front() {
+    get_allocator().destroy(_M_start);
+    ++_M_start;
+  }
+
+  void resize(size_type __new_size, const _Type& __x = _Type()) {
+    if (__new_size < size())
+      erase(begin() + __new_size, end());
+    else
+      insert(end(), __new_size - size(), __x);
+  }
+
+  // swap() : 공간은 그것을 할당한 할당기가 해제해야 하므로, 할당기도 함께 바꾼다.
+  void swap(devector<_Type, _AllocatorType>& __x) {
+    _Alloc_traits<_Type, _AllocatorType>::_S_swap(this->_M_data_allocator, __x._M_data_allocator);
+    std::swap(_M_storage, __x._M_storage);
+    std::swap(_M_start, __x._M_start);
+    std::swap(_M_finish, __x._M_finish);
+    std::swap(_M_end_of_storage, __x._M_end_of_storage);
+  }
+
+public:
+  // CONSTRUCTOR
+  // (앞쪽 빈 공간 없이, 딱 필요한 만큼만 할당한다.)
+
+  explicit devector(const allocator_type& __a = allocator_type()) : _Base(__a) {}
+
+  explicit devector(
+    size_type __n,
+    const _Type& __value = _Type(),
+    const allocator_type& __a = allocator_type()
+  ) : _Base(__n, __a)
+    { _M_finish = std::uninitialized_fill_n(_M_start, __n, __value); }
+
+  template <typename _InputIterator>
+    devector(
+      typename ft::enable_if<!ft::is_integral<_InputIterator>::value,
+      _InputIterator>::type  __first,
+      _InputIterator __last,
+      const allocator_type& __a = allocator_type()
+    ) : _Base(__a) {
+    typedef typename iterator_traits<_InputIterator>::iterator_category _IterCategory;
+    _M_range_initialize(__first, __last, _IterCategory());
+  }
+
+  devector(const devector<_Type, _AllocatorType>& __x) : _Base(__x.size(), __x.get_allocator())
+    { _M_finish = std::uninitialized_copy(__x.begin(), __x.end(), _M_start); }
+
+  // DESTRUCTOR
+  ~devector() { _M_destroy(begin(), end()); }
+
+  // ASSIGN OPERATOR
+  // 복사본을 만든 뒤 swap한다. (strong guarantee)
+  devector<_Type, _AllocatorType>& operator=(const devector<_Type, _AllocatorType>& __x) {
+    if (this != &__x) {
+      devector<_Type, _AllocatorType> __tmp(__x);
+      swap(__tmp);
+    }
+    return *this;
+  }
+
+  void assign(size_type __n, const _Type& __val) {
+    devector<_Type, _AllocatorType> __tmp(__n, __val, get_allocator());
+    swap(__tmp);
+  }
+
+  template<typename _InputIterator>
+  void assign(
+    typename ft::enable_if<!ft::is_integral<_InputIterator>::value,
+    _InputIterator>::type __first,
+    _InputIterator __last) {
+    devector<_Type, _AllocatorType> __tmp(__first, __last, get_allocator());
+    swap(__tmp);
+  }
+
+  allocator_type get_allocator() const { return _Base::get_allocator(); }
+
+//----------------------------------------------------------------------------------------
+
+protected:
+  // _M_FUNCTIONS
+
+  void _M_destroy(iterator __first, iterator __last) {
+    for (; __first != __last; ++__first)
+      get_allocator().destroy(__first.base());
+  }
+
+  void _M_range_check(size_type __n) const {
+    if (__n >= this->size())
+      throw std::out_of_range("devector");
+  }
+
+  template <typename _InputIterator>
+  void _M_range_initialize(_InputIterator __first, _InputIterator __last, std::input_iterator_tag) {
+    try {
+      for (; __first != __last; ++__first)
+        push_back(*__first);
+    }
+    catch(...)
+    {
+  clear();
+  throw;
+    }
+  }
+
+  template <typename _ForwardIterator>
+  void _M_range_initialize(_ForwardIterator __first, _ForwardIterator __last, std::forward_iterator_tag) {
+    size_type __n = std::distance(__first, __last);
+    _M_storage = _M_allocate(__n);
+    _M_start = _M_finish = _M_storage;
+    _M_end_of_storage = _M_storage + __n;
+    _M_finish = std::uninitialized_copy(__first, __last, _M_start); // (실패하면 base의 소멸자가 해제한다.)
+  }
+
+  // _M_make_room() :
+  // 앞쪽에 __front개, 뒤쪽에 __back개 이상의 빈 공간을 확보한다.
+  // 1) 이미 충분하면 아무 일도 하지 않는다.
+  // 2) 다 넣고도 전체의 절반 이상이 비어 있으면, 같은 공간 안에서 요소를 가운데로 옮긴다. (re-center)
+  //    옮긴 뒤에는 한쪽 끝에 남은 공간이 현재 size의 절반 이상이므로, 옮기는 비용은 push 한 번당 O(1)로 나누어진다.
+  // 3) 아니면 vector와 같은 정책(capacity의 2배, 그보다 더 필요하면 그만큼)으로 재할당하고 가운데에 놓는다.
+  // 남는 공간은 앞뒤로 반씩 나누어, 확보를 요청한 만큼을 더해 준다.
+  void _M_make_room(size_type __front, size_type __back)
+  {
+    if (front_free_capacity() >= __front && back_free_capacity() >= __back)
+      return;
+    const size_type __size = size();
+    const size_type __need = __size + __front + __back;
+    const size_type __old_capacity = capacity();
+
+    if (__need <= __old_capacity / 2) {
+      _M_recenter(_M_storage + __front + (__old_capacity - __need) / 2);
+      return;
+    }
+
+    const size_type __len = __old_capacity + std::max(__old_capacity, __front + __back);
+    pointer __new_storage = _M_allocate(__len);
+    pointer __new_start = __new_storage + __front + (__len - __need) / 2;
+    pointer __new_finish;
+    try {
+      __new_finish = _M_relocate(_M_start, _M_finish, __new_start);
+    }
+    catch(...)
+    {
+  _M_deallocate(__new_storage, __len);
+  throw;
+    }
+    _M_destroy(begin(), end());
+    _M_deallocate(_M_storage, __old_capacity);
+    _M_storage = __new_storage;
+    _M_start = __new_start;
+    _M_finish = __new_finish;
+    _M_end_of_storage = __new_storage + __len;
+  }
+
+  // _M_relocate() :
+  // 재할당할 때 요소를 새 공간으로 옮긴다. (vector::_M_relocate()와 같이, has_cheap_swap이면 swap으로 옮긴다.)
+  pointer _M_relocate(pointer __first, pointer __last, pointer __result)
+    { return _M_relocate(__first, __last, __result, typename has_cheap_swap<_Type>::type()); }
+
+  pointer _M_relocate(pointer __first, pointer __last, pointer __result, false_type)
+    { return std::uninitialized_copy(__first, __last, __result); }
+
+  pointer _M_relocate(pointer __first, pointer __last, pointer __result, true_type)
+  {
+    pointer __cur = __result;
+    try {
+      for (; __first != __last; ++__first, ++__cur) {
+        ft::_Construct(__cur);
+        __cur->swap(*__first);
+      }
+    }
+    catch(...)
+    {
+  for (; __cur != __result; ) { // 옮긴 것을 되돌리고 새 쪽을 소멸시킨다.
+    --__cur;
+    --__first;
+    __cur->swap(*__first);
+    get_allocator().destroy(__cur);
+  }
+  throw;
+    }
+    return __cur;
+  }
+
+  // _M_recenter() :
+  // 같은 공간 안에서 요소들을 __new_start부터 시작하도록 옮긴다.
+  // 빈 공간으로 넘어가는 요소는 생성하고, 기존 요소와 겹치는 곳은 대입하고, 남겨진 자리는 소멸시킨다.
+  void _M_recenter(pointer __new_start)
+  {
+    const size_type __size = size();
+    pointer __new_finish = __new_start + __size;
+
+    if (__new_start < _M_start) { // 앞으로 당기는 경우
+      // 예) [__ __ __ 1 2 3 4] → [__ 1 2 3 4 __ __]
+      const size_type __gap = _M_start - __new_start;
+      if (__gap >= __size) { // 겹치지 않는 경우
+        std::uninitialized_copy(_M_start, _M_finish, __new_start);
+        _M_destroy(begin(), end());
+      }
+      else {
+        std::uninitialized_copy(_M_start, _M_start + __gap, __new_start); // [__ 1 2 3 4]: 1을 생성
+        _M_start = __new_start; // (여기서부터는 [__new_start, _M_finish)가 모두 생성되어 있다.)
+        std::copy(_M_start + 2 * __gap, _M_finish, _M_start + __gap); // [1 2 3 4 4]: 234를 대입
+        _M_destroy(iterator(__new_finish), end()); // [1 2 3 4 __]
+      }
+    }
+    else if (__new_start > _M_start) { // 뒤로 미는 경우
+      const size_type __gap = __new_start - _M_start;
+      if (__gap >= __size) {
+        std::uninitialized_copy(_M_start, _M_finish, __new_start);
+        _M_destroy(begin(), end());
+      }
+      else {
+        std::uninitialized_copy(_M_finish - __gap, _M_finish, _M_finish);
+        _M_finish = __new_finish;
+        std::copy_backward(_M_start, _M_finish - 2 * __gap, _M_finish - __gap);
+        _M_destroy(begin(), iterator(__new_start));
+      }
+    }
+    _M_start = __new_start;
+    _M_finish = __new_finish;
+  }
+
+  // _M_range_insert() :
+  // __idx번째 자리에 [__first, __last)를 삽입한다.
+
+  // _M_range_insert1. input iterator는 하나씩 넣는다.
+  template <typename _InputIterator>
+  void _M_range_insert(size_type __idx, _InputIterator __first, _InputIterator __last, std::input_iterator_tag)
+  {
+    for (; __first != __last; ++__first, ++__idx)
+      insert(begin() + __idx, *__first);
+  }
+
+  // _M_range_insert2. forward iterator
+  template <typename _ForwardIterator>
+  void _M_range_insert(size_type __idx, _ForwardIterator __first, _ForwardIterator __last, std::forward_iterator_tag)
+  {
+    const size_type __n = std::distance(__first, __last);
+    if (__n == 0)
+      return;
+    if (__idx < size() - __idx) { // 앞쪽이 더 짧으면 앞쪽을 민다.
+      _M_make_room(__n, 0);
+      iterator __position = begin() + __idx;
+      iterator __old_start = begin();
+      if (__idx > __n) {
+        // 예) [1234], idx == 3, [AB] → [12|1234] → [12 3|34] → [123AB4]
+        std::uninitialized_copy(__old_start, __old_start + __n, __old_start - __n); // 12를 **생성**
+        _M_start -= __n;
+        std::copy(__old_start + __n, __position, __old_start); // 3을 대입
+        std::copy(__first, __last, __position - __n); // AB를 대입
+      }
+      else {
+        // 예) [12345], idx == 1, [ABC] → [AB|12345] → [1AB|12345] → [1ABC2345]
+        _ForwardIterator __mid = __first;
+        std::advance(__mid, __n - __idx);
+        std::uninitialized_copy(__first, __mid, __old_start - (__n - __idx)); // AB를 **생성**
+        _M_start -= __n - __idx;
+        std::uninitialized_copy(__old_start, __position, __old_start - __n); // 1을 **생성**
+        _M_start -= __idx;
+        std::copy(__mid, __last, __old_start); // C를 대입
+      }
+    }
+    else { // 뒤쪽을 민다. (vector::_M_range_insert_in_place()와 같다.)
+      _M_make_room(0, __n);
+      iterator __position = begin() + __idx;
+      const size_type __elems_after = end() - __position;
+      iterator __old_finish = end();
+      if (__elems_after > __n) {
+        std::uninitialized_copy(_M_finish - __n, _M_finish, _M_finish);
+        _M_finish += __n;
+        std::copy_backward(__position, __old_finish - __n, __old_finish);
+        std::copy(__first, __last, __position);
+      }
+      else {
+        _ForwardIterator __mid = __first;
+        std::advance(__mid, __elems_after);
+        std::uninitialized_copy(__mid, __last, _M_finish);
+        _M_finish += __n - __elems_after;
+        std::uninitialized_copy(__position, __old_finish, _M_finish);
+        _M_finish += __elems_after;
+        std::copy(__first, __mid, __position);
+      }
+    }
+  }
+
+  // _M_fill_insert() :
+  // _M_range_insert()와 같은 방식으로 __idx번째 자리에 __x를 __n개 삽입한다.
+  void _M_fill_insert(size_type __idx, size_type __n, const _Type& __x)
+  {
+    if (__n == 0)
+      return;
+    _Type __x_copy = __x; // (__x가 옮겨지는 요소일 수도 있으므로 먼저 복사한다.)
+    if (__idx < size() - __idx) {
+      _M_make_room(__n, 0);
+      iterator __position = begin() + __idx;
+      iterator __old_start = begin();
+      if (__idx > __n) {
+        std::uninitialized_copy(__old_start, __old_start + __n, __old_start - __n);
+        _M_start -= __n;
+        std::copy(__old_start + __n, __position, __old_start);
+        std::fill(__position - __n, __position, __x_copy);
+      }
+      else {
+        std::uninitialized_fill_n(__old_start - (__n - __idx), __n - __idx, __x_copy);
+        _M_start -= __n - __idx;
+        std::uninitialized_copy(__old_start, __position, __old_start - __n);
+        _M_start -= __idx;
+        std::fill(__old_start, __position, __x_copy);
+      }
+    }
+    else {
+      _M_make_room(0, __n);
+      iterator __position = begin() + __idx;
+      const size_type __elems_after = end() - __position;
+      iterator __old_finish = end();
+      if (__elems_after > __n) {
+        std::uninitialized_copy(_M_finish - __n, _M_finish, _M_finish);
+        _M_finish += __n;
+        std::copy_backward(__position, __old_finish - __n, __old_finish);
+        std::fill(__position, __position + __n, __x_copy);
+      }
+      else {
+        std::uninitialized_fill_n(_M_finish, __n - __elems_after, __x_copy);
+        _M_finish += __n - __elems_after;
+        std::uninitialized_copy(__position, __old_finish, _M_finish);
+        _M_finish += __elems_after;
+        std::fill(__position, __old_finish, __x_copy);
+      }
+    }
+  }
+
+}; // class devector
+
+
+// 비멤버함수 (관련 연산자)
+
+template <typename _Type, typename _AllocatorType>
+bool operator==(const devector<_Type, _AllocatorType>& __x, const devector<_Type, _AllocatorType>& __y) {
+  return __x.size() == __y.size() &&
+    ft::equal(__x.begin(), __x.end(), __y.begin());
+}
+
+template <typename _Type, typename _AllocatorType>
+bool operator<(const devector<_Type, _AllocatorType>& __x, const devector<_Type, _AllocatorType>& __y) {
+  return ft::lexicographical_compare(__x.begin(), __x.end(), __y.begin(), __y.end());
+}
+
+template <typename _Type, typename _AllocatorType>
+bool operator!=(const devector<_Type, _AllocatorType>& __x, const devector<_Type, _AllocatorType>& __y) {
+  return !(__x == __y);
+}
+
+template <typename _Type, typename _AllocatorType>
+bool operator>(const devector<_Type, _AllocatorType>& __x, const devector<_Type, _AllocatorType>& __y) {
+  return __y < __x;
+}
+
+template <typename _Type, typename _AllocatorType>
+bool operator<=(const devector<_Type, _AllocatorType>& __x, const devector<_Type, _AllocatorType>& __y) {
+  return !(__y < __x);
+}
+
+template <typename _Type, typename _AllocatorType>
+bool operator>=(const devector<_Type, _AllocatorType>& __x, const devector<_Type, _AllocatorType>& __y) {
+  return !(__x < __y);
+}
+
+template <typename _Type, typename _AllocatorType>
+void swap(devector<_Type, _AllocatorType>& __x, devector<_Type, _AllocatorType>& __y)
+{
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 : swap()은 포인터 4개만 바꾼다.
+// (vector와 같이, 빈 devector를 기본생성할 수 있는 std::allocator일 때만)
+template <typename _Type>
+struct has_cheap_swap<devector<_Type, std::allocator<_Type> > > : public true_type {};
+
+} // namespace ft
+
+#endif // DEVECTOR_HPP
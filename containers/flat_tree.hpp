@@ -0,0 +1,282 @@
+#ifndef FLAT_TREE_HPP
+#define FLAT_TREE_HPP
+
+#include <cstddef>
+  // size_t, ptrdiff_t
+
+#include <memory>
+  // std::allocator
+
+#include <algorithm>
+  // std::stable_sort(), std::inplace_merge(), std::unique(), std::swap()
+
+#include <functional>
+  // std::less
+
+#include "vector.hpp"
+  // ft::vector: 요소를 정렬된 순서로 담는다.
+
+#include "pair.hpp"
+  // ft::pair
+
+#include "function.hpp"
+  // ft::sorted_unique_t
+
+namespace ft
+{
+
+// _Flat_tree
+// : flat_map, flat_set이 내장하는, 정렬된 vector 위의 연관 컨테이너.
+//
+// 요소를 key 순서대로 ft::vector 하나에 연속으로 담고, 찾을 때는 이진 탐색을 한다.
+// 노드가 없으므로 요소마다 붙는 포인터 3개와 색, 할당 오버헤드가 없고, 순회는 배열을 훑는 것과 같다.
+// 대신 중간에 넣거나 지우면 뒤의 요소를 모두 옮기므로 O(n)이다. 한 번 만들어 두고 주로 읽는 표에 알맞다.
+// 여러 개를 넣을 때는 범위 insert를 쓰자. 뒤에 붙인 뒤 한 번 정렬하고 한 번 병합하므로 O(n + m log m)이다.
+//
+// vector의 요소는 대입할 수 있어야 하므로 value_type의 key는 const가 아니다. 반복자로 key를 바꾸면 안 된다.
+// insert와 erase는 vector와 마찬가지로 반복자, 참조, 포인터를 무효화한다.
+template <typename _Key, typename _Value, typename _GetKeyOfValue, typename _Compare, typename _Alloc = std::allocator<_Value> >
+class _Flat_tree {
+
+public:
+  typedef _Key key_type;
+  typedef _Value value_type;
+  typedef ft::vector<_Value, _Alloc> sequence_type;
+  typedef typename sequence_type::pointer pointer;
+  typedef typename sequence_type::const_pointer const_pointer;
+  typedef typename sequence_type::reference reference;
+  typedef typename sequence_type::const_reference const_reference;
+  typedef typename sequence_type::iterator iterator;
+  typedef typename sequence_type::const_iterator const_iterator;
+  typedef typename sequence_type::reverse_iterator reverse_iterator;
+  typedef typename sequence_type::const_reverse_iterator const_reverse_iterator;
+  typedef typename sequence_type::size_type size_type;
+  typedef typename sequence_type::difference_type difference_type;
+  typedef typename sequence_type::allocator_type allocator_type;
+
+private:
+  sequence_type _M_seq; // key 순서대로 정렬되어 있고, 중복이 없다.
+  _Compare _M_key_compare;
+
+  // 요소끼리 key로 비교한다. (정렬, 병합용)
+  struct _Value_compare {
+    _Compare _M_comp;
+    _Value_compare(const _Compare& __c) : _M_comp(__c) {}
+    bool operator()(const value_type& __x, const value_type& __y) const
+      { return _M_comp(_GetKeyOfValue()(__x), _GetKeyOfValue()(__y)); }
+  };
+
+  // key가 같은지 (둘 다 서로보다 작지 않으면 같다.)
+  struct _Value_equiv {
+    _Compare _M_comp;
+    _Value_equiv(const _Compare& __c) : _M_comp(__c) {}
+    bool operator()(const value_type& __x, const value_type& __y) const
+      { return !_M_comp(_GetKeyOfValue()(__x), _GetKeyOfValue()(__y))
+            && !_M_comp(_GetKeyOfValue()(__y), _GetKeyOfValue()(__x)); }
+  };
+
+  const key_type& _M_key(size_type __i) const { return _GetKeyOfValue()(_M_seq[__i]); }
+
+  // __k 이상인 첫 요소의 번호
+  size_type _M_lower_index(const key_type& __k) const {
+    size_type __lo = 0, __hi = _M_seq.size();
+    while (__lo < __hi) {
+      size_type __mid = (__lo + __hi) / 2;
+      if (_M_key_compare(_M_key(__mid), __k))
+        __lo = __mid + 1;
+      else
+        __hi = __mid;
+    }
+    return __lo;
+  }
+
+  // __k보다 큰 첫 요소의 번호
+  size_type _M_upper_index(const key_type& __k) const {
+    size_type __lo = 0, __hi = _M_seq.size();
+    while (__lo < __hi) {
+      size_type __mid = (__lo + __hi) / 2;
+      if (_M_key_compare(__k, _M_key(__mid)))
+        __hi = __mid;
+      else
+        __lo = __mid + 1;
+    }
+    return __lo;
+  }
+
+public:
+  // CONSTRUCTOR
+  _Flat_tree() : _M_seq(), _M_key_compare() {}
+
+  _Flat_tree(const _Compare& __comp, const allocator_type& __a = allocator_type())
+    : _M_seq(__a), _M_key_compare(__comp) {}
+
+  // 받아들이는 생성자 :
+  // 이미 정렬되어 있고 중복이 없는 vector의 공간을 그대로 넘겨받는다. (요소를 복사하지 않는다. __seq는 비게 된다.)
+  _Flat_tree(sorted_unique_t, sequence_type& __seq, const _Compare& __comp = _Compare())
+    : _M_seq(__seq.get_allocator()), _M_key_compare(__comp)
+    { _M_seq.swap(__seq); }
+
+                                // accessors:
+
+  _Compare key_comp() const { return _M_key_compare; }
+  allocator_type get_allocator() const { return _M_seq.get_allocator(); }
+
+  iterator begin() { return _M_seq.begin(); }
+  const_iterator begin() const { return _M_seq.begin(); }
+  iterator end() { return _M_seq.end(); }
+  const_iterator end() const { return _M_seq.end(); }
+  reverse_iterator rbegin() { return _M_seq.rbegin(); }
+  const_reverse_iterator rbegin() const { return _M_seq.rbegin(); }
+  reverse_iterator rend() { return _M_seq.rend(); }
+  const_reverse_iterator rend() const { return _M_seq.rend(); }
+  bool empty() const { return _M_seq.empty(); }
+  size_type size() const { return _M_seq.size(); }
+  size_type max_size() const { return _M_seq.max_size(); }
+
+  // 내부 vector. 정렬된 배열로 그대로 읽어도 된다.
+  const sequence_type& sequence() const { return _M_seq; }
+
+  size_type capacity() const { return _M_seq.capacity(); }
+  void reserve(size_type __n) { _M_seq.reserve(__n); }
+  void shrink_to_fit() { _M_seq.shrink_to_fit(); }
+
+  void swap(_Flat_tree& __t) {
+    _M_seq.swap(__t._M_seq);
+    std::swap(_M_key_compare, __t._M_key_compare);
+  }
+
+  // const_iterator를 같은 위치의 iterator로 바꾼다. (set의 반복자는 모두 const_iterator이므로)
+  iterator _M_const_cast(const_iterator __it) { return begin() + (__it - const_iterator(begin())); }
+
+                                // insert/erase
+
+  pair<iterator, bool> insert_unique(const value_type& __v) {
+    const key_type& __k = _GetKeyOfValue()(__v);
+    size_type __i = _M_lower_index(__k);
+    if (__i != size() && !_M_key_compare(__k, _M_key(__i)))
+      return pair<iterator, bool>(begin() + __i, false);
+    return pair<iterator, bool>(_M_seq.insert(begin() + __i, __v), true);
+  }
+
+  // 힌트와 함께 :
+  // __v가 힌트 바로 앞에 들어갈 자리라면 탐색 없이 넣는다. (end()를 힌트로 정렬된 값을 넣으면 push_back과 같다.)
+  iterator insert_unique(iterator __position, const value_type& __v) {
+    const key_type& __k = _GetKeyOfValue()(__v);
+    if ((__position == end() || _M_key_compare(__k, _GetKeyOfValue()(*__position))) &&
+        (__position == begin() || _M_key_compare(_GetKeyOfValue()(*(__position - 1)), __k)))
+      return _M_seq.insert(__position, __v);
+    return insert_unique(__v).first;
+  }
+
+  // 범위 :
+  // 모두 맨 뒤에 붙인 뒤, 붙인 부분만 정렬하고 원래 부분과 한 번 병합한다.
+  // key가 같은 요소가 여럿이면 (map의 insert처럼) 먼저 있던 것을 남긴다. (stable_sort와 inplace_merge는 순서를 지킨다.)
+  template <class _InputIterator>
+  void insert_unique(_InputIterator __first, _InputIterator __last) {
+    const size_type __old = size();
+    _M_append(__first, __last);
+    _M_merge_tail(__old, true);
+  }
+
+  // 정렬된 범위 :
+  // [__first, __last)가 정렬되어 있고 중복이 없다고 믿는다. 정렬을 건너뛰고 병합만 한다.
+  template <class _InputIterator>
+  void insert_sorted_unique(_InputIterator __first, _InputIterator __last) {
+    const size_type __old = size();
+    _M_append(__first, __last);
+    _M_merge_tail(__old, false);
+  }
+
+  iterator erase(iterator __position) { return _M_seq.erase(__position); }
+
+  size_type erase(const key_type& __k) {
+    size_type __i = _M_lower_index(__k);
+    if (__i == size() || _M_key_compare(__k, _M_key(__i)))
+      return 0;
+    _M_seq.erase(begin() + __i);
+    return 1;
+  }
+
+  iterator erase(iterator __first, iterator __last) { return _M_seq.erase(__first, __last); }
+
+  void clear() { _M_seq.clear(); }
+
+                                // map operations:
+
+  iterator find(const key_type& __k) {
+    size_type __i = _M_lower_index(__k);
+    return (__i == size() || _M_key_compare(__k, _M_key(__i))) ? end() : begin() + __i;
+  }
+  const_iterator find(const key_type& __k) const {
+    size_type __i = _M_lower_index(__k);
+    return (__i == size() || _M_key_compare(__k, _M_key(__i))) ? end() : begin() + __i;
+  }
+
+  size_type count(const key_type& __k) const { return find(__k) == end() ? 0 : 1; }
+
+  iterator lower_bound(const key_type& __k) { return begin() + _M_lower_index(__k); }
+  const_iterator lower_bound(const key_type& __k) const { return begin() + _M_lower_index(__k); }
+  iterator upper_bound(const key_type& __k) { return begin() + _M_upper_index(__k); }
+  const_iterator upper_bound(const key_type& __k) const { return begin() + _M_upper_index(__k); }
+
+  pair<iterator, iterator> equal_range(const key_type& __k)
+    { return pair<iterator, iterator>(lower_bound(__k), upper_bound(__k)); }
+  pair<const_iterator, const_iterator> equal_range(const key_type& __k) const
+    { return pair<const_iterator, const_iterator>(lower_bound(__k), upper_bound(__k)); }
+
+private:
+  // 뒤에 붙이다가 예외가 나면, 붙인 것을 지워서 원래대로 되돌린다.
+  template <class _InputIterator>
+  void _M_append(_InputIterator __first, _InputIterator __last) {
+    const size_type __old = size();
+    try {
+      _M_seq.insert(end(), __first, __last);
+    }
+    catch(...)
+    {
+  if (size() != __old)
+    _M_seq.erase(begin() + __old, end());
+  throw;
+    }
+  }
+
+  // _M_merge_tail() :
+  // [0, __old)는 정렬되어 있고, [__old, size())는 새로 붙인 부분이다.
+  // 새 부분을 (필요하면) 정렬하고 그 안의 중복을 지운 뒤, 두 부분이 겹칠 때만 병합하고 다시 중복을 지운다.
+  void _M_merge_tail(size_type __old, bool __sort) {
+    if (size() == __old)
+      return;
+    value_type* __base = _M_seq.data();
+    value_type* __mid = __base + __old;
+    value_type* __last = __base + size();
+    if (__sort)
+      std::stable_sort(__mid, __last, _Value_compare(_M_key_compare));
+    __last = std::unique(__mid, __last, _Value_equiv(_M_key_compare));
+    // 새 부분이 모두 원래 부분보다 크면 (뒤에 이어 붙이는 경우) 병합할 필요가 없다.
+    if (__old != 0 && !_M_key_compare(_GetKeyOfValue()(__mid[-1]), _GetKeyOfValue()(*__mid))) {
+      std::inplace_merge(__base, __mid, __last, _Value_compare(_M_key_compare));
+      __last = std::unique(__base, __last, _Value_equiv(_M_key_compare));
+    }
+    _M_seq.erase(begin() + (__last - __base), end());
+  }
+}; // class _Flat_tree
+
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+bool
+operator==(const _Flat_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __x,
+           const _Flat_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __y)
+{
+  return __x.sequence() == __y.sequence();
+}
+
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+bool
+operator<(const _Flat_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __x,
+          const _Flat_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __y)
+{
+  return __x.sequence() < __y.sequence();
+}
+
+} // namespace ft
+
+#endif // FLAT_TREE_HPP
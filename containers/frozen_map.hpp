@@ -0,0 +1,493 @@
+#ifndef FROZEN_MAP_HPP
+#define FROZEN_MAP_HPP
+
+#include <cstddef>
+  // size_t, ptrdiff_t
+
+#include <memory>
+  // std::allocator
+
+#include <iterator>
+  // std::bidirectional_iterator_tag, std::distance()
+
+#include <algorithm>
+  // std::swap()
+
+#include <stdexcept>
+  // std::out_of_range
+
+#include "pair.hpp"
+  // ft::pair
+
+#include "iterator.hpp"
+  // ft::reverse_iterator
+
+#include "alloc.hpp"
+  // _Alloc_traits: 요소 할당기를 key 배열, 값 배열의 할당기로 rebind한다.
+
+#include "construct.hpp"
+  // ft::_Construct()
+
+#include "algorithm.hpp"
+  // ft::equal(), ft::lexicographical_compare()
+
+#include "function.hpp"
+  // ft::sorted_unique_t
+
+#include "map.hpp"
+  // ft::map
+
+#include "type_traits.hpp"
+  // ft::has_cheap_swap
+
+namespace ft
+{
+
+// frozen_map
+// 한 번 만들고 나면 찾기만 하는 map. ft::map이나 정렬된 범위로 만들고, 이후에는 고칠 수 없다.
+//
+// 요소를 Eytzinger 순서(완전 이진 트리를 BFS 순서로 편 것)로 배열에 담는다. 1번이 root이고, k번의 자식은 2k, 2k + 1번이다.
+// - 찾을 때 쓰는 key만 따로 모은 배열(_M_keys)과, 같은 순서의 value_type 배열(_M_values)을 둔다.
+//   검색은 key 배열만 읽고, 찾은 뒤에 값 배열을 한 번 읽는다. (key는 두 배열에 한 벌씩 들어 있다.)
+// - 내려가는 방향을 분기 없이 k = 2k + (key[k] < x)로 정한다. 분기 예측이 틀릴 일이 없다.
+// - key 배열을 캐시 라인에 맞추어 두면, k의 몇 단계 아래 자손들(16k ~ 16k + 15, 4바이트 key일 때)이
+//   캐시 라인 하나에 모인다. 매 단계 그 라인을 prefetch하므로, 메모리를 기다리는 동안 검색이 몇 단계 더 진행된다.
+// 노드 포인터를 따라가는 _Rb_tree보다 작은 key(정수 등)에서 find(), lower_bound()가 몇 배 빠르다.
+
+//------------------     iterator     ------------------//
+
+// Eytzinger 배열의 k번 요소를 가리킨다. 0이면 end()다.
+// 정렬 순서의 다음 요소는 오른쪽 자식의 leftmost이거나, 왼쪽 자식으로서 올라오는 첫 조상이다.
+template <typename _Value>
+struct _Frozen_map_iterator
+{
+  typedef std::bidirectional_iterator_tag iterator_category;
+  typedef _Value value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const _Value& reference;
+  typedef const _Value* pointer;
+
+  typedef _Frozen_map_iterator<_Value> _Self;
+
+  const _Value* _M_values; // 0번 요소의 자리가 아니라 1번 요소의 자리다.
+  std::size_t _M_size;
+  std::size_t _M_k;
+
+  _Frozen_map_iterator() : _M_values(0), _M_size(0), _M_k(0) {}
+  _Frozen_map_iterator(const _Value* __values, std::size_t __n, std::size_t __k)
+    : _M_values(__values), _M_size(__n), _M_k(__k) {}
+
+  reference operator*() const { return _M_values[_M_k - 1]; }
+  pointer operator->() const { return &(operator*()); }
+
+  _Self& operator++() {
+    if (2 * _M_k + 1 <= _M_size) {
+      _M_k = 2 * _M_k + 1;
+      while (2 * _M_k <= _M_size)
+        _M_k = 2 * _M_k;
+    }
+    else {
+      // 오른쪽 자식이었던 동안 올라가고, 한 번 더 올라간다. root의 오른쪽 끝이었으면 0(end())이 된다.
+      while (_M_k & 1)
+        _M_k >>= 1;
+      _M_k >>= 1;
+    }
+    return *this;
+  }
+  _Self operator++(int) { _Self __tmp = *this; ++*this; return __tmp; }
+
+  // end()에서는 rightmost로 간다.
+  _Self& operator--() {
+    if (_M_k == 0) {
+      _M_k = 1;
+      while (2 * _M_k + 1 <= _M_size)
+        _M_k = 2 * _M_k + 1;
+    }
+    else if (2 * _M_k <= _M_size) {
+      _M_k = 2 * _M_k;
+      while (2 * _M_k + 1 <= _M_size)
+        _M_k = 2 * _M_k + 1;
+    }
+    else {
+      while (_M_k != 1 && !(_M_k & 1))
+        _M_k >>= 1;
+      _M_k >>= 1;
+    }
+    return *this;
+  }
+  _Self operator--(int) { _Self __tmp = *this; --*this; return __tmp; }
+
+  bool operator==(const _Self& __x) const { return _M_k == __x._M_k; }
+  bool operator!=(const _Self& __x) const { return _M_k != __x._M_k; }
+};
+
+//------------------     frozen_map     ------------------//
+
+template <
+  typename _KeyType, // 요소를 정렬하고, 고유하게 식별하는 데에 사용된다.
+  typename _MappedType, // 내가 저장하는 실제 데이터
+  typename _KeyCompare = std::less<_KeyType>, // 요소의 순서를 비교하고, 동일한지 결정할 때 사용한다.
+  typename _Alloc = std::allocator<pair<const _KeyType, _MappedType> >
+> class frozen_map {
+public:
+  typedef _KeyType key_type;
+  typedef _MappedType data_type;
+  typedef _MappedType mapped_type;
+  typedef pair<const _KeyType, _MappedType> value_type;
+  typedef _KeyCompare key_compare;
+
+  class value_compare
+  {
+  friend class frozen_map<_KeyType, _MappedType, _KeyCompare, _Alloc>;
+
+  protected :
+    _KeyCompare comp;
+    value_compare(_KeyCompare __c) : comp(__c) {}
+
+  public:
+    bool operator()(const value_type& __x, const value_type& __y) const {
+      return comp(__x.first, __y.first);
+    }
+  };
+
+  typedef const value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef const value_type& reference;
+  typedef const value_type& const_reference;
+  typedef _Frozen_map_iterator<value_type> const_iterator;
+  typedef const_iterator iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef const_reverse_iterator reverse_iterator;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef typename _Alloc_traits<value_type, _Alloc>::allocator_type allocator_type;
+
+private:
+  typedef typename _Alloc_traits<char, _Alloc>::allocator_type _Byte_allocator;
+
+  enum {
+    _S_cache_line = 64,
+    // 한 캐시 라인에 들어가는 key의 수. k번을 보면서 _M_keys[k * _S_keys_per_line]을 prefetch한다. (배열 밖이면 하지 않는다.)
+    _S_keys_per_line = sizeof(key_type) < _S_cache_line ? _S_cache_line / sizeof(key_type) : 1
+  };
+
+  allocator_type _M_value_allocator;
+  _Byte_allocator _M_byte_allocator;
+
+  char* _M_key_block; // key 배열을 캐시 라인에 맞추기 위해 넉넉히 할당받은 공간
+  key_type* _M_keys; // _M_keys[1 .. _M_size]. 0번은 쓰지 않는다.
+  value_type* _M_values; // _M_values[k - 1]이 _M_keys[k]의 요소다.
+  size_type _M_size;
+  _KeyCompare _M_key_compare;
+
+public:
+  // allocation/deallocation
+
+  frozen_map()
+    : _M_key_block(0), _M_keys(0), _M_values(0), _M_size(0) {}
+
+  explicit frozen_map(const _KeyCompare& __comp, const allocator_type& __a = allocator_type())
+    : _M_value_allocator(__a), _M_byte_allocator(__a),
+      _M_key_block(0), _M_keys(0), _M_values(0), _M_size(0), _M_key_compare(__comp) {}
+
+  // ft::map으로 생성 :
+  // __m의 요소를 복사한다. 비교 함수도 __m의 것을 쓴다.
+  template <class _MapAlloc>
+  explicit frozen_map(const map<_KeyType, _MappedType, _KeyCompare, _MapAlloc>& __m,
+                      const allocator_type& __a = allocator_type())
+    : _M_value_allocator(__a), _M_byte_allocator(__a),
+      _M_key_block(0), _M_keys(0), _M_values(0), _M_size(0), _M_key_compare(__m.key_comp())
+    { _M_build(__m.begin(), __m.size()); }
+
+  // 정렬된 범위로 생성 :
+  // [__first, __last)가 key 순서대로 정렬되어 있고 중복이 없어야 한다. 개수를 먼저 세므로 forward iterator여야 한다.
+  template <class _ForwardIterator>
+  frozen_map(sorted_unique_t, _ForwardIterator __first, _ForwardIterator __last,
+             const _KeyCompare& __comp = _KeyCompare(),
+             const allocator_type& __a = allocator_type())
+    : _M_value_allocator(__a), _M_byte_allocator(__a),
+      _M_key_block(0), _M_keys(0), _M_values(0), _M_size(0), _M_key_compare(__comp)
+    { _M_build(__first, std::distance(__first, __last)); }
+
+  frozen_map(const frozen_map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x)
+    : _M_value_allocator(__x._M_value_allocator), _M_byte_allocator(__x._M_byte_allocator),
+      _M_key_block(0), _M_keys(0), _M_values(0), _M_size(0), _M_key_compare(__x._M_key_compare)
+    { _M_copy(__x); }
+
+  frozen_map<_KeyType, _MappedType, _KeyCompare, _Alloc>&
+  operator=(const frozen_map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x)
+  {
+    if (this != &__x) {
+      frozen_map<_KeyType, _MappedType, _KeyCompare, _Alloc> __tmp(__x);
+      swap(__tmp);
+    }
+    return *this;
+  }
+
+  ~frozen_map() {
+    for (size_type __k = 1; __k <= _M_size; ++__k) {
+      _M_keys[__k].~key_type();
+      _M_values[__k - 1].~value_type();
+    }
+    _M_deallocate();
+  }
+
+  // accessors:
+
+  key_compare key_comp() const { return _M_key_compare; }
+  value_compare value_comp() const { return value_compare(_M_key_compare); }
+  allocator_type get_allocator() const { return _M_value_allocator; }
+
+  const_iterator begin() const {
+    if (_M_size == 0)
+      return end();
+    size_type __k = 1;
+    while (2 * __k <= _M_size)
+      __k = 2 * __k;
+    return const_iterator(_M_values, _M_size, __k);
+  }
+  const_iterator end() const { return const_iterator(_M_values, _M_size, 0); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+  bool empty() const { return _M_size == 0; }
+  size_type size() const { return _M_size; }
+  size_type max_size() const { return _M_value_allocator.max_size(); }
+
+  // at():
+  // 해당 키의 값. 키가 없으면 std::out_of_range를 던진다.
+  const _MappedType& at(const key_type& __k) const {
+    const size_type __i = _M_find_index(__k);
+    if (__i == 0)
+      throw std::out_of_range("frozen_map");
+    return _M_values[__i - 1].second;
+  }
+
+  // swap() :
+  void swap(frozen_map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x) {
+    std::swap(_M_value_allocator, __x._M_value_allocator);
+    std::swap(_M_byte_allocator, __x._M_byte_allocator);
+    std::swap(_M_key_block, __x._M_key_block);
+    std::swap(_M_keys, __x._M_keys);
+    std::swap(_M_values, __x._M_values);
+    std::swap(_M_size, __x._M_size);
+    std::swap(_M_key_compare, __x._M_key_compare);
+  }
+
+  // map operations:
+
+  const_iterator find(const key_type& __x) const
+    { return const_iterator(_M_values, _M_size, _M_find_index(__x)); }
+
+  // count() :
+  // 1과 0 중에서만 반환한다.
+  size_type count(const key_type& __x) const { return _M_find_index(__x) == 0 ? 0 : 1; }
+
+  const_iterator lower_bound(const key_type& __x) const
+    { return const_iterator(_M_values, _M_size, _M_lower_bound_index(__x)); }
+  const_iterator upper_bound(const key_type& __x) const
+    { return const_iterator(_M_values, _M_size, _M_upper_bound_index(__x)); }
+  pair<const_iterator,const_iterator> equal_range(const key_type& __x) const {
+    return pair<const_iterator,const_iterator>(lower_bound(__x), upper_bound(__x));
+  }
+
+private:
+  // _M_prefetch() :
+  // 몇 단계 아래의 후손 자리 __k는 배열 밖일 수 있다. 그때는 배열 밖을 가리키는 포인터를 만들지 않는다.
+  void _M_prefetch(size_type __k) const {
+    if (__k <= _M_size)
+      __builtin_prefetch(_M_keys + __k);
+  }
+
+  // _M_lower_bound_index() :
+  // 끝까지 내려가면 __k에는 지나온 방향이 비트로 남는다. (1이 오른쪽, 즉 key[k] < __x)
+  // 답은 마지막으로 왼쪽으로 간 노드이므로, 끝의 1 비트들과 그 위의 0 비트 하나를 떼어내면 된다.
+  // 한 번도 왼쪽으로 가지 않았으면 0(end())이 된다.
+  size_type _M_lower_bound_index(const key_type& __x) const {
+    size_type __k = 1;
+    while (__k <= _M_size) {
+      _M_prefetch(__k * _S_keys_per_line);
+      __k = 2 * __k + _M_key_compare(_M_keys[__k], __x);
+    }
+    return __k >> __builtin_ffsl(static_cast<long>(~__k));
+  }
+
+  // _M_upper_bound_index() : key가 __x보다 큰 첫 요소. 방향만 !(__x < key[k])로 바뀐다.
+  size_type _M_upper_bound_index(const key_type& __x) const {
+    size_type __k = 1;
+    while (__k <= _M_size) {
+      _M_prefetch(__k * _S_keys_per_line);
+      __k = 2 * __k + !_M_key_compare(__x, _M_keys[__k]);
+    }
+    return __k >> __builtin_ffsl(static_cast<long>(~__k));
+  }
+
+  size_type _M_find_index(const key_type& __x) const {
+    const size_type __k = _M_lower_bound_index(__x);
+    return (__k == 0 || _M_key_compare(__x, _M_keys[__k])) ? 0 : __k;
+  }
+
+  // _M_allocate() :
+  // key 배열은 0번 자리가 캐시 라인의 시작에 오도록 한 라인만큼 더 받아서 맞춘다.
+  void _M_allocate(size_type __n) {
+    _M_values = _M_value_allocator.allocate(__n);
+    try {
+      _M_key_block = _M_byte_allocator.allocate((__n + 1) * sizeof(key_type) + _S_cache_line);
+    }
+    catch(...)
+    {
+  _M_value_allocator.deallocate(_M_values, __n);
+  _M_values = 0;
+  throw;
+    }
+    const std::size_t __addr = reinterpret_cast<std::size_t>(_M_key_block);
+    _M_keys = reinterpret_cast<key_type*>(_M_key_block
+        + ((_S_cache_line - __addr % _S_cache_line) % _S_cache_line));
+  }
+
+  // 요소는 모두 없앴어야 한다. _M_size는 할당받은 크기다.
+  void _M_deallocate() {
+    if (_M_values == 0)
+      return;
+    _M_value_allocator.deallocate(_M_values, _M_size);
+    _M_byte_allocator.deallocate(_M_key_block, (_M_size + 1) * sizeof(key_type) + _S_cache_line);
+    _M_key_block = 0;
+    _M_keys = 0;
+    _M_values = 0;
+    _M_size = 0;
+  }
+
+  // _M_build() :
+  // 정렬된 요소 __n개를 받는다. 트리를 in-order로 돌면서 차례로 채우면 Eytzinger 순서가 된다.
+  // 예외가 나면 그때까지 만든 요소(in-order로 앞의 __built개)를 없애고 공간을 돌려준다.
+  template <class _InputIterator>
+  void _M_build(_InputIterator __first, size_type __n) {
+    if (__n == 0)
+      return;
+    _M_allocate(__n);
+    _M_size = __n;
+    size_type __built = 0;
+    try {
+      _M_fill(1, __first, __built);
+    }
+    catch(...)
+    {
+  _M_destroy_first(1, __built);
+  _M_deallocate();
+  throw;
+    }
+  }
+
+  // 재귀의 깊이는 log2(n)이다.
+  template <class _InputIterator>
+  void _M_fill(size_type __k, _InputIterator& __it, size_type& __built) {
+    if (__k > _M_size)
+      return;
+    _M_fill(2 * __k, __it, __built);
+    ft::_Construct(&_M_values[__k - 1], *__it);
+    try {
+      ft::_Construct(&_M_keys[__k], _M_values[__k - 1].first);
+    }
+    catch(...)
+    {
+  _M_values[__k - 1].~value_type();
+  throw;
+    }
+    ++__built;
+    ++__it;
+    _M_fill(2 * __k + 1, __it, __built);
+  }
+
+  // in-order로 앞의 __left개 요소를 없앤다.
+  void _M_destroy_first(size_type __k, size_type& __left) {
+    if (__k > _M_size || __left == 0)
+      return;
+    _M_destroy_first(2 * __k, __left);
+    if (__left == 0)
+      return;
+    _M_keys[__k].~key_type();
+    _M_values[__k - 1].~value_type();
+    --__left;
+    _M_destroy_first(2 * __k + 1, __left);
+  }
+
+  // _M_copy() : 배열을 같은 순서로 복사한다.
+  void _M_copy(const frozen_map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x) {
+    if (__x._M_size == 0)
+      return;
+    _M_allocate(__x._M_size);
+    _M_size = __x._M_size;
+    size_type __k = 1;
+    try {
+      for ( ; __k <= _M_size; ++__k) {
+        ft::_Construct(&_M_values[__k - 1], __x._M_values[__k - 1]);
+        try {
+          ft::_Construct(&_M_keys[__k], __x._M_keys[__k]);
+        }
+        catch(...)
+        {
+  _M_values[__k - 1].~value_type();
+  throw;
+        }
+      }
+    }
+    catch(...)
+    {
+  while (--__k != 0) {
+    _M_keys[__k].~key_type();
+    _M_values[__k - 1].~value_type();
+  }
+  _M_deallocate();
+  throw;
+    }
+  }
+};
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator==(const frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+                const frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return __x.size() == __y.size() && ft::equal(__x.begin(), __x.end(), __y.begin());
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator<(const frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+               const frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return ft::lexicographical_compare(__x.begin(), __x.end(), __y.begin(), __y.end());
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator!=(const frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+                const frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return !(__x == __y);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator>(const frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+               const frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return __y < __x;
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator<=(const frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+                const frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return !(__y < __x);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator>=(const frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+                const frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return !(__x < __y);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+void swap(frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+          frozen_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 :
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+struct has_cheap_swap<frozen_map<_Key,_MappedType,_KeyCompare,_Alloc> > : public true_type {};
+
+} // namespace ft
+
+#endif /* FROZEN_MAP_HPP */
@@ -17,6 +17,40 @@ struct _Select1st {
   }
 };
 
+// identity :
+// set처럼 value 자체가 key일 때 쓰는 functor
+
+template <typename _Type>
+struct _Identity {
+  _Type& operator()(_Type& __x) const { return __x; }
+  const _Type& operator()(const _Type& __x) const { return __x; }
+};
+
+// merge_second :
+// 두 pair의 second끼리 합치는 functor. map_union() 등이 사용자의 합치는 함수(mapped_type끼리)를 트리에 넘길 때 감싼다.
+
+template <typename _Merge>
+struct _Merge_second {
+  _Merge _M_merge;
+  explicit _Merge_second(const _Merge& __m) : _M_merge(__m) {}
+  template <typename _Pair>
+  void operator()(_Pair& __x, _Pair& __y) { _M_merge(__x.second, __y.second); }
+};
+
+// keep_first :
+// 합치지 않고 첫 번째 값을 그대로 두는 functor. (map_union() 등의 기본값)
+
+struct _Keep_first {
+  template <typename _Type>
+  void operator()(_Type&, _Type&) const {}
+};
+
+// sorted_unique :
+// 넘겨주는 범위가 이미 key 순서대로 정렬되어 있고 중복이 없다는 것을 알려주는 태그.
+// map(ft::sorted_unique, first, last)처럼 쓰면, 비교 없이 균형 잡힌 트리를 한 번에 만든다. (_Rb_tree::insert_sorted_unique())
+struct sorted_unique_t {};
+const sorted_unique_t sorted_unique = sorted_unique_t();
+
 }
 
 #endif // FUNCTION_HPP
\ No newline at end of file
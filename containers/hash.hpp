@@ -0,0 +1,98 @@
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <cstddef>
+  // size_t
+
+#include <string>
+  // std::string
+
+#include "type_traits.hpp"
+  // ft::is_integral
+
+namespace ft
+{
+
+// _Hash_mix :
+// 비트를 골고루 섞는다. (MurmurHash3의 finalizer)
+// unordered_map은 해시의 아래 7비트와 나머지 비트를 따로 쓰므로, 입력의 한 비트가 바뀌면 결과의 모든 비트가 바뀌어야 한다.
+// 정수를 그대로 해시로 쓰면(std::hash처럼) 연속된 key나 같은 배수의 key가 몇 개의 그룹에 몰린다.
+template <std::size_t _Bytes>
+struct _Hash_mix;
+
+template <>
+struct _Hash_mix<4>
+{
+  static std::size_t _S_mix(std::size_t __x) {
+    __x ^= __x >> 16;
+    __x *= static_cast<std::size_t>(0x85ebca6bUL);
+    __x ^= __x >> 13;
+    __x *= static_cast<std::size_t>(0xc2b2ae35UL);
+    __x ^= __x >> 16;
+    return __x;
+  }
+};
+
+template <>
+struct _Hash_mix<8>
+{
+  static std::size_t _S_mix(std::size_t __x) {
+    __x ^= __x >> 33;
+    __x *= static_cast<std::size_t>(0xff51afd7ed558ccdULL);
+    __x ^= __x >> 33;
+    __x *= static_cast<std::size_t>(0xc4ceb9fe1a85ec53ULL);
+    __x ^= __x >> 33;
+    return __x;
+  }
+};
+
+inline std::size_t _Hash_mix_bits(std::size_t __x) { return _Hash_mix<sizeof(std::size_t)>::_S_mix(__x); }
+
+// hash
+// unordered_map, unordered_set의 기본 해시 함수 객체.
+// 정수 타입(is_integral)과 포인터, std::string에 대해 정의되어 있다. 다른 타입은 특수화하거나 해시 함수를 직접 넘긴다.
+// (정의되지 않은 타입에 쓰면 operator()가 없어서 컴파일 에러가 난다.)
+template <typename _Type, bool = is_integral<_Type>::value>
+struct _Hash_base {};
+
+template <typename _Type>
+struct _Hash_base<_Type, true>
+{
+  typedef _Type argument_type;
+  typedef std::size_t result_type;
+
+  std::size_t operator()(_Type __x) const { return _Hash_mix_bits(static_cast<std::size_t>(__x)); }
+};
+
+template <typename _Type>
+struct hash : public _Hash_base<_Type> {};
+
+template <typename _Type>
+struct hash<_Type*>
+{
+  typedef _Type* argument_type;
+  typedef std::size_t result_type;
+
+  std::size_t operator()(_Type* __p) const { return _Hash_mix_bits(reinterpret_cast<std::size_t>(__p)); }
+};
+
+// std::string은 FNV-1a로 한 바이트씩 모은 뒤에 섞는다.
+template <>
+struct hash<std::string>
+{
+  typedef std::string argument_type;
+  typedef std::size_t result_type;
+
+  std::size_t operator()(const std::string& __s) const {
+    std::size_t __h = static_cast<std::size_t>(2166136261UL);
+    for (std::string::size_type __i = 0; __i < __s.size(); ++__i) {
+      __h ^= static_cast<unsigned char>(__s[__i]);
+      __h *= static_cast<std::size_t>(16777619UL);
+    }
+    return _Hash_mix_bits(__h);
+  }
+};
+
+} // namespace ft
+
+#endif // HASH_HPP
@@ -0,0 +1,606 @@
+#ifndef HASHTABLE_HPP
+#define HASHTABLE_HPP
+
+#include <cstddef>
+  // size_t, ptrdiff_t
+
+#include <memory>
+  // std::allocator
+
+#include <iterator>
+  // std::forward_iterator_tag
+
+#include <algorithm>
+  // std::swap()
+
+#include "pair.hpp"
+  // ft::pair
+
+#include "alloc.hpp"
+  // _Alloc_traits: 요소 할당기를 slot 배열, control byte 배열의 할당기로 rebind한다.
+
+#include "construct.hpp"
+  // ft::_Construct()
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+  // _mm_loadu_si128(), _mm_cmpeq_epi8(), _mm_movemask_epi8()
+#endif
+
+namespace ft
+{
+
+// _Hashtable
+// : unordered_map, unordered_set이 내장하는 open addressing 해시 테이블. (Swiss table)
+//
+// 요소는 노드 없이 slot 배열 하나에 바로 들어 있다. slot마다 1바이트의 control byte가 따로 있다.
+// - control byte는 비어 있음(_S_ctrl_empty), 지워짐(_S_ctrl_deleted), 또는 요소가 있음(해시의 아래 7비트, H2) 중 하나다.
+// - 해시의 나머지 비트(H1)로 시작 위치를 정하고, control byte를 16개씩(그룹) 한꺼번에 읽어 H2가 같은 칸만 key를 비교한다.
+//   SSE2가 있으면 그룹 하나를 명령 몇 개로 비교한다. 없으면 같은 일을 바이트마다 한다.
+//   H2가 우연히 같을 확률은 1/128이므로, key 비교는 거의 찾는 요소에서만 일어난다.
+// - 그룹에 빈 칸이 있으면 더 찾을 필요가 없다. 없으면 다음 그룹으로 간다. (16, 32, 48, ... 칸씩 건너뛴다.)
+// - 용량(_M_capacity)은 2^k - 1이고, 요소 수가 용량의 7/8을 넘지 않게 키운다.
+//
+// control byte 배열은 용량 + 1 + 15바이트다. 용량 번째 칸은 끝 표시(_S_ctrl_end)이고, 그 뒤의 15칸은 앞의 15칸의 복사본이다.
+// 그래서 어느 위치에서 16바이트를 읽어도 배열을 넘지 않고, 끝에서 처음으로 돌아가는 그룹도 한 번에 읽는다.
+//
+// 지울 때는, 그 칸을 지나서 더 찾아간 검색이 없었다면 빈 칸으로 되돌린다. (아래 _M_erase_meta() 참고)
+// 그럴 수 없을 때만 지워짐(tombstone)으로 남긴다. 지워짐이 쌓여 빈 칸이 모자라면 같은 크기로 다시 해시한다.
+//
+// insert는 다시 해시할 때 모든 반복자를 무효화한다. erase는 지운 요소의 반복자만 무효화한다.
+
+//------------------     control byte     ------------------//
+
+typedef signed char _Hashtable_ctrl;
+
+enum {
+  _S_ctrl_empty = -128,
+  _S_ctrl_deleted = -2,
+  _S_ctrl_end = -1 // begin()부터의 순회가 여기서 멈춘다.
+};
+
+// 용량이 0인 테이블의 control byte. 끝 표시 뒤에 빈 칸만 있으므로, 찾기는 바로 실패하고 begin()은 end()다.
+inline _Hashtable_ctrl* _Hashtable_empty_group() {
+  static _Hashtable_ctrl __group[16] = {
+    _S_ctrl_end,   _S_ctrl_empty, _S_ctrl_empty, _S_ctrl_empty,
+    _S_ctrl_empty, _S_ctrl_empty, _S_ctrl_empty, _S_ctrl_empty,
+    _S_ctrl_empty, _S_ctrl_empty, _S_ctrl_empty, _S_ctrl_empty,
+    _S_ctrl_empty, _S_ctrl_empty, _S_ctrl_empty, _S_ctrl_empty
+  };
+  return __group;
+}
+
+// _Hashtable_group :
+// control byte 16개. 각 _M_match*()는 조건에 맞는 칸의 비트를 켠 마스크를 반환한다. (i번째 비트가 i번째 칸)
+struct _Hashtable_group
+{
+  enum { _S_width = 16 };
+
+#ifdef __SSE2__
+  __m128i _M_ctrl;
+
+  explicit _Hashtable_group(const _Hashtable_ctrl* __p)
+    : _M_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(__p))) {}
+
+  unsigned _M_match(_Hashtable_ctrl __h2) const
+    { return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(__h2), _M_ctrl)); }
+
+  unsigned _M_match_empty() const { return _M_match(_S_ctrl_empty); }
+
+  // 비어 있음(-128)과 지워짐(-2)만 끝 표시(-1)보다 작다.
+  unsigned _M_match_empty_or_deleted() const
+    { return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(_S_ctrl_end), _M_ctrl)); }
+#else
+  const _Hashtable_ctrl* _M_ctrl;
+
+  explicit _Hashtable_group(const _Hashtable_ctrl* __p) : _M_ctrl(__p) {}
+
+  unsigned _M_match(_Hashtable_ctrl __h2) const {
+    unsigned __mask = 0;
+    for (int __i = 0; __i < _S_width; ++__i)
+      if (_M_ctrl[__i] == __h2)
+        __mask |= 1u << __i;
+    return __mask;
+  }
+
+  unsigned _M_match_empty() const { return _M_match(_S_ctrl_empty); }
+
+  unsigned _M_match_empty_or_deleted() const {
+    unsigned __mask = 0;
+    for (int __i = 0; __i < _S_width; ++__i)
+      if (_M_ctrl[__i] < _S_ctrl_end)
+        __mask |= 1u << __i;
+    return __mask;
+  }
+#endif
+
+  // 앞에서부터 연속된 빈 칸, 지워진 칸의 수. (순회할 때 건너뛸 칸 수)
+  unsigned _M_count_leading_empty_or_deleted() const
+    { return __builtin_ctz(~_M_match_empty_or_deleted()); }
+};
+
+//------------------     iterator     ------------------//
+
+// control byte와 slot을 같이 가리킨다. 끝 표시를 가리키면 end()다.
+template <typename _Value, typename _Reference, typename _Pointer>
+struct _Hashtable_iterator
+{
+  typedef std::forward_iterator_tag iterator_category;
+  typedef _Value value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef _Reference reference;
+  typedef _Pointer pointer;
+
+  typedef _Hashtable_iterator<_Value, _Value&, _Value*> iterator;
+  typedef _Hashtable_iterator<_Value, _Reference, _Pointer> _Self;
+
+  _Hashtable_ctrl* _M_ctrl;
+  _Value* _M_slot;
+
+  _Hashtable_iterator() : _M_ctrl(0), _M_slot(0) {}
+  _Hashtable_iterator(_Hashtable_ctrl* __ctrl, _Value* __slot) : _M_ctrl(__ctrl), _M_slot(__slot) {}
+  _Hashtable_iterator(const iterator& __it) : _M_ctrl(__it._M_ctrl), _M_slot(__it._M_slot) {}
+
+  reference operator*() const { return *_M_slot; }
+  pointer operator->() const { return _M_slot; }
+
+  // 요소가 있는 칸이나 끝 표시까지 그룹 단위로 건너뛴다.
+  void _M_skip_empty_or_deleted() {
+    while (*_M_ctrl < _S_ctrl_end) {
+      const unsigned __shift = _Hashtable_group(_M_ctrl)._M_count_leading_empty_or_deleted();
+      _M_ctrl += __shift;
+      _M_slot += __shift;
+    }
+  }
+
+  _Self& operator++() {
+    ++_M_ctrl;
+    ++_M_slot;
+    _M_skip_empty_or_deleted();
+    return *this;
+  }
+  _Self operator++(int) { _Self __tmp = *this; ++*this; return __tmp; }
+};
+
+template <class _Value, class _RefL, class _PtrL, class _RefR, class _PtrR>
+bool operator==(const _Hashtable_iterator<_Value, _RefL, _PtrL>& __x,
+                const _Hashtable_iterator<_Value, _RefR, _PtrR>& __y)
+{ return __x._M_ctrl == __y._M_ctrl; }
+
+template <class _Value, class _RefL, class _PtrL, class _RefR, class _PtrR>
+bool operator!=(const _Hashtable_iterator<_Value, _RefL, _PtrL>& __x,
+                const _Hashtable_iterator<_Value, _RefR, _PtrR>& __y)
+{ return !(__x == __y); }
+
+//------------------     Hashtable     ------------------//
+
+template <typename _Key, typename _Value, typename _GetKeyOfValue, typename _Hash, typename _Equal,
+          typename _Alloc = std::allocator<_Value> >
+class _Hashtable {
+
+public:
+  typedef _Key key_type;
+  typedef _Value value_type;
+  typedef _Hash hasher;
+  typedef _Equal key_equal;
+  typedef value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  typedef typename _Alloc_traits<_Value, _Alloc>::allocator_type allocator_type;
+
+  typedef _Hashtable_iterator<value_type, value_type&, value_type*> iterator;
+  typedef _Hashtable_iterator<value_type, const value_type&, const value_type*> const_iterator;
+
+private:
+  typedef typename _Alloc_traits<_Hashtable_ctrl, _Alloc>::allocator_type _Ctrl_allocator;
+
+  enum {
+    _S_width = _Hashtable_group::_S_width,
+    _S_cloned = _S_width - 1 // 끝 표시 뒤에 복사해 두는 control byte 수
+  };
+
+  allocator_type _M_slot_allocator;
+  _Ctrl_allocator _M_ctrl_allocator;
+
+  _Hashtable_ctrl* _M_ctrl; // _M_capacity + 1 + _S_cloned 바이트
+  value_type* _M_slots; // _M_capacity칸
+  size_type _M_capacity; // 0 또는 2^k - 1
+  size_type _M_size;
+  size_type _M_growth_left; // 빈 칸 중에서 더 채워도 되는 칸 수. 0이 되면 다시 해시한다.
+  _Hash _M_hash;
+  _Equal _M_equal;
+
+  static size_type _S_h1(size_type __hash) { return __hash >> 7; }
+  static _Hashtable_ctrl _S_h2(size_type __hash) { return static_cast<_Hashtable_ctrl>(__hash & 0x7f); }
+  static bool _S_is_full(_Hashtable_ctrl __c) { return __c >= 0; }
+
+  // 용량 __cap에서 채울 수 있는 요소 수. (7/8)
+  static size_type _S_capacity_to_growth(size_type __cap) { return __cap - __cap / 8; }
+
+  // 요소 __n개를 담을 수 있는 가장 작은 용량. (2^k - 1)
+  static size_type _S_growth_to_capacity(size_type __n) {
+    if (__n == 0)
+      return 0;
+    size_type __cap = 1;
+    while (_S_capacity_to_growth(__cap) < __n)
+      __cap = __cap * 2 + 1;
+    return __cap;
+  }
+
+  static const key_type& _S_key(const value_type& __v) { return _GetKeyOfValue()(__v); }
+
+  // control byte를 바꾼다. 앞의 15칸이면 끝 표시 뒤의 복사본도 바꾼다. (아니면 자기 자신을 한 번 더 쓴다.)
+  void _M_set_ctrl(size_type __i, _Hashtable_ctrl __c) {
+    _M_ctrl[__i] = __c;
+    _M_ctrl[((__i - _S_cloned) & _M_capacity) + (_S_cloned & _M_capacity)] = __c;
+  }
+
+  // _M_find_index() :
+  // __k가 들어 있는 칸. 없으면 _M_capacity(끝 표시)를 반환한다.
+  // 시작 위치에서부터 그룹을 차례로 읽는다. 건너뛰는 폭은 그룹마다 16칸씩 늘어나므로, 용량이 2^k - 1이면 모든 그룹을 한 번씩 거친다.
+  size_type _M_find_index(const key_type& __k) const {
+    const size_type __hash = _M_hash(__k);
+    const _Hashtable_ctrl __h2 = _S_h2(__hash);
+    size_type __offset = _S_h1(__hash) & _M_capacity;
+    for (size_type __step = _S_width; ; __step += _S_width) {
+      _Hashtable_group __g(_M_ctrl + __offset);
+      for (unsigned __m = __g._M_match(__h2); __m != 0; __m &= __m - 1) {
+        const size_type __i = (__offset + __builtin_ctz(__m)) & _M_capacity;
+        if (_M_equal(__k, _S_key(_M_slots[__i])))
+          return __i;
+      }
+      if (__g._M_match_empty() != 0)
+        return _M_capacity;
+      __offset = (__offset + __step) & _M_capacity;
+    }
+  }
+
+  // _M_find_first_non_full() :
+  // __hash의 검색 순서에서 처음 만나는 빈 칸이나 지워진 칸. 용량이 0이 아니어야 한다.
+  size_type _M_find_first_non_full(size_type __hash) const {
+    size_type __offset = _S_h1(__hash) & _M_capacity;
+    for (size_type __step = _S_width; ; __step += _S_width) {
+      const unsigned __m = _Hashtable_group(_M_ctrl + __offset)._M_match_empty_or_deleted();
+      if (__m != 0)
+        return (__offset + __builtin_ctz(__m)) & _M_capacity;
+      __offset = (__offset + __step) & _M_capacity;
+    }
+  }
+
+  // 모든 칸을 비우고, 끝 표시를 단다.
+  void _M_reset_ctrl() {
+    for (size_type __i = 0; __i < _M_capacity + 1 + _S_cloned; ++__i)
+      _M_ctrl[__i] = _S_ctrl_empty;
+    _M_ctrl[_M_capacity] = _S_ctrl_end;
+    _M_growth_left = _S_capacity_to_growth(_M_capacity) - _M_size;
+  }
+
+  // 용량 __cap의 빈 배열을 할당받아 단다. 예전 배열은 부르는 쪽이 가지고 있어야 한다.
+  void _M_allocate(size_type __cap) {
+    _Hashtable_ctrl* __ctrl = _M_ctrl_allocator.allocate(__cap + 1 + _S_cloned);
+    try {
+      _M_slots = _M_slot_allocator.allocate(__cap);
+    }
+    catch(...)
+    {
+  _M_ctrl_allocator.deallocate(__ctrl, __cap + 1 + _S_cloned);
+  throw;
+    }
+    _M_ctrl = __ctrl;
+    _M_capacity = __cap;
+    _M_reset_ctrl();
+  }
+
+  // 요소는 모두 없앴어야 한다.
+  void _M_deallocate() {
+    if (_M_capacity != 0) {
+      _M_ctrl_allocator.deallocate(_M_ctrl, _M_capacity + 1 + _S_cloned);
+      _M_slot_allocator.deallocate(_M_slots, _M_capacity);
+    }
+    _M_ctrl = _Hashtable_empty_group();
+    _M_slots = 0;
+    _M_capacity = 0;
+    _M_growth_left = 0;
+  }
+
+  void _M_destroy_all() {
+    for (size_type __i = 0; __i < _M_capacity; ++__i)
+      if (_S_is_full(_M_ctrl[__i]))
+        _M_slots[__i].~value_type();
+  }
+
+  // _M_resize() :
+  // 용량 __cap의 새 배열로 요소를 모두 옮긴다. (복사 생성 후 원본을 소멸시킨다.)
+  // 복사하다 예외가 나면 새 배열을 버리고, 테이블은 그대로다.
+  void _M_resize(size_type __cap) {
+    _Hashtable_ctrl* __old_ctrl = _M_ctrl;
+    value_type* __old_slots = _M_slots;
+    const size_type __old_cap = _M_capacity;
+    const size_type __n = _M_size;
+    const size_type __growth_left = _M_growth_left;
+
+    _M_allocate(__cap);
+    _M_size = 0;
+    size_type __i = 0;
+    try {
+      for ( ; __i < __old_cap; ++__i) {
+        if (!_S_is_full(__old_ctrl[__i]))
+          continue;
+        const size_type __hash = _M_hash(_S_key(__old_slots[__i]));
+        const size_type __j = _M_find_first_non_full(__hash);
+        ft::_Construct(&_M_slots[__j], __old_slots[__i]);
+        _M_set_ctrl(__j, _S_h2(__hash));
+        ++_M_size;
+      }
+    }
+    catch(...)
+    {
+  _M_destroy_all();
+  _M_ctrl_allocator.deallocate(_M_ctrl, _M_capacity + 1 + _S_cloned);
+  _M_slot_allocator.deallocate(_M_slots, _M_capacity);
+  _M_ctrl = __old_ctrl;
+  _M_slots = __old_slots;
+  _M_capacity = __old_cap;
+  _M_size = __n;
+  _M_growth_left = __growth_left;
+  throw;
+    }
+    _M_growth_left = _S_capacity_to_growth(_M_capacity) - _M_size;
+
+    for (__i = 0; __i < __old_cap; ++__i)
+      if (_S_is_full(__old_ctrl[__i]))
+        __old_slots[__i].~value_type();
+    if (__old_cap != 0) {
+      _M_ctrl_allocator.deallocate(__old_ctrl, __old_cap + 1 + _S_cloned);
+      _M_slot_allocator.deallocate(__old_slots, __old_cap);
+    }
+  }
+
+  // 더 채울 칸이 없을 때 : 지워진 칸이 많으면(요소가 용량의 25/32 이하) 같은 크기로 다시 해시해서 지워짐을 없애고,
+  // 아니면 두 배로 키운다.
+  void _M_rehash_and_grow() {
+    if (_M_capacity > _S_width && _M_size * 32 <= _M_capacity * 25)
+      _M_resize(_M_capacity);
+    else
+      _M_resize(_M_capacity * 2 + 1);
+  }
+
+  // _M_erase_meta() :
+  // __i를 빈 칸으로 되돌릴 수 있는지 본다.
+  // __i의 앞뒤로 빈 칸 없이 이어진 칸이 16개 미만이면, 어떤 그룹을 읽어도 그 안에 빈 칸이 있었으므로
+  // __i를 지나쳐서 더 찾아간 검색이 없다. 그러면 빈 칸으로 되돌려도 다른 요소를 못 찾게 되지 않는다.
+  void _M_erase_meta(size_type __i) {
+    const size_type __before = (__i - _S_width) & _M_capacity;
+    const unsigned __empty_after = _Hashtable_group(_M_ctrl + __i)._M_match_empty();
+    const unsigned __empty_before = _Hashtable_group(_M_ctrl + __before)._M_match_empty();
+    // __empty_before의 위쪽(16비트 중)에서부터 연속된 0의 수는 __i 바로 앞의 빈 칸 아닌 칸의 수다.
+    const bool __was_never_full = __empty_before != 0 && __empty_after != 0
+      && static_cast<unsigned>(__builtin_ctz(__empty_after) + __builtin_clz(__empty_before) - (sizeof(unsigned) * 8 - _S_width))
+         < static_cast<unsigned>(_S_width);
+    _M_set_ctrl(__i, __was_never_full ? static_cast<_Hashtable_ctrl>(_S_ctrl_empty)
+                                      : static_cast<_Hashtable_ctrl>(_S_ctrl_deleted));
+    if (__was_never_full)
+      ++_M_growth_left;
+  }
+
+  void _M_init() {
+    _M_ctrl = _Hashtable_empty_group();
+    _M_slots = 0;
+    _M_capacity = 0;
+    _M_size = 0;
+    _M_growth_left = 0;
+  }
+
+public:
+  // allocation/deallocation
+
+  _Hashtable(size_type __n, const _Hash& __hf, const _Equal& __eql, const allocator_type& __a)
+    : _M_slot_allocator(__a), _M_ctrl_allocator(__a), _M_hash(__hf), _M_equal(__eql)
+  {
+    _M_init();
+    if (__n != 0)
+      _M_allocate(_S_growth_to_capacity(__n));
+  }
+
+  // 복사 : 요소 수에 맞는 용량으로 새로 넣는다. (지워짐은 복사되지 않는다.)
+  _Hashtable(const _Hashtable& __x)
+    : _M_slot_allocator(__x._M_slot_allocator), _M_ctrl_allocator(__x._M_ctrl_allocator),
+      _M_hash(__x._M_hash), _M_equal(__x._M_equal)
+  {
+    _M_init();
+    if (__x._M_size == 0)
+      return;
+    _M_allocate(_S_growth_to_capacity(__x._M_size));
+    try {
+      for (const_iterator __it = __x.begin(); __it != __x.end(); ++__it) {
+        const size_type __hash = _M_hash(_S_key(*__it));
+        const size_type __j = _M_find_first_non_full(__hash);
+        ft::_Construct(&_M_slots[__j], *__it);
+        _M_set_ctrl(__j, _S_h2(__hash));
+        ++_M_size;
+        --_M_growth_left;
+      }
+    }
+    catch(...)
+    {
+  _M_destroy_all();
+  _M_deallocate();
+  throw;
+    }
+  }
+
+  _Hashtable& operator=(const _Hashtable& __x) {
+    if (this != &__x) {
+      _Hashtable __tmp(__x);
+      swap(__tmp);
+    }
+    return *this;
+  }
+
+  ~_Hashtable() {
+    _M_destroy_all();
+    _M_deallocate();
+  }
+
+  // accessors:
+
+  hasher hash_function() const { return _M_hash; }
+  key_equal key_eq() const { return _M_equal; }
+  allocator_type get_allocator() const { return _M_slot_allocator; }
+
+  iterator begin() {
+    iterator __it(_M_ctrl, _M_slots);
+    __it._M_skip_empty_or_deleted();
+    return __it;
+  }
+  const_iterator begin() const { return const_cast<_Hashtable*>(this)->begin(); }
+  iterator end() { return iterator(_M_ctrl + _M_capacity, _M_slots + _M_capacity); }
+  const_iterator end() const { return const_cast<_Hashtable*>(this)->end(); }
+
+  bool empty() const { return _M_size == 0; }
+  size_type size() const { return _M_size; }
+  size_type max_size() const { return _M_slot_allocator.max_size(); }
+
+  // bucket interface : slot 하나를 bucket 하나로 센다.
+  size_type bucket_count() const { return _M_capacity; }
+  float load_factor() const { return _M_capacity == 0 ? 0.0f : static_cast<float>(_M_size) / _M_capacity; }
+  float max_load_factor() const { return 7.0f / 8.0f; }
+
+  // rehash() :
+  // 용량을 __n 이상이면서 지금의 요소를 담을 수 있는 가장 작은 크기로 바꾼다. 모든 반복자를 무효화한다.
+  void rehash(size_type __n) {
+    size_type __cap = _S_growth_to_capacity(_M_size);
+    if (__n > __cap) {
+      __cap = 1;
+      while (__cap < __n)
+        __cap = __cap * 2 + 1;
+    }
+    if (__cap == _M_capacity)
+      return;
+    if (__cap == 0)
+      _M_deallocate();
+    else
+      _M_resize(__cap);
+  }
+
+  // reserve() :
+  // 다시 해시하지 않고 요소 __n개를 넣을 수 있게 한다.
+  void reserve(size_type __n) {
+    if (__n > _M_size + _M_growth_left)
+      _M_resize(_S_growth_to_capacity(__n));
+  }
+
+  void swap(_Hashtable& __t) {
+    _Alloc_traits<_Value, _Alloc>::_S_swap(_M_slot_allocator, __t._M_slot_allocator);
+    _Alloc_traits<_Hashtable_ctrl, _Alloc>::_S_swap(_M_ctrl_allocator, __t._M_ctrl_allocator);
+    std::swap(_M_ctrl, __t._M_ctrl);
+    std::swap(_M_slots, __t._M_slots);
+    std::swap(_M_capacity, __t._M_capacity);
+    std::swap(_M_size, __t._M_size);
+    std::swap(_M_growth_left, __t._M_growth_left);
+    std::swap(_M_hash, __t._M_hash);
+    std::swap(_M_equal, __t._M_equal);
+  }
+
+  // insert_unique() :
+  // 같은 key가 없으면 넣는다. 빈 칸이 모자라면 먼저 다시 해시하므로 그때는 모든 반복자가 무효화된다.
+  pair<iterator, bool> insert_unique(const value_type& __v) {
+    const key_type& __k = _S_key(__v);
+    size_type __i = _M_find_index(__k);
+    if (__i != _M_capacity)
+      return pair<iterator, bool>(iterator(_M_ctrl + __i, _M_slots + __i), false);
+
+    const size_type __hash = _M_hash(__k);
+    if (_M_capacity != 0)
+      __i = _M_find_first_non_full(__hash);
+    // 지워진 칸을 다시 쓰는 것은 빈 칸을 줄이지 않는다.
+    if (_M_capacity == 0 || (_M_growth_left == 0 && _M_ctrl[__i] != _S_ctrl_deleted)) {
+      _M_rehash_and_grow();
+      __i = _M_find_first_non_full(__hash);
+    }
+    ft::_Construct(&_M_slots[__i], __v);
+    if (_M_ctrl[__i] == _S_ctrl_empty)
+      --_M_growth_left;
+    _M_set_ctrl(__i, _S_h2(__hash));
+    ++_M_size;
+    return pair<iterator, bool>(iterator(_M_ctrl + __i, _M_slots + __i), true);
+  }
+
+  template <class _InputIterator>
+  void insert_unique(_InputIterator __first, _InputIterator __last) {
+    for ( ; __first != __last; ++__first)
+      insert_unique(*__first);
+  }
+
+  // erase() :
+  // 요소를 옮기지 않으므로 다른 반복자는 그대로 쓸 수 있다.
+  void erase(const_iterator __position) {
+    const size_type __i = __position._M_ctrl - _M_ctrl;
+    _M_slots[__i].~value_type();
+    --_M_size;
+    _M_erase_meta(__i);
+  }
+
+  size_type erase(const key_type& __k) {
+    const size_type __i = _M_find_index(__k);
+    if (__i == _M_capacity)
+      return 0;
+    erase(const_iterator(iterator(_M_ctrl + __i, _M_slots + __i)));
+    return 1;
+  }
+
+  void erase(const_iterator __first, const_iterator __last) {
+    while (__first != __last)
+      erase(__first++);
+  }
+
+  // clear() : 요소를 모두 지우고 용량은 그대로 둔다.
+  void clear() {
+    _M_destroy_all();
+    _M_size = 0;
+    if (_M_capacity != 0)
+      _M_reset_ctrl();
+  }
+
+  // set operations:
+
+  iterator find(const key_type& __k) {
+    const size_type __i = _M_find_index(__k);
+    return iterator(_M_ctrl + __i, _M_slots + __i);
+  }
+  const_iterator find(const key_type& __k) const { return const_cast<_Hashtable*>(this)->find(__k); }
+
+  size_type count(const key_type& __k) const { return _M_find_index(__k) == _M_capacity ? 0 : 1; }
+
+  pair<iterator, iterator> equal_range(const key_type& __k) {
+    iterator __i = find(__k);
+    iterator __j = __i;
+    if (__j != end())
+      ++__j;
+    return pair<iterator, iterator>(__i, __j);
+  }
+  pair<const_iterator, const_iterator> equal_range(const key_type& __k) const {
+    pair<iterator, iterator> __p = const_cast<_Hashtable*>(this)->equal_range(__k);
+    return pair<const_iterator, const_iterator>(__p.first, __p.second);
+  }
+
+  // 요소 수가 같고, __x의 모든 요소가 같은 값으로 __y에 있으면 같다. (순서는 보지 않는다.)
+  bool _M_equal_elements(const _Hashtable& __y) const {
+    if (_M_size != __y._M_size)
+      return false;
+    for (const_iterator __it = begin(); __it != end(); ++__it) {
+      const_iterator __j = __y.find(_S_key(*__it));
+      if (__j == __y.end() || !(*__j == *__it))
+        return false;
+    }
+    return true;
+  }
+};
+
+} // namespace ft
+
+#endif /* HASHTABLE_HPP */
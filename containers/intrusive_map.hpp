@@ -0,0 +1,355 @@
+#ifndef INTRUSIVE_MAP_HPP
+#define INTRUSIVE_MAP_HPP
+
+#include <cstddef>
+  // size_t, ptrdiff_t
+
+#include <functional>
+  // std::less
+
+#include <algorithm>
+  // std::swap()
+
+#include "tree.hpp"
+  // ft::_Rb_tree_node_base, ft::_Rb_tree_base_iterator, _Rb_tree_rebalance_for_insert(), _Rb_tree_rebalance_for_erase()
+
+#include "iterator.hpp"
+  // ft::reverse_iterator
+
+#include "pair.hpp"
+  // ft::pair
+
+#include "type_traits.hpp"
+  // ft::has_cheap_swap
+
+namespace ft
+{
+
+// intrusive_map
+// 요소를 복사해서 노드에 담지 않고, 사용자의 객체를 그대로 트리에 거는 map. (key는 고유하다.)
+// 사용자는 자기 구조체에 훅(intrusive_map_hook, 즉 _Rb_tree_node_base)을 멤버로 두고, 그 멤버 포인터를 템플릿 인자로 넘긴다.
+// 트리는 훅끼리 연결하고, 균형은 _Rb_tree와 같은 함수(_Rb_tree_rebalance_for_insert/erase)로 맞춘다.
+// header도 intrusive_map 안에 있으므로 insert(), erase()를 포함해 어떤 연산도 할당하지 않는다.
+//
+// 객체의 수명은 사용자가 관리한다.
+// - 걸려 있는 동안 객체를 옮기거나 지우면 안 되고, key를 바꾸어도 안 된다.
+// - erase(), clear()는 객체를 트리에서 떼기만 한다. (소멸시키지 않는다.)
+// - 훅 하나로는 트리 하나에만 걸 수 있다. 여러 트리에 걸려면 훅을 여러 개 둔다.
+//
+// 예)
+//   struct job { int id; ft::intrusive_map_hook by_id; };
+//   struct job_id { const int& operator()(const job& __j) const { return __j.id; } };
+//   ft::intrusive_map<int, job, &job::by_id, job_id> jobs;
+
+typedef _Rb_tree_node_base intrusive_map_hook;
+
+// _Intrusive_hook_traits :
+// 훅의 주소와 훅을 가진 객체의 주소를 서로 바꾼다. (객체 안에서 훅의 위치는 멤버 포인터로 정해진다.)
+template <typename _Value, _Rb_tree_node_base _Value::* _Hook>
+struct _Intrusive_hook_traits
+{
+  // 객체의 시작에서 훅까지의 거리. 실제 객체 없이, 정렬된 빈 자리에 대고 멤버의 주소를 잰다.
+  static std::ptrdiff_t _S_offset() {
+    union { char _M_buf[sizeof(_Value)]; void* _M_p; long double _M_ld; long long _M_ll; } __u;
+    _Value* __p = reinterpret_cast<_Value*>(__u._M_buf);
+    return reinterpret_cast<char*>(&(__p->*_Hook)) - __u._M_buf;
+  }
+
+  static _Value* _S_value(_Rb_tree_node_base* __x)
+    { return reinterpret_cast<_Value*>(reinterpret_cast<char*>(__x) - _S_offset()); }
+  static const _Value* _S_value(const _Rb_tree_node_base* __x)
+    { return reinterpret_cast<const _Value*>(reinterpret_cast<const char*>(__x) - _S_offset()); }
+  static _Rb_tree_node_base* _S_hook(_Value& __v) { return &(__v.*_Hook); }
+};
+
+//------------------     iterator     ------------------//
+
+// 순회(_M_increment(), _M_decrement())는 _Rb_tree의 반복자 그대로이고, 역참조만 훅에서 객체로 바꾼다.
+template <typename _Value, typename _Reference, typename _Pointer, _Rb_tree_node_base _Value::* _Hook>
+struct _Intrusive_map_iterator : public _Rb_tree_base_iterator
+{
+  typedef _Value value_type;
+  typedef _Reference reference;
+  typedef _Pointer pointer;
+  typedef _Intrusive_map_iterator<_Value, _Value&, _Value*, _Hook> iterator;
+  typedef _Intrusive_map_iterator<_Value, const _Value&, const _Value*, _Hook> const_iterator;
+  typedef _Intrusive_map_iterator<_Value, _Reference, _Pointer, _Hook> _Self;
+
+  _Intrusive_map_iterator() {}
+  explicit _Intrusive_map_iterator(_Base_ptr __x) { _M_node = __x; }
+  _Intrusive_map_iterator(const iterator& __it) { _M_node = __it._M_node; }
+
+  reference operator*() const { return *_Intrusive_hook_traits<_Value, _Hook>::_S_value(_M_node); }
+  pointer operator->() const { return &(operator*()); }
+
+  _Self& operator++() { _M_increment(); return *this; }
+  _Self operator++(int) {
+    _Self __tmp = *this;
+    _M_increment();
+    return __tmp;
+  }
+
+  _Self& operator--() { _M_decrement(); return *this; }
+  _Self operator--(int) {
+    _Self __tmp = *this;
+    _M_decrement();
+    return __tmp;
+  }
+
+  // iterator와 const_iterator를 섞어 비교할 때는 iterator 쪽이 const_iterator로 바뀐다.
+  friend bool operator==(const _Self& __x, const _Self& __y) { return __x._M_node == __y._M_node; }
+  friend bool operator!=(const _Self& __x, const _Self& __y) { return __x._M_node != __y._M_node; }
+};
+
+//------------------     intrusive_map     ------------------//
+
+template <
+  typename _KeyType,
+  typename _Value, // 사용자의 객체. 훅을 멤버로 가진다.
+  _Rb_tree_node_base _Value::* _Hook, // 이 트리가 쓰는 훅
+  typename _KeyOfValue, // 객체에서 key를 꺼내는 함수 객체 (const _Value& -> const _KeyType&)
+  typename _KeyCompare = std::less<_KeyType>
+> class intrusive_map {
+public:
+  typedef _KeyType key_type;
+  typedef _Value value_type;
+  typedef _KeyCompare key_compare;
+  typedef value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef _Intrusive_map_iterator<value_type, reference, pointer, _Hook> iterator;
+  typedef _Intrusive_map_iterator<value_type, const_reference, const_pointer, _Hook> const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+private:
+  typedef _Rb_tree_node_base* _Base_ptr;
+  typedef const _Rb_tree_node_base* _Const_Base_ptr;
+  typedef _Intrusive_hook_traits<_Value, _Hook> _Hook_traits;
+
+  // header : _Rb_tree의 header와 같다. (부모 자리에 root, 왼쪽에 leftmost, 오른쪽에 rightmost)
+  _Rb_tree_node_base _M_header;
+  size_type _M_node_count;
+  _KeyCompare _M_key_compare;
+
+  // header가 안에 있으므로, 복사하면 root가 다른 header를 가리키게 된다. (객체를 두 트리가 나눠 가질 수도 없다.)
+  intrusive_map(const intrusive_map&);
+  intrusive_map& operator=(const intrusive_map&);
+
+  static const _KeyType& _S_key(_Const_Base_ptr __x)
+    { return _KeyOfValue()(*_Hook_traits::_S_value(__x)); }
+
+  _Base_ptr _M_end() { return &_M_header; }
+  _Const_Base_ptr _M_end() const { return &_M_header; }
+  _Base_ptr _M_root() const { return _M_header._M_get_parent(); }
+
+  // _M_reset() : 빈 트리의 header. (header는 항상 red다.)
+  // 생성자에서는 header가 아직 초기화되지 않았으므로, 부모와 색을 읽지 않고 한 번에 쓴다.
+  void _M_reset() {
+    _M_header._M_init_parent_color(0, _S_rb_tree_red);
+    _M_header._M_left = &_M_header;
+    _M_header._M_right = &_M_header;
+    _M_node_count = 0;
+  }
+
+  // _M_lower_bound() : key가 __k보다 작지 않은 첫 노드. 없으면 header
+  _Base_ptr _M_lower_bound(const key_type& __k) const {
+    _Base_ptr __y = const_cast<_Base_ptr>(_M_end());
+    _Base_ptr __x = _M_root();
+    while (__x != 0)
+      if (!_M_key_compare(_S_key(__x), __k))
+        __y = __x, __x = __x->_M_left;
+      else
+        __x = __x->_M_right;
+    return __y;
+  }
+
+  // _M_upper_bound() : key가 __k보다 큰 첫 노드. 없으면 header
+  _Base_ptr _M_upper_bound(const key_type& __k) const {
+    _Base_ptr __y = const_cast<_Base_ptr>(_M_end());
+    _Base_ptr __x = _M_root();
+    while (__x != 0)
+      if (_M_key_compare(__k, _S_key(__x)))
+        __y = __x, __x = __x->_M_left;
+      else
+        __x = __x->_M_right;
+    return __y;
+  }
+
+  // _M_find() : key가 __k인 노드. 없으면 header
+  _Base_ptr _M_find(const key_type& __k) const {
+    _Base_ptr __j = _M_lower_bound(__k);
+    if (__j == _M_end() || _M_key_compare(__k, _S_key(__j)))
+      return const_cast<_Base_ptr>(_M_end());
+    return __j;
+  }
+
+public:
+  // allocation/deallocation : (아무것도 할당하지 않는다.)
+
+  explicit intrusive_map(const _KeyCompare& __comp = _KeyCompare())
+    : _M_key_compare(__comp) { _M_reset(); }
+
+  // 걸려 있던 객체는 그대로 남는다.
+  ~intrusive_map() {}
+
+  // accessors:
+
+  key_compare key_comp() const { return _M_key_compare; }
+
+  iterator begin() { return iterator(_M_header._M_left); }
+  const_iterator begin() const { return const_iterator(_M_header._M_left); }
+  iterator end() { return iterator(_M_end()); }
+  const_iterator end() const { return const_iterator(const_cast<_Base_ptr>(_M_end())); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+  bool empty() const { return _M_node_count == 0; }
+  size_type size() const { return _M_node_count; }
+  size_type max_size() const { return size_type(-1) / sizeof(value_type); }
+
+  // iterator_to() :
+  // 트리에 걸려 있는 객체를 가리키는 반복자. 찾지 않으므로 O(1)이다.
+  iterator iterator_to(reference __v) { return iterator(_Hook_traits::_S_hook(__v)); }
+  const_iterator iterator_to(const_reference __v) const
+    { return const_iterator(_Hook_traits::_S_hook(const_cast<reference>(__v))); }
+
+  // swap() :
+  // header가 안에 있으므로, root의 부모와 (비었을 때의) leftmost, rightmost를 각자의 header로 고친다.
+  void swap(intrusive_map& __x) {
+    std::swap(_M_header, __x._M_header);
+    std::swap(_M_node_count, __x._M_node_count);
+    std::swap(_M_key_compare, __x._M_key_compare);
+    _M_fix_header();
+    __x._M_fix_header();
+  }
+
+  // insert() :
+  // __v를 건다. 같은 key가 이미 있으면 걸지 않고 (그 요소, false)를 반환한다.
+  // __v의 훅은 다른 트리에 걸려 있지 않아야 한다.
+  pair<iterator, bool> insert(reference __v) {
+    const key_type& __k = _KeyOfValue()(__v);
+    _Base_ptr __y = _M_end();
+    _Base_ptr __x = _M_root();
+    bool __comp = true;
+    while (__x != 0) {
+      __y = __x;
+      __comp = _M_key_compare(__k, _S_key(__x));
+      __x = __comp ? __x->_M_left : __x->_M_right;
+    }
+    iterator __j(__y);
+    if (__comp) { // __y의 왼쪽에 들어갈 때는 바로 앞 요소와 비교한다.
+      if (__j == begin())
+        return pair<iterator, bool>(_M_link(__y, true, __v), true);
+      --__j;
+    }
+    if (_M_key_compare(_S_key(__j._M_node), __k))
+      return pair<iterator, bool>(_M_link(__y, __comp, __v), true);
+    return pair<iterator, bool>(__j, false);
+  }
+
+  // erase() :
+  // 객체를 트리에서 뗀다. 다른 요소의 반복자는 그대로 쓸 수 있다.
+  // 1. 단일 요소 (반복자로)
+  void erase(iterator __position) {
+    _Rb_tree_rebalance_for_erase(__position._M_node, _M_header._M_parent_slot(),
+                                 _M_header._M_left, _M_header._M_right);
+    --_M_node_count;
+  }
+
+  // 2. 키로
+  // 지운 요소의 개수(0 또는 1)를 반환한다.
+  size_type erase(const key_type& __k) {
+    _Base_ptr __x = _M_find(__k);
+    if (__x == _M_end())
+      return 0;
+    erase(iterator(__x));
+    return 1;
+  }
+
+  // 3. 범위
+  void erase(iterator __first, iterator __last) {
+    if (__first == begin() && __last == end())
+      clear();
+    else
+      while (__first != __last)
+        erase(__first++);
+  }
+
+  // clear() : 모든 객체를 떼어낸다. 객체를 하나씩 건드리지 않으므로 O(1)이다.
+  void clear() { _M_reset(); }
+
+  // map operations:
+
+  iterator find(const key_type& __k) { return iterator(_M_find(__k)); }
+  const_iterator find(const key_type& __k) const { return const_iterator(_M_find(__k)); }
+
+  // count() : 1과 0 중에서만 반환한다.
+  size_type count(const key_type& __k) const { return _M_find(__k) == _M_end() ? 0 : 1; }
+
+  iterator lower_bound(const key_type& __k) { return iterator(_M_lower_bound(__k)); }
+  const_iterator lower_bound(const key_type& __k) const { return const_iterator(_M_lower_bound(__k)); }
+  iterator upper_bound(const key_type& __k) { return iterator(_M_upper_bound(__k)); }
+  const_iterator upper_bound(const key_type& __k) const { return const_iterator(_M_upper_bound(__k)); }
+
+  pair<iterator, iterator> equal_range(const key_type& __k) {
+    return pair<iterator, iterator>(lower_bound(__k), upper_bound(__k));
+  }
+  pair<const_iterator, const_iterator> equal_range(const key_type& __k) const {
+    return pair<const_iterator, const_iterator>(lower_bound(__k), upper_bound(__k));
+  }
+
+private:
+  // _M_link() :
+  // __v의 훅을 __y의 (__left면 왼쪽, 아니면 오른쪽) 자식으로 걸고 rebalance한다. (_Rb_tree::_M_insert_node()와 같다.)
+  iterator _M_link(_Base_ptr __y, bool __left, reference __v) {
+    _Base_ptr __z = _Hook_traits::_S_hook(__v);
+    if (__y == _M_end()) { // 첫 요소
+      _M_header._M_left = __z;
+      _M_header._M_set_parent(__z);
+      _M_header._M_right = __z;
+    }
+    else if (__left) {
+      __y->_M_left = __z;
+      if (__y == _M_header._M_left)
+        _M_header._M_left = __z;
+    }
+    else {
+      __y->_M_right = __z;
+      if (__y == _M_header._M_right)
+        _M_header._M_right = __z;
+    }
+    __z->_M_init_parent_color(__y, _S_rb_tree_red); // 사용자의 훅은 초기화되어 있지 않을 수 있다.
+    __z->_M_left = 0;
+    __z->_M_right = 0;
+    _Rb_tree_rebalance_for_insert(__z, _M_header._M_parent_slot());
+    ++_M_node_count;
+    return iterator(__z);
+  }
+
+  // _M_fix_header() : swap() 뒤에 root와 header를 다시 잇는다.
+  void _M_fix_header() {
+    if (_M_node_count == 0)
+      _M_reset();
+    else
+      _M_root()->_M_set_parent(&_M_header);
+  }
+};
+
+template <class _Key, class _Value, _Rb_tree_node_base _Value::* _Hook, class _KeyOfValue, class _KeyCompare>
+void swap(intrusive_map<_Key,_Value,_Hook,_KeyOfValue,_KeyCompare>& __x,
+          intrusive_map<_Key,_Value,_Hook,_KeyOfValue,_KeyCompare>& __y) {
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 :
+template <class _Key, class _Value, _Rb_tree_node_base _Value::* _Hook, class _KeyOfValue, class _KeyCompare>
+struct has_cheap_swap<intrusive_map<_Key,_Value,_Hook,_KeyOfValue,_KeyCompare> > : public true_type {};
+
+} // namespace ft
+
+#endif /* INTRUSIVE_MAP_HPP */
@@ -51,6 +51,7 @@ public:
   typedef typename _Rb_tree_type::size_type size_type;
   typedef typename _Rb_tree_type::difference_type difference_type;
   typedef typename _Rb_tree_type::allocator_type allocator_type;
+  typedef typename _Rb_tree_type::node_type node_type;
 
   // allocation/deallocation
 
@@ -69,6 +70,14 @@ public:
       const allocator_type& __a = allocator_type())
     : _M_tree(__comp, __a) { _M_tree.insert_unique(__first, __last); }
   
+  // 정렬된 범위로 생성 :
+  // [__first, __last)가 key 순서대로 정렬되어 있고 중복이 없어야 한다. 비교 없이 O(n)에 만든다.
+  template <class _InputIterator>
+  map(sorted_unique_t, _InputIterator __first, _InputIterator __last,
+      const _KeyCompare& __comp = _KeyCompare(),
+      const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) { _M_tree.insert_sorted_unique(__first, __last); }
+  
   map(const map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x) : _M_tree(__x._M_tree) {}
 
   map<_KeyType, _MappedType, _KeyCompare, _Alloc>&
@@ -107,16 +116,20 @@ public:
   }
 
   // at():
-  _MappedType& at(size_type __n) { 
-    if (__n >= this->size())
+  // __k가 key인 요소의 값을 반환한다. operator[]와 달리 없으면 삽입하지 않고 out_of_range를 던진다.
+  // (순서로 접근하려면 nth()를 쓰자.)
+  _MappedType& at(const key_type& __k) { 
+    iterator __i = find(__k);
+    if (__i == end())
       throw std::out_of_range("map");
-    return (*this)[__n]; 
+    return (*__i).second; 
   }
   
-  const _MappedType& at(size_type __n) const { 
-    if (__n >= this->size())
+  const _MappedType& at(const key_type& __k) const { 
+    const_iterator __i = find(__k);
+    if (__i == end())
       throw std::out_of_range("map");
-    return (*this)[__n]; 
+    return (*__i).second; 
   }
 
   // swap() :
@@ -132,11 +145,39 @@ public:
     { return _M_tree.insert_unique(position, __x); }
 
   // 3. 범위
+  // (빈 map에 정렬된 범위를 넣으면 O(n)에 만든다.)
   template <class _InputIterator>
   void insert(_InputIterator __first, _InputIterator __last) {
     _M_tree.insert_unique(__first, __last);
   }
 
+  // 4. 정렬된 범위
+  // [__first, __last)가 정렬되어 있고 중복이 없어야 한다. 빈 map이라면 정렬 여부도 확인하지 않는다.
+  template <class _InputIterator>
+  void insert(sorted_unique_t, _InputIterator __first, _InputIterator __last) {
+    _M_tree.insert_sorted_unique(__first, __last);
+  }
+
+  // 5. node handle
+  // extract()로 떼어낸 노드를 그대로 연결한다. 성공하면 __nh는 비고, 같은 key가 이미 있으면 노드는 __nh에 남는다.
+  pair<iterator, bool> insert(node_type& __nh)
+    { return _M_tree.insert_unique(__nh); }
+  iterator insert(iterator __position, node_type& __nh)
+    { return _M_tree.insert_unique(__position, __nh); }
+
+  // extract() :
+  // 요소를 지우지 않고 노드째로 떼어낸다. 다른 map에 insert()하면 할당/해제/복사 없이 옮겨진다.
+  // (node_type은 복사하면 소유권이 넘어간다. 자세한 것은 tree.hpp의 _Rb_tree_node_handle을 참고하자.)
+  node_type extract(iterator __position)
+    { return _M_tree.extract(__position); }
+  node_type extract(const key_type& __x)
+    { return _M_tree.extract(__x); }
+
+  // merge() :
+  // __src의 요소 중 이 map에 없는 key의 요소를 노드째로 옮겨온다. 겹치는 key의 요소는 __src에 남는다.
+  void merge(map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __src)
+    { _M_tree.merge_unique(__src._M_tree); }
+
   // erase() :
   // 1. 단일 요소 (반복자로)
   void erase(iterator __position) 
@@ -176,6 +217,23 @@ public:
     return _M_tree.upper_bound(__x); 
   }
 
+  // find_batch(), lower_bound_batch() :
+  // [__first, __last)의 key마다 find(), lower_bound()의 결과를 순서대로 __out에 쓴다. 끝난 __out을 반환한다.
+  // 여러 검색을 번갈아 진행하며 다음 노드를 prefetch하므로, 큰 map에서 key를 많이 찾을 때 하나씩 찾는 것보다 빠르다.
+  template <class _ForwardIter, class _OutputIter>
+  _OutputIter find_batch(_ForwardIter __first, _ForwardIter __last, _OutputIter __out)
+    { return _M_tree.find_batch(__first, __last, __out); }
+  template <class _ForwardIter, class _OutputIter>
+  _OutputIter find_batch(_ForwardIter __first, _ForwardIter __last, _OutputIter __out) const
+    { return _M_tree.find_batch(__first, __last, __out); }
+
+  template <class _ForwardIter, class _OutputIter>
+  _OutputIter lower_bound_batch(_ForwardIter __first, _ForwardIter __last, _OutputIter __out)
+    { return _M_tree.lower_bound_batch(__first, __last, __out); }
+  template <class _ForwardIter, class _OutputIter>
+  _OutputIter lower_bound_batch(_ForwardIter __first, _ForwardIter __last, _OutputIter __out) const
+    { return _M_tree.lower_bound_batch(__first, __last, __out); }
+
   // * lower_bound()와 upper_bound()의 활용
   // [1245]에서 1부터 4까지의 요소를 포함하는 범위는 [lower_bound(1), upper_bound(4))로 표현할 수 있다.
   // (upper_bound(4)는 5를 가리키고 있으므로)
@@ -187,6 +245,88 @@ public:
     return _M_tree.equal_range(__x);
   }
 
+  // 투명한 비교 (heterogeneous lookup) :
+  // key_compare가 is_transparent를 선언했다면 key_type이 아닌 타입으로도 찾을 수 있다. 임시 key_type을 만들지 않는다.
+  // C++98에는 std::less<>가 없으므로, 비교 함수 객체가 직접 is_transparent를 선언하고 operator()를 템플릿으로 둔다.
+  //   struct str_less {
+  //     typedef void is_transparent;
+  //     template <typename _A, typename _B>
+  //     bool operator()(const _A& __a, const _B& __b) const { return std::strcmp(_S_c_str(__a), _S_c_str(__b)) < 0; }
+  //     static const char* _S_c_str(const std::string& __s) { return __s.c_str(); }
+  //     static const char* _S_c_str(const char* __s) { return __s; }
+  //   };
+  //   map<std::string, V, str_less>를 const char*로 찾으면 임시 std::string을 만들지 않는다.
+  template <typename _Kt>
+  typename __enable_if_transparent<key_compare, _Kt, iterator>::type
+  find(const _Kt& __x) { return _M_tree.find(__x); }
+  template <typename _Kt>
+  typename __enable_if_transparent<key_compare, _Kt, const_iterator>::type
+  find(const _Kt& __x) const { return _M_tree.find(__x); }
+
+  template <typename _Kt>
+  typename __enable_if_transparent<key_compare, _Kt, size_type>::type
+  count(const _Kt& __x) const { return _M_tree.find(__x) == _M_tree.end() ? 0 : 1; }
+
+  template <typename _Kt>
+  typename __enable_if_transparent<key_compare, _Kt, iterator>::type
+  lower_bound(const _Kt& __x) { return _M_tree.lower_bound(__x); }
+  template <typename _Kt>
+  typename __enable_if_transparent<key_compare, _Kt, const_iterator>::type
+  lower_bound(const _Kt& __x) const { return _M_tree.lower_bound(__x); }
+
+  template <typename _Kt>
+  typename __enable_if_transparent<key_compare, _Kt, iterator>::type
+  upper_bound(const _Kt& __x) { return _M_tree.upper_bound(__x); }
+  template <typename _Kt>
+  typename __enable_if_transparent<key_compare, _Kt, const_iterator>::type
+  upper_bound(const _Kt& __x) const { return _M_tree.upper_bound(__x); }
+
+  template <typename _Kt>
+  typename __enable_if_transparent<key_compare, _Kt, pair<iterator,iterator> >::type
+  equal_range(const _Kt& __x) { return _M_tree.equal_range(__x); }
+  template <typename _Kt>
+  typename __enable_if_transparent<key_compare, _Kt, pair<const_iterator,const_iterator> >::type
+  equal_range(const _Kt& __x) const { return _M_tree.equal_range(__x); }
+
+  // split() :
+  // key가 __k보다 작지 않은 요소를 모두 __right로 옮긴다. __right에 있던 요소는 먼저 지운다.
+  void split(const key_type& __k, map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __right)
+    { _M_tree.split(__k, __right._M_tree); }
+
+  // join() :
+  // __right의 요소를 모두 이 map으로 옮긴다. __right의 모든 key가 이 map의 모든 key보다 커야 한다.
+  // 할당기가 같으면 둘 다 노드를 다시 만들지 않고 O(log n)에 끝난다. (자세한 것은 tree.hpp를 참고하자.)
+  void join(map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __right)
+    { _M_tree.join(__right._M_tree); }
+
+  // order statistics:
+  // FT_RB_TREE_ORDER_STATISTICS를 정의하면 모두 O(log n)이다. (아니면 O(n))
+
+  // nth() : 정렬 순서로 __k번째(0부터) 요소. __k >= size()이면 end().
+  iterator nth(size_type __k) { return _M_tree.nth(__k); }
+  const_iterator nth(size_type __k) const { return _M_tree.nth(__k); }
+
+  // rank() : key가 __x보다 작은 요소의 개수.
+  size_type rank(const key_type& __x) const { return _M_tree.rank(__x); }
+
+  // index_of() : __it가 몇 번째 요소인지. end()는 size().
+  size_type index_of(const_iterator __it) const { return _M_tree.index_of(__it); }
+
+  // distance() : std::distance(__first, __last)와 같다.
+  difference_type distance(const_iterator __first, const_iterator __last) const {
+    return _M_tree.distance(__first, __last);
+  }
+
+  template <class _K1, class _T1, class _C1, class _A1, class _Merge>
+  friend void map_union(map<_K1, _T1, _C1, _A1>&, map<_K1, _T1, _C1, _A1>&, _Merge);
+  template <class _K1, class _T1, class _C1, class _A1, class _Merge>
+  friend void map_intersection(map<_K1, _T1, _C1, _A1>&, map<_K1, _T1, _C1, _A1>&, _Merge);
+  template <class _K1, class _T1, class _C1, class _A1>
+  friend void map_difference(map<_K1, _T1, _C1, _A1>&, map<_K1, _T1, _C1, _A1>&);
+  // (parallel_assign.hpp에 있다. pthread가 필요하므로 map.hpp는 그것을 포함하지 않는다.)
+  template <class _K1, class _T1, class _C1, class _A1>
+  friend void parallel_assign(map<_K1, _T1, _C1, _A1>&, const map<_K1, _T1, _C1, _A1>&, unsigned);
+
   template <class _K1, class _T1, class _C1, class _A1>
   friend bool operator== (const map<_K1, _T1, _C1, _A1>&,
                           const map<_K1, _T1, _C1, _A1>&);
@@ -237,6 +377,51 @@ void swap(map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
   __x.swap(__y);
 }
 
+// 집합 연산 :
+// 결과를 __x에 만들고, __y는 비운다. __y의 노드는 다시 만들지 않고 __x로 옮긴다. (할당기가 다르면 하나씩 넣는다.)
+// 두 map을 root에서 나누고 붙이는 분할정복이므로, 작은 쪽이 m개, 큰 쪽이 n개일 때 O(m log(n/m + 1))이다.
+// 작은 변경분을 큰 map에 합치는 데에 알맞다. (자세한 것은 tree.hpp의 union_with()를 참고하자.)
+// key가 겹치면 __x의 요소가 남고, __merge(__x의 mapped 값, __y의 mapped 값)로 값을 합친다. (둘 다 T&로 받는다.)
+// __merge를 주지 않으면 __x의 값을 그대로 둔다. __merge는 예외를 던지면 안 된다.
+
+// map_union() : __x = __x ∪ __y
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc, class _Merge>
+void map_union(map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+               map<_Key,_MappedType,_KeyCompare,_Alloc>& __y, _Merge __merge) {
+  __x._M_tree.union_with(__y._M_tree, _Merge_second<_Merge>(__merge));
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+void map_union(map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+               map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  map_union(__x, __y, _Keep_first());
+}
+
+// map_intersection() : __x = __x ∩ __y
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc, class _Merge>
+void map_intersection(map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+                      map<_Key,_MappedType,_KeyCompare,_Alloc>& __y, _Merge __merge) {
+  __x._M_tree.intersect_with(__y._M_tree, _Merge_second<_Merge>(__merge));
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+void map_intersection(map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+                      map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  map_intersection(__x, __y, _Keep_first());
+}
+
+// map_difference() : __x = __x - __y
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+void map_difference(map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+                    map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  __x._M_tree.subtract(__y._M_tree);
+}
+
+// has_cheap_swap 특수화 :
+// map의 swap()은 header 포인터만 바꾸므로, vector<map<K, V> >는 재할당할 때 트리를 복사하지 않고 swap으로 옮긴다.
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+struct has_cheap_swap<map<_Key,_MappedType,_KeyCompare,_Alloc> > : public true_type {};
+
 } // namespace ft
 
 #endif /* MAP_HPP */
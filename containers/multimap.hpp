@@ -0,0 +1,224 @@
+#ifndef MULTIMAP_HPP
+#define MULTIMAP_HPP
+
+#include "tree.hpp"
+
+namespace ft
+{
+// multimap
+// map과 같지만 같은 key를 여러 개 가질 수 있다. 같은 key의 요소끼리는 넣은 순서대로 놓인다.
+// (operator[]와 at()은 어느 요소를 가리킬지 정할 수 없으므로 없다.)
+template <
+  typename _KeyType, // 요소를 정렬하는 데에 사용된다. 고유하지 않아도 된다.
+  typename _MappedType, // 내가 저장하는 실제 데이터
+  typename _KeyCompare = std::less<_KeyType>, // 요소의 순서를 비교하고, 동일한지 결정할 때 사용한다.
+  typename _Alloc = std::allocator<pair<const _KeyType, _MappedType> >
+// 위의 타입들은 그대로 사용되어, 내장된 tree의 타입을 결정한다.
+> class multimap {
+public:
+  typedef _KeyType key_type;
+  typedef _MappedType data_type;
+  typedef _MappedType mapped_type;
+  typedef pair<const _KeyType, _MappedType> value_type; // 노드(pair)의 타입
+  typedef _KeyCompare key_compare;
+
+  class value_compare
+  {
+  friend class multimap<_KeyType, _MappedType, _KeyCompare, _Alloc>;
+
+  protected :
+    _KeyCompare comp;
+    value_compare(_KeyCompare __c) : comp(__c) {}
+
+  public:
+    bool operator()(const value_type& __x, const value_type& __y) const {
+      return comp(__x.first, __y.first);
+    }
+  };
+
+private:
+  typedef _Rb_tree<key_type, value_type, _Select1st<value_type>, key_compare, _Alloc> 
+    _Rb_tree_type;
+  _Rb_tree_type _M_tree; // 이것이 실제 multimap
+public:
+  typedef typename _Rb_tree_type::pointer pointer;
+  typedef typename _Rb_tree_type::const_pointer const_pointer;
+  typedef typename _Rb_tree_type::reference reference;
+  typedef typename _Rb_tree_type::const_reference const_reference;
+  typedef typename _Rb_tree_type::iterator iterator;
+  typedef typename _Rb_tree_type::const_iterator const_iterator;
+  typedef typename _Rb_tree_type::reverse_iterator reverse_iterator;
+  typedef typename _Rb_tree_type::const_reverse_iterator const_reverse_iterator;
+  typedef typename _Rb_tree_type::size_type size_type;
+  typedef typename _Rb_tree_type::difference_type difference_type;
+  typedef typename _Rb_tree_type::allocator_type allocator_type;
+
+  // allocation/deallocation
+
+  multimap() : _M_tree(_KeyCompare(), allocator_type()) {}
+  explicit multimap(const _KeyCompare& __comp,
+                    const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) {}
+
+  template <class _InputIterator>
+  multimap(_InputIterator __first, _InputIterator __last)
+    : _M_tree(_KeyCompare(), allocator_type())
+    { _M_tree.insert_equal(__first, __last); }
+
+  template <class _InputIterator>
+  multimap(_InputIterator __first, _InputIterator __last, const _KeyCompare& __comp,
+      const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) { _M_tree.insert_equal(__first, __last); }
+
+  multimap(const multimap<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x) : _M_tree(__x._M_tree) {}
+
+  multimap<_KeyType, _MappedType, _KeyCompare, _Alloc>&
+  operator=(const multimap<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x)
+  {
+    _M_tree = __x._M_tree;
+    return *this; 
+  }
+
+  // accessors:
+
+  key_compare key_comp() const { return _M_tree.key_comp(); }
+  value_compare value_comp() const { return value_compare(_M_tree.key_comp()); }
+  allocator_type get_allocator() const { return _M_tree.get_allocator(); }
+
+  iterator begin() { return _M_tree.begin(); }
+  const_iterator begin() const { return _M_tree.begin(); }
+  iterator end() { return _M_tree.end(); }
+  const_iterator end() const { return _M_tree.end(); }
+  reverse_iterator rbegin() { return _M_tree.rbegin(); }
+  const_reverse_iterator rbegin() const { return _M_tree.rbegin(); }
+  reverse_iterator rend() { return _M_tree.rend(); }
+  const_reverse_iterator rend() const { return _M_tree.rend(); }
+  bool empty() const { return _M_tree.empty(); }
+  size_type size() const { return _M_tree.size(); }
+  size_type max_size() const { return _M_tree.max_size(); }
+
+  // swap() :
+  void swap(multimap<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x) { _M_tree.swap(__x._M_tree); }
+
+  // insert() :
+  // 항상 넣고, 넣은 요소를 가리키는 반복자를 반환한다. 같은 key가 있으면 그 뒤에 들어간다.
+  // 1. 단일요소
+  iterator insert(const value_type& __x)
+    { return _M_tree.insert_equal(__x); }
+
+  // 2. 힌트와 함께
+  // __position 바로 앞에 넣어도 순서가 맞으면 탐색 없이 넣는다. (시간순으로 들어오는 요소는 end()를 힌트로 주자.)
+  iterator insert(iterator __position, const value_type& __x)
+    { return _M_tree.insert_equal(__position, __x); }
+
+  // 3. 범위
+  // (빈 multimap에 정렬된 범위를 넣으면 O(n)에 만든다.)
+  template <class _InputIterator>
+  void insert(_InputIterator __first, _InputIterator __last) {
+    _M_tree.insert_equal(__first, __last);
+  }
+
+  // erase() :
+  // 1. 단일 요소 (반복자로)
+  void erase(iterator __position) 
+    { _M_tree.erase(__position); }
+
+  // 2. 키로
+  // __x가 key인 요소를 모두 지우고, 지운 요소의 개수를 반환한다.
+  size_type erase(const key_type& __x) 
+    { return _M_tree.erase(__x); }
+  
+  // 3. 범위
+  void erase(iterator __first, iterator __last)
+    { _M_tree.erase(__first, __last); }
+  
+  void clear() { _M_tree.clear(); }
+
+  // multimap operations:
+  // (설명은 tree.hpp를 참고하자.)
+
+  // find() : __x가 key인 요소 중 첫 번째.
+  iterator find(const key_type& __x) { return _M_tree.find(__x); }
+  const_iterator find(const key_type& __x) const { return _M_tree.find(__x); }
+
+  // count() :
+  // __x가 key인 요소 수. equal_range()를 구해서 그 거리를 잰다.
+  // FT_RB_TREE_ORDER_STATISTICS를 정의하면 O(log n)이고, 아니면 O(log n + 개수)다.
+  size_type count(const key_type& __x) const { return _M_tree.count(__x); }
+
+  iterator lower_bound(const key_type& __x) {return _M_tree.lower_bound(__x); }
+  const_iterator lower_bound(const key_type& __x) const {
+    return _M_tree.lower_bound(__x); 
+  }
+
+  iterator upper_bound(const key_type& __x) {return _M_tree.upper_bound(__x); }
+  const_iterator upper_bound(const key_type& __x) const {
+    return _M_tree.upper_bound(__x); 
+  }
+
+  // equal_range() :
+  // [lower_bound(__x), upper_bound(__x))를 한 번 내려가면서 구한다.
+  pair<iterator,iterator> equal_range(const key_type& __x) {
+    return _M_tree.equal_range(__x);
+  }
+  pair<const_iterator,const_iterator> equal_range(const key_type& __x) const {
+    return _M_tree.equal_range(__x);
+  }
+
+  template <class _K1, class _T1, class _C1, class _A1>
+  friend bool operator== (const multimap<_K1, _T1, _C1, _A1>&,
+                          const multimap<_K1, _T1, _C1, _A1>&);
+  template <class _K1, class _T1, class _C1, class _A1>
+  friend bool operator< (const multimap<_K1, _T1, _C1, _A1>&,
+                         const multimap<_K1, _T1, _C1, _A1>&);
+};
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator==(const multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+                const multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return __x._M_tree == __y._M_tree;
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator<(const multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+               const multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return __x._M_tree < __y._M_tree;
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator!=(const multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+                const multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return !(__x == __y);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator>(const multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+               const multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return __y < __x;
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator<=(const multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+                const multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return !(__y < __x);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator>=(const multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+                const multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return !(__x < __y);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+void swap(multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __x, 
+          multimap<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 :
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+struct has_cheap_swap<multimap<_Key,_MappedType,_KeyCompare,_Alloc> > : public true_type {};
+
+} // namespace ft
+
+#endif /* MULTIMAP_HPP */
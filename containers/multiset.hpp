@@ -0,0 +1,189 @@
+#ifndef MULTISET_HPP
+#define MULTISET_HPP
+
+#include "tree.hpp"
+
+namespace ft
+{
+// multiset
+// 같은 key를 여러 개 가질 수 있는, 정렬된 key의 모임. multimap과 같은 트리를 쓰고, value가 곧 key다.
+// key를 바꾸면 순서가 깨지므로 반복자는 모두 const_iterator다.
+template <
+  typename _KeyType,
+  typename _KeyCompare = std::less<_KeyType>,
+  typename _Alloc = std::allocator<_KeyType>
+> class multiset {
+public:
+  typedef _KeyType key_type;
+  typedef _KeyType value_type;
+  typedef _KeyCompare key_compare;
+  typedef _KeyCompare value_compare;
+
+private:
+  typedef _Rb_tree<key_type, value_type, _Identity<value_type>, key_compare, _Alloc> 
+    _Rb_tree_type;
+  typedef typename _Rb_tree_type::iterator _Tree_iterator;
+  _Rb_tree_type _M_tree; // 이것이 실제 multiset
+
+  // 트리의 erase(), insert()의 힌트는 (고칠 수 있는) iterator를 받는다.
+  static _Tree_iterator _S_tree_iterator(typename _Rb_tree_type::const_iterator __it)
+    { return _Tree_iterator((typename _Tree_iterator::_Link_type) __it._M_node); }
+public:
+  typedef typename _Rb_tree_type::const_pointer pointer;
+  typedef typename _Rb_tree_type::const_pointer const_pointer;
+  typedef typename _Rb_tree_type::const_reference reference;
+  typedef typename _Rb_tree_type::const_reference const_reference;
+  typedef typename _Rb_tree_type::const_iterator iterator;
+  typedef typename _Rb_tree_type::const_iterator const_iterator;
+  typedef typename _Rb_tree_type::const_reverse_iterator reverse_iterator;
+  typedef typename _Rb_tree_type::const_reverse_iterator const_reverse_iterator;
+  typedef typename _Rb_tree_type::size_type size_type;
+  typedef typename _Rb_tree_type::difference_type difference_type;
+  typedef typename _Rb_tree_type::allocator_type allocator_type;
+
+  // allocation/deallocation
+
+  multiset() : _M_tree(_KeyCompare(), allocator_type()) {}
+  explicit multiset(const _KeyCompare& __comp,
+                    const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) {}
+
+  template <class _InputIterator>
+  multiset(_InputIterator __first, _InputIterator __last)
+    : _M_tree(_KeyCompare(), allocator_type())
+    { _M_tree.insert_equal(__first, __last); }
+
+  template <class _InputIterator>
+  multiset(_InputIterator __first, _InputIterator __last, const _KeyCompare& __comp,
+           const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) { _M_tree.insert_equal(__first, __last); }
+
+  multiset(const multiset<_KeyType, _KeyCompare, _Alloc>& __x) : _M_tree(__x._M_tree) {}
+
+  multiset<_KeyType, _KeyCompare, _Alloc>&
+  operator=(const multiset<_KeyType, _KeyCompare, _Alloc>& __x)
+  {
+    _M_tree = __x._M_tree;
+    return *this; 
+  }
+
+  // accessors:
+
+  key_compare key_comp() const { return _M_tree.key_comp(); }
+  value_compare value_comp() const { return _M_tree.key_comp(); }
+  allocator_type get_allocator() const { return _M_tree.get_allocator(); }
+
+  const_iterator begin() const { return _M_tree.begin(); }
+  const_iterator end() const { return _M_tree.end(); }
+  const_reverse_iterator rbegin() const { return _M_tree.rbegin(); }
+  const_reverse_iterator rend() const { return _M_tree.rend(); }
+  bool empty() const { return _M_tree.empty(); }
+  size_type size() const { return _M_tree.size(); }
+  size_type max_size() const { return _M_tree.max_size(); }
+
+  // swap() :
+  void swap(multiset<_KeyType, _KeyCompare, _Alloc>& __x) { _M_tree.swap(__x._M_tree); }
+
+  // insert() :
+  // 항상 넣고, 넣은 요소를 가리키는 반복자를 반환한다. 같은 key가 있으면 그 뒤에 들어간다.
+  // 1. 단일요소
+  iterator insert(const value_type& __x)
+    { return _M_tree.insert_equal(__x); }
+
+  // 2. 힌트와 함께
+  iterator insert(iterator __position, const value_type& __x)
+    { return _M_tree.insert_equal(_S_tree_iterator(__position), __x); }
+
+  // 3. 범위
+  template <class _InputIterator>
+  void insert(_InputIterator __first, _InputIterator __last) {
+    _M_tree.insert_equal(__first, __last);
+  }
+
+  // erase() :
+  // 1. 단일 요소 (반복자로)
+  void erase(iterator __position) 
+    { _M_tree.erase(_S_tree_iterator(__position)); }
+
+  // 2. 키로
+  // __x와 같은 요소를 모두 지우고, 지운 요소의 개수를 반환한다.
+  size_type erase(const key_type& __x) 
+    { return _M_tree.erase(__x); }
+  
+  // 3. 범위
+  void erase(iterator __first, iterator __last)
+    { _M_tree.erase(_S_tree_iterator(__first), _S_tree_iterator(__last)); }
+  
+  void clear() { _M_tree.clear(); }
+
+  // multiset operations:
+
+  const_iterator find(const key_type& __x) const { return _M_tree.find(__x); }
+
+  // count() :
+  // __x와 같은 요소 수. FT_RB_TREE_ORDER_STATISTICS를 정의하면 O(log n)이고, 아니면 O(log n + 개수)다.
+  size_type count(const key_type& __x) const { return _M_tree.count(__x); }
+
+  const_iterator lower_bound(const key_type& __x) const { return _M_tree.lower_bound(__x); }
+  const_iterator upper_bound(const key_type& __x) const { return _M_tree.upper_bound(__x); }
+  pair<const_iterator,const_iterator> equal_range(const key_type& __x) const {
+    return _M_tree.equal_range(__x);
+  }
+
+  template <class _K1, class _C1, class _A1>
+  friend bool operator== (const multiset<_K1, _C1, _A1>&,
+                          const multiset<_K1, _C1, _A1>&);
+  template <class _K1, class _C1, class _A1>
+  friend bool operator< (const multiset<_K1, _C1, _A1>&,
+                         const multiset<_K1, _C1, _A1>&);
+};
+
+template <class _Key, class _KeyCompare, class _Alloc>
+bool operator==(const multiset<_Key,_KeyCompare,_Alloc>& __x, 
+                const multiset<_Key,_KeyCompare,_Alloc>& __y) {
+  return __x._M_tree == __y._M_tree;
+}
+
+template <class _Key, class _KeyCompare, class _Alloc>
+bool operator<(const multiset<_Key,_KeyCompare,_Alloc>& __x, 
+               const multiset<_Key,_KeyCompare,_Alloc>& __y) {
+  return __x._M_tree < __y._M_tree;
+}
+
+template <class _Key, class _KeyCompare, class _Alloc>
+bool operator!=(const multiset<_Key,_KeyCompare,_Alloc>& __x, 
+                const multiset<_Key,_KeyCompare,_Alloc>& __y) {
+  return !(__x == __y);
+}
+
+template <class _Key, class _KeyCompare, class _Alloc>
+bool operator>(const multiset<_Key,_KeyCompare,_Alloc>& __x, 
+               const multiset<_Key,_KeyCompare,_Alloc>& __y) {
+  return __y < __x;
+}
+
+template <class _Key, class _KeyCompare, class _Alloc>
+bool operator<=(const multiset<_Key,_KeyCompare,_Alloc>& __x, 
+                const multiset<_Key,_KeyCompare,_Alloc>& __y) {
+  return !(__y < __x);
+}
+
+template <class _Key, class _KeyCompare, class _Alloc>
+bool operator>=(const multiset<_Key,_KeyCompare,_Alloc>& __x, 
+                const multiset<_Key,_KeyCompare,_Alloc>& __y) {
+  return !(__x < __y);
+}
+
+template <class _Key, class _KeyCompare, class _Alloc>
+void swap(multiset<_Key,_KeyCompare,_Alloc>& __x, 
+          multiset<_Key,_KeyCompare,_Alloc>& __y) {
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 :
+template <class _Key, class _KeyCompare, class _Alloc>
+struct has_cheap_swap<multiset<_Key,_KeyCompare,_Alloc> > : public true_type {};
+
+} // namespace ft
+
+#endif /* MULTISET_HPP */
@@ -0,0 +1,499 @@
+#ifndef OFFSET_MAP_HPP
+#define OFFSET_MAP_HPP
+
+#include <cstddef>
+  // size_t, ptrdiff_t
+
+#include <functional>
+  // std::less
+
+#include <algorithm>
+  // std::swap()
+
+#include <stdexcept>
+  // std::out_of_range
+
+#include "tree.hpp"
+  // ft::_Rb_tree_algorithms: 순회, rebalance를 _Rb_tree와 함께 쓴다.
+
+#include "shm_allocator.hpp"
+  // ft::offset_ptr, ft::shm_segment, ft::shm_allocator
+
+#include "iterator.hpp"
+  // ft::reverse_iterator
+
+#include "pair.hpp"
+  // ft::pair
+
+#include "construct.hpp"
+  // ft::_Construct()
+
+#include "algorithm.hpp"
+  // ft::equal(), ft::lexicographical_compare()
+
+#include "type_traits.hpp"
+  // ft::has_cheap_swap
+
+namespace ft
+{
+
+// offset_map
+// 공유 메모리(shm_segment)에 통째로 들어가, 여러 프로세스가 복사 없이 함께 보는 map.
+// 노드끼리, 그리고 header와 노드가 그냥 포인터 대신 offset_ptr(자기 위치로부터의 거리)로 이어져 있어서,
+// 세그먼트가 프로세스마다 다른 주소에 붙어도 트리를 그대로 따라갈 수 있다.
+// 회전, rebalance, 순회는 _Rb_tree와 같은 코드(_Rb_tree_algorithms)를 노드 타입만 바꾸어 쓴다.
+//
+// 사용법 : 세그먼트의 루트 객체로 만들고, 다른 프로세스는 같은 타입으로 찾는다.
+//   ft::shm_segment __seg("/dev/shm/index", 64 << 20);
+//   typedef ft::offset_map<int, record> index_type;
+//   index_type* __m = __seg.find_or_construct<index_type>();
+//
+// 제약 :
+// - offset_map 자체도 세그먼트 안에 있어야 한다. (header를 노드가 가리키므로)
+// - key와 mapped_type도 세그먼트 밖을 가리키면 안 된다. (정수, 고정 길이 배열, offset_ptr 등. std::string은 안 된다.)
+// - 모든 프로세스가 같은 타입(같은 빌드)으로 써야 한다. 노드의 모양은 FT_RB_TREE_* 매크로와 상관없다.
+// - 잠금이 없다. 고치는 동안에는 다른 프로세스가 읽으면 안 된다. (한 프로세스가 만들고, 나머지는 읽기만 하는 용도)
+// - 반복자는 이 프로세스의 주소를 담으므로 다른 프로세스에 넘길 수 없다.
+
+//------------------     node     ------------------//
+
+// 모양은 _Rb_tree_node_base와 같고, 부모와 자식을 offset_ptr에 담는다. 색은 따로 둔다.
+struct _Offset_rb_tree_node_base
+{
+  typedef _Rb_tree_Color_type _Color_type;
+  typedef _Offset_rb_tree_node_base* _Base_ptr;
+  typedef offset_ptr<_Offset_rb_tree_node_base> _Link;
+
+  _Link _M_parent;
+  _Link _M_left;
+  _Link _M_right;
+  _Color_type _M_color;
+
+  _Base_ptr _M_get_parent() const { return _M_parent; }
+  void _M_set_parent(_Base_ptr __p) { _M_parent = __p; }
+  _Color_type _M_get_color() const { return _M_color; }
+  void _M_set_color(_Color_type __c) { _M_color = __c; }
+  _Link& _M_parent_slot() { return _M_parent; }
+
+  static _Base_ptr _S_minimum(_Base_ptr __x)
+  {
+    while (__x->_M_left != 0) __x = __x->_M_left;
+    return __x;
+  }
+
+  static _Base_ptr _S_maximum(_Base_ptr __x)
+  {
+    while (__x->_M_right != 0) __x = __x->_M_right;
+    return __x;
+  }
+};
+
+template <typename _Value>
+struct _Offset_rb_tree_node : public _Offset_rb_tree_node_base
+{
+  _Value _M_value_field;
+};
+
+// 서브트리 크기는 저장하지 않는다. (세그먼트의 모양이 매크로에 따라 바뀌지 않도록)
+inline void _Rb_tree_reset_size(_Offset_rb_tree_node_base*) {}
+inline void _Rb_tree_add_size_to_path(_Offset_rb_tree_node_base*, _Offset_rb_tree_node_base*, std::ptrdiff_t) {}
+
+typedef _Rb_tree_algorithms<_Offset_rb_tree_node_base, _Offset_rb_tree_node_base::_Link>
+  _Offset_rb_tree_algorithms;
+
+//------------------     iterator     ------------------//
+
+template <typename _Value, typename _Reference, typename _Pointer>
+struct _Offset_rb_tree_iterator
+{
+  typedef std::bidirectional_iterator_tag iterator_category;
+  typedef std::ptrdiff_t difference_type;
+  typedef _Value value_type;
+  typedef _Reference reference;
+  typedef _Pointer pointer;
+  typedef _Offset_rb_tree_iterator<_Value, _Value&, _Value*> iterator;
+  typedef _Offset_rb_tree_iterator<_Value, const _Value&, const _Value*> const_iterator;
+  typedef _Offset_rb_tree_iterator<_Value, _Reference, _Pointer> _Self;
+  typedef _Offset_rb_tree_node_base* _Base_ptr;
+  typedef _Offset_rb_tree_node<_Value>* _Link_type;
+
+  _Base_ptr _M_node; // 이 프로세스의 주소
+
+  _Offset_rb_tree_iterator() : _M_node(0) {}
+  explicit _Offset_rb_tree_iterator(_Base_ptr __x) : _M_node(__x) {}
+  _Offset_rb_tree_iterator(const iterator& __it) : _M_node(__it._M_node) {}
+
+  reference operator*() const { return static_cast<_Link_type>(_M_node)->_M_value_field; }
+  pointer operator->() const { return &(operator*()); }
+
+  _Self& operator++() { _M_node = _Offset_rb_tree_algorithms::_S_increment(_M_node); return *this; }
+  _Self operator++(int) {
+    _Self __tmp = *this;
+    ++*this;
+    return __tmp;
+  }
+
+  _Self& operator--() { _M_node = _Offset_rb_tree_algorithms::_S_decrement(_M_node); return *this; }
+  _Self operator--(int) {
+    _Self __tmp = *this;
+    --*this;
+    return __tmp;
+  }
+
+  // iterator와 const_iterator를 섞어 비교할 때는 iterator 쪽이 const_iterator로 바뀐다.
+  friend bool operator==(const _Self& __x, const _Self& __y) { return __x._M_node == __y._M_node; }
+  friend bool operator!=(const _Self& __x, const _Self& __y) { return __x._M_node != __y._M_node; }
+};
+
+//------------------     offset_map     ------------------//
+
+template <
+  typename _KeyType,
+  typename _MappedType,
+  typename _KeyCompare = std::less<_KeyType>
+> class offset_map {
+public:
+  typedef _KeyType key_type;
+  typedef _MappedType data_type;
+  typedef _MappedType mapped_type;
+  typedef pair<const _KeyType, _MappedType> value_type;
+  typedef _KeyCompare key_compare;
+  typedef shm_allocator<value_type> allocator_type;
+
+  class value_compare
+  {
+  friend class offset_map<_KeyType, _MappedType, _KeyCompare>;
+
+  protected :
+    _KeyCompare comp;
+    value_compare(_KeyCompare __c) : comp(__c) {}
+  public:
+    bool operator()(const value_type& __x, const value_type& __y) const {
+      return comp(__x.first, __y.first);
+    }
+  };
+
+  typedef value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef _Offset_rb_tree_iterator<value_type, reference, pointer> iterator;
+  typedef _Offset_rb_tree_iterator<value_type, const_reference, const_pointer> const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+private:
+  typedef _Offset_rb_tree_node_base _Node_base;
+  typedef _Offset_rb_tree_node<value_type> _Node;
+  typedef _Node_base* _Base_ptr;
+  typedef const _Node_base* _Const_Base_ptr;
+  typedef shm_allocator<_Node> _Node_allocator;
+
+  _Node_base _M_header; // _Rb_tree의 header와 같다. (부모 자리에 root, 왼쪽에 leftmost, 오른쪽에 rightmost)
+  size_type _M_node_count;
+  _KeyCompare _M_key_compare;
+  _Node_allocator _M_node_allocator;
+
+  // 세그먼트 안에 하나만 두는 객체다.
+  offset_map(const offset_map&);
+  offset_map& operator=(const offset_map&);
+
+  static const _KeyType& _S_key(_Const_Base_ptr __x)
+    { return static_cast<const _Node*>(__x)->_M_value_field.first; }
+
+  _Base_ptr _M_end() const { return const_cast<_Base_ptr>(&_M_header); }
+  _Base_ptr _M_root() const { return _M_header._M_get_parent(); }
+
+  void _M_reset() {
+    _M_header._M_set_color(_S_rb_tree_red);
+    _M_header._M_set_parent(0);
+    _M_header._M_left = &_M_header;
+    _M_header._M_right = &_M_header;
+    _M_node_count = 0;
+  }
+
+  _Node* _M_create_node(const value_type& __v) {
+    _Node* __tmp = _M_node_allocator.allocate(1);
+    try {
+      ft::_Construct(&__tmp->_M_value_field, __v);
+    }
+    catch (...) {
+      _M_node_allocator.deallocate(__tmp, 1);
+      throw;
+    }
+    return __tmp;
+  }
+
+  void _M_destroy_node(_Base_ptr __x) {
+    _Node* __p = static_cast<_Node*>(__x);
+    __p->_M_value_field.~value_type();
+    _M_node_allocator.deallocate(__p, 1);
+  }
+
+  // _M_erase() : __x를 root로 하는 서브트리를 rebalance 없이 모두 지운다.
+  void _M_erase(_Base_ptr __x) {
+    while (__x != 0) {
+      _M_erase(__x->_M_right);
+      _Base_ptr __y = __x->_M_left;
+      _M_destroy_node(__x);
+      __x = __y;
+    }
+  }
+
+  _Base_ptr _M_lower_bound(const key_type& __k) const {
+    _Base_ptr __y = _M_end();
+    _Base_ptr __x = _M_root();
+    while (__x != 0)
+      if (!_M_key_compare(_S_key(__x), __k))
+        __y = __x, __x = __x->_M_left;
+      else
+        __x = __x->_M_right;
+    return __y;
+  }
+
+  _Base_ptr _M_upper_bound(const key_type& __k) const {
+    _Base_ptr __y = _M_end();
+    _Base_ptr __x = _M_root();
+    while (__x != 0)
+      if (_M_key_compare(__k, _S_key(__x)))
+        __y = __x, __x = __x->_M_left;
+      else
+        __x = __x->_M_right;
+    return __y;
+  }
+
+  _Base_ptr _M_find(const key_type& __k) const {
+    _Base_ptr __j = _M_lower_bound(__k);
+    if (__j == _M_end() || _M_key_compare(__k, _S_key(__j)))
+      return _M_end();
+    return __j;
+  }
+
+  // _M_insert_node() : __z를 __y의 자식으로 걸고 rebalance한다. (_Rb_tree::_M_insert_node()와 같다.)
+  iterator _M_insert_node(_Base_ptr __y, bool __left, _Base_ptr __z) {
+    if (__y == _M_end()) {
+      _M_header._M_left = __z;
+      _M_header._M_set_parent(__z);
+      _M_header._M_right = __z;
+    }
+    else if (__left) {
+      __y->_M_left = __z;
+      if (__y == _M_header._M_left)
+        _M_header._M_left = __z;
+    }
+    else {
+      __y->_M_right = __z;
+      if (__y == _M_header._M_right)
+        _M_header._M_right = __z;
+    }
+    __z->_M_set_parent(__y);
+    __z->_M_left = 0;
+    __z->_M_right = 0;
+    _Offset_rb_tree_algorithms::_S_rebalance_for_insert(__z, _M_header._M_parent_slot());
+    ++_M_node_count;
+    return iterator(__z);
+  }
+
+  // _M_fix_header() : swap() 뒤에 root와 header를 다시 잇는다.
+  void _M_fix_header() {
+    if (_M_node_count == 0)
+      _M_reset();
+    else
+      _M_root()->_M_set_parent(&_M_header);
+  }
+
+public:
+  // allocation/deallocation
+  // 보통은 shm_segment::find_or_construct()가 shm_allocator<char>를 넘겨 만든다.
+
+  explicit offset_map(const allocator_type& __a, const _KeyCompare& __comp = _KeyCompare())
+    : _M_node_count(0), _M_key_compare(__comp), _M_node_allocator(__a) { _M_reset(); }
+
+  ~offset_map() { clear(); }
+
+  // accessors:
+
+  key_compare key_comp() const { return _M_key_compare; }
+  value_compare value_comp() const { return value_compare(_M_key_compare); }
+  allocator_type get_allocator() const { return allocator_type(_M_node_allocator); }
+
+  iterator begin() { return iterator(_M_header._M_left); }
+  const_iterator begin() const { return const_iterator(_M_header._M_left); }
+  iterator end() { return iterator(_M_end()); }
+  const_iterator end() const { return const_iterator(_M_end()); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+  bool empty() const { return _M_node_count == 0; }
+  size_type size() const { return _M_node_count; }
+  size_type max_size() const { return _M_node_allocator.max_size(); }
+
+  // opearator[] :
+  // 키가 없으면 기본값으로 넣는다.
+  _MappedType& operator[](const key_type& __k) {
+    iterator __i = lower_bound(__k);
+    if (__i == end() || key_comp()(__k, (*__i).first))
+      __i = insert(value_type(__k, _MappedType())).first;
+    return (*__i).second;
+  }
+
+  // at():
+  // 해당 키의 값. 키가 없으면 std::out_of_range를 던진다.
+  _MappedType& at(const key_type& __k) {
+    iterator __i = find(__k);
+    if (__i == end())
+      throw std::out_of_range("offset_map");
+    return (*__i).second;
+  }
+  const _MappedType& at(const key_type& __k) const {
+    const_iterator __i = find(__k);
+    if (__i == end())
+      throw std::out_of_range("offset_map");
+    return (*__i).second;
+  }
+
+  // swap() :
+  // 같은 세그먼트 안의 offset_map끼리만 바꿀 수 있다.
+  void swap(offset_map& __x) {
+    std::swap(_M_header, __x._M_header);
+    std::swap(_M_node_count, __x._M_node_count);
+    std::swap(_M_key_compare, __x._M_key_compare);
+    _M_fix_header();
+    __x._M_fix_header();
+  }
+
+  // insert() :
+  // 1. 단일요소
+  pair<iterator, bool> insert(const value_type& __v) {
+    _Base_ptr __y = _M_end();
+    _Base_ptr __x = _M_root();
+    bool __comp = true;
+    while (__x != 0) {
+      __y = __x;
+      __comp = _M_key_compare(__v.first, _S_key(__x));
+      __x = __comp ? __x->_M_left : __x->_M_right;
+    }
+    iterator __j(__y);
+    if (__comp) { // __y의 왼쪽에 들어갈 때는 바로 앞 요소와 비교한다.
+      if (__j == begin())
+        return pair<iterator, bool>(_M_insert_node(__y, true, _M_create_node(__v)), true);
+      --__j;
+    }
+    if (_M_key_compare(_S_key(__j._M_node), __v.first))
+      return pair<iterator, bool>(_M_insert_node(__y, __comp, _M_create_node(__v)), true);
+    return pair<iterator, bool>(__j, false);
+  }
+
+  // 2. 범위
+  template <class _InputIterator>
+  void insert(_InputIterator __first, _InputIterator __last) {
+    for ( ; __first != __last; ++__first)
+      insert(*__first);
+  }
+
+  // erase() :
+  // 1. 단일 요소 (반복자로)
+  void erase(iterator __position) {
+    _Base_ptr __y = _Offset_rb_tree_algorithms::_S_rebalance_for_erase(
+      __position._M_node, _M_header._M_parent_slot(), _M_header._M_left, _M_header._M_right);
+    _M_destroy_node(__y);
+    --_M_node_count;
+  }
+
+  // 2. 키로
+  // 지운 요소의 개수(0 또는 1)를 반환한다.
+  size_type erase(const key_type& __k) {
+    _Base_ptr __x = _M_find(__k);
+    if (__x == _M_end())
+      return 0;
+    erase(iterator(__x));
+    return 1;
+  }
+
+  // 3. 범위
+  void erase(iterator __first, iterator __last) {
+    if (__first == begin() && __last == end())
+      clear();
+    else
+      while (__first != __last)
+        erase(__first++);
+  }
+
+  void clear() {
+    _M_erase(_M_root());
+    _M_reset();
+  }
+
+  // map operations:
+
+  iterator find(const key_type& __k) { return iterator(_M_find(__k)); }
+  const_iterator find(const key_type& __k) const { return const_iterator(_M_find(__k)); }
+
+  // count() : 1과 0 중에서만 반환한다.
+  size_type count(const key_type& __k) const { return _M_find(__k) == _M_end() ? 0 : 1; }
+
+  iterator lower_bound(const key_type& __k) { return iterator(_M_lower_bound(__k)); }
+  const_iterator lower_bound(const key_type& __k) const { return const_iterator(_M_lower_bound(__k)); }
+  iterator upper_bound(const key_type& __k) { return iterator(_M_upper_bound(__k)); }
+  const_iterator upper_bound(const key_type& __k) const { return const_iterator(_M_upper_bound(__k)); }
+
+  pair<iterator, iterator> equal_range(const key_type& __k) {
+    return pair<iterator, iterator>(lower_bound(__k), upper_bound(__k));
+  }
+  pair<const_iterator, const_iterator> equal_range(const key_type& __k) const {
+    return pair<const_iterator, const_iterator>(lower_bound(__k), upper_bound(__k));
+  }
+};
+
+template <class _Key, class _MappedType, class _KeyCompare>
+bool operator==(const offset_map<_Key,_MappedType,_KeyCompare>& __x,
+                const offset_map<_Key,_MappedType,_KeyCompare>& __y) {
+  return __x.size() == __y.size() && ft::equal(__x.begin(), __x.end(), __y.begin());
+}
+
+template <class _Key, class _MappedType, class _KeyCompare>
+bool operator<(const offset_map<_Key,_MappedType,_KeyCompare>& __x,
+               const offset_map<_Key,_MappedType,_KeyCompare>& __y) {
+  return ft::lexicographical_compare(__x.begin(), __x.end(), __y.begin(), __y.end());
+}
+
+template <class _Key, class _MappedType, class _KeyCompare>
+bool operator!=(const offset_map<_Key,_MappedType,_KeyCompare>& __x,
+                const offset_map<_Key,_MappedType,_KeyCompare>& __y) {
+  return !(__x == __y);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare>
+bool operator>(const offset_map<_Key,_MappedType,_KeyCompare>& __x,
+               const offset_map<_Key,_MappedType,_KeyCompare>& __y) {
+  return __y < __x;
+}
+
+template <class _Key, class _MappedType, class _KeyCompare>
+bool operator<=(const offset_map<_Key,_MappedType,_KeyCompare>& __x,
+                const offset_map<_Key,_MappedType,_KeyCompare>& __y) {
+  return !(__y < __x);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare>
+bool operator>=(const offset_map<_Key,_MappedType,_KeyCompare>& __x,
+                const offset_map<_Key,_MappedType,_KeyCompare>& __y) {
+  return !(__x < __y);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare>
+void swap(offset_map<_Key,_MappedType,_KeyCompare>& __x,
+          offset_map<_Key,_MappedType,_KeyCompare>& __y) {
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 :
+template <class _Key, class _MappedType, class _KeyCompare>
+struct has_cheap_swap<offset_map<_Key,_MappedType,_KeyCompare> > : public true_type {};
+
+} // namespace ft
+
+#endif /* OFFSET_MAP_HPP */
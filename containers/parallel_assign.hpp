@@ -0,0 +1,203 @@
+#ifndef PARALLEL_ASSIGN_HPP
+#define PARALLEL_ASSIGN_HPP
+
+#include <cstddef>
+  // size_t
+
+#include <pthread.h>
+  // pthread_create(), pthread_join(): 스레드를 쓰므로 -pthread로 링크해야 한다.
+
+#include "map.hpp"
+  // ft::map, ft::_Rb_tree
+
+namespace ft
+{
+
+// 여러 스레드로 나누어 하는 트리 복사 (ft 확장)
+// pthread에 의존하므로 tree.hpp, map.hpp와 따로 둔다. 쓸 때만 이 헤더를 포함한다.
+
+// _Rb_tree_parallel_copy :
+// _Rb_tree의 friend. 트리의 내부(_S_copy(), _M_clone_node(), header)를 직접 써서 복사를 나누어 맡긴다.
+template <class _Tree>
+struct _Rb_tree_parallel_copy
+{
+  typedef typename _Tree::_Link_type _Link_type;
+  typedef typename _Tree::_Base_ptr _Base_ptr;
+  typedef typename _Tree::size_type size_type;
+  typedef typename _Tree::_Node_allocator _Node_allocator;
+  typedef typename _Tree::_Node_alloc_traits _Node_alloc_traits;
+
+  // 스레드에 나누어 맡기는 일. __src 서브트리의 복사본을 __parent 아래의 *__slot에 단다.
+  struct _Copy_task {
+    _Link_type _M_src;
+    _Link_type _M_parent;
+    _Base_ptr* _M_slot;
+  };
+
+  // 스레드 하나. 공유하는 __next에서 일을 하나씩 가져간다.
+  struct _Copy_worker {
+    _Copy_task* _M_tasks;
+    size_type _M_task_count;
+    size_type* _M_next;
+    _Node_allocator _M_arena;
+    bool _M_failed;
+    pthread_t _M_thread;
+  };
+
+  enum {
+    _S_copy_max_threads = 64,
+    _S_copy_tasks_per_thread = 4, // 서브트리의 크기가 고르지 않으므로, 스레드마다 일을 몇 개씩 나누어 둔다.
+    _S_copy_min_per_thread = 1 << 14 // 스레드 하나가 이보다 적게 복사하게 되면 스레드를 줄인다.
+  };
+
+  static void _S_copy_top(_Tree& __t, _Link_type __x, _Link_type __top, size_type __depth, size_type __cut,
+                          _Copy_task* __tasks, size_type& __n);
+  static void* _S_copy_worker(void* __arg);
+  static void _S_assign(_Tree& __t, const _Tree& __x, unsigned __threads);
+};
+
+// _S_copy_top() :
+// __x를 복제한 __top(이미 제자리에 달려 있다) 아래를 깊이 __cut 전까지 복제한다.
+// 깊이 __cut의 서브트리는 복제하지 않고, 어디에 달아야 하는지와 함께 __tasks에 적어 둔다.
+// 달기 전에는 자식 포인터가 0이므로, 도중에 예외가 나도 _M_clear(_M_begin())로 지울 수 있다.
+template <class _Tree>
+void _Rb_tree_parallel_copy<_Tree>
+  ::_S_copy_top(_Tree& __t, _Link_type __x, _Link_type __top, size_type __depth, size_type __cut,
+                _Copy_task* __tasks, size_type& __n)
+{
+  _Link_type __src[2] = { _Tree::_S_left(__x), _Tree::_S_right(__x) };
+  _Base_ptr* __slot[2] = { &__top->_M_left, &__top->_M_right };
+  for (int __i = 0; __i < 2; ++__i) {
+    if (__src[__i] == 0)
+      continue;
+    if (__depth + 1 == __cut) {
+      __tasks[__n]._M_src = __src[__i];
+      __tasks[__n]._M_parent = __top;
+      __tasks[__n]._M_slot = __slot[__i];
+      ++__n;
+    }
+    else {
+      _Link_type __y = __t._M_clone_node(__src[__i]);
+      __y->_M_set_parent(__top);
+      *__slot[__i] = __y;
+      _S_copy_top(__t, __src[__i], __y, __depth + 1, __cut, __tasks, __n);
+    }
+  }
+}
+
+// _S_copy_worker() :
+// 남은 일이 없을 때까지 하나씩 가져가서 자기 arena로 복사한다.
+// 예외가 나면 그 일의 부분 복사본은 _S_copy()가 지우고, 실패했다고 적고 멈춘다.
+template <class _Tree>
+void* _Rb_tree_parallel_copy<_Tree>::_S_copy_worker(void* __arg)
+{
+  _Copy_worker* __w = static_cast<_Copy_worker*>(__arg);
+  for (;;) {
+    size_type __i = __atomic_fetch_add(__w->_M_next, 1, __ATOMIC_RELAXED);
+    if (__i >= __w->_M_task_count)
+      break;
+    _Copy_task& __t = __w->_M_tasks[__i];
+    try {
+      *__t._M_slot = _Tree::_S_copy(__w->_M_arena, __t._M_src, __t._M_parent);
+    }
+    catch(...)
+    {
+      __w->_M_failed = true;
+      break;
+    }
+  }
+  return 0;
+}
+
+// _S_assign() :
+// 1. 스레드마다 일이 _S_copy_tasks_per_thread개 정도 되도록 자를 깊이를 정하고, 그 위를 이 스레드가 복제한다.
+// 2. 스레드를 띄우고, 이 스레드도 함께 일을 가져간다. (스레드를 띄우지 못하면 남은 스레드가 그만큼 더 한다.)
+// 3. 모두 끝나면 arena를 이 트리의 할당기로 합친다. 이제 모든 노드를 이 트리가 해제할 수 있다.
+// 4. 어느 스레드에서든 예외가 났다면, 만든 것을 모두 지우고 이 스레드에서 직렬로 다시 복사한다.
+//    (스레드에서 난 예외를 그대로 옮길 수 없기 때문이다. 같은 예외가 다시 나면 operator=처럼 그 예외가 나간다.)
+template <class _Tree>
+void _Rb_tree_parallel_copy<_Tree>::_S_assign(_Tree& __t, const _Tree& __x, unsigned __threads)
+{
+  if (&__t == &__x)
+    return;
+  if (__threads > unsigned(_S_copy_max_threads))
+    __threads = _S_copy_max_threads;
+  while (__threads > 1 && __x._M_node_count / __threads < size_type(_S_copy_min_per_thread))
+    --__threads;
+  if (__threads <= 1) {
+    __t = __x;
+    return;
+  }
+
+  __t.clear();
+  __t._M_key_compare = __x._M_key_compare;
+
+  // 깊이 __cut에는 노드가 2^__cut개까지 있다.
+  size_type __cut = 0;
+  while ((size_type(1) << __cut) < size_type(__threads) * _S_copy_tasks_per_thread)
+    ++__cut;
+  _Copy_task __tasks[_S_copy_max_threads * _S_copy_tasks_per_thread * 2];
+  size_type __n = 0;
+  try {
+    __t._M_root() = __t._M_clone_node(__x._M_begin());
+    __t._M_root()->_M_set_parent(__t._M_header);
+    _S_copy_top(__t, __x._M_begin(), __t._M_begin(), 0, __cut, __tasks, __n);
+  }
+  catch(...)
+  {
+    __t._M_clear(__t._M_begin());
+    __t._M_empty_initialize();
+    throw;
+  }
+
+  // __workers[0]은 이 스레드다. 트리의 할당기(의 복사본)를 그대로 쓴다. 다른 스레드는 그동안 그 할당기를 건드리지 않는다.
+  size_type __next = 0;
+  _Copy_worker __workers[_S_copy_max_threads];
+  unsigned __started = 1;
+  for (unsigned __i = 0; __i < __threads; ++__i) {
+    __workers[__i]._M_tasks = __tasks;
+    __workers[__i]._M_task_count = __n;
+    __workers[__i]._M_next = &__next;
+    __workers[__i]._M_failed = false;
+    __workers[__i]._M_arena = __i == 0 ? __t._M_node_allocator
+                                       : _Node_alloc_traits::_S_arena(__t._M_node_allocator);
+  }
+  for (; __started < __threads; ++__started)
+    if (pthread_create(&__workers[__started]._M_thread, 0, _S_copy_worker, &__workers[__started]) != 0)
+      break;
+  _S_copy_worker(&__workers[0]);
+  bool __failed = __workers[0]._M_failed;
+  for (unsigned __i = 1; __i < __started; ++__i) {
+    pthread_join(__workers[__i]._M_thread, 0);
+    _Node_alloc_traits::_S_adopt(__t._M_node_allocator, __workers[__i]._M_arena);
+    __failed = __failed || __workers[__i]._M_failed;
+  }
+
+  if (__failed) {
+    __t._M_clear(__t._M_begin());
+    __t._M_empty_initialize();
+    __t = __x;
+    return;
+  }
+  __t._M_leftmost() = _Tree::_S_minimum(__t._M_begin());
+  __t._M_rightmost() = _Tree::_S_maximum(__t._M_begin());
+  __t._M_node_count = __x._M_node_count;
+}
+
+// parallel_assign() :
+// __dst = __src와 같지만, 큰 map을 __threads개의 스레드로 나누어 복사한다.
+// 위쪽 몇 단계는 이 스레드가 복사하고, 그 아래의 서브트리들을 스레드들이 나누어 복사한 뒤 제자리에 단다.
+// 노드를 그대로 복제하므로 모양과 색, leftmost, rightmost는 operator=로 복사한 것과 같다.
+// 스레드 하나가 맡을 노드가 적으면 스레드를 줄인다. (1개가 되면 그냥 operator=다.)
+// 할당기가 스레드에 안전하지 않으면(slab_allocator) 스레드마다 따로 할당하고(_S_arena), 끝나면 합친다(_S_adopt).
+// 복사하는 동안 __src를 고치면 안 된다.
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+void parallel_assign(map<_Key,_MappedType,_KeyCompare,_Alloc>& __dst,
+                     const map<_Key,_MappedType,_KeyCompare,_Alloc>& __src, unsigned __threads) {
+  typedef typename map<_Key,_MappedType,_KeyCompare,_Alloc>::_Rb_tree_type _Tree;
+  _Rb_tree_parallel_copy<_Tree>::_S_assign(__dst._M_tree, __src._M_tree, __threads);
+}
+
+} // namespace ft
+
+#endif // PARALLEL_ASSIGN_HPP
@@ -0,0 +1,231 @@
+#ifndef PERSISTENT_MAP_HPP
+#define PERSISTENT_MAP_HPP
+
+#include <stdexcept>
+  // std::out_of_range
+
+#include "persistent_tree.hpp"
+  // ft::_Persistent_tree
+
+#include "function.hpp"
+  // ft::_Select1st
+
+#include "type_traits.hpp"
+  // ft::has_cheap_swap
+
+namespace ft
+{
+// persistent_map
+// 스냅샷을 O(1)에 뜰 수 있는 map. 버전끼리 노드를 나누어 쓴다. (persistent_tree.hpp 참고)
+//
+// 복사 생성과 대입, snapshot()은 root 포인터만 복사한다. 그 뒤에 어느 한쪽을 고치면, 바뀌는 자리까지의
+// O(log n)개 노드만 복제하므로 두 버전은 나머지 노드를 계속 함께 쓴다.
+// 다른 버전에 보이는 노드를 고치지 않기 위해 요소는 반복자로 고칠 수 없다. 값을 바꾸려면 insert_or_assign()을 쓴다.
+// 반복자는 persistent_map이 고쳐지면 무효화된다.
+template <
+  typename _KeyType, // 요소를 정렬하고, 고유하게 식별하는 데에 사용된다.
+  typename _MappedType, // 내가 저장하는 실제 데이터
+  typename _KeyCompare = std::less<_KeyType>, // 요소의 순서를 비교하고, 동일한지 결정할 때 사용한다.
+  typename _Alloc = std::allocator<pair<const _KeyType, _MappedType> >
+// 위의 타입들은 그대로 사용되어, 내장된 tree의 타입을 결정한다.
+> class persistent_map {
+public:
+  typedef _KeyType key_type;
+  typedef _MappedType data_type;
+  typedef _MappedType mapped_type;
+  typedef pair<const _KeyType, _MappedType> value_type; // 노드(pair)의 타입
+  typedef _KeyCompare key_compare;
+
+  class value_compare
+  {
+  friend class persistent_map<_KeyType, _MappedType, _KeyCompare, _Alloc>;
+
+  protected :
+    _KeyCompare comp;
+    value_compare(_KeyCompare __c) : comp(__c) {}
+
+  public:
+    bool operator()(const value_type& __x, const value_type& __y) const {
+      return comp(__x.first, __y.first);
+    }
+  };
+
+private:
+  typedef _Persistent_tree<key_type, value_type, _Select1st<value_type>, key_compare, _Alloc>
+    _Tree_type;
+  _Tree_type _M_tree; // 이것이 실제 persistent_map
+public:
+  typedef typename _Tree_type::const_pointer pointer;
+  typedef typename _Tree_type::const_pointer const_pointer;
+  typedef typename _Tree_type::const_reference reference;
+  typedef typename _Tree_type::const_reference const_reference;
+  typedef typename _Tree_type::const_iterator iterator;
+  typedef typename _Tree_type::const_iterator const_iterator;
+  typedef typename _Tree_type::const_reverse_iterator reverse_iterator;
+  typedef typename _Tree_type::const_reverse_iterator const_reverse_iterator;
+  typedef typename _Tree_type::size_type size_type;
+  typedef typename _Tree_type::difference_type difference_type;
+  typedef typename _Tree_type::allocator_type allocator_type;
+
+  // allocation/deallocation
+
+  persistent_map() : _M_tree(_KeyCompare(), allocator_type()) {}
+  explicit persistent_map(const _KeyCompare& __comp,
+                          const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) {}
+
+  template <class _InputIterator>
+  persistent_map(_InputIterator __first, _InputIterator __last)
+    : _M_tree(_KeyCompare(), allocator_type())
+    { _M_tree.insert_unique(__first, __last); }
+
+  template <class _InputIterator>
+  persistent_map(_InputIterator __first, _InputIterator __last, const _KeyCompare& __comp,
+      const allocator_type& __a = allocator_type())
+    : _M_tree(__comp, __a) { _M_tree.insert_unique(__first, __last); }
+
+  // 복사 생성자 : 노드를 복사하지 않고 나누어 가진다. O(1)
+  persistent_map(const persistent_map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x) : _M_tree(__x._M_tree) {}
+
+  persistent_map<_KeyType, _MappedType, _KeyCompare, _Alloc>&
+  operator=(const persistent_map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x)
+  {
+    _M_tree = __x._M_tree;
+    return *this;
+  }
+
+  // snapshot() :
+  // 지금의 내용을 가진 버전. 복사 생성과 같다. 이후에 어느 쪽을 고쳐도 다른 쪽은 변하지 않는다.
+  persistent_map<_KeyType, _MappedType, _KeyCompare, _Alloc> snapshot() const { return *this; }
+
+  // accessors:
+
+  key_compare key_comp() const { return _M_tree.key_comp(); }
+  value_compare value_comp() const { return value_compare(_M_tree.key_comp()); }
+  allocator_type get_allocator() const { return _M_tree.get_allocator(); }
+
+  const_iterator begin() const { return _M_tree.begin(); }
+  const_iterator end() const { return _M_tree.end(); }
+  const_reverse_iterator rbegin() const { return _M_tree.rbegin(); }
+  const_reverse_iterator rend() const { return _M_tree.rend(); }
+  bool empty() const { return _M_tree.empty(); }
+  size_type size() const { return _M_tree.size(); }
+  size_type max_size() const { return _M_tree.max_size(); }
+
+  // at():
+  // 해당 키의 값. 키가 없으면 std::out_of_range를 던진다.
+  // (operator[]는 없다. 나누어 쓰는 노드의 값을 참조로 내어줄 수 없기 때문이다.)
+  const _MappedType& at(const key_type& __k) const {
+    const value_type* __v = _M_tree.find_value(__k);
+    if (__v == 0)
+      throw std::out_of_range("persistent_map");
+    return __v->second;
+  }
+
+  // swap() :
+  void swap(persistent_map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x) { _M_tree.swap(__x._M_tree); }
+
+  // insert() :
+  // 1. 단일요소
+  pair<iterator, bool> insert(const value_type& __x)
+    { return _M_tree.insert_unique(__x); }
+
+  // 2. 범위
+  template <class _InputIterator>
+  void insert(_InputIterator __first, _InputIterator __last) {
+    _M_tree.insert_unique(__first, __last);
+  }
+
+  // insert_or_assign() :
+  // 키가 없으면 넣고, 있으면 값을 __obj로 바꾼다. 새로 넣었으면 true를 반환한다.
+  bool insert_or_assign(const key_type& __k, const _MappedType& __obj)
+    { return _M_tree.insert_or_assign(value_type(__k, __obj)); }
+
+  // erase() :
+  // 1. 단일 요소 (반복자로)
+  void erase(iterator __position)
+    { _M_tree.erase(__position); }
+
+  // 2. 단일 요소 (키로)
+  // 지운 요소의 개수를 반환한다.
+  size_type erase(const key_type& __x)
+    { return _M_tree.erase(__x); }
+
+  void clear() { _M_tree.clear(); }
+
+  // shares_root_with() :
+  // __x와 같은 버전인지. (한쪽이 다른 쪽의 스냅샷이고, 그 뒤로 둘 다 고쳐지지 않았는지)
+  bool shares_root_with(const persistent_map<_KeyType, _MappedType, _KeyCompare, _Alloc>& __x) const
+    { return _M_tree.shares_root_with(__x._M_tree); }
+
+  // map operations:
+
+  const_iterator find(const key_type& __x) const { return _M_tree.find(__x); }
+
+  // count() :
+  // 1과 0 중에서만 반환한다.
+  size_type count(const key_type& __x) const { return _M_tree.count(__x); }
+
+  const_iterator lower_bound(const key_type& __x) const { return _M_tree.lower_bound(__x); }
+  const_iterator upper_bound(const key_type& __x) const { return _M_tree.upper_bound(__x); }
+  pair<const_iterator,const_iterator> equal_range(const key_type& __x) const {
+    return _M_tree.equal_range(__x);
+  }
+
+  template <class _K1, class _T1, class _C1, class _A1>
+  friend bool operator== (const persistent_map<_K1, _T1, _C1, _A1>&,
+                          const persistent_map<_K1, _T1, _C1, _A1>&);
+  template <class _K1, class _T1, class _C1, class _A1>
+  friend bool operator< (const persistent_map<_K1, _T1, _C1, _A1>&,
+                         const persistent_map<_K1, _T1, _C1, _A1>&);
+};
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator==(const persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+                const persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return __x._M_tree == __y._M_tree;
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator<(const persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+               const persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return __x._M_tree < __y._M_tree;
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator!=(const persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+                const persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return !(__x == __y);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator>(const persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+               const persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return __y < __x;
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator<=(const persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+                const persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return !(__y < __x);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+bool operator>=(const persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+                const persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  return !(__x < __y);
+}
+
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+void swap(persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __x,
+          persistent_map<_Key,_MappedType,_KeyCompare,_Alloc>& __y) {
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 :
+template <class _Key, class _MappedType, class _KeyCompare, class _Alloc>
+struct has_cheap_swap<persistent_map<_Key,_MappedType,_KeyCompare,_Alloc> > : public true_type {};
+
+} // namespace ft
+
+#endif /* PERSISTENT_MAP_HPP */
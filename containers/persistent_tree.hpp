@@ -0,0 +1,790 @@
+#ifndef PERSISTENT_TREE_HPP
+#define PERSISTENT_TREE_HPP
+
+#include <cstddef>
+  // size_t, ptrdiff_t
+
+#include <memory>
+  // std::allocator
+
+#include <iterator>
+  // std::bidirectional_iterator_tag
+
+#include <algorithm>
+  // std::swap()
+
+#include "pair.hpp"
+  // ft::pair
+
+#include "iterator.hpp"
+  // ft::reverse_iterator
+
+#include "alloc.hpp"
+  // _Alloc_traits: 요소 할당기를 노드 할당기로 rebind한다.
+
+#include "construct.hpp"
+  // ft::_Construct()
+
+#include "algorithm.hpp"
+  // ft::equal(), ft::lexicographical_compare()
+
+#include "tree.hpp"
+  // _Rb_tree_Color_type, _S_rb_tree_red, _S_rb_tree_black
+
+namespace ft
+{
+
+// _Persistent_tree
+// : persistent_map이 내장하는, 여러 버전이 노드를 나누어 쓰는 red-black tree.
+//
+// _Rb_tree를 복사하면 노드를 모두 복사한다(_M_copy). _Persistent_tree는 노드에 참조 카운트를 두고,
+// 복사할 때 root만 가리키고 카운트를 올린다. 그래서 복사(스냅샷)는 O(1)이고, 두 트리는 모든 노드를 함께 쓴다.
+//
+// - 노드는 부모를 가리키지 않는다. 한 노드가 여러 버전의 여러 부모 아래에 있을 수 있기 때문이다.
+//   그래서 삽입, 삭제는 root에서 내려온 경로를 스택(배열)에 담아 두고, _Rb_tree의 rebalance와 같은 규칙으로
+//   그 경로를 거슬러 올라가며 고친다. 반복자도 같은 이유로 경로를 스택에 담고 다닌다.
+// - 카운트가 1인 노드는 이 트리만 가지고 있으므로 그 자리에서 고친다. 카운트가 2 이상인 노드는 다른 버전과
+//   나누어 쓰는 노드이므로, 고치기 전에 복제해서 부모의 포인터를 복제본으로 바꾼다(_M_unshare).
+//   삽입, 삭제는 root에서 바뀌는 자리까지의 경로와 색을 바꿀 형제 몇 개만 복제하므로 O(log n)개만 새로 만든다.
+//   스냅샷을 뜨지 않았다면 모든 카운트가 1이므로 아무것도 복제하지 않는다.
+// - 나누어 쓰는 노드는 절대 고치지 않으므로, 스냅샷은 그 뒤에 원본을 어떻게 고쳐도 변하지 않는다.
+//   값을 바꾸려면 insert_or_assign()을 쓴다. 그래서 반복자는 모두 const_iterator다.
+// - 참조 카운트는 원자적이지 않다. 같은 노드를 나누어 쓰는 버전들을 서로 다른 스레드에서 고치거나 없애면 안 된다.
+// - 반복자는 자신이 가리키는 트리가 고쳐지면 무효화된다. (고쳐지지 않을 스냅샷을 떠서 순회하면 된다.)
+
+//------------------     node     ------------------//
+
+// red-black tree의 높이는 2 * log2(n + 1)을 넘지 않으므로, size_t로 셀 수 있는 어떤 크기에서도 이 깊이면 충분하다.
+// 경로 스택과 반복자의 스택이 이 크기의 배열이다.
+enum { _S_persistent_tree_max_height = 2 * sizeof(std::size_t) * 8 };
+
+template <typename _Value>
+struct _Persistent_tree_node
+{
+  typedef _Persistent_tree_node<_Value>* _Link_type;
+
+  _Link_type _M_left;
+  _Link_type _M_right;
+  std::size_t _M_refcount; // 이 노드를 가리키는 부모 노드와 root의 수
+  _Rb_tree_Color_type _M_color;
+  _Value _M_value_field;
+};
+
+//------------------     iterator     ------------------//
+
+// root에서 현재 노드까지의 경로를 스택에 담는다. 스택이 비어 있으면 end()다.
+// 노드가 부모를 모르므로, 위로 올라가는 대신 스택에서 꺼낸다. --end()를 위해 root를 따로 기억한다.
+template <typename _Value>
+struct _Persistent_tree_iterator
+{
+  typedef std::bidirectional_iterator_tag iterator_category;
+  typedef _Value value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const _Value& reference;
+  typedef const _Value* pointer;
+
+  typedef _Persistent_tree_iterator<_Value> _Self;
+  typedef const _Persistent_tree_node<_Value>* _Const_link;
+
+  _Const_link _M_root;
+  std::size_t _M_depth;
+  _Const_link _M_stack[_S_persistent_tree_max_height];
+
+  _Persistent_tree_iterator() : _M_root(0), _M_depth(0) {}
+  explicit _Persistent_tree_iterator(_Const_link __root) : _M_root(__root), _M_depth(0) {}
+
+  // 스택은 쓰고 있는 만큼만 복사한다.
+  _Persistent_tree_iterator(const _Self& __x) : _M_root(__x._M_root), _M_depth(__x._M_depth) {
+    for (std::size_t __i = 0; __i < _M_depth; ++__i)
+      _M_stack[__i] = __x._M_stack[__i];
+  }
+
+  _Self& operator=(const _Self& __x) {
+    _M_root = __x._M_root;
+    _M_depth = __x._M_depth;
+    for (std::size_t __i = 0; __i < _M_depth; ++__i)
+      _M_stack[__i] = __x._M_stack[__i];
+    return *this;
+  }
+
+  _Const_link _M_node() const { return _M_depth ? _M_stack[_M_depth - 1] : 0; }
+
+  reference operator*() const { return _M_stack[_M_depth - 1]->_M_value_field; }
+  pointer operator->() const { return &(operator*()); }
+
+  void _M_push_leftmost(_Const_link __x) {
+    for (; __x != 0; __x = __x->_M_left)
+      _M_stack[_M_depth++] = __x;
+  }
+
+  void _M_push_rightmost(_Const_link __x) {
+    for (; __x != 0; __x = __x->_M_right)
+      _M_stack[_M_depth++] = __x;
+  }
+
+  // 오른쪽 서브트리가 있으면 그 leftmost로 내려가고,
+  // 없으면 왼쪽 자식에서 올라오는 조상을 만날 때까지 스택에서 꺼낸다. 그런 조상이 없으면 end()가 된다.
+  _Self& operator++() {
+    _Const_link __x = _M_stack[_M_depth - 1];
+    if (__x->_M_right != 0)
+      _M_push_leftmost(__x->_M_right);
+    else {
+      do
+        __x = _M_stack[--_M_depth];
+      while (_M_depth != 0 && _M_stack[_M_depth - 1]->_M_right == __x);
+    }
+    return *this;
+  }
+  _Self operator++(int) { _Self __tmp = *this; ++*this; return __tmp; }
+
+  // end()에서는 rightmost로 간다.
+  _Self& operator--() {
+    if (_M_depth == 0) {
+      _M_push_rightmost(_M_root);
+      return *this;
+    }
+    _Const_link __x = _M_stack[_M_depth - 1];
+    if (__x->_M_left != 0)
+      _M_push_rightmost(__x->_M_left);
+    else {
+      do
+        __x = _M_stack[--_M_depth];
+      while (_M_depth != 0 && _M_stack[_M_depth - 1]->_M_left == __x);
+    }
+    return *this;
+  }
+  _Self operator--(int) { _Self __tmp = *this; --*this; return __tmp; }
+};
+
+template <class _Value>
+bool operator==(const _Persistent_tree_iterator<_Value>& __x,
+                const _Persistent_tree_iterator<_Value>& __y)
+{ return __x._M_node() == __y._M_node(); }
+
+template <class _Value>
+bool operator!=(const _Persistent_tree_iterator<_Value>& __x,
+                const _Persistent_tree_iterator<_Value>& __y)
+{ return !(__x == __y); }
+
+//------------------     Persistent tree     ------------------//
+
+template <typename _Key, typename _Value, typename _GetKeyOfValue, typename _Compare, typename _Alloc = std::allocator<_Value> >
+class _Persistent_tree {
+
+public:
+  typedef _Key key_type;
+  typedef _Value value_type;
+  typedef const value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef const value_type& reference;
+  typedef const value_type& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  typedef typename _Alloc_traits<_Value, _Alloc>::allocator_type allocator_type;
+
+  typedef _Persistent_tree_iterator<value_type> const_iterator;
+  typedef const_iterator iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef const_reverse_iterator reverse_iterator;
+
+private:
+  typedef _Persistent_tree_node<_Value> _Node;
+  typedef _Node* _Link_type;
+  typedef const _Node* _Const_link;
+
+  // 삭제의 case 1(형제가 red)에서 경로에 노드가 하나 끼어들므로 한 칸 더 둔다.
+  enum { _S_path_size = _S_persistent_tree_max_height + 1 };
+
+  typename _Alloc_traits<_Node, _Alloc>::allocator_type _M_node_allocator;
+
+  _Link_type _M_root;
+  size_type _M_node_count; // 요소 수
+  _Compare _M_key_compare;
+
+                                // 노드 할당/해제
+
+  _Link_type _M_create_node(const value_type& __v) {
+    _Link_type __x = _M_node_allocator.allocate(1);
+    try {
+      ft::_Construct(&__x->_M_value_field, __v);
+    }
+    catch(...)
+    {
+  _M_node_allocator.deallocate(__x, 1);
+  throw;
+    }
+    __x->_M_left = __x->_M_right = 0;
+    __x->_M_refcount = 1;
+    __x->_M_color = _S_rb_tree_red;
+    return __x;
+  }
+
+  // 값과 색, 자식을 그대로 가진 새 노드. 자식은 이제 부모가 하나 더 생긴다.
+  _Link_type _M_clone_node(_Const_link __x) {
+    _Link_type __tmp = _M_create_node(__x->_M_value_field);
+    __tmp->_M_color = __x->_M_color;
+    __tmp->_M_left = _S_retain(__x->_M_left);
+    __tmp->_M_right = _S_retain(__x->_M_right);
+    return __tmp;
+  }
+
+  static _Link_type _S_retain(_Link_type __x) {
+    if (__x != 0)
+      ++__x->_M_refcount;
+    return __x;
+  }
+
+  // 카운트를 내리고, 아무도 가리키지 않게 되면 지운다. 자식도 그렇게 내려간다.
+  // (오른쪽은 반복으로 내려가므로 재귀의 깊이는 트리의 높이를 넘지 않는다.)
+  void _M_release(_Link_type __x) {
+    while (__x != 0 && --__x->_M_refcount == 0) {
+      _M_release(__x->_M_left);
+      _Link_type __y = __x->_M_right;
+      __x->_M_value_field.~_Value();
+      _M_node_allocator.deallocate(__x, 1);
+      __x = __y;
+    }
+  }
+
+  // _M_unshare() :
+  // __slot이 가리키는 노드를 이 트리만 가지게 한다. 나누어 쓰는 노드면 복제본으로 바꾸어 단다.
+  // 트리의 내용은 그대로이므로 언제 해도 안전하다. 예외가 나면 __slot은 그대로다.
+  // (__slot은 root이거나, 이미 이 트리만 가지고 있는 노드의 자식 포인터여야 한다.)
+  _Link_type _M_unshare(_Link_type& __slot) {
+    _Link_type __x = __slot;
+    if (__x != 0 && __x->_M_refcount > 1) {
+      __slot = _M_clone_node(__x);
+      --__x->_M_refcount;
+    }
+    return __slot;
+  }
+
+                                // 기타 도우미
+
+  static const _Key& _S_key(_Const_link __x) { return _GetKeyOfValue()(__x->_M_value_field); }
+  static bool _S_is_black(_Const_link __x) { return __x == 0 || __x->_M_color == _S_rb_tree_black; }
+
+  // __path[__i]를 가리키는 포인터. (부모의 자식 포인터, 혹은 root)
+  _Link_type& _M_slot(_Link_type* __path, size_type __i) {
+    if (__i == 0)
+      return _M_root;
+    _Link_type __p = __path[__i - 1];
+    return __p->_M_left == __path[__i] ? __p->_M_left : __p->_M_right;
+  }
+
+  // 회전 : __slot에 달린 노드를 내리고 그 자식을 올린다. 두 노드 모두 이 트리만 가진 노드여야 한다.
+  static void _S_rotate_left(_Link_type& __slot) {
+    _Link_type __x = __slot;
+    _Link_type __y = __x->_M_right;
+    __x->_M_right = __y->_M_left;
+    __y->_M_left = __x;
+    __slot = __y;
+  }
+
+  static void _S_rotate_right(_Link_type& __slot) {
+    _Link_type __x = __slot;
+    _Link_type __y = __x->_M_left;
+    __x->_M_left = __y->_M_right;
+    __y->_M_right = __x;
+    __slot = __y;
+  }
+
+  _Link_type _M_find_node(const key_type& __k) const;
+  const_iterator _M_make_iterator(const key_type& __k, bool __upper) const;
+
+  void _M_prepare_insert_fixup(_Link_type* __path, size_type __i);
+  void _M_insert_fixup(_Link_type* __path, size_type __i);
+  void _M_prepare_erase_fixup(_Link_type* __path, size_type __d, size_type __e);
+  void _M_erase_fixup(_Link_type* __path, size_type __k, _Link_type __x);
+  void _M_unshare_near(_Link_type& __slot, int __levels);
+
+public:
+                                // allocation/deallocation
+  _Persistent_tree()
+    : _M_node_allocator(allocator_type()), _M_root(0), _M_node_count(0), _M_key_compare() {}
+
+  _Persistent_tree(const _Compare& __comp)
+    : _M_node_allocator(allocator_type()), _M_root(0), _M_node_count(0), _M_key_compare(__comp) {}
+
+  _Persistent_tree(const _Compare& __comp, const allocator_type& __a)
+    : _M_node_allocator(__a), _M_root(0), _M_node_count(0), _M_key_compare(__comp) {}
+
+  // 복사 생성자 : root를 나누어 가진다. O(1)
+  _Persistent_tree(const _Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __x)
+    : _M_node_allocator(__x._M_node_allocator), _M_root(_S_retain(__x._M_root)),
+      _M_node_count(__x._M_node_count), _M_key_compare(__x._M_key_compare) {}
+
+  ~_Persistent_tree() { _M_release(_M_root); }
+
+  // 대입 : 역시 root만 바꾸어 단다. 자기 자신을 대입해도 먼저 카운트를 올리므로 안전하다.
+  _Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>&
+  operator=(const _Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __x) {
+    _Link_type __root = _S_retain(__x._M_root);
+    _M_release(_M_root);
+    _M_root = __root;
+    _M_node_count = __x._M_node_count;
+    _M_key_compare = __x._M_key_compare;
+    _M_node_allocator = __x._M_node_allocator;
+    return *this;
+  }
+
+                                // accessors
+  _Compare key_comp() const { return _M_key_compare; }
+  allocator_type get_allocator() const { return allocator_type(_M_node_allocator); }
+
+  const_iterator begin() const {
+    const_iterator __it(_M_root);
+    __it._M_push_leftmost(_M_root);
+    return __it;
+  }
+  const_iterator end() const { return const_iterator(_M_root); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+  bool empty() const { return _M_node_count == 0; }
+  size_type size() const { return _M_node_count; }
+  size_type max_size() const { return _M_node_allocator.max_size(); }
+
+  // 두 트리가 같은 root를 나누어 가지는지. (스냅샷을 뜬 뒤 어느 쪽도 고치지 않았는지)
+  bool shares_root_with(const _Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __x) const
+    { return _M_root == __x._M_root; }
+
+  void swap(_Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __t) {
+    std::swap(_M_root, __t._M_root);
+    std::swap(_M_node_count, __t._M_node_count);
+    std::swap(_M_key_compare, __t._M_key_compare);
+    _Alloc_traits<_Node, _Alloc>::_S_swap(_M_node_allocator, __t._M_node_allocator);
+  }
+
+                                // insert/erase
+  pair<const_iterator,bool> insert_unique(const value_type& __v);
+
+  template <class _InputIterator>
+  void insert_unique(_InputIterator __first, _InputIterator __last) {
+    for (; __first != __last; ++__first)
+      insert_unique(*__first);
+  }
+
+  // insert_or_assign() :
+  // 같은 key가 있으면 그 노드를 __v를 담은 새 노드로 바꾸어 단다. (나누어 쓰는 노드를 고치지 않기 위해)
+  // 새로 넣었으면 true를 반환한다.
+  bool insert_or_assign(const value_type& __v);
+
+  size_type erase(const key_type& __k);
+  void erase(const_iterator __position) { erase(_S_key(__position._M_node())); }
+
+  void clear() {
+    _M_release(_M_root);
+    _M_root = 0;
+    _M_node_count = 0;
+  }
+
+                                // set operations
+  const_iterator find(const key_type& __k) const {
+    const_iterator __j = lower_bound(__k);
+    return (__j == end() || _M_key_compare(__k, _S_key(__j._M_node()))) ? end() : __j;
+  }
+  size_type count(const key_type& __k) const { return _M_find_node(__k) != 0; }
+  const_iterator lower_bound(const key_type& __k) const { return _M_make_iterator(__k, false); }
+  const_iterator upper_bound(const key_type& __k) const { return _M_make_iterator(__k, true); }
+  pair<const_iterator,const_iterator> equal_range(const key_type& __k) const
+    { return pair<const_iterator,const_iterator>(lower_bound(__k), upper_bound(__k)); }
+
+  // 해당 key를 가진 값. 없으면 0
+  const value_type* find_value(const key_type& __k) const {
+    _Const_link __x = _M_find_node(__k);
+    return __x ? &__x->_M_value_field : 0;
+  }
+}; // class _Persistent_tree
+
+//------------------     Persistent tree 관련 연산자     ------------------//
+
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+bool
+operator==(const _Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __x,
+           const _Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __y)
+{
+  return __x.size() == __y.size() &&
+         (__x.shares_root_with(__y) || ft::equal(__x.begin(), __x.end(), __y.begin()));
+}
+
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+bool
+operator<(const _Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __x,
+          const _Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __y)
+{
+  return ft::lexicographical_compare(__x.begin(), __x.end(), __y.begin(), __y.end());
+}
+
+//------------------     Persistent tree 클래스 멤버함수의 정의     ------------------//
+
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+typename _Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_Link_type
+_Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_M_find_node(const key_type& __k) const
+{
+  _Link_type __x = _M_root;
+  while (__x != 0) {
+    if (_M_key_compare(__k, _S_key(__x)))
+      __x = __x->_M_left;
+    else if (_M_key_compare(_S_key(__x), __k))
+      __x = __x->_M_right;
+    else
+      return __x;
+  }
+  return 0;
+}
+
+// _M_make_iterator() :
+// lower_bound(__upper가 false)나 upper_bound의 반복자를 만든다.
+// 내려가며 지나는 노드를 모두 쌓고, 마지막으로 왼쪽으로 꺾은 노드(= 답)까지만 남긴다. 답의 조상이 곧 그 아래의 스택이다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+typename _Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::const_iterator
+_Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_M_make_iterator(const key_type& __k, bool __upper) const
+{
+  const_iterator __it(_M_root);
+  size_type __found = 0; // 답까지의 깊이. 0이면 답이 없다. (end())
+  for (_Const_link __x = _M_root; __x != 0; ) {
+    __it._M_stack[__it._M_depth++] = __x;
+    bool __go_left = __upper ? _M_key_compare(__k, _S_key(__x)) : !_M_key_compare(_S_key(__x), __k);
+    if (__go_left) {
+      __found = __it._M_depth;
+      __x = __x->_M_left;
+    }
+    else
+      __x = __x->_M_right;
+  }
+  __it._M_depth = __found;
+  return __it;
+}
+
+// insert_unique() :
+// 1. 먼저 읽기만 하며 찾아본다. 이미 있으면 아무것도 복제하지 않는다.
+// 2. root부터 들어갈 자리까지 내려가며 경로를 이 트리만 가진 노드로 만든다.
+// 3. rebalance가 색을 바꿀 삼촌을 미리 복제해 둔다. 그 뒤로는 할당하지 않으므로 예외가 나지 않는다.
+//    (복제는 트리의 내용을 바꾸지 않으므로, 도중에 예외가 나도 트리는 그대로다.)
+// 4. 새 노드를 달고, _Rb_tree_rebalance_for_insert와 같은 규칙으로 경로를 거슬러 올라가며 고친다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+pair<typename _Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::const_iterator, bool>
+_Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::insert_unique(const value_type& __v)
+{
+  const key_type& __k = _GetKeyOfValue()(__v);
+  if (_M_find_node(__k) != 0)
+    return pair<const_iterator,bool>(find(__k), false);
+
+  _Link_type __path[_S_path_size];
+  size_type __depth = 0;
+  _Link_type* __slot = &_M_root;
+  while (*__slot != 0) {
+    _Link_type __x = _M_unshare(*__slot);
+    __path[__depth++] = __x;
+    __slot = _M_key_compare(__k, _S_key(__x)) ? &__x->_M_left : &__x->_M_right;
+  }
+  _M_prepare_insert_fixup(__path, __depth);
+
+  _Link_type __z = _M_create_node(__v);
+  *__slot = __z;
+  __path[__depth] = __z;
+  ++_M_node_count;
+  _M_insert_fixup(__path, __depth);
+  return pair<const_iterator,bool>(find(__k), true);
+}
+
+// _M_prepare_insert_fixup() :
+// _M_insert_fixup()이 색을 바꿀 red 삼촌을 미리 복제한다.
+// 삼촌이 red인 동안 두 단계씩 올라가고, 그 밖의 경우에는 경로 위의 노드만 고치므로 거기서 멈춘다.
+// 올라가는 동안 읽는 색은 아래 단계에서 바뀌지 않는 노드의 색이므로, 실제 rebalance와 같은 길을 따라간다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+void
+_Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_M_prepare_insert_fixup(_Link_type* __path, size_type __i)
+{
+  while (__i >= 2) {
+    _Link_type __p = __path[__i - 1];
+    if (__p->_M_color == _S_rb_tree_black)
+      return;
+    _Link_type __g = __path[__i - 2];
+    _Link_type& __u = (__p == __g->_M_left) ? __g->_M_right : __g->_M_left;
+    if (_S_is_black(__u))
+      return;
+    _M_unshare(__u);
+    __i -= 2;
+  }
+}
+
+// _M_insert_fixup() :
+// __path[__i]가 새 노드이고, __path[0..__i-1]이 그 조상이다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+void
+_Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_M_insert_fixup(_Link_type* __path, size_type __i)
+{
+  while (__i > 0) {
+    _Link_type __p = __path[__i - 1];
+    if (__p->_M_color == _S_rb_tree_black)
+      break;
+    // 부모가 red이면 부모는 root가 아니므로 조부모가 있다.
+    _Link_type __g = __path[__i - 2];
+    _Link_type __x = __path[__i];
+    if (__p == __g->_M_left) {
+      _Link_type __u = __g->_M_right;
+      if (!_S_is_black(__u)) {
+        __p->_M_color = _S_rb_tree_black;
+        __u->_M_color = _S_rb_tree_black;
+        __g->_M_color = _S_rb_tree_red;
+        __i -= 2;
+        continue;
+      }
+      if (__x == __p->_M_right) {
+        _S_rotate_left(__g->_M_left);
+        __p = __x;
+      }
+      __p->_M_color = _S_rb_tree_black;
+      __g->_M_color = _S_rb_tree_red;
+      _S_rotate_right(_M_slot(__path, __i - 2));
+    }
+    else {
+      _Link_type __u = __g->_M_left;
+      if (!_S_is_black(__u)) {
+        __p->_M_color = _S_rb_tree_black;
+        __u->_M_color = _S_rb_tree_black;
+        __g->_M_color = _S_rb_tree_red;
+        __i -= 2;
+        continue;
+      }
+      if (__x == __p->_M_left) {
+        _S_rotate_right(__g->_M_right);
+        __p = __x;
+      }
+      __p->_M_color = _S_rb_tree_black;
+      __g->_M_color = _S_rb_tree_red;
+      _S_rotate_left(_M_slot(__path, __i - 2));
+    }
+    break;
+  }
+  _M_root->_M_color = _S_rb_tree_black;
+}
+
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+bool
+_Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::insert_or_assign(const value_type& __v)
+{
+  const key_type& __k = _GetKeyOfValue()(__v);
+  if (_M_find_node(__k) == 0) {
+    insert_unique(__v);
+    return true;
+  }
+
+  _Link_type* __slot = &_M_root;
+  for (;;) {
+    _Link_type __x = *__slot;
+    if (_M_key_compare(__k, _S_key(__x)))
+      __slot = &_M_unshare(*__slot)->_M_left;
+    else if (_M_key_compare(_S_key(__x), __k))
+      __slot = &_M_unshare(*__slot)->_M_right;
+    else
+      break;
+  }
+  // 찾은 노드 자신은 복제하지 않고, 새 값으로 만든 노드가 그 자식과 색을 이어받는다.
+  _Link_type __old = *__slot;
+  _Link_type __tmp = _M_create_node(__v);
+  __tmp->_M_color = __old->_M_color;
+  __tmp->_M_left = _S_retain(__old->_M_left);
+  __tmp->_M_right = _S_retain(__old->_M_right);
+  *__slot = __tmp;
+  _M_release(__old);
+  return false;
+}
+
+// erase() :
+// 1. 먼저 읽기만 하며 찾아본다. 없으면 아무것도 복제하지 않는다.
+// 2. 지울 노드 __z까지, __z의 자식이 둘이면 그 다음 노드 __y까지 내려가며 경로를 이 트리만 가진 노드로 만든다.
+// 3. rebalance가 고칠 형제와 조카를 미리 복제해 둔다. 그 뒤로는 예외가 나지 않는다.
+// 4. _Rb_tree_rebalance_for_erase와 같이 __y를 떼어 __z의 자리에 달고, 경로를 거슬러 올라가며 고친다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+typename _Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::size_type
+_Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::erase(const key_type& __k)
+{
+  if (_M_find_node(__k) == 0)
+    return 0;
+
+  _Link_type __path[_S_path_size];
+  size_type __d = 0;
+  _Link_type* __z_slot = &_M_root;
+  for (;;) {
+    _Link_type __x = _M_unshare(*__z_slot);
+    __path[__d] = __x;
+    if (_M_key_compare(__k, _S_key(__x)))
+      __z_slot = &__x->_M_left;
+    else if (_M_key_compare(_S_key(__x), __k))
+      __z_slot = &__x->_M_right;
+    else
+      break;
+    ++__d;
+  }
+  _Link_type __z = __path[__d];
+  size_type __e = __d; // 실제로 트리에서 떨어져 나가는 노드 __y의 깊이
+  _Link_type* __y_slot = __z_slot;
+  if (__z->_M_left != 0 && __z->_M_right != 0) {
+    __y_slot = &__z->_M_right;
+    for (;;) {
+      _Link_type __x = _M_unshare(*__y_slot);
+      __path[++__e] = __x;
+      if (__x->_M_left == 0)
+        break;
+      __y_slot = &__x->_M_left;
+    }
+  }
+  _Link_type __y = __path[__e];
+  _Rb_tree_Color_type __removed_color = __y->_M_color;
+  if (__removed_color == _S_rb_tree_black)
+    _M_prepare_erase_fixup(__path, __d, __e);
+
+  // __y의 자리에는 그 자식(많아야 하나)을 단다.
+  _Link_type __x = __y->_M_left != 0 ? __y->_M_left : __y->_M_right;
+  *__y_slot = __x;
+  if (__y != __z) {
+    // __y가 __z의 자리와 색을 이어받는다.
+    __y->_M_left = __z->_M_left;
+    __y->_M_right = __z->_M_right;
+    __y->_M_color = __z->_M_color;
+    *__z_slot = __y;
+    __path[__d] = __y;
+  }
+  __z->_M_left = __z->_M_right = 0;
+  _M_release(__z);
+  --_M_node_count;
+
+  if (__removed_color == _S_rb_tree_black)
+    _M_erase_fixup(__path, __e, __x);
+  return 1;
+}
+
+// _M_unshare_near() :
+// __slot의 노드와 그 아래 __levels 단계까지를 이 트리만 가진 노드로 만든다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+void
+_Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_M_unshare_near(_Link_type& __slot, int __levels)
+{
+  _Link_type __x = _M_unshare(__slot);
+  if (__x != 0 && __levels > 0) {
+    _M_unshare_near(__x->_M_left, __levels - 1);
+    _M_unshare_near(__x->_M_right, __levels - 1);
+  }
+}
+
+// _M_prepare_erase_fixup() :
+// __y를 떼어내기 전에, _M_erase_fixup()이 고칠 경로 밖의 노드를 미리 복제한다.
+// 떼어낸 뒤의 모양을 흉내 낸다. 깊이 __d에는 __y가 __z의 자식과 색을 가지고 앉고, __x는 깊이 __e에 온다.
+// - 형제와 그 자식이 모두 black이면(case 2) 형제를 red로 바꾸고 한 단계 올라간다. 형제만 복제한다.
+//   위로 올라가며 읽는 색은 아래 단계에서 바뀌지 않는 노드의 색이므로, 실제 rebalance와 같은 길을 따라간다.
+// - 그 밖의 경우(case 1, 3, 4)에는 형제의 서브트리 안에서 끝난다. 형제부터 두 단계 아래까지를 복제한다.
+// - __x가 red로 끝나면 black으로 바꾸므로 __x도 복제한다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+void
+_Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_M_prepare_erase_fixup(_Link_type* __path, size_type __d, size_type __e)
+{
+  _Link_type __z = __path[__d];
+  _Link_type __y = __path[__e];
+  _Link_type& __x_slot = __y->_M_left != 0 ? __y->_M_left : __y->_M_right;
+  if (!_S_is_black(__x_slot)) {
+    _M_unshare(__x_slot);
+    return;
+  }
+  for (size_type __k = __e; __k > 0; --__k) {
+    // 깊이 __k - 1의 노드. __y가 __z의 자리에 앉으므로 깊이 __d에서는 __z의 자식과 색을 본다.
+    _Link_type __xp = (__k - 1 == __d) ? __z : __path[__k - 1];
+    bool __x_is_left;
+    if (__k == __e)
+      __x_is_left = (__e == __d) ? (__xp->_M_left == __z) : (__e - 1 != __d);
+    else
+      __x_is_left = (__xp->_M_left == __path[__k]);
+    _Link_type& __w = __x_is_left ? __xp->_M_right : __xp->_M_left;
+    if (__w->_M_color == _S_rb_tree_red
+        || !_S_is_black(__w->_M_left) || !_S_is_black(__w->_M_right)) {
+      _M_unshare_near(__w, 2);
+      return;
+    }
+    _M_unshare(__w);
+    // 올라간 __x(= __xp)가 red면 black으로 바꾸고 끝난다. 경로 위의 노드이므로 복제할 필요가 없다.
+    if (__xp->_M_color == _S_rb_tree_red)
+      return;
+  }
+}
+
+// _M_erase_fixup() :
+// __path[0..__k-1]이 __x의 조상이다. (__x는 0일 수 있다.) _Rb_tree_rebalance_for_erase의 while문과 같다.
+// case 1에서 회전하면 형제가 __x의 부모 위로 올라오므로, 경로에 끼워 넣는다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+void
+_Persistent_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_M_erase_fixup(_Link_type* __path, size_type __k, _Link_type __x)
+{
+  while (__k > 0 && _S_is_black(__x)) {
+    _Link_type __xp = __path[__k - 1];
+    if (__x == __xp->_M_left) {
+      _Link_type __w = __xp->_M_right;
+      if (__w->_M_color == _S_rb_tree_red) {
+        __w->_M_color = _S_rb_tree_black;
+        __xp->_M_color = _S_rb_tree_red;
+        _S_rotate_left(_M_slot(__path, __k - 1));
+        __path[__k - 1] = __w;
+        __path[__k] = __xp;
+        ++__k;
+        __w = __xp->_M_right;
+      }
+      if (_S_is_black(__w->_M_left) && _S_is_black(__w->_M_right)) {
+        __w->_M_color = _S_rb_tree_red;
+        __x = __xp;
+        --__k;
+      }
+      else {
+        if (_S_is_black(__w->_M_right)) {
+          __w->_M_left->_M_color = _S_rb_tree_black;
+          __w->_M_color = _S_rb_tree_red;
+          _S_rotate_right(__xp->_M_right);
+          __w = __xp->_M_right;
+        }
+        __w->_M_color = __xp->_M_color;
+        __xp->_M_color = _S_rb_tree_black;
+        if (__w->_M_right != 0)
+          __w->_M_right->_M_color = _S_rb_tree_black;
+        _S_rotate_left(_M_slot(__path, __k - 1));
+        return;
+      }
+    }
+    else {
+      _Link_type __w = __xp->_M_left;
+      if (__w->_M_color == _S_rb_tree_red) {
+        __w->_M_color = _S_rb_tree_black;
+        __xp->_M_color = _S_rb_tree_red;
+        _S_rotate_right(_M_slot(__path, __k - 1));
+        __path[__k - 1] = __w;
+        __path[__k] = __xp;
+        ++__k;
+        __w = __xp->_M_left;
+      }
+      if (_S_is_black(__w->_M_right) && _S_is_black(__w->_M_left)) {
+        __w->_M_color = _S_rb_tree_red;
+        __x = __xp;
+        --__k;
+      }
+      else {
+        if (_S_is_black(__w->_M_left)) {
+          __w->_M_right->_M_color = _S_rb_tree_black;
+          __w->_M_color = _S_rb_tree_red;
+          _S_rotate_left(__xp->_M_left);
+          __w = __xp->_M_left;
+        }
+        __w->_M_color = __xp->_M_color;
+        __xp->_M_color = _S_rb_tree_black;
+        if (__w->_M_left != 0)
+          __w->_M_left->_M_color = _S_rb_tree_black;
+        _S_rotate_right(_M_slot(__path, __k - 1));
+        return;
+      }
+    }
+  }
+  if (__x != 0 && __x->_M_color == _S_rb_tree_red)
+    __x->_M_color = _S_rb_tree_black;
+}
+
+} // namespace ft
+
+#endif /* PERSISTENT_TREE_HPP */
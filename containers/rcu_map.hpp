@@ -0,0 +1,370 @@
+#ifndef RCU_MAP_HPP
+#define RCU_MAP_HPP
+
+#include <cstddef>
+  // size_t
+
+#include <functional>
+  // std::less
+
+#include <pthread.h>
+  // pthread_mutex_t
+
+#include "map.hpp"
+  // ft::map: 한 버전의 내용. 발행한 뒤에는 고치지 않는다.
+
+#include "alloc.hpp"
+  // _Alloc_traits
+
+namespace ft
+{
+
+// rcu_map
+// 읽기가 압도적으로 많은 표를 위한, 읽기에 잠금이 없는 map. (read-copy-update)
+//
+// - 지금의 내용은 고치지 않는 ft::map 하나(버전)이고, 그 포인터만 공개되어 있다.
+//   읽는 쪽은 포인터를 읽어 그 map에서 find, lower_bound 등을 한다. 원자적 load/store와 fence만 쓰고,
+//   read-modify-write(CAS, fetch_add)나 잠금은 쓰지 않는다. 그래서 읽는 스레드끼리 캐시라인을 주고받지 않는다.
+// - 쓰는 쪽은 mutex를 잡고, 지금 버전을 복사해서 고친 새 버전을 만든 뒤 포인터를 바꾸어 단다. (O(n))
+//   쓰기가 드물다고 가정한다. 여러 변경은 update()로 묶어서 한 번에 발행하자.
+// - 이전 버전은 아직 읽고 있는 스레드가 있을 수 있으므로 바로 지우지 않는다. (epoch 기반 회수)
+//   전역 epoch은 발행할 때마다 1씩 오른다. 읽는 스레드는 읽기를 시작할 때 본 epoch을 자기 칸(_Reader_slot)에 적고,
+//   끝나면 0으로 지운다. epoch E에 물러난 버전은, 읽고 있는 모든 스레드의 칸이 E보다 클 때 지운다.
+//   (그런 스레드는 그 버전이 물러난 뒤에 읽기를 시작했으므로 새 버전을 보고 있다.)
+//   회수는 쓰는 쪽이 발행할 때 하거나 reclaim()을 부를 때 한다.
+//
+// 쓰는 법 :
+//   ft::rcu_map<K, T>::reader r(table);         // 스레드마다 하나. 등록할 때만 mutex를 잡는다.
+//   {
+//     ft::rcu_map<K, T>::read_guard g(r);        // 이 범위 안에서 *g는 바뀌지 않는 map이다.
+//     ft::map<K, T>::const_iterator i = g->find(k);
+//   }
+// read_guard를 겹쳐 잡으면 안 된다. read_guard를 오래 잡고 있으면 그동안 물러난 버전을 지우지 못한다.
+template <
+  typename _KeyType,
+  typename _MappedType,
+  typename _KeyCompare = std::less<_KeyType>,
+  typename _Alloc = std::allocator<pair<const _KeyType, _MappedType> >
+> class rcu_map {
+public:
+  typedef ft::map<_KeyType, _MappedType, _KeyCompare, _Alloc> map_type;
+  typedef typename map_type::key_type key_type;
+  typedef typename map_type::mapped_type mapped_type;
+  typedef typename map_type::value_type value_type;
+  typedef typename map_type::size_type size_type;
+
+private:
+  // 발행된 버전. 물러나면 _M_retired 목록에 달린다.
+  struct _Version
+  {
+    map_type _M_map;
+    std::size_t _M_retired_epoch; // 물러날 때의 epoch
+    _Version* _M_next;
+
+    explicit _Version(const map_type& __m) : _M_map(__m), _M_retired_epoch(0), _M_next(0) {}
+  };
+
+  // 읽는 스레드 하나의 칸. 읽는 동안 본 epoch을 적고, 읽지 않을 때는 0이다.
+  // 자기 칸에만 쓰므로, 다른 스레드의 칸과 같은 캐시라인에 놓이지 않도록 뒤를 채운다.
+  struct _Reader_slot
+  {
+    std::size_t _M_epoch;
+    bool _M_in_use; // reader가 차지하고 있는지. (쓰는 쪽 mutex 안에서만 바꾼다.)
+    _Reader_slot* _M_next;
+    char _M_pad[64];
+  };
+
+  typedef typename _Alloc_traits<_Version, _Alloc>::allocator_type _Version_allocator;
+  typedef typename _Alloc_traits<_Reader_slot, _Alloc>::allocator_type _Slot_allocator;
+
+  _Version_allocator _M_version_allocator;
+  _Slot_allocator _M_slot_allocator;
+
+  _Version* _M_current; // 읽는 쪽은 __atomic_load_n으로만 읽는다.
+  std::size_t _M_epoch; // 전역 epoch. 1부터 시작한다. (0은 '읽지 않음')
+  _Reader_slot* _M_slots; // 한 번 만든 칸은 rcu_map이 없어질 때까지 남는다.
+  _Version* _M_retired; // 물러났지만 아직 지우지 못한 버전
+  mutable pthread_mutex_t _M_writer_lock; // 쓰기, 회수, reader 등록을 한 줄로 세운다.
+
+  rcu_map(const rcu_map&);
+  rcu_map& operator=(const rcu_map&);
+
+  _Version* _M_create_version(const map_type& __m) {
+    _Version* __v = _M_version_allocator.allocate(1);
+    try {
+      new (static_cast<void*>(__v)) _Version(__m);
+    }
+    catch(...)
+    {
+  _M_version_allocator.deallocate(__v, 1);
+  throw;
+    }
+    return __v;
+  }
+
+  void _M_destroy_version(_Version* __v) {
+    __v->~_Version();
+    _M_version_allocator.deallocate(__v, 1);
+  }
+
+  // _M_publish() :
+  // __v를 지금 버전으로 단다. (_M_writer_lock을 잡은 채로 부른다.)
+  // 포인터를 바꾼 뒤에 epoch을 올리므로, 올라간 epoch을 본 reader는 반드시 새 버전을 본다.
+  void _M_publish(_Version* __v) {
+    _Version* __old = _M_current;
+    __atomic_store_n(&_M_current, __v, __ATOMIC_RELEASE);
+    __old->_M_retired_epoch = _M_epoch;
+    __old->_M_next = _M_retired;
+    _M_retired = __old;
+    __atomic_store_n(&_M_epoch, _M_epoch + 1, __ATOMIC_RELEASE);
+    _M_reclaim();
+  }
+
+  // _M_reclaim() :
+  // 읽고 있는 reader가 모두 그 버전이 물러난 뒤에 시작했다면 지운다. 지운 버전의 수를 반환한다.
+  // (_M_writer_lock을 잡은 채로 부른다.)
+  size_type _M_reclaim() {
+    // reader의 [칸에 쓰기 -> fence -> 버전 읽기]와 짝을 이룬다.
+    // 둘 중 적어도 하나는 상대가 쓴 것을 본다. reader가 옛 버전을 읽었다면 여기서 그 칸을 본다.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    std::size_t __min = _M_epoch;
+    for (_Reader_slot* __s = _M_slots; __s != 0; __s = __s->_M_next) {
+      std::size_t __e = __atomic_load_n(&__s->_M_epoch, __ATOMIC_ACQUIRE);
+      if (__e != 0 && __e < __min)
+        __min = __e;
+    }
+    size_type __n = 0;
+    _Version** __link = &_M_retired;
+    while (*__link != 0) {
+      _Version* __v = *__link;
+      if (__v->_M_retired_epoch < __min) {
+        *__link = __v->_M_next;
+        _M_destroy_version(__v);
+        ++__n;
+      }
+      else
+        __link = &__v->_M_next;
+    }
+    return __n;
+  }
+
+  _Reader_slot* _M_acquire_slot() {
+    _Writer_guard __guard(&_M_writer_lock);
+    for (_Reader_slot* __s = _M_slots; __s != 0; __s = __s->_M_next)
+      if (!__s->_M_in_use) {
+        __s->_M_in_use = true;
+        return __s;
+      }
+    _Reader_slot* __s = _M_slot_allocator.allocate(1);
+    __s->_M_epoch = 0;
+    __s->_M_in_use = true;
+    __s->_M_next = _M_slots;
+    _M_slots = __s;
+    return __s;
+  }
+
+  void _M_release_slot(_Reader_slot* __s) {
+    _Writer_guard __guard(&_M_writer_lock);
+    __s->_M_in_use = false;
+  }
+
+  class _Writer_guard
+  {
+    pthread_mutex_t* _M_lock;
+
+    _Writer_guard(const _Writer_guard&);
+    _Writer_guard& operator=(const _Writer_guard&);
+
+  public:
+    explicit _Writer_guard(pthread_mutex_t* __l) : _M_lock(__l) { pthread_mutex_lock(_M_lock); }
+    ~_Writer_guard() { pthread_mutex_unlock(_M_lock); }
+  };
+
+public:
+  // reader
+  // 읽는 스레드의 칸 하나를 차지한다. 스레드마다 하나씩 만들어 두고 계속 쓴다. 스레드끼리 나누어 쓰면 안 된다.
+  class reader
+  {
+    friend class rcu_map;
+    friend class read_guard;
+    rcu_map* _M_owner;
+    _Reader_slot* _M_slot;
+
+    reader(const reader&);
+    reader& operator=(const reader&);
+
+  public:
+    explicit reader(rcu_map& __m) : _M_owner(&__m), _M_slot(__m._M_acquire_slot()) {}
+    ~reader() { _M_owner->_M_release_slot(_M_slot); }
+
+    // lookup() :
+    // 키가 있으면 그 값을 __out에 복사하고 true를 반환한다.
+    bool lookup(const key_type& __k, mapped_type& __out);
+  };
+
+  // read_guard
+  // 살아 있는 동안 읽기 구간이다. 그동안 *g가 가리키는 버전은 지워지지 않고, 바뀌지도 않는다.
+  class read_guard
+  {
+    _Reader_slot* _M_slot;
+    const _Version* _M_version;
+
+    read_guard(const read_guard&);
+    read_guard& operator=(const read_guard&);
+
+  public:
+    // epoch을 읽고, 칸에 적고, fence 뒤에 버전을 읽는다.
+    // epoch을 acquire로 읽으므로, 발행이 올린 epoch을 보았다면 그 발행의 버전이나 그 뒤의 버전을 읽는다.
+    explicit read_guard(reader& __r) : _M_slot(__r._M_slot), _M_version(0) {
+      rcu_map* __m = __r._M_owner;
+      __atomic_store_n(&_M_slot->_M_epoch, __atomic_load_n(&__m->_M_epoch, __ATOMIC_ACQUIRE), __ATOMIC_RELAXED);
+      __atomic_thread_fence(__ATOMIC_SEQ_CST);
+      _M_version = __atomic_load_n(&__m->_M_current, __ATOMIC_ACQUIRE);
+    }
+
+    // 버전을 다 읽은 뒤에 칸을 지운다.
+    ~read_guard() { __atomic_store_n(&_M_slot->_M_epoch, 0, __ATOMIC_RELEASE); }
+
+    const map_type& operator*() const { return _M_version->_M_map; }
+    const map_type* operator->() const { return &_M_version->_M_map; }
+  };
+
+  // allocation/deallocation
+
+  explicit rcu_map(const map_type& __m = map_type())
+    : _M_version_allocator(__m.get_allocator()), _M_slot_allocator(__m.get_allocator()),
+      _M_current(0), _M_epoch(1), _M_slots(0), _M_retired(0)
+  {
+    _M_current = _M_create_version(__m);
+    pthread_mutex_init(&_M_writer_lock, 0);
+  }
+
+  // reader가 모두 없어진 뒤에 없애야 한다.
+  ~rcu_map() {
+    while (_M_retired != 0) {
+      _Version* __v = _M_retired;
+      _M_retired = __v->_M_next;
+      _M_destroy_version(__v);
+    }
+    _M_destroy_version(_M_current);
+    while (_M_slots != 0) {
+      _Reader_slot* __s = _M_slots;
+      _M_slots = __s->_M_next;
+      _M_slot_allocator.deallocate(__s, 1);
+    }
+    pthread_mutex_destroy(&_M_writer_lock);
+  }
+
+  // writers :
+  // 모두 새 버전을 만들어 발행한다. 예외가 나면 아무것도 발행하지 않는다.
+
+  // snapshot() :
+  // 지금 버전의 복사본.
+  map_type snapshot() const {
+    _Writer_guard __guard(&_M_writer_lock);
+    return _M_current->_M_map;
+  }
+
+  // assign() :
+  // __m을 통째로 새 버전으로 발행한다. (설정을 다시 읽었을 때)
+  void assign(const map_type& __m) {
+    _Writer_guard __guard(&_M_writer_lock);
+    _M_publish(_M_create_version(__m));
+  }
+
+  // update() :
+  // 지금 버전의 복사본에 __f(map_type&)를 적용해서 발행한다. 여러 변경을 한 번의 복사로 묶는다.
+  template <class _Function>
+  void update(_Function __f) {
+    _Writer_guard __guard(&_M_writer_lock);
+    _Version* __v = _M_create_version(_M_current->_M_map);
+    try {
+      __f(__v->_M_map);
+    }
+    catch(...)
+    {
+  _M_destroy_version(__v);
+  throw;
+    }
+    _M_publish(__v);
+  }
+
+  // insert(), insert_or_assign(), erase() :
+  // 하나만 바꾸는 update(). 바뀌는 것이 없으면 발행하지 않는다.
+  bool insert(const value_type& __x) {
+    _Writer_guard __guard(&_M_writer_lock);
+    if (_M_current->_M_map.count(__x.first))
+      return false;
+    _Version* __v = _M_create_version(_M_current->_M_map);
+    try {
+      __v->_M_map.insert(__x);
+    }
+    catch(...)
+    {
+  _M_destroy_version(__v);
+  throw;
+    }
+    _M_publish(__v);
+    return true;
+  }
+
+  bool insert_or_assign(const key_type& __k, const mapped_type& __obj) {
+    _Writer_guard __guard(&_M_writer_lock);
+    _Version* __v = _M_create_version(_M_current->_M_map);
+    bool __inserted;
+    try {
+      pair<typename map_type::iterator, bool> __p = __v->_M_map.insert(value_type(__k, __obj));
+      if (!(__inserted = __p.second))
+        (*__p.first).second = __obj;
+    }
+    catch(...)
+    {
+  _M_destroy_version(__v);
+  throw;
+    }
+    _M_publish(__v);
+    return __inserted;
+  }
+
+  size_type erase(const key_type& __k) {
+    _Writer_guard __guard(&_M_writer_lock);
+    if (!_M_current->_M_map.count(__k))
+      return 0;
+    _Version* __v = _M_create_version(_M_current->_M_map);
+    __v->_M_map.erase(__k);
+    _M_publish(__v);
+    return 1;
+  }
+
+  // reclaim() :
+  // 지울 수 있게 된 이전 버전을 지금 지운다. 지운 버전의 수를 반환한다.
+  // (발행할 때마다 저절로 하므로, 쓰기가 멈춘 뒤에 메모리를 돌려받고 싶을 때만 부르면 된다.)
+  size_type reclaim() {
+    _Writer_guard __guard(&_M_writer_lock);
+    return _M_reclaim();
+  }
+
+  // 아직 지우지 못한 이전 버전의 수
+  size_type retired_count() const {
+    _Writer_guard __guard(&_M_writer_lock);
+    size_type __n = 0;
+    for (const _Version* __v = _M_retired; __v != 0; __v = __v->_M_next)
+      ++__n;
+    return __n;
+  }
+};
+
+template <class _KeyType, class _MappedType, class _KeyCompare, class _Alloc>
+bool rcu_map<_KeyType, _MappedType, _KeyCompare, _Alloc>::reader::lookup(const key_type& __k, mapped_type& __out)
+{
+  read_guard __g(*this);
+  typename map_type::const_iterator __i = __g->find(__k);
+  if (__i == __g->end())
+    return false;
+  __out = (*__i).second;
+  return true;
+}
+
+} // namespace ft
+
+#endif /* RCU_MAP_HPP */
@@ -0,0 +1,313 @@
+#ifndef SHARDED_MAP_HPP
+#define SHARDED_MAP_HPP
+
+#include <cstddef>
+  // size_t
+
+#include <new>
+  // std::bad_alloc
+
+#include <algorithm>
+  // std::upper_bound()
+
+#include <functional>
+  // std::less
+
+#include <pthread.h>
+  // pthread_rwlock_t
+
+#include "tree.hpp"
+  // ft::_Rb_tree
+
+#include "vector.hpp"
+  // ft::vector: shard 사이의 경계 key를 담는다.
+
+#include "function.hpp"
+  // ft::_Select1st
+
+#include "alloc.hpp"
+  // _Alloc_traits
+
+namespace ft
+{
+
+//------------------     lock     ------------------//
+
+// 범위를 벗어날 때 (예외로 벗어나도) rwlock을 푼다.
+class _Rwlock_read_guard
+{
+  pthread_rwlock_t* _M_lock;
+
+  _Rwlock_read_guard(const _Rwlock_read_guard&);
+  _Rwlock_read_guard& operator=(const _Rwlock_read_guard&);
+
+public:
+  explicit _Rwlock_read_guard(pthread_rwlock_t* __l) : _M_lock(__l) { pthread_rwlock_rdlock(_M_lock); }
+  ~_Rwlock_read_guard() { pthread_rwlock_unlock(_M_lock); }
+};
+
+class _Rwlock_write_guard
+{
+  pthread_rwlock_t* _M_lock;
+
+  _Rwlock_write_guard(const _Rwlock_write_guard&);
+  _Rwlock_write_guard& operator=(const _Rwlock_write_guard&);
+
+public:
+  explicit _Rwlock_write_guard(pthread_rwlock_t* __l) : _M_lock(__l) { pthread_rwlock_wrlock(_M_lock); }
+  ~_Rwlock_write_guard() { pthread_rwlock_unlock(_M_lock); }
+};
+
+//------------------     shard     ------------------//
+
+// key 범위 하나를 맡는 _Rb_tree와 그것을 지키는 rwlock.
+// sharded_map은 shard마다 캐시라인 경계에서 시작하는 _S_stride바이트 칸을 준다. (_M_create_shards() 참고)
+// 그래서 이웃 shard의 lock과 트리가 같은 캐시라인을 쓰지 않는다.
+// (한 shard의 lock을 잡을 때마다 이웃 shard를 쓰는 스레드의 캐시라인까지 무효화되는 것을 막는다.)
+template <typename _Key, typename _Value, typename _GetKeyOfValue, typename _Compare, typename _Alloc>
+struct _Sharded_map_shard
+{
+  typedef _Rb_tree<_Key, _Value, _GetKeyOfValue, _Compare, _Alloc> _Tree;
+
+  // 캐시라인 크기. (x86-64와 대부분의 ARM64는 64바이트)
+  static const std::size_t _S_cache_line = 64;
+  // 배열에서 shard 하나가 차지하는 칸. sizeof를 캐시라인 크기의 배수로 올린 것이다.
+  static const std::size_t _S_stride = (sizeof(pthread_rwlock_t) + sizeof(_Tree) + _S_cache_line - 1)
+                                       / _S_cache_line * _S_cache_line;
+
+  mutable pthread_rwlock_t _M_lock;
+  _Tree _M_tree;
+
+  _Sharded_map_shard(const _Compare& __comp, const typename _Tree::allocator_type& __a)
+    : _M_tree(__comp, __a)
+  {
+    if (pthread_rwlock_init(&_M_lock, 0) != 0)
+      throw std::bad_alloc();
+  }
+  ~_Sharded_map_shard() { pthread_rwlock_destroy(&_M_lock); }
+
+private:
+  _Sharded_map_shard(const _Sharded_map_shard&);
+  _Sharded_map_shard& operator=(const _Sharded_map_shard&);
+};
+
+// sharded_map
+// 여러 스레드가 함께 쓰는, key 범위로 나뉜 map.
+//
+// map 하나를 mutex 하나로 감싸면 모든 연산이 한 줄로 서므로, 스레드를 늘려도 코어 하나만큼밖에 빨라지지 않는다.
+// sharded_map은 key 공간을 경계 key로 나누어 shard마다 _Rb_tree와 rwlock을 따로 둔다.
+// - 경계가 b[0] < b[1] < ... < b[n-1]이면 shard는 n + 1개이고, shard i는 b[i-1] <= key < b[i]인 key를 맡는다.
+//   (shard 0은 b[0]보다 작은 key, shard n은 b[n-1] 이상인 key)
+// - find, insert, erase처럼 key 하나를 다루는 연산은 그 key의 shard 하나만 잠근다. 읽기끼리는 함께 들어간다.
+// - for_each()는 shard를 key 순서대로 하나씩 읽기 잠금을 잡고 훑는다. 그래서 순서는 보장되지만,
+//   다른 shard를 훑는 사이에 일어난 변경은 보일 수도, 안 보일 수도 있다. (전체의 일관된 스냅샷이 아니다.)
+//   size()도 마찬가지다.
+// - 다른 스레드가 언제든 지울 수 있으므로 반복자나 참조를 내어주지 않는다. 값은 복사해서 꺼내고(lookup()),
+//   고칠 때는 잠금 안에서 함수를 부른다(update()). 그 함수 안에서 같은 sharded_map을 부르면 안 된다. (교착)
+// - shard마다 할당기의 복사본을 쓴다. 할당기는 여러 스레드에서 동시에 써도 안전해야 한다.
+//   (slab_allocator는 노드 할당기로 rebind할 때 트리마다 새 풀을 만들므로 shard끼리 풀을 공유하지 않는다.)
+// 경계는 생성할 때 정하고 바꾸지 않는다. key가 고르게 퍼지도록 경계를 고르자.
+template <
+  typename _KeyType,
+  typename _MappedType,
+  typename _KeyCompare = std::less<_KeyType>,
+  typename _Alloc = std::allocator<pair<const _KeyType, _MappedType> >
+> class sharded_map {
+public:
+  typedef _KeyType key_type;
+  typedef _MappedType mapped_type;
+  typedef pair<const _KeyType, _MappedType> value_type;
+  typedef _KeyCompare key_compare;
+  typedef std::size_t size_type;
+
+private:
+  typedef _Sharded_map_shard<key_type, value_type, _Select1st<value_type>, key_compare, _Alloc> _Shard;
+  typedef typename _Shard::_Tree _Tree;
+  typedef typename _Alloc_traits<char, _Alloc>::allocator_type _Byte_allocator;
+
+public:
+  typedef typename _Tree::allocator_type allocator_type;
+
+private:
+  _Byte_allocator _M_byte_allocator;
+  char* _M_storage;    // 할당받은 그대로의 주소 (해제할 때 쓴다)
+  char* _M_shards;     // _M_storage 안에서 캐시라인 경계로 올린 주소. shard i는 _M_shards + i * _Shard::_S_stride에 있다.
+  size_type _M_shard_count;
+  ft::vector<key_type> _M_bounds; // shard 사이의 경계. _M_shard_count - 1개
+  _KeyCompare _M_key_compare;
+
+  // 여러 스레드가 함께 쓰는 lock을 가지므로 복사할 수 없다.
+  sharded_map(const sharded_map&);
+  sharded_map& operator=(const sharded_map&);
+
+  size_type _M_storage_size() const { return _M_shard_count * _Shard::_S_stride + _Shard::_S_cache_line - 1; }
+
+  // _M_create_shards() :
+  // 할당기는 캐시라인 정렬을 보장하지 않으므로, 캐시라인 하나만큼 더 받아 시작 주소를 경계로 올린다.
+  void _M_create_shards(const allocator_type& __a) {
+    _M_shard_count = _M_bounds.size() + 1;
+    _M_storage = _M_byte_allocator.allocate(_M_storage_size());
+    const std::size_t __mis = reinterpret_cast<std::size_t>(_M_storage) % _Shard::_S_cache_line;
+    _M_shards = _M_storage + (__mis == 0 ? 0 : _Shard::_S_cache_line - __mis);
+    size_type __i = 0;
+    try {
+      for (; __i < _M_shard_count; ++__i)
+        new (static_cast<void*>(_M_shards + __i * _Shard::_S_stride)) _Shard(_M_key_compare, __a);
+    }
+    catch(...) {
+      while (__i > 0)
+        _M_shard_at(--__i).~_Shard();
+      _M_byte_allocator.deallocate(_M_storage, _M_storage_size());
+      throw;
+    }
+  }
+
+  _Shard& _M_shard_at(size_type __i) const { return *reinterpret_cast<_Shard*>(_M_shards + __i * _Shard::_S_stride); }
+  _Shard& _M_shard(const key_type& __k) const { return _M_shard_at(shard_of(__k)); }
+
+public:
+  // 생성 :
+  // 1. shard 하나. (mutex 하나로 감싼 map과 같다.)
+  explicit sharded_map(const _KeyCompare& __comp = _KeyCompare(),
+                       const allocator_type& __a = allocator_type())
+    : _M_byte_allocator(__a), _M_storage(0), _M_shards(0), _M_shard_count(0), _M_bounds(), _M_key_compare(__comp)
+    { _M_create_shards(__a); }
+
+  // 2. 경계 key의 범위 [__first, __last)로. 경계는 오름차순이고 중복이 없어야 한다.
+  template <class _InputIterator>
+  sharded_map(_InputIterator __first, _InputIterator __last,
+              const _KeyCompare& __comp = _KeyCompare(),
+              const allocator_type& __a = allocator_type())
+    : _M_byte_allocator(__a), _M_storage(0), _M_shards(0), _M_shard_count(0), _M_bounds(__first, __last), _M_key_compare(__comp)
+    { _M_create_shards(__a); }
+
+  ~sharded_map() {
+    for (size_type __i = 0; __i < _M_shard_count; ++__i)
+      _M_shard_at(__i).~_Shard();
+    _M_byte_allocator.deallocate(_M_storage, _M_storage_size());
+  }
+
+  // accessors:
+
+  key_compare key_comp() const { return _M_key_compare; }
+  size_type shard_count() const { return _M_shard_count; }
+
+  // shard_of() :
+  // __k를 맡는 shard의 번호. 경계 중에서 __k보다 큰 첫 경계의 위치다.
+  size_type shard_of(const key_type& __k) const {
+    return std::upper_bound(_M_bounds.begin(), _M_bounds.end(), __k, _M_key_compare) - _M_bounds.begin();
+  }
+
+  // size() :
+  // shard마다 차례로 잠그고 센다. 세는 동안에도 다른 shard는 바뀔 수 있다.
+  size_type size() const {
+    size_type __n = 0;
+    for (size_type __i = 0; __i < _M_shard_count; ++__i) {
+      _Rwlock_read_guard __guard(&_M_shard_at(__i)._M_lock);
+      __n += _M_shard_at(__i)._M_tree.size();
+    }
+    return __n;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  // insert() :
+  // 새로 넣었으면 true. 이미 있으면 값을 바꾸지 않는다.
+  bool insert(const value_type& __x) {
+    _Shard& __s = _M_shard(__x.first);
+    _Rwlock_write_guard __guard(&__s._M_lock);
+    return __s._M_tree.insert_unique(__x).second;
+  }
+
+  // insert_or_assign() :
+  // 키가 없으면 넣고, 있으면 값을 __obj로 바꾼다. 새로 넣었으면 true를 반환한다.
+  bool insert_or_assign(const key_type& __k, const mapped_type& __obj) {
+    _Shard& __s = _M_shard(__k);
+    _Rwlock_write_guard __guard(&__s._M_lock);
+    pair<typename _Tree::iterator, bool> __p = __s._M_tree.insert_unique(value_type(__k, __obj));
+    if (!__p.second)
+      (*__p.first).second = __obj;
+    return __p.second;
+  }
+
+  // erase() :
+  // 지운 요소의 개수를 반환한다.
+  size_type erase(const key_type& __k) {
+    _Shard& __s = _M_shard(__k);
+    _Rwlock_write_guard __guard(&__s._M_lock);
+    return __s._M_tree.erase(__k);
+  }
+
+  void clear() {
+    for (size_type __i = 0; __i < _M_shard_count; ++__i) {
+      _Rwlock_write_guard __guard(&_M_shard_at(__i)._M_lock);
+      _M_shard_at(__i)._M_tree.clear();
+    }
+  }
+
+  // lookup() :
+  // 키가 있으면 그 값을 __out에 복사하고 true를 반환한다.
+  bool lookup(const key_type& __k, mapped_type& __out) const {
+    _Shard& __s = _M_shard(__k);
+    _Rwlock_read_guard __guard(&__s._M_lock);
+    typename _Tree::const_iterator __i = __s._M_tree.find(__k);
+    if (__i == __s._M_tree.end())
+      return false;
+    __out = (*__i).second;
+    return true;
+  }
+
+  // count() :
+  // 1과 0 중에서만 반환한다.
+  size_type count(const key_type& __k) const {
+    _Shard& __s = _M_shard(__k);
+    _Rwlock_read_guard __guard(&__s._M_lock);
+    return __s._M_tree.find(__k) != __s._M_tree.end();
+  }
+
+  // update() :
+  // 키가 있으면 그 shard를 쓰기 잠금한 채로 __f(값)을 부르고 true를 반환한다.
+  template <class _Function>
+  bool update(const key_type& __k, _Function __f) {
+    _Shard& __s = _M_shard(__k);
+    _Rwlock_write_guard __guard(&__s._M_lock);
+    typename _Tree::iterator __i = __s._M_tree.find(__k);
+    if (__i == __s._M_tree.end())
+      return false;
+    __f((*__i).second);
+    return true;
+  }
+
+  // for_each() :
+  // 1. 모든 요소를 key 순서대로 __f(const value_type&)에 넘긴다.
+  template <class _Function>
+  _Function for_each(_Function __f) const {
+    for (size_type __i = 0; __i < _M_shard_count; ++__i) {
+      _Rwlock_read_guard __guard(&_M_shard_at(__i)._M_lock);
+      const _Tree& __t = _M_shard_at(__i)._M_tree;
+      for (typename _Tree::const_iterator __j = __t.begin(); __j != __t.end(); ++__j)
+        __f(*__j);
+    }
+    return __f;
+  }
+
+  // 2. [__lo, __hi) 범위의 key만. 그 범위에 걸친 shard만 잠근다.
+  template <class _Function>
+  _Function for_each(const key_type& __lo, const key_type& __hi, _Function __f) const {
+    if (!_M_key_compare(__lo, __hi))
+      return __f;
+    const size_type __last = shard_of(__hi);
+    for (size_type __i = shard_of(__lo); __i <= __last; ++__i) {
+      _Rwlock_read_guard __guard(&_M_shard_at(__i)._M_lock);
+      const _Tree& __t = _M_shard_at(__i)._M_tree;
+      typename _Tree::const_iterator __end = __t.lower_bound(__hi);
+      for (typename _Tree::const_iterator __j = __t.lower_bound(__lo); __j != __end; ++__j)
+        __f(*__j);
+    }
+    return __f;
+  }
+};
+
+} // namespace ft
+
+#endif /* SHARDED_MAP_HPP */
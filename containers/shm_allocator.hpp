@@ -0,0 +1,335 @@
+#ifndef SHM_ALLOCATOR_HPP
+#define SHM_ALLOCATOR_HPP
+
+#include <cstddef>
+  // size_t, ptrdiff_t
+
+#include <cstring>
+  // std::memset()
+
+#include <new>
+  // std::bad_alloc, placement new
+
+#include <stdexcept>
+  // std::runtime_error
+
+#include <typeinfo>
+  // typeid(): 루트 객체의 타입을 확인한다.
+
+#include <fcntl.h>
+  // open()
+
+#include <unistd.h>
+  // ftruncate(), close(), unlink()
+
+#include <sys/stat.h>
+  // fstat(): 이미 있는 세그먼트의 크기
+
+#include <sys/mman.h>
+  // mmap(MAP_SHARED): 파일을 여러 프로세스가 같은 페이지로 나누어 본다.
+  // munmap()
+
+namespace ft
+{
+
+// offset_ptr
+// 가리키는 곳의 주소 대신, 자기 자신(this)에서 그곳까지의 거리를 저장하는 포인터.
+// 세그먼트 안의 객체끼리 가리키면 거리는 세그먼트를 어느 주소에 붙이든 같으므로, 다른 프로세스에서도 그대로 쓸 수 있다.
+// 복사하면 거리가 아니라 가리키는 곳을 복사한다. (새 자리에서 거리를 다시 잰다.)
+// 그냥 포인터(_Type*)와 서로 바뀌므로, 포인터를 쓰는 코드(_Rb_tree_algorithms 등)에 그대로 넘길 수 있다.
+template <typename _Type>
+class offset_ptr
+{
+public:
+  typedef _Type element_type;
+
+  offset_ptr() : _M_off(1) {}
+  offset_ptr(_Type* __p) { _M_set(__p); }
+  offset_ptr(const offset_ptr& __x) { _M_set(__x.get()); }
+  template <typename _Other>
+  offset_ptr(const offset_ptr<_Other>& __x) { _M_set(__x.get()); }
+
+  offset_ptr& operator=(const offset_ptr& __x) { _M_set(__x.get()); return *this; }
+  offset_ptr& operator=(_Type* __p) { _M_set(__p); return *this; }
+
+  _Type* get() const {
+    if (_M_off == 1)
+      return 0;
+    return reinterpret_cast<_Type*>(const_cast<char*>(reinterpret_cast<const char*>(this)) + _M_off);
+  }
+  operator _Type*() const { return get(); }
+  _Type* operator->() const { return get(); }
+  _Type& operator*() const { return *get(); }
+
+private:
+  // this에서 가리키는 곳까지의 바이트 거리. 1이면 null이다.
+  // (0은 자기 자신을 가리킬 때 써야 하고, offset_ptr과 대상은 모두 1바이트보다 크게 정렬되므로 1은 나올 수 없다.)
+  std::ptrdiff_t _M_off;
+
+  void _M_set(_Type* __p) {
+    _M_off = __p ? reinterpret_cast<char*>(__p) - reinterpret_cast<char*>(this) : 1;
+  }
+};
+
+// _Shm_segment_header :
+// 세그먼트 맨 앞에 놓이는 관리 정보. 위치는 모두 세그먼트 시작(= 이 header)으로부터의 거리로 저장한다. (0이면 없음)
+// 할당은 16바이트 단위로 올림한다.
+// - 4KB 이하는 크기별 free list에서 먼저 꺼내고, 없으면 아직 나눠주지 않은 공간(_M_top)의 앞에서 자른다.
+// - 더 큰 블록은 돌려받아도 세그먼트 끝(_M_top 바로 앞)에 있을 때만 다시 쓴다.
+// 잠금이 없으므로, 한 세그먼트에 할당하는 쓰기는 한 번에 하나의 프로세스(스레드)만 해야 한다.
+struct _Shm_segment_header
+{
+  enum { _S_align = 16, _S_classes = 256 };
+  static std::size_t _S_magic() { return static_cast<std::size_t>(0x66745f73686dUL); } // "ft_shm"
+
+  std::size_t _M_magic;
+  std::size_t _M_size; // 세그먼트 전체의 크기
+  std::size_t _M_top; // 아직 나눠주지 않은 공간의 시작
+  std::size_t _M_root; // 루트 객체 (find_or_construct())
+  std::size_t _M_root_type; // 루트 객체 타입의 이름(typeid)을 해시한 값. 다른 타입으로 붙으려는 것을 막는다.
+  std::size_t _M_free[_S_classes]; // _M_free[i] : (i + 1) * 16 바이트 블록의 free list
+
+  static std::size_t _S_round(std::size_t __bytes)
+    { return __bytes == 0 ? std::size_t(_S_align) : (__bytes + _S_align - 1) / _S_align * _S_align; }
+
+  char* _M_base() { return reinterpret_cast<char*>(this); }
+
+  // _S_type_tag() : 타입 이름의 FNV-1a 해시. 같은 빌드의 프로세스끼리는 같은 값이다.
+  template <typename _Type>
+  static std::size_t _S_type_tag() {
+    std::size_t __h = static_cast<std::size_t>(2166136261UL);
+    for (const char* __p = typeid(_Type).name(); *__p; ++__p) {
+      __h ^= static_cast<unsigned char>(*__p);
+      __h *= static_cast<std::size_t>(16777619UL);
+    }
+    return __h;
+  }
+
+  void _M_init(std::size_t __size) {
+    std::memset(this, 0, sizeof(*this));
+    _M_magic = _S_magic();
+    _M_size = __size;
+    _M_top = _S_round(sizeof(*this));
+  }
+
+  void* _M_allocate(std::size_t __bytes) {
+    __bytes = _S_round(__bytes);
+    if (__bytes <= std::size_t(_S_align) * _S_classes) {
+      std::size_t& __head = _M_free[__bytes / _S_align - 1];
+      if (__head != 0) {
+        char* __p = _M_base() + __head;
+        __head = *reinterpret_cast<std::size_t*>(__p); // (빈 블록의 앞에 다음 빈 블록의 위치가 있다.)
+        return __p;
+      }
+    }
+    if (__bytes > _M_size - _M_top)
+      throw std::bad_alloc();
+    char* __p = _M_base() + _M_top;
+    _M_top += __bytes;
+    return __p;
+  }
+
+  void _M_deallocate(void* __p, std::size_t __bytes) {
+    __bytes = _S_round(__bytes);
+    const std::size_t __off = static_cast<char*>(__p) - _M_base();
+    if (__bytes <= std::size_t(_S_align) * _S_classes) {
+      std::size_t& __head = _M_free[__bytes / _S_align - 1];
+      *reinterpret_cast<std::size_t*>(__p) = __head;
+      __head = __off;
+    }
+    else if (__off + __bytes == _M_top)
+      _M_top = __off;
+  }
+};
+
+template <typename _Type>
+class shm_allocator;
+
+// shm_segment
+// 파일 하나를 MAP_SHARED로 붙인 공유 메모리. (/dev/shm 아래의 파일이면 POSIX 공유 메모리이고, 보통 파일이면 mapped file이다.)
+// 같은 파일을 붙인 프로세스들은 같은 페이지를 본다. 붙는 주소는 프로세스마다 다를 수 있으므로,
+// 세그먼트 안의 객체는 서로를 offset_ptr로 가리켜야 한다. (offset_map이 그렇게 만들어져 있다.)
+//
+// shm_segment(path, bytes) : 파일이 없거나 비어 있으면 bytes 크기로 만들고 초기화한다. 있으면 그대로 붙는다.
+// shm_segment(path) : 이미 만들어진 세그먼트에 붙기만 한다.
+// 세그먼트를 만드는 것은 한 프로세스만 하고, 다른 프로세스는 그 다음에 붙는다.
+// shm_segment 객체가 없어지면 붙인 것만 떼고, 파일과 내용은 남는다. (지우려면 remove())
+class shm_segment
+{
+public:
+  explicit shm_segment(const char* __path, std::size_t __bytes = 0)
+    : _M_fd(-1), _M_base(0), _M_size(0)
+  {
+    _M_fd = ::open(__path, __bytes ? O_RDWR | O_CREAT : O_RDWR, 0600);
+    if (_M_fd < 0)
+      throw std::runtime_error("shm_segment: cannot open");
+    try {
+      struct stat __st;
+      if (::fstat(_M_fd, &__st) != 0)
+        throw std::runtime_error("shm_segment: cannot stat");
+      const bool __fresh = (__st.st_size == 0);
+      if (__fresh) {
+        if (__bytes < 2 * sizeof(_Shm_segment_header))
+          __bytes = 2 * sizeof(_Shm_segment_header);
+        if (::ftruncate(_M_fd, __bytes) != 0)
+          throw std::runtime_error("shm_segment: cannot resize");
+        _M_size = __bytes;
+      }
+      else
+        _M_size = static_cast<std::size_t>(__st.st_size);
+      void* __p = ::mmap(0, _M_size, PROT_READ | PROT_WRITE, MAP_SHARED, _M_fd, 0);
+      if (__p == MAP_FAILED)
+        throw std::bad_alloc();
+      _M_base = __p;
+      if (__fresh)
+        _M_header()->_M_init(_M_size);
+      else if (_M_size < sizeof(_Shm_segment_header) ||
+               _M_header()->_M_magic != _Shm_segment_header::_S_magic() ||
+               _M_header()->_M_size != _M_size)
+        throw std::runtime_error("shm_segment: not a segment");
+    }
+    catch (...) {
+      if (_M_base)
+        ::munmap(_M_base, _M_size);
+      ::close(_M_fd);
+      throw;
+    }
+  }
+
+  ~shm_segment() {
+    ::munmap(_M_base, _M_size);
+    ::close(_M_fd);
+  }
+
+  // 이 프로세스에서 세그먼트가 붙은 주소
+  void* base() const { return _M_base; }
+  std::size_t size() const { return _M_size; }
+
+  // free_bytes() : 아직 한 번도 나눠주지 않은 공간의 크기 (free list에 돌아온 블록은 세지 않는다.)
+  std::size_t free_bytes() const { return _M_header()->_M_size - _M_header()->_M_top; }
+
+  // find_or_construct() :
+  // 세그먼트의 루트 객체. 없으면 세그먼트 안에 _Type(shm_allocator<char>(*this))로 만든다.
+  // 다른 프로세스는 같은 _Type으로 불러 같은 객체를 얻는다. (다른 타입이면 std::runtime_error를 던진다.)
+  template <typename _Type>
+  _Type* find_or_construct() {
+    _Type* __p = find<_Type>();
+    if (__p)
+      return __p;
+    _Shm_segment_header* __h = _M_header();
+    void* __mem = __h->_M_allocate(sizeof(_Type));
+    try {
+      __p = ::new (__mem) _Type(shm_allocator<char>(*this));
+    }
+    catch (...) {
+      __h->_M_deallocate(__mem, sizeof(_Type));
+      throw;
+    }
+    __h->_M_root = static_cast<char*>(__mem) - __h->_M_base();
+    __h->_M_root_type = _Shm_segment_header::_S_type_tag<_Type>();
+    return __p;
+  }
+
+  // find() : 루트 객체. 없으면 null
+  template <typename _Type>
+  _Type* find() const {
+    _Shm_segment_header* __h = _M_header();
+    if (__h->_M_root == 0)
+      return 0;
+    if (__h->_M_root_type != _Shm_segment_header::_S_type_tag<_Type>())
+      throw std::runtime_error("shm_segment: root type mismatch");
+    return reinterpret_cast<_Type*>(__h->_M_base() + __h->_M_root);
+  }
+
+  // destroy() : 루트 객체를 소멸시키고 공간을 돌려준다.
+  template <typename _Type>
+  void destroy() {
+    _Type* __p = find<_Type>();
+    if (!__p)
+      return;
+    __p->~_Type();
+    _M_header()->_M_deallocate(__p, sizeof(_Type));
+    _M_header()->_M_root = 0;
+    _M_header()->_M_root_type = 0;
+  }
+
+  // remove() : 세그먼트 파일을 지운다. 이미 붙어 있는 프로세스는 뗄 때까지 계속 쓸 수 있다.
+  static bool remove(const char* __path) { return ::unlink(__path) == 0; }
+
+private:
+  int _M_fd;
+  void* _M_base;
+  std::size_t _M_size;
+
+  _Shm_segment_header* _M_header() const { return static_cast<_Shm_segment_header*>(_M_base); }
+
+  // 붙인 매핑을 하나만 가지므로 복사할 수 없다.
+  shm_segment(const shm_segment&);
+  shm_segment& operator=(const shm_segment&);
+
+  template <typename _Type>
+  friend class shm_allocator;
+};
+
+// shm_allocator
+// shm_segment 안에서 할당하는 할당기. 세그먼트 header를 offset_ptr로 가리키므로,
+// 할당기 자체를 세그먼트 안(예: offset_map의 멤버)에 두면 다른 프로세스에서도 그대로 쓸 수 있다.
+// 같은 세그먼트의 할당기끼리는 같다. (서로의 블록을 해제할 수 있다.)
+template <typename _Type>
+class shm_allocator
+{
+public:
+  typedef _Type value_type;
+  typedef _Type* pointer;
+  typedef const _Type* const_pointer;
+  typedef _Type& reference;
+  typedef const _Type& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template <typename _Other>
+  struct rebind { typedef shm_allocator<_Other> other; };
+
+  explicit shm_allocator(shm_segment& __s) : _M_header(__s._M_header()) {}
+  shm_allocator(const shm_allocator& __a) : _M_header(__a._M_header) {}
+  template <typename _Other>
+  shm_allocator(const shm_allocator<_Other>& __a) : _M_header(__a._M_header) {}
+
+  shm_allocator& operator=(const shm_allocator& __a) { _M_header = __a._M_header; return *this; }
+
+  pointer address(reference __x) const { return &__x; }
+  const_pointer address(const_reference __x) const { return &__x; }
+
+  pointer allocate(size_type __n, const void* = 0) {
+    if (__n > max_size())
+      throw std::bad_alloc();
+    return static_cast<pointer>(_M_header->_M_allocate(__n * sizeof(_Type)));
+  }
+  void deallocate(pointer __p, size_type __n) { _M_header->_M_deallocate(__p, __n * sizeof(_Type)); }
+
+  size_type max_size() const { return size_type(-1) / sizeof(_Type); }
+
+  void construct(pointer __p, const _Type& __v) { ::new (static_cast<void*>(__p)) _Type(__v); }
+  void destroy(pointer __p) { __p->~_Type(); }
+
+  template <typename _T1, typename _T2>
+  friend bool operator==(const shm_allocator<_T1>&, const shm_allocator<_T2>&);
+
+private:
+  offset_ptr<_Shm_segment_header> _M_header;
+
+  template <typename _Other>
+  friend class shm_allocator;
+};
+
+template <typename _T1, typename _T2>
+bool operator==(const shm_allocator<_T1>& __x, const shm_allocator<_T2>& __y)
+  { return __x._M_header.get() == __y._M_header.get(); }
+
+template <typename _T1, typename _T2>
+bool operator!=(const shm_allocator<_T1>& __x, const shm_allocator<_T2>& __y)
+  { return !(__x == __y); }
+
+} // namespace ft
+
+#endif /* SHM_ALLOCATOR_HPP */
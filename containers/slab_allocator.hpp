@@ -0,0 +1,313 @@
+#ifndef SLAB_ALLOCATOR_HPP
+#define SLAB_ALLOCATOR_HPP
+
+#include <cstddef>
+  // size_t, ptrdiff_t
+
+#include <new>
+  // ::operator new(), ::operator delete()
+  // std::bad_alloc
+
+#include <limits>
+  // std::numeric_limits
+
+#include "alloc.hpp"
+  // _Alloc_traits: 아래에서 slab_allocator에 대해 특수화한다.
+
+namespace ft
+{
+
+// _Slab_pool
+// : 같은 크기의 슬롯을 큰 덩어리(slab)에서 잘라 나누어 주는 풀.
+//
+// 해제된 슬롯은 그 자리에 다음 빈 슬롯의 주소를 써서 연결한다. (intrusive free list)
+// slab은 처음에 _S_first_slots개의 슬롯으로 시작해서, 새로 만들 때마다 2배씩 (_S_max_slots까지) 커진다.
+// 따라서 노드 백만 개를 만들어도 malloc은 수십 번만 일어나고, 노드들은 몇 개의 큰 덩어리 안에 모여 있다.
+// 풀은 할당기의 복사본들이 공유하고, 마지막 복사본이 사라질 때 slab을 모두 돌려준다. (참조 횟수)
+class _Slab_pool
+{
+  struct _Slot { _Slot* _M_next; };
+
+  // 각 slab의 맨 앞에 놓이는 머리. slab끼리 연결한다.
+  struct _Slab {
+    _Slab* _M_next;
+    std::size_t _M_slots;
+  };
+
+  enum { _S_first_slots = 32, _S_max_slots = 1 << 14 };
+
+  std::size_t _M_slot_size;
+  std::size_t _M_refcount;
+  _Slot* _M_free; // 해제된 슬롯 목록
+  _Slab* _M_slabs; // 가장 최근의 slab부터 연결되어 있다.
+  char* _M_cur; // 가장 최근의 slab에서 아직 한 번도 나누어 주지 않은 부분
+  char* _M_end;
+  std::size_t _M_next_slots; // 다음 slab의 슬롯 수
+
+  // slab 머리의 크기. 뒤따르는 슬롯이 정렬되도록 16바이트 단위로 올린다.
+  static std::size_t _S_header_size() { return (sizeof(_Slab) + 15) / 16 * 16; }
+
+  char* _M_first_slot(_Slab* __s) const { return reinterpret_cast<char*>(__s) + _S_header_size(); }
+
+  void _M_add_slab()
+  {
+    const std::size_t __slots = _M_next_slots;
+    _Slab* __s = static_cast<_Slab*>(::operator new(_S_header_size() + __slots * _M_slot_size));
+    __s->_M_next = _M_slabs;
+    __s->_M_slots = __slots;
+    _M_slabs = __s;
+    _M_cur = _M_first_slot(__s);
+    _M_end = _M_cur + __slots * _M_slot_size;
+    if (_M_next_slots < _S_max_slots)
+      _M_next_slots *= 2;
+  }
+
+  _Slab_pool(const _Slab_pool&);
+  _Slab_pool& operator=(const _Slab_pool&);
+
+public:
+  // __slot_size: 나누어 줄 슬롯의 크기 (정렬이 맞추어진 크기여야 한다.)
+  explicit _Slab_pool(std::size_t __slot_size)
+    : _M_slot_size(__slot_size), _M_refcount(1), _M_free(0), _M_slabs(0),
+      _M_cur(0), _M_end(0), _M_next_slots(_S_first_slots) {}
+
+  ~_Slab_pool() { release(0); }
+
+  void _M_add_ref() { ++_M_refcount; }
+  std::size_t _M_drop_ref() { return --_M_refcount; }
+  bool _M_unshared() const { return _M_refcount == 1; }
+
+  void* get()
+  {
+    if (_M_free) {
+      _Slot* __p = _M_free;
+      _M_free = __p->_M_next;
+      return __p;
+    }
+    if (_M_cur == _M_end)
+      _M_add_slab();
+    void* __p = _M_cur;
+    _M_cur += _M_slot_size;
+    return __p;
+  }
+
+  void put(void* __p)
+  {
+    _Slot* __s = static_cast<_Slot*>(__p);
+    __s->_M_next = _M_free;
+    _M_free = __s;
+  }
+
+  // _M_absorb() :
+  // 슬롯 크기가 같은 __o의 slab과 빈 슬롯을 모두 가져온다. __o는 빈 풀이 된다.
+  // 이후에는 __o가 나누어 준 슬롯도 이 풀에 put()하고, release()로 한 번에 돌려줄 수 있다.
+  void _M_absorb(_Slab_pool& __o)
+  {
+    // __o가 아직 나누어 주지 않은 부분은 빈 슬롯으로 바꾼다.
+    for (char* __p = __o._M_cur; __p != __o._M_end; __p += _M_slot_size)
+      __o.put(__p);
+    __o._M_cur = __o._M_end = 0;
+    if (__o._M_slabs) {
+      // 가장 최근의 slab(_M_cur가 가리키는 slab)이 계속 맨 앞에 오도록, 그 뒤에 끼워 넣는다.
+      _Slab* __tail = __o._M_slabs;
+      while (__tail->_M_next)
+        __tail = __tail->_M_next;
+      if (_M_slabs) {
+        __tail->_M_next = _M_slabs->_M_next;
+        _M_slabs->_M_next = __o._M_slabs;
+      }
+      else
+        _M_slabs = __o._M_slabs;
+      __o._M_slabs = 0;
+    }
+    if (__o._M_free) {
+      _Slot* __tail = __o._M_free;
+      while (__tail->_M_next)
+        __tail = __tail->_M_next;
+      __tail->_M_next = _M_free;
+      _M_free = __o._M_free;
+      __o._M_free = 0;
+    }
+  }
+
+  // release() :
+  // __keep이 들어있는 slab만 남기고 모든 slab을 한 번에 돌려준다. (__keep이 0이면 전부)
+  // 남긴 slab에서는 __keep을 제외한 슬롯이 모두 빈 슬롯이 된다.
+  // 나누어 준 슬롯 하나하나를 해제할 필요가 없으므로, _Rb_tree::clear()가 노드마다 put()하는 대신 사용한다.
+  void release(void* __keep)
+  {
+    _Slab* __kept = 0;
+    while (_M_slabs) {
+      _Slab* __s = _M_slabs;
+      _M_slabs = __s->_M_next;
+      char* __first = _M_first_slot(__s);
+      char* __k = static_cast<char*>(__keep);
+      if (__k >= __first && __k < __first + __s->_M_slots * _M_slot_size)
+        __kept = __s;
+      else
+        ::operator delete(__s);
+    }
+    _M_free = 0;
+    _M_cur = _M_end = 0;
+    if (__kept) {
+      __kept->_M_next = 0;
+      _M_slabs = __kept;
+      char* __first = _M_first_slot(__kept);
+      for (std::size_t __i = __kept->_M_slots; __i != 0; ) {
+        char* __p = __first + --__i * _M_slot_size;
+        if (__p != __keep)
+          put(__p);
+      }
+    }
+  }
+};
+
+// slab_allocator
+// : 요소 하나짜리 할당(allocate(1))을 _Slab_pool에서 처리하는 할당기.
+//
+// map<Key, T, Compare, slab_allocator<pair<const Key, T> > >처럼 쓰면,
+// _Rb_tree_base가 _Alloc_traits로 rebind한 노드용 slab_allocator가 노드를 slab에서 받아온다.
+// 복사본끼리는 풀을 공유하지만, 다른 타입으로 변환(rebind)하면 슬롯 크기가 다르므로 새 풀을 쓴다.
+// 풀은 처음 할당할 때 만들어진다. 두 개 이상을 한꺼번에 할당하는 경우는 그냥 ::operator new를 사용한다.
+// 할당기마다 풀이 따로 있으므로, 할당기를 바꾸지 않고 공간만 바꾸는 컨테이너에는 쓸 수 없다.
+// ft의 컨테이너(map, vector, devector, stable_vector 등)는 swap()에서 할당기도 함께 바꾸므로 그대로 쓸 수 있다.
+// (vector처럼 한 번에 여러 개를 할당하는 컨테이너에서는 크기가 1인 공간만 풀에서 받는다.)
+// (풀의 참조 횟수는 스레드에 안전하지 않다. 컨테이너와 마찬가지로 한 스레드에서 사용한다.)
+template <typename _Type>
+class slab_allocator
+{
+public:
+  typedef _Type value_type;
+  typedef _Type* pointer;
+  typedef const _Type* const_pointer;
+  typedef _Type& reference;
+  typedef const _Type& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template <typename _Other>
+  struct rebind { typedef slab_allocator<_Other> other; };
+
+  slab_allocator() : _M_pool(0) {}
+
+  slab_allocator(const slab_allocator& __a) : _M_pool(__a._M_pool)
+    { if (_M_pool) _M_pool->_M_add_ref(); }
+
+  template <typename _Other>
+  slab_allocator(const slab_allocator<_Other>&) : _M_pool(0) {}
+
+  ~slab_allocator() { _M_drop(); }
+
+  slab_allocator& operator=(const slab_allocator& __a)
+  {
+    if (__a._M_pool)
+      __a._M_pool->_M_add_ref();
+    _M_drop();
+    _M_pool = __a._M_pool;
+    return *this;
+  }
+
+  pointer address(reference __x) const { return &__x; }
+  const_pointer address(const_reference __x) const { return &__x; }
+
+  pointer allocate(size_type __n, const void* = 0)
+  {
+    if (__n != 1)
+      return static_cast<pointer>(::operator new(__n * sizeof(_Type)));
+    if (_M_pool == 0)
+      _M_pool = new _Slab_pool(_S_slot_size());
+    return static_cast<pointer>(_M_pool->get());
+  }
+
+  void deallocate(pointer __p, size_type __n)
+  {
+    if (__n != 1)
+      ::operator delete(__p);
+    else
+      _M_pool->put(__p);
+  }
+
+  size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(_Type); }
+
+  void construct(pointer __p, const _Type& __val) { new (static_cast<void*>(__p)) _Type(__val); }
+  void destroy(pointer __p) { __p->~_Type(); }
+
+  // _M_release_all() :
+  // 이 할당기만 풀을 쓰고 있을 때, __keep의 slab을 제외한 모든 slab을 돌려준다. 돌려주었으면 true.
+  bool _M_release_all(void* __keep)
+  {
+    if (_M_pool == 0 || !_M_pool->_M_unshared())
+      return false;
+    _M_pool->release(__keep);
+    return true;
+  }
+
+  bool _M_can_release_all() const { return _M_pool != 0 && _M_pool->_M_unshared(); }
+
+  // _M_adopt() :
+  // __arena가 할당한 것을 이 할당기가 해제할 수 있도록, __arena의 풀을 이 풀로 옮긴다.
+  void _M_adopt(slab_allocator& __arena)
+  {
+    if (__arena._M_pool == 0 || __arena._M_pool == _M_pool)
+      return;
+    if (_M_pool == 0)
+      _M_pool = new _Slab_pool(_S_slot_size());
+    _M_pool->_M_absorb(*__arena._M_pool);
+  }
+
+  // _M_swap_pool() :
+  // 복사와 대입을 거치지 않고 풀 포인터만 바꾼다. (참조 횟수는 그대로다.)
+  void _M_swap_pool(slab_allocator& __a) { std::swap(_M_pool, __a._M_pool); }
+
+private:
+  _Slab_pool* _M_pool;
+
+  // 다른 타입으로 rebind한 할당기끼리도 풀을 비교한다.
+  template <typename _T1, typename _T2>
+  friend bool operator==(const slab_allocator<_T1>&, const slab_allocator<_T2>&);
+  template <typename _T1, typename _T2>
+  friend bool operator!=(const slab_allocator<_T1>&, const slab_allocator<_T2>&);
+
+  // 슬롯 크기: _Type의 크기를 정렬 단위의 배수로 올린다. (빈 슬롯이 포인터를 담을 수 있어야 한다.)
+  static size_type _S_slot_size()
+  {
+    const size_type __align = __alignof__(_Type) > __alignof__(void*) ? __alignof__(_Type) : __alignof__(void*);
+    const size_type __size = sizeof(_Type) > sizeof(void*) ? sizeof(_Type) : sizeof(void*);
+    return (__size + __align - 1) / __align * __align;
+  }
+
+  void _M_drop()
+  {
+    if (_M_pool && _M_pool->_M_drop_ref() == 0)
+      delete _M_pool;
+  }
+};
+
+// 같은 풀을 쓰는 할당기끼리만 서로의 메모리를 해제할 수 있다.
+template <typename _T1, typename _T2>
+bool operator==(const slab_allocator<_T1>& __x, const slab_allocator<_T2>& __y)
+  { return __x._M_pool == __y._M_pool; }
+
+template <typename _T1, typename _T2>
+bool operator!=(const slab_allocator<_T1>& __x, const slab_allocator<_T2>& __y)
+  { return __x._M_pool != __y._M_pool; }
+
+} // namespace ft
+
+// _Alloc_traits 특수화 : slab_allocator는 노드를 한 번에 해제할 수 있다.
+template <class _Type, class _Other>
+struct _Alloc_traits<_Type, ft::slab_allocator<_Other> >
+{
+  typedef ft::slab_allocator<_Type> allocator_type;
+
+  static bool _S_can_release_all(const allocator_type& __a) { return __a._M_can_release_all(); }
+  static void _S_release_all(allocator_type& __a, void* __keep) { __a._M_release_all(__keep); }
+
+  static void _S_swap(allocator_type& __a, allocator_type& __b) { __a._M_swap_pool(__b); }
+
+  // 풀은 스레드에 안전하지 않으므로, 스레드마다 새 풀을 쓰고 끝나면 __a의 풀로 합친다.
+  static allocator_type _S_arena(const allocator_type&) { return allocator_type(); }
+  static void _S_adopt(allocator_type& __a, allocator_type& __arena) { __a._M_adopt(__arena); }
+};
+
+#endif // SLAB_ALLOCATOR_HPP
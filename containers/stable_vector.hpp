@@ -0,0 +1,611 @@
+#ifndef STABLE_VECTOR_HPP
+#define STABLE_VECTOR_HPP
+
+#include <memory>
+  // std::allocator
+
+#include <iterator>
+  // std::distance(), std::random_access_iterator_tag
+
+#include <limits>
+  // std::numeric_limits
+
+#include <stdexcept>
+  // std::out_of_range
+
+#include "vector.hpp"
+  // ft::vector: 포인터 배열(index)과 청크 목록을 담는다.
+
+#include "alloc.hpp"
+  // _Alloc_traits: 요소 할당기를 포인터용 할당기로 rebind한다.
+
+#include "iterator.hpp"
+  // ft::reverse_iterator
+
+#include "algorithm.hpp"
+  // ft::equal(), ft::lexicographical_compare()
+
+#include "type_traits.hpp"
+  // ft::enable_if
+  // ft::is_integral
+
+namespace ft
+{
+
+// stable_vector
+// : 요소 자체는 풀(pool)에서 할당한 고정된 슬롯에 두고, 요소를 가리키는 포인터 배열만 연속으로 유지하는 시퀀스 컨테이너.
+//
+// vector<Buffer>처럼 요소가 큰 경우, vector는 재할당할 때마다 요소 전체(4KB)를 복사한다.
+// stable_vector는 재할당할 때 포인터(8바이트)만 옮기고, 요소는 한 번 생성된 자리에서 움직이지 않는다.
+// 따라서 push_back, insert, erase 이후에도 (지워지지 않은) 요소에 대한 참조와 포인터는 계속 유효하다.
+// (반복자는 포인터 배열을 가리키므로, vector와 마찬가지로 재할당 시 무효화된다.)
+
+//------------------     iterator     ------------------//
+
+// 포인터 배열 위를 움직이는 임의접근반복자. 역참조할 때 한 번 더 따라간다.
+template <typename _Type, typename _Reference, typename _Pointer>
+struct _Stable_vector_iterator
+{
+  typedef std::random_access_iterator_tag iterator_category;
+  typedef _Type value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef _Reference reference;
+  typedef _Pointer pointer;
+
+  typedef _Stable_vector_iterator<_Type, _Type&, _Type*> iterator;
+  typedef _Stable_vector_iterator<_Type, _Reference, _Pointer> _Self;
+
+  _Type* const* _M_cur; // 포인터 배열 안의 현재 위치
+
+  _Stable_vector_iterator() : _M_cur(0) {}
+  explicit _Stable_vector_iterator(_Type* const* __p) : _M_cur(__p) {}
+  _Stable_vector_iterator(const iterator& __it) : _M_cur(__it._M_cur) {}
+
+  _Type* const* base() const { return _M_cur; }
+
+  reference operator*() const { return **_M_cur; }
+  pointer operator->() const { return *_M_cur; }
+  reference operator[](difference_type __n) const { return *_M_cur[__n]; }
+
+  _Self& operator++() { ++_M_cur; return *this; }
+  _Self operator++(int) { _Self __tmp = *this; ++_M_cur; return __tmp; }
+  _Self& operator--() { --_M_cur; return *this; }
+  _Self operator--(int) { _Self __tmp = *this; --_M_cur; return __tmp; }
+
+  _Self& operator+=(difference_type __n) { _M_cur += __n; return *this; }
+  _Self& operator-=(difference_type __n) { _M_cur -= __n; return *this; }
+  _Self operator+(difference_type __n) const { return _Self(_M_cur + __n); }
+  _Self operator-(difference_type __n) const { return _Self(_M_cur - __n); }
+};
+
+// const와 그냥 반복자를 섞어서 비교할 수 있도록, base()로 비교한다.
+
+template <class _Type, class _RefL, class _PtrL, class _RefR, class _PtrR>
+bool operator==(const _Stable_vector_iterator<_Type, _RefL, _PtrL>& __x,
+                const _Stable_vector_iterator<_Type, _RefR, _PtrR>& __y)
+{ return __x.base() == __y.base(); }
+
+template <class _Type, class _RefL, class _PtrL, class _RefR, class _PtrR>
+bool operator!=(const _Stable_vector_iterator<_Type, _RefL, _PtrL>& __x,
+                const _Stable_vector_iterator<_Type, _RefR, _PtrR>& __y)
+{ return __x.base() != __y.base(); }
+
+template <class _Type, class _RefL, class _PtrL, class _RefR, class _PtrR>
+bool operator<(const _Stable_vector_iterator<_Type, _RefL, _PtrL>& __x,
+               const _Stable_vector_iterator<_Type, _RefR, _PtrR>& __y)
+{ return __x.base() < __y.base(); }
+
+template <class _Type, class _RefL, class _PtrL, class _RefR, class _PtrR>
+bool operator>(const _Stable_vector_iterator<_Type, _RefL, _PtrL>& __x,
+               const _Stable_vector_iterator<_Type, _RefR, _PtrR>& __y)
+{ return __y < __x; }
+
+template <class _Type, class _RefL, class _PtrL, class _RefR, class _PtrR>
+bool operator<=(const _Stable_vector_iterator<_Type, _RefL, _PtrL>& __x,
+                const _Stable_vector_iterator<_Type, _RefR, _PtrR>& __y)
+{ return !(__y < __x); }
+
+template <class _Type, class _RefL, class _PtrL, class _RefR, class _PtrR>
+bool operator>=(const _Stable_vector_iterator<_Type, _RefL, _PtrL>& __x,
+                const _Stable_vector_iterator<_Type, _RefR, _PtrR>& __y)
+{ return !(__x < __y); }
+
+template <class _Type, class _RefL, class _PtrL, class _RefR, class _PtrR>
+std::ptrdiff_t operator-(const _Stable_vector_iterator<_Type, _RefL, _PtrL>& __x,
+                         const _Stable_vector_iterator<_Type, _RefR, _PtrR>& __y)
+{ return __x.base() - __y.base(); }
+
+template <class _Type, class _Ref, class _Ptr>
+_Stable_vector_iterator<_Type, _Ref, _Ptr>
+operator+(std::ptrdiff_t __n, const _Stable_vector_iterator<_Type, _Ref, _Ptr>& __x)
+{ return __x + __n; }
+
+//------------------     stable_vector_base     ------------------//
+
+// stable_vector base는 슬롯 풀을 담당한다. (vector base처럼 공간의 할당/해제만 하고, 초기화는 하지 않는다.)
+// 슬롯은 청크 단위로 한꺼번에 할당하고, 청크 크기는 지금까지 할당한 슬롯 수만큼 커진다. (vector의 2배 정책과 같다.)
+// 지워진 요소의 슬롯은 free list에 넣어 두었다가 다음 삽입에 재사용한다.
+template <typename _Type, typename _AllocatorType>
+class _Stable_vector_base {
+
+public:
+  typedef _AllocatorType allocator_type;
+  typedef typename _Alloc_traits<_Type*, _AllocatorType>::allocator_type _Ptr_allocator_type;
+
+  allocator_type get_allocator() const { return _M_data_allocator; }
+
+protected:
+  struct _Chunk {
+    _Type* _M_start;
+    size_t _M_size;
+  };
+  typedef typename _Alloc_traits<_Chunk, _AllocatorType>::allocator_type _Chunk_allocator_type;
+
+  allocator_type _M_data_allocator;
+  vector<_Type*, _Ptr_allocator_type> _M_index; // 요소를 가리키는 포인터 배열 (이것만 연속이다)
+  vector<_Type*, _Ptr_allocator_type> _M_free_slots; // 재사용할 슬롯
+  vector<_Chunk, _Chunk_allocator_type> _M_chunks; // 할당한 청크 목록
+  _Type* _M_chunk_cur; // 마지막 청크에서 아직 한 번도 쓰지 않은 첫 슬롯
+  _Type* _M_chunk_end; // 마지막 청크의 끝
+  size_t _M_slot_count; // 지금까지 할당한 슬롯의 수
+
+  // _M_get_slot() :
+  // 초기화되지 않은 슬롯 1개를 반환한다. 재사용할 슬롯이 있으면 그것을 먼저 쓴다.
+  _Type* _M_get_slot() {
+    if (!_M_free_slots.empty()) {
+      _Type* __p = _M_free_slots.back();
+      _M_free_slots.pop_back();
+      return __p;
+    }
+    if (_M_chunk_cur == _M_chunk_end)
+      _M_add_chunk(_M_slot_count != 0 ? _M_slot_count : 1);
+    return _M_chunk_cur++;
+  }
+
+  // _M_put_slot() :
+  // (이미 destroy된) 슬롯을 free list에 돌려준다.
+  void _M_put_slot(_Type* __p) { _M_free_slots.push_back(__p); }
+
+  // _M_reserve_slots() :
+  // 앞으로 __n개의 슬롯을 더 쓸 수 있도록 청크를 미리 할당한다.
+  void _M_reserve_slots(size_t __n) {
+    size_t __avail = _M_free_slots.size() + (_M_chunk_end - _M_chunk_cur);
+    if (__avail < __n)
+      _M_add_chunk(__n - __avail);
+  }
+
+  void _M_add_chunk(size_t __n) {
+    // free list가 나중에 모든 슬롯을 담을 수 있도록 미리 늘려둔다. (_M_put_slot()이 예외를 던지지 않게 된다.)
+    _M_free_slots.reserve(_M_slot_count + __n);
+    _M_chunks.reserve(_M_chunks.size() + 1);
+    // 마지막 청크에 남은 슬롯은 free list로 옮겨서 버리지 않는다.
+    for (; _M_chunk_cur != _M_chunk_end; ++_M_chunk_cur)
+      _M_free_slots.push_back(_M_chunk_cur);
+    _Chunk __c;
+    __c._M_start = _M_data_allocator.allocate(__n);
+    __c._M_size = __n;
+    _M_chunks.push_back(__c);
+    _M_chunk_cur = __c._M_start;
+    _M_chunk_end = __c._M_start + __n;
+    _M_slot_count += __n;
+  }
+
+  // _M_release_slots() :
+  // 모든 청크를 해제한다. (요소는 미리 destroy되어 있어야 한다.)
+  void _M_release_slots() {
+    for (size_t __i = 0; __i < _M_chunks.size(); ++__i)
+      _M_data_allocator.deallocate(_M_chunks[__i]._M_start, _M_chunks[__i]._M_size);
+    _M_chunks.clear();
+    _M_free_slots.clear();
+    _M_chunk_cur = 0;
+    _M_chunk_end = 0;
+    _M_slot_count = 0;
+  }
+
+  // _M_swap_base() : 청크는 그것을 할당한 할당기가 해제해야 하므로, 할당기도 함께 바꾼다.
+  void _M_swap_base(_Stable_vector_base& __x) {
+    _Alloc_traits<_Type, _AllocatorType>::_S_swap(_M_data_allocator, __x._M_data_allocator);
+    _M_index.swap(__x._M_index);
+    _M_free_slots.swap(__x._M_free_slots);
+    _M_chunks.swap(__x._M_chunks);
+    std::swap(_M_chunk_cur, __x._M_chunk_cur);
+    std::swap(_M_chunk_end, __x._M_chunk_end);
+    std::swap(_M_slot_count, __x._M_slot_count);
+  }
+
+public:
+  // CONSTRUCTOR
+  _Stable_vector_base(const allocator_type& __a)
+    : _M_data_allocator(__a), _M_index(_Ptr_allocator_type(__a)),
+      _M_free_slots(_Ptr_allocator_type(__a)), _M_chunks(_Chunk_allocator_type(__a)),
+      _M_chunk_cur(0), _M_chunk_end(0), _M_slot_count(0) {}
+
+  // DESTRUCTOR
+  ~_Stable_vector_base() { _M_release_slots(); }
+}; // class _Stable_vector_base
+
+
+
+template <
+  typename _Type, // 요소의 타입
+  typename _AllocatorType = std::allocator<_Type> // 할당기 객체의 타입
+> class stable_vector : protected _Stable_vector_base<_Type, _AllocatorType>
+{
+
+private:
+  typedef _Stable_vector_base<_Type, _AllocatorType> _Base;
+  typedef stable_vector<_Type, _AllocatorType> stable_vector_type;
+
+public:
+  // Member types
+
+  typedef _Type  value_type;
+  typedef typename _Base::allocator_type  allocator_type;
+  typedef std::size_t  size_type;
+  typedef std::ptrdiff_t  difference_type;
+
+  typedef value_type& reference;
+  typedef const value_type&  const_reference;
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::const_pointer const_pointer;
+
+  typedef _Stable_vector_iterator<_Type, _Type&, _Type*>  iterator;
+  typedef _Stable_vector_iterator<_Type, const _Type&, const _Type*>  const_iterator;
+
+  typedef ft::reverse_iterator<const_iterator>  const_reverse_iterator;
+  typedef ft::reverse_iterator<iterator>  reverse_iterator;
+
+protected:
+  using _Base::_M_index;
+  using _Base::_M_get_slot;
+  using _Base::_M_put_slot;
+  using _Base::_M_reserve_slots;
+
+public:
+  // 멤버함수: 요소 접근 관련
+
+  reference at(size_type __n) {
+    _M_range_check(__n);
+    return (*this)[__n];
+  }
+
+  const_reference at(size_type __n) const {
+    _M_range_check(__n);
+    return (*this)[__n];
+  }
+
+  reference operator[](size_type __n) { return *_M_index[__n]; }
+  const_reference operator[](size_type __n) const { return *_M_index[__n]; }
+
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+
+  reference back() { return *(end() - 1); }
+  const_reference back() const { return *(end() - 1); }
+
+  // data() :
+  // vector와 달리 요소는 연속이 아니다. 연속인 포인터 배열을 반환한다.
+  _Type* const* data() const { return _M_index.data(); }
+
+public:
+  // 멤버함수: 반복자 관련
+
+  iterator begin() { return iterator(_M_index.data()); }
+  const_iterator begin() const { return const_iterator(_M_index.data()); }
+
+  iterator end() { return iterator(_M_index.data() + _M_index.size()); }
+  const_iterator end() const { return const_iterator(_M_index.data() + _M_index.size()); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+public:
+  // 멤버함수: capacity 관련
+
+  bool empty() const { return _M_index.empty(); }
+
+  size_type size() const { return _M_index.size(); }
+
+  size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(_Type); }
+
+  // reserve() :
+  // 포인터 배열과 슬롯을 함께 미리 확보한다. 이후 __n개까지는 할당 없이 삽입된다.
+  void reserve(size_type __n) {
+    if (__n > size())
+      _M_reserve_slots(__n - size());
+    _M_index.reserve(__n);
+  }
+
+  // capacity() :
+  // 재할당 없이 가질 수 있는 요소의 수 (포인터 배열 기준)
+  size_type capacity() const { return _M_index.capacity(); }
+
+public:
+  // 멤버함수: 변환자
+
+  void clear() { erase(begin(), end()); }
+
+  // insert1. 단일 요소 :
+  // 요소를 새 슬롯에 생성한 다음, 포인터만 포인터 배열에 끼워넣는다. 다른 요소는 움직이지 않는다.
+  iterator insert(iterator __position, const _Type& __x) {
+    size_type __n = __position - begin();
+    _Type* __p = _M_create_element(__x);
+    try {
+      _M_index.insert(_M_index.begin() + __n, __p);
+    }
+    catch(...)
+    {
+  _M_destroy_element(__p);
+  throw;
+    }
+    return begin() + __n;
+  }
+
+  // insert2. 채우기 :
+  void insert(iterator __pos, size_type __n, const _Type& __x) {
+    vector<_Type*, typename _Base::_Ptr_allocator_type> __tmp(get_allocator());
+    __tmp.reserve(__n);
+    try {
+      for (; __n != 0; --__n)
+        __tmp.push_back(_M_create_element(__x));
+    }
+    catch(...)
+    {
+  _M_destroy_elements(__tmp);
+  throw;
+    }
+    _M_insert_pointers(__pos, __tmp);
+  }
+
+  // insert3. 범위 :
+  template<typename _InputIterator>
+  void insert(
+    iterator __pos,
+    typename ft::enable_if<!ft::is_integral<_InputIterator>::value,
+    _InputIterator>::type __first,
+    _InputIterator __last) {
+    vector<_Type*, typename _Base::_Ptr_allocator_type> __tmp(get_allocator());
+    try {
+      for (; __first != __last; ++__first) {
+        if (__tmp.size() == __tmp.capacity()) // push_back()이 던지기 전에 생성한 요소를 잃어버리지 않도록 공간을 먼저 확보한다
+          __tmp.reserve(__tmp.size() != 0 ? 2 * __tmp.size() : 1);
+        __tmp.push_back(_M_create_element(*__first));
+      }
+    }
+    catch(...)
+    {
+  _M_destroy_elements(__tmp);
+  throw;
+    }
+    _M_insert_pointers(__pos, __tmp);
+  }
+
+  // erase1. 단일 요소
+  // 지운 요소의 슬롯은 재사용되고, 포인터 배열에서만 뒤의 포인터들이 한 칸씩 당겨진다.
+  iterator erase(iterator __position) {
+    size_type __n = __position - begin();
+    _M_destroy_element(_M_index[__n]);
+    _M_index.erase(_M_index.begin() + __n);
+    return begin() + __n;
+  }
+
+  // erase2. 범위
+  iterator erase(iterator __first, iterator __last) {
+    size_type __n = __first - begin();
+    for (iterator __i = __first; __i != __last; ++__i)
+      _M_destroy_element(*__i.base());
+    _M_index.erase(_M_index.begin() + __n, _M_index.begin() + (__last - begin()));
+    return begin() + __n;
+  }
+
+  // push_back() :
+  // 재할당이 필요하면 포인터 배열만 재할당된다. (요소당 8바이트만 옮긴다.)
+  void push_back(const _Type& __x) {
+    if (_M_index.size() == _M_index.capacity())
+      _M_index.reserve(_M_index.size() != 0 ? 2 * _M_index.size() : 1);
+    _M_index.push_back(_M_create_element(__x)); // (위에서 공간을 확보했으므로 push_back()은 던지지 않는다.)
+  }
+
+  void pop_back() {
+    _M_destroy_element(_M_index.back());
+    _M_index.pop_back();
+  }
+
+  void resize(size_type __new_size, const _Type& __x = _Type()) {
+    if (__new_size < size())
+      erase(begin() + __new_size, end());
+    else
+      insert(end(), __new_size - size(), __x);
+  }
+
+  // swap() :
+  // 포인터 배열과 풀을 통째로 바꾼다. 요소는 움직이지 않으므로 참조도 유효하다. (다른 컨테이너 소속이 될 뿐이다.)
+  void swap(stable_vector<_Type, _AllocatorType>& __x) { this->_M_swap_base(__x); }
+
+public:
+  // CONSTRUCTOR
+
+  explicit stable_vector(const allocator_type& __a = allocator_type()) : _Base(__a) {}
+
+  explicit stable_vector(
+    size_type __n,
+    const _Type& __value = _Type(),
+    const allocator_type& __a = allocator_type()
+  ) : _Base(__a)
+    { _M_initialize(__n, __value); }
+
+  template <typename _InputIterator>
+    stable_vector(
+      typename ft::enable_if<!ft::is_integral<_InputIterator>::value,
+      _InputIterator>::type  __first,
+      _InputIterator __last,
+      const allocator_type& __a = allocator_type()
+    ) : _Base(__a) {
+    try {
+      insert(end(), __first, __last);
+    }
+    catch(...)
+    {
+  clear();
+  throw;
+    }
+  }
+
+  stable_vector(const stable_vector& __x) : _Base(__x.get_allocator()) {
+    try {
+      reserve(__x.size());
+      insert(end(), __x.begin(), __x.end());
+    }
+    catch(...)
+    {
+  clear();
+  throw;
+    }
+  }
+
+  // DESTRUCTOR
+  // (슬롯 해제는 base의 소멸자가 한다.)
+  ~stable_vector() { clear(); }
+
+  // ASSIGN OPERATOR
+  // 복사본을 만든 뒤 swap한다. (strong guarantee)
+  stable_vector<_Type, _AllocatorType>& operator=(const stable_vector<_Type, _AllocatorType>& __x) {
+    if (this != &__x) {
+      stable_vector<_Type, _AllocatorType> __tmp(__x);
+      swap(__tmp);
+    }
+    return *this;
+  }
+
+  void assign(size_type __n, const _Type& __val) {
+    stable_vector<_Type, _AllocatorType> __tmp(__n, __val, get_allocator());
+    swap(__tmp);
+  }
+
+  template<typename _InputIterator>
+  void assign(
+    typename ft::enable_if<!ft::is_integral<_InputIterator>::value,
+    _InputIterator>::type __first,
+    _InputIterator __last) {
+    stable_vector<_Type, _AllocatorType> __tmp(__first, __last, get_allocator());
+    swap(__tmp);
+  }
+
+  allocator_type get_allocator() const { return _Base::get_allocator(); }
+
+//----------------------------------------------------------------------------------------
+
+protected:
+  // _M_FUNCTIONS
+
+  void _M_range_check(size_type __n) const {
+    if (__n >= this->size())
+      throw std::out_of_range("stable_vector");
+  }
+
+  void _M_initialize(size_type __n, const _Type& __value) {
+    try {
+      reserve(__n);
+      insert(end(), __n, __value);
+    }
+    catch(...)
+    {
+  clear();
+  throw;
+    }
+  }
+
+  // _M_create_element() :
+  // 슬롯을 하나 받아 __x의 복사본을 생성한다. 생성 중 예외가 발생하면 슬롯을 돌려준다.
+  _Type* _M_create_element(const _Type& __x) {
+    _Type* __p = _M_get_slot();
+    try {
+      this->_M_data_allocator.construct(__p, __x);
+    }
+    catch(...)
+    {
+  _M_put_slot(__p);
+  throw;
+    }
+    return __p;
+  }
+
+  void _M_destroy_element(_Type* __p) {
+    this->_M_data_allocator.destroy(__p);
+    _M_put_slot(__p);
+  }
+
+  template <typename _PtrVector>
+  void _M_destroy_elements(_PtrVector& __ptrs) {
+    for (size_type __i = 0; __i < __ptrs.size(); ++__i)
+      _M_destroy_element(__ptrs[__i]);
+  }
+
+  // _M_insert_pointers() :
+  // 미리 생성해 둔 요소들의 포인터를 __pos에 끼워넣는다. 실패하면 생성한 요소를 되돌린다.
+  template <typename _PtrVector>
+  void _M_insert_pointers(iterator __pos, _PtrVector& __ptrs) {
+    size_type __n = __pos - begin();
+    try {
+      _M_index.insert(_M_index.begin() + __n, __ptrs.begin(), __ptrs.end());
+    }
+    catch(...)
+    {
+  _M_destroy_elements(__ptrs);
+  throw;
+    }
+  }
+
+}; // class stable_vector
+
+
+// 비멤버함수 (관련 연산자)
+
+template <typename _Type, typename _AllocatorType>
+bool operator==(const stable_vector<_Type, _AllocatorType>& __x, const stable_vector<_Type, _AllocatorType>& __y) {
+  return __x.size() == __y.size() &&
+        ft::equal(__x.begin(), __x.end(), __y.begin());
+}
+
+template <typename _Type, typename _AllocatorType>
+bool operator<(const stable_vector<_Type, _AllocatorType>& __x, const stable_vector<_Type, _AllocatorType>& __y) {
+  return ft::lexicographical_compare(__x.begin(), __x.end(), __y.begin(), __y.end());
+}
+
+template <typename _Type, typename _AllocatorType>
+bool operator!=(const stable_vector<_Type, _AllocatorType>& __x, const stable_vector<_Type, _AllocatorType>& __y) {
+  return !(__x == __y);
+}
+
+template <typename _Type, typename _AllocatorType>
+bool operator>(const stable_vector<_Type, _AllocatorType>& __x, const stable_vector<_Type, _AllocatorType>& __y) {
+  return __y < __x;
+}
+
+template <typename _Type, typename _AllocatorType>
+bool operator<=(const stable_vector<_Type, _AllocatorType>& __x, const stable_vector<_Type, _AllocatorType>& __y) {
+  return !(__y < __x);
+}
+
+template <typename _Type, typename _AllocatorType>
+bool operator>=(const stable_vector<_Type, _AllocatorType>& __x, const stable_vector<_Type, _AllocatorType>& __y) {
+  return !(__x < __y);
+}
+
+template <typename _Type, typename _AllocatorType>
+void swap(stable_vector<_Type, _AllocatorType>& __x, stable_vector<_Type, _AllocatorType>& __y)
+{
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 : swap()은 포인터 배열과 풀만 바꾼다.
+// (vector와 같이, 빈 stable_vector를 기본생성할 수 있는 std::allocator일 때만)
+template <typename _Type>
+struct has_cheap_swap<stable_vector<_Type, std::allocator<_Type> > > : public true_type {};
+
+} // namespace ft
+
+#endif // STABLE_VECTOR_HPP
@@ -66,6 +66,10 @@ public:
 
   void pop() { c.pop_back(); }
 
+  // swap() :
+  // underlying container의 swap()을 사용한다.
+  void swap(stack& __x) { c.swap(__x.c); }
+
 };
 
 // 관련 연산자 realational operators :
@@ -109,6 +113,17 @@ bool operator>=(const stack<_ValueType,_ContainerType>& __x, const stack<_ValueT
 {
   return !(__x < __y);
 }
+
+template <typename _ValueType, typename _ContainerType>
+void swap(stack<_ValueType,_ContainerType>& __x, stack<_ValueType,_ContainerType>& __y)
+{
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 :
+// stack의 swap()은 underlying container의 swap()이므로, 그 container를 따른다.
+template <typename _ValueType, typename _ContainerType>
+struct has_cheap_swap<stack<_ValueType,_ContainerType> > : public has_cheap_swap<_ContainerType> {};
 }
 
 #endif // STACK_HPP
@@ -42,15 +42,65 @@ const _Rb_tree_Color_type _S_rb_tree_black = true;
 
 //------------------     node     ------------------//
 
+// FT_RB_TREE_COMPACT_NODE :
+// 정의하면 색을 따로 저장하지 않고, 부모 포인터의 최하위 비트에 넣는다. (노드는 최소 2바이트 단위로 정렬되므로 이 비트는 항상 0이다.)
+// bool 하나 때문에 생기던 8바이트의 패딩이 사라져, 64비트에서 노드 머리가 32바이트에서 24바이트로 줄어든다.
+// 어느 쪽이든 부모와 색은 아래의 접근자(_M_get_parent() 등)로만 다룬다.
+
+// FT_RB_TREE_ORDER_STATISTICS :
+// 정의하면 노드마다 자기를 루트로 하는 서브트리의 노드 수(_M_size)를 저장한다.
+// 삽입/삭제/회전할 때 함께 갱신하므로, nth(), rank(), distance()가 O(log n)이 된다. (정의하지 않으면 O(n)으로 순회한다.)
+// 노드가 한 워드 커지므로 필요할 때만 켠다.
+
 struct _Rb_tree_node_base
 {
   typedef _Rb_tree_Color_type _Color_type;
   typedef _Rb_tree_node_base* _Base_ptr;
 
+#ifndef FT_RB_TREE_COMPACT_NODE
   _Color_type _M_color; 
   _Base_ptr _M_parent;
+#else
+  _Base_ptr _M_parent_and_color; // 부모 포인터 | 색 (red == 0, black == 1)
+#endif
   _Base_ptr _M_left;
   _Base_ptr _M_right;
+#ifdef FT_RB_TREE_ORDER_STATISTICS
+  std::size_t _M_size; // 서브트리의 노드 수 (header는 사용하지 않는다)
+#endif
+
+#ifndef FT_RB_TREE_COMPACT_NODE
+  _Base_ptr _M_get_parent() const { return _M_parent; }
+  void _M_set_parent(_Base_ptr __p) { _M_parent = __p; }
+  _Color_type _M_get_color() const { return _M_color; }
+  void _M_set_color(_Color_type __c) { _M_color = __c; }
+
+  // _M_init_parent_color() :
+  // 새 노드(또는 header)를 처음 연결할 때 쓴다. 부모와 색을 읽지 않고 한 번에 써넣는다.
+  void _M_init_parent_color(_Base_ptr __p, _Color_type __c) { _M_parent = __p; _M_color = __c; }
+
+  // _M_parent_slot() :
+  // header 전용. header의 부모 자리에는 root가 저장된다. (rebalance 함수가 root를 참조로 받아 바꾼다.)
+  _Base_ptr& _M_parent_slot() { return _M_parent; }
+#else
+  _Base_ptr _M_get_parent() const
+    { return reinterpret_cast<_Base_ptr>(reinterpret_cast<std::size_t>(_M_parent_and_color) & ~std::size_t(1)); }
+  void _M_set_parent(_Base_ptr __p)
+    { _M_parent_and_color = reinterpret_cast<_Base_ptr>(reinterpret_cast<std::size_t>(__p) | _M_get_color()); }
+  _Color_type _M_get_color() const
+    { return reinterpret_cast<std::size_t>(_M_parent_and_color) & 1; }
+  void _M_set_color(_Color_type __c)
+    { _M_parent_and_color = reinterpret_cast<_Base_ptr>(reinterpret_cast<std::size_t>(_M_get_parent()) | std::size_t(__c)); }
+
+  // _M_init_parent_color() :
+  // 새 노드(또는 header)를 처음 연결할 때 쓴다. _M_set_parent()와 _M_set_color()는 워드의 나머지 절반을 읽어서
+  // 다시 쓰므로, 아직 초기화되지 않은 워드에 쓰면 안 된다. 이 함수는 읽지 않고 워드 전체를 써넣는다.
+  void _M_init_parent_color(_Base_ptr __p, _Color_type __c)
+    { _M_parent_and_color = reinterpret_cast<_Base_ptr>(reinterpret_cast<std::size_t>(__p) | std::size_t(__c)); }
+
+  // header는 항상 red(0)이므로, 부모 자리에 root 포인터가 비트 그대로 들어 있다.
+  _Base_ptr& _M_parent_slot() { return _M_parent_and_color; }
+#endif
 
   static _Base_ptr _S_minimum(_Base_ptr __x)
   {
@@ -73,62 +123,86 @@ struct _Rb_tree_node : public _Rb_tree_node_base
   _Value _M_value_field;
 };
 
-//------------------     iterator     ------------------//
+//------------------     algorithms     ------------------//
 
-struct _Rb_tree_base_iterator
+// _Rb_tree_algorithms :
+// 노드끼리의 연결만 다루는 red-black tree 알고리즘 (순회, 회전, 삽입/삭제 후 rebalance).
+// 노드 타입(_NodeBase)과, 노드가 자식/부모를 담는 칸의 타입(_Slot)을 받는다.
+// _Rb_tree는 _Rb_tree_node_base와 그냥 포인터로 쓰고, offset_map은 자기 위치로부터의 거리로 가리키는 노드(offset_ptr)로 쓴다. (offset_map.hpp 참고)
+// 노드는 _M_left, _M_right, _M_get_parent() 등 _Rb_tree_node_base와 같은 모양이어야 하고, _Slot은 _NodeBase*와 서로 바뀌어야 한다.
+template <typename _NodeBase, typename _Slot = _NodeBase*>
+struct _Rb_tree_algorithms
 {
-  typedef _Rb_tree_node_base::_Base_ptr _Base_ptr;
-  typedef std::bidirectional_iterator_tag iterator_category;
-  typedef std::ptrdiff_t difference_type;
-
-  _Base_ptr _M_node;
+  typedef _NodeBase* _Base_ptr;
 
-  void _M_increment()
+  static _Base_ptr _S_increment(_Base_ptr __x)
   {
     // 오른쪽 서브트리가 있을 때
-    if (_M_node->_M_right != 0) {
-      _M_node = _M_node->_M_right; // 오른쪽 서브트리에서
-      while (_M_node->_M_left != 0) // 가장 왼쪽 노드를 찾는다
-        _M_node = _M_node->_M_left;
+    if (__x->_M_right != 0) {
+      __x = __x->_M_right; // 오른쪽 서브트리에서
+      while (__x->_M_left != 0) // 가장 왼쪽 노드를 찾는다
+        __x = __x->_M_left;
     }
 
     // 내 위에서 찾아야 할 때
     else { 
-      _Base_ptr __target = _M_node->_M_parent;
-      while (_M_node == __target->_M_right) { // 타겟이 나의 왼쪽에 있으면(나보다 작으면) 계속 찾는다
-        _M_node = __target;
-        __target = __target->_M_parent;
+      _Base_ptr __target = __x->_M_get_parent();
+      while (__x == __target->_M_right) { // 타겟이 나의 왼쪽에 있으면(나보다 작으면) 계속 찾는다
+        __x = __target;
+        __target = __target->_M_get_parent();
       }
-      if (_M_node->_M_right != __target)
-        _M_node = __target; // increment. // 최초 _M_node가 제일 큰  노드였을 때: sentinel node(_M_header)로 갱신된다.
+      if (__x->_M_right != __target)
+        __x = __target; // increment. // 최초 __x가 제일 큰  노드였을 때: sentinel node(_M_header)로 갱신된다.
     }
+    return __x;
   }
 
-  void _M_decrement()
+  static _Base_ptr _S_decrement(_Base_ptr __x)
   {
-    // _M_node가 header일 때
+    // __x가 header일 때
     // 즉, end()에서 ++연산을 하는 것은 불가하지만(undefined), --연산을 하는 것은 가능하다.
-    if (_M_node->_M_color == _S_rb_tree_red && // root가 아닐 때
-        _M_node->_M_parent->_M_parent == _M_node) // _M_node가 root일 때 혹은 header일 때
-      _M_node = _M_node->_M_right;
+    if (__x->_M_get_color() == _S_rb_tree_red && // root가 아닐 때
+        __x->_M_get_parent()->_M_get_parent() == __x) // __x가 root일 때 혹은 header일 때
+      __x = __x->_M_right;
     
     // 왼쪽 서브트리가 있을 때
-    else if (_M_node->_M_left != 0) {
-      _M_node = _M_node->_M_left; // 왼쪽 서브트리에서
-      while (_M_node->_M_right != 0) // 가장 오른쪽 노드를 찾는다
-        _M_node = _M_node->_M_right;
+    else if (__x->_M_left != 0) {
+      __x = __x->_M_left; // 왼쪽 서브트리에서
+      while (__x->_M_right != 0) // 가장 오른쪽 노드를 찾는다
+        __x = __x->_M_right;
     }
 
     // 내 위에서 찾아야 할 때
     else {
-      _Base_ptr __target = _M_node->_M_parent;
-      while (_M_node == __target->_M_left) { // 타겟이 나의 오른쪽에 있으면(나보다 크면) 계속 찾는다
-        _M_node = __target;
-        __target = __target->_M_parent;
+      _Base_ptr __target = __x->_M_get_parent();
+      while (__x == __target->_M_left) { // 타겟이 나의 오른쪽에 있으면(나보다 크면) 계속 찾는다
+        __x = __target;
+        __target = __target->_M_get_parent();
       }
-      _M_node = __target;
+      __x = __target;
     }
+    return __x;
   }
+
+  static void _S_rotate_left(_Base_ptr __x, _Slot& __root);
+  static void _S_rotate_right(_Base_ptr __x, _Slot& __root);
+  static bool _S_rebalance_for_insert(_Base_ptr __x, _Slot& __root);
+  static _Base_ptr _S_rebalance_for_erase(_Base_ptr __innode, _Slot& __root,
+                                          _Slot& __leftmost, _Slot& __rightmost);
+};
+
+//------------------     iterator     ------------------//
+
+struct _Rb_tree_base_iterator
+{
+  typedef _Rb_tree_node_base::_Base_ptr _Base_ptr;
+  typedef std::bidirectional_iterator_tag iterator_category;
+  typedef std::ptrdiff_t difference_type;
+
+  _Base_ptr _M_node;
+
+  void _M_increment() { _M_node = _Rb_tree_algorithms<_Rb_tree_node_base>::_S_increment(_M_node); }
+  void _M_decrement() { _M_node = _Rb_tree_algorithms<_Rb_tree_node_base>::_S_decrement(_M_node); }
 };
 
 template <typename _Value, typename _Reference, typename _Pointer>
@@ -208,7 +282,32 @@ bool operator!=(const _Rb_tree_iterator<_Value, _Value&, _Value*>& __x,
 
 //------------------     utils: insert, erase에 사용됨     ------------------//
 
-void _Rb_tree_rotate_left(_Rb_tree_node_base* __x, _Rb_tree_node_base*& __root)
+// 서브트리 크기 관리 :
+// FT_RB_TREE_ORDER_STATISTICS가 없으면 모두 아무 일도 하지 않는다.
+#ifdef FT_RB_TREE_ORDER_STATISTICS
+inline std::size_t _Rb_tree_subtree_size(const _Rb_tree_node_base* __x)
+{ return __x ? __x->_M_size : 0; }
+
+// 두 자식의 크기로 __x의 크기를 다시 계산한다.
+inline void _Rb_tree_reset_size(_Rb_tree_node_base* __x)
+{ __x->_M_size = _Rb_tree_subtree_size(__x->_M_left) + _Rb_tree_subtree_size(__x->_M_right) + 1; }
+
+// __x의 조상 (root까지) 모두의 크기에 __d를 더한다.
+inline void _Rb_tree_add_size_to_path(_Rb_tree_node_base* __x, _Rb_tree_node_base* __root, std::ptrdiff_t __d)
+{
+  while (__x != __root) {
+    __x = __x->_M_get_parent();
+    __x->_M_size += __d;
+  }
+}
+#else
+inline std::size_t _Rb_tree_subtree_size(const _Rb_tree_node_base*) { return 0; }
+inline void _Rb_tree_reset_size(_Rb_tree_node_base*) {}
+inline void _Rb_tree_add_size_to_path(_Rb_tree_node_base*, _Rb_tree_node_base*, std::ptrdiff_t) {}
+#endif
+
+template <typename _NodeBase, typename _Slot>
+void _Rb_tree_algorithms<_NodeBase, _Slot>::_S_rotate_left(_Base_ptr __x, _Slot& __root)
 {
   //      [P]
   //   [1]   [x]
@@ -221,113 +320,130 @@ void _Rb_tree_rotate_left(_Rb_tree_node_base* __x, _Rb_tree_node_base*& __root)
   //        [2]
 
   // 연결을 바꾸어준다
-  _Rb_tree_node_base* __y = __x->_M_right;
+  _Base_ptr __y = __x->_M_right;
   __x->_M_right = __y->_M_left;
   if (__y->_M_left != 0)
-    __y->_M_left->_M_parent = __x;
+    __y->_M_left->_M_set_parent(__x);
   
   // 회전한 뭉치를 더 위의 노드와 연결해준다
-  __y->_M_parent = __x->_M_parent; // __y에 부모 연결
+  __y->_M_set_parent(__x->_M_get_parent()); // __y에 부모 연결
   // 부모에 __y 연결
   if (__x == __root)
     __root = __y;
-  else if (__x == __x->_M_parent->_M_left)
-    __x->_M_parent->_M_left = __y;
-  else /* (__x == __x->_M_parent->_M_right) */ 
-    __x->_M_parent->_M_right = __y;
+  else if (__x == __x->_M_get_parent()->_M_left)
+    __x->_M_get_parent()->_M_left = __y;
+  else /* (__x == __x->_M_get_parent()->_M_right) */ 
+    __x->_M_get_parent()->_M_right = __y;
 
   // __x와 __y를 서로 연결해준다
   __y->_M_left = __x;
-  __x->_M_parent = __y;
+  __x->_M_set_parent(__y);
+
+  // 이제 __x가 __y의 자식이므로, __x부터 다시 센다
+  _Rb_tree_reset_size(__x);
+  _Rb_tree_reset_size(__y);
 }
 
-void _Rb_tree_rotate_right(_Rb_tree_node_base* __x, _Rb_tree_node_base*& __root)
+template <typename _NodeBase, typename _Slot>
+void _Rb_tree_algorithms<_NodeBase, _Slot>::_S_rotate_right(_Base_ptr __x, _Slot& __root)
 {
-  // _Rb_tree_rotate_left()와 동일하다.
+  // _S_rotate_left()와 동일하다.
   
-  _Rb_tree_node_base* __y = __x->_M_left;
+  _Base_ptr __y = __x->_M_left;
   __x->_M_left = __y->_M_right;
   if (__y->_M_right != 0)
-    __y->_M_right->_M_parent = __x;
+    __y->_M_right->_M_set_parent(__x);
 
-  __y->_M_parent = __x->_M_parent;
+  __y->_M_set_parent(__x->_M_get_parent());
   if (__x == __root)
     __root = __y;
-  else if (__x == __x->_M_parent->_M_right)
-    __x->_M_parent->_M_right = __y;
+  else if (__x == __x->_M_get_parent()->_M_right)
+    __x->_M_get_parent()->_M_right = __y;
   else
-    __x->_M_parent->_M_left = __y;
+    __x->_M_get_parent()->_M_left = __y;
 
   __y->_M_right = __x;
-  __x->_M_parent = __y;
+  __x->_M_set_parent(__y);
+
+  _Rb_tree_reset_size(__x);
+  _Rb_tree_reset_size(__y);
 }
 
-void _Rb_tree_rebalance_for_insert(_Rb_tree_node_base* __x, _Rb_tree_node_base*& __root)
+// _S_rebalance_for_insert() :
+// red로 칠한 __x 때문에 생긴 red-red 연속을 없앤다.
+// 마지막에 red였던 root를 black으로 바꾸었다면 (= 트리의 black height가 1 늘었다면) true를 반환한다. (_Rb_tree_join()이 쓴다.)
+template <typename _NodeBase, typename _Slot>
+bool _Rb_tree_algorithms<_NodeBase, _Slot>::_S_rebalance_for_insert(_Base_ptr __x, _Slot& __root)
 {
-  __x->_M_color = _S_rb_tree_red; // 삽입되는 노드는 항상 red다.
+  __x->_M_set_color(_S_rb_tree_red); // 삽입되는 노드는 항상 red다.
+  _Rb_tree_reset_size(__x);
+  _Rb_tree_add_size_to_path(__x, __root, 1); // 회전 전에 조상들의 크기부터 맞춰둔다.
   while (__x != __root &&  // root에 도착하지 않았다면 체크를 계속한다
-    __x->_M_parent->_M_color == _S_rb_tree_red) { // red-red 연속일 때
+    __x->_M_get_parent()->_M_get_color() == _S_rb_tree_red) { // red-red 연속일 때
 
     // 1. 나는 왼쪽, 삼촌은 오른쪽
-    if (__x->_M_parent == __x->_M_parent->_M_parent->_M_left) {
-      _Rb_tree_node_base* __y = __x->_M_parent->_M_parent->_M_right;
+    if (__x->_M_get_parent() == __x->_M_get_parent()->_M_get_parent()->_M_left) {
+      _Base_ptr __y = __x->_M_get_parent()->_M_get_parent()->_M_right;
 
       // 1-1. case1: 삼촌이 red -> recoloring
-      if (__y && __y->_M_color == _S_rb_tree_red) {
-        __x->_M_parent->_M_color = _S_rb_tree_black;
-        __y->_M_color = _S_rb_tree_black;
-        __x->_M_parent->_M_parent->_M_color = _S_rb_tree_red;
-        __x = __x->_M_parent->_M_parent;
+      if (__y && __y->_M_get_color() == _S_rb_tree_red) {
+        __x->_M_get_parent()->_M_set_color(_S_rb_tree_black);
+        __y->_M_set_color(_S_rb_tree_black);
+        __x->_M_get_parent()->_M_get_parent()->_M_set_color(_S_rb_tree_red);
+        __x = __x->_M_get_parent()->_M_get_parent();
       }
       // 1-2. 삼촌이 red가 아닐 때 -> restructing
       else {
         // case2: 할아버지까지 꺾여있을 때 -> 회전을 통해 case3으로 만들기
-        if (__x == __x->_M_parent->_M_right) {
-          __x = __x->_M_parent;// rotate하면 부모자식 관계가 바뀌므로, 그전에 __x는 자식을 가리키도록 해준다.
-          _Rb_tree_rotate_left(__x, __root);
+        if (__x == __x->_M_get_parent()->_M_right) {
+          __x = __x->_M_get_parent();// rotate하면 부모자식 관계가 바뀌므로, 그전에 __x는 자식을 가리키도록 해준다.
+          _S_rotate_left(__x, __root);
         }
         // case3: 색을 바꾸고 회전
-        __x->_M_parent->_M_color = _S_rb_tree_black;
-        __x->_M_parent->_M_parent->_M_color = _S_rb_tree_red;
-        _Rb_tree_rotate_right(__x->_M_parent->_M_parent, __root);
+        __x->_M_get_parent()->_M_set_color(_S_rb_tree_black);
+        __x->_M_get_parent()->_M_get_parent()->_M_set_color(_S_rb_tree_red);
+        _S_rotate_right(__x->_M_get_parent()->_M_get_parent(), __root);
       }
     }
     // 2. 나는 오른쪽, 삼촌은 왼쪽
     else {
-      _Rb_tree_node_base* __y = __x->_M_parent->_M_parent->_M_left;
+      _Base_ptr __y = __x->_M_get_parent()->_M_get_parent()->_M_left;
       // 2-1. case1: 삼촌이 red -> recoloring
-      if (__y && __y->_M_color == _S_rb_tree_red) {
-        __x->_M_parent->_M_color = _S_rb_tree_black;
-        __y->_M_color = _S_rb_tree_black;
-        __x->_M_parent->_M_parent->_M_color = _S_rb_tree_red;
-        __x = __x->_M_parent->_M_parent;
+      if (__y && __y->_M_get_color() == _S_rb_tree_red) {
+        __x->_M_get_parent()->_M_set_color(_S_rb_tree_black);
+        __y->_M_set_color(_S_rb_tree_black);
+        __x->_M_get_parent()->_M_get_parent()->_M_set_color(_S_rb_tree_red);
+        __x = __x->_M_get_parent()->_M_get_parent();
       }
       // 2-2. 삼촌이 red가 아닐 때 -> restructing
       else {
         // case2: 할아버지까지 꺾여있을 때 -> 회전을 통해 case3으로 만들기
-        if (__x == __x->_M_parent->_M_left) {
-          __x = __x->_M_parent;
-          _Rb_tree_rotate_right(__x, __root);
+        if (__x == __x->_M_get_parent()->_M_left) {
+          __x = __x->_M_get_parent();
+          _S_rotate_right(__x, __root);
         }
         // case3: 색을 바꾸고 회전
-        __x->_M_parent->_M_color = _S_rb_tree_black;
-        __x->_M_parent->_M_parent->_M_color = _S_rb_tree_red;
-        _Rb_tree_rotate_left(__x->_M_parent->_M_parent, __root);
+        __x->_M_get_parent()->_M_set_color(_S_rb_tree_black);
+        __x->_M_get_parent()->_M_get_parent()->_M_set_color(_S_rb_tree_red);
+        _S_rotate_left(__x->_M_get_parent()->_M_get_parent(), __root);
       }
     }
   }
-  __root->_M_color = _S_rb_tree_black;// root의 색은 언제나 black이다.
+  const bool __grown = (__x == __root); // (__x는 항상 red이므로, 여기서 멈췄다면 root가 red다.)
+  __root->_M_set_color(_S_rb_tree_black);// root의 색은 언제나 black이다.
+  return __grown;
 }
 
-_Rb_tree_node_base*
-_Rb_tree_rebalance_for_erase(_Rb_tree_node_base* __innode,// 사용자가 erase에 넣은 노드
-                             _Rb_tree_node_base*& __root,
-                             _Rb_tree_node_base*& __leftmost,
-                             _Rb_tree_node_base*& __rightmost)
+template <typename _NodeBase, typename _Slot>
+typename _Rb_tree_algorithms<_NodeBase, _Slot>::_Base_ptr
+_Rb_tree_algorithms<_NodeBase, _Slot>::_S_rebalance_for_erase(_Base_ptr __innode,// 사용자가 erase에 넣은 노드
+                                                              _Slot& __root,
+                                                              _Slot& __leftmost,
+                                                              _Slot& __rightmost)
 {
-  _Rb_tree_node_base* __target = __innode; // target: 지울 노드
-  _Rb_tree_node_base* __x = 0;
-  _Rb_tree_node_base* __x_parent = 0;
+  _Base_ptr __target = __innode; // target: 지울 노드
+  _Base_ptr __x = 0;
+  _Base_ptr __x_parent = 0;
 
   /************* erase 과정 *************/
 
@@ -345,20 +461,22 @@ _Rb_tree_rebalance_for_erase(_Rb_tree_node_base* __innode,// 사용자가 erase
         __target = __target->_M_left;
       __x = __target->_M_right;
     }
+  // 실제로 트리에서 빠지는 자리는 __target의 자리다. 그 조상들의 크기를 하나씩 줄인다.
+  _Rb_tree_add_size_to_path(__target, __root, -1);
   // 2-1. target이 지울 노드가 아닌 successor를 가리키고 있을 때
   if (__target != __innode) {
     // 2-1-1. __innode 이하의 서브트리를 __innode 없이 정렬한다.
     // (1). successor(target)의 왼쪽에 삭제될 노드의 왼쪽을 연결해준다.
-    __innode->_M_left->_M_parent = __target; 
+    __innode->_M_left->_M_set_parent(__target); 
     __target->_M_left = __innode->_M_left;
     // (2). __x와 __x_parent를 연결한다.
     if (__target != __innode->_M_right) {
-      __x_parent = __target->_M_parent;
-      if (__x) __x->_M_parent = __target->_M_parent;
-      __target->_M_parent->_M_left = __x; 
+      __x_parent = __target->_M_get_parent();
+      if (__x) __x->_M_set_parent(__target->_M_get_parent());
+      __target->_M_get_parent()->_M_left = __x; 
       // (3). (1)과 (2)를 연결한다.
       __target->_M_right = __innode->_M_right;
-      __innode->_M_right->_M_parent = __target;
+      __innode->_M_right->_M_set_parent(__target);
     }
     else
       __x_parent = __target;  
@@ -366,39 +484,42 @@ _Rb_tree_rebalance_for_erase(_Rb_tree_node_base* __innode,// 사용자가 erase
 // 2-1-2. 2-1-1에서 만든 서브트리를 innode의 부모와 연결한다.
     if (__root == __innode)
       __root = __target;
-    else if (__innode->_M_parent->_M_left == __innode)
-      __innode->_M_parent->_M_left = __target;
+    else if (__innode->_M_get_parent()->_M_left == __innode)
+      __innode->_M_get_parent()->_M_left = __target;
     else 
-      __innode->_M_parent->_M_right = __target;
-    __target->_M_parent = __innode->_M_parent;
-    std::swap(__target->_M_color, __innode->_M_color); // successor는 그 자리에 있던(삭제된 노드)의 색을 물려받는다. 삭제된 노드는 successor의 색을 가진다.
+      __innode->_M_get_parent()->_M_right = __target;
+    __target->_M_set_parent(__innode->_M_get_parent());
+    _Rb_tree_Color_type __c = __target->_M_get_color(); // successor는 그 자리에 있던(삭제된 노드)의 색을 물려받는다. 삭제된 노드는 successor의 색을 가진다.
+    __target->_M_set_color(__innode->_M_get_color());
+    __innode->_M_set_color(__c);
+    _Rb_tree_reset_size(__target); // successor는 __innode의 자리(와 크기)를 물려받는다.
     __target = __innode;
     // => 이제 2의 __target도 정말 지운(트리에서 out된) 노드를 가리킨다.
   }
   // 1-1. (__target == __innode)
   else {  
     // 1-1-1. __innode를 뺀 위아래를 연결해준다.                   
-    __x_parent = __target->_M_parent;
-    if (__x) __x->_M_parent = __target->_M_parent;   
+    __x_parent = __target->_M_get_parent();
+    if (__x) __x->_M_set_parent(__target->_M_get_parent());   
     if (__root == __innode)
       __root = __x;
     else 
-      if (__innode->_M_parent->_M_left == __innode)
-        __innode->_M_parent->_M_left = __x;
+      if (__innode->_M_get_parent()->_M_left == __innode)
+        __innode->_M_get_parent()->_M_left = __x;
       else
-        __innode->_M_parent->_M_right = __x;
+        __innode->_M_get_parent()->_M_right = __x;
     // 1-1-2. __leftmost, __rightmost를 갱신해준다.
     if (__leftmost == __innode) {
       if (__innode->_M_right == 0) 
-        __leftmost = __innode->_M_parent;
+        __leftmost = __innode->_M_get_parent();
       else
-        __leftmost = _Rb_tree_node_base::_S_minimum(__x);
+        __leftmost = _NodeBase::_S_minimum(__x);
     }
     if (__rightmost == __innode) {
       if (__innode->_M_left == 0)     
-        __rightmost = __innode->_M_parent;  
+        __rightmost = __innode->_M_get_parent();  
       else           
-        __rightmost = _Rb_tree_node_base::_S_maximum(__x);
+        __rightmost = _NodeBase::_S_maximum(__x);
     }
   }
     // __target은 지울 노드다.
@@ -408,79 +529,259 @@ _Rb_tree_rebalance_for_erase(_Rb_tree_node_base* __innode,// 사용자가 erase
   // 삭제되는 색이 red면 어떠한 속성도 위반하지 않는다.
   // 삭제되는 색이 black일 때만 위반을 해결한다.
 
-  if (__target->_M_color != _S_rb_tree_red) { 
-    while (__x != __root && (__x == 0 || __x->_M_color == _S_rb_tree_black))
+  if (__target->_M_get_color() != _S_rb_tree_red) { 
+    while (__x != __root && (__x == 0 || __x->_M_get_color() == _S_rb_tree_black))
       if (__x == __x_parent->_M_left) {
-        _Rb_tree_node_base* __sister = __x_parent->_M_right;
+        _Base_ptr __sister = __x_parent->_M_right;
         // case1. __sister가 red일 때
         // : 회전을 통해 __sister가 black인 상황(case2, 3, 4)으로 만든다.
-        if (__sister->_M_color == _S_rb_tree_red) {
-          __sister->_M_color = _S_rb_tree_black;
-          __x_parent->_M_color = _S_rb_tree_red;
-          _Rb_tree_rotate_left(__x_parent, __root);
+        if (__sister->_M_get_color() == _S_rb_tree_red) {
+          __sister->_M_set_color(_S_rb_tree_black);
+          __x_parent->_M_set_color(_S_rb_tree_red);
+          _S_rotate_left(__x_parent, __root);
           __sister = __x_parent->_M_right;
         }
         // case2. __sister가 black이고, __sister의 두 자녀 모두 black일 때
         if ((__sister->_M_left == 0 || 
-             __sister->_M_left->_M_color == _S_rb_tree_black) &&
+             __sister->_M_left->_M_get_color() == _S_rb_tree_black) &&
             (__sister->_M_right == 0 || 
-             __sister->_M_right->_M_color == _S_rb_tree_black)) {
-          __sister->_M_color = _S_rb_tree_red;
+             __sister->_M_right->_M_get_color() == _S_rb_tree_black)) {
+          __sister->_M_set_color(_S_rb_tree_red);
           __x = __x_parent;
-          __x_parent = __x_parent->_M_parent;
+          __x_parent = __x_parent->_M_get_parent();
         } else {
           // case3. __sister가 black이고, __sister의 왼쪽 자녀가 red
           // : 회전을 통해 case4로 만든다.
           if (__sister->_M_right == 0 || 
-              __sister->_M_right->_M_color == _S_rb_tree_black) {
-            if (__sister->_M_left) __sister->_M_left->_M_color = _S_rb_tree_black;
-            __sister->_M_color = _S_rb_tree_red;
-            _Rb_tree_rotate_right(__sister, __root);
+              __sister->_M_right->_M_get_color() == _S_rb_tree_black) {
+            if (__sister->_M_left) __sister->_M_left->_M_set_color(_S_rb_tree_black);
+            __sister->_M_set_color(_S_rb_tree_red);
+            _S_rotate_right(__sister, __root);
             __sister = __x_parent->_M_right;
           }
           // case4. __sister가 black이고, __sister의 오른쪽 자녀가 red
-          __sister->_M_color = __x_parent->_M_color;
-          __x_parent->_M_color = _S_rb_tree_black;
-          if (__sister->_M_right) __sister->_M_right->_M_color = _S_rb_tree_black;
-          _Rb_tree_rotate_left(__x_parent, __root);
+          __sister->_M_set_color(__x_parent->_M_get_color());
+          __x_parent->_M_set_color(_S_rb_tree_black);
+          if (__sister->_M_right) __sister->_M_right->_M_set_color(_S_rb_tree_black);
+          _S_rotate_left(__x_parent, __root);
           break;// (case3, case4는 거슬러 올라가서 확인할 필요 없이 종료된다.)
         }
       } else { 
         // (오른쪽 왼쪽이 바뀌어 반복되는 코드)       
-        _Rb_tree_node_base* __sister = __x_parent->_M_left;
-        if (__sister->_M_color == _S_rb_tree_red) {
-          __sister->_M_color = _S_rb_tree_black;
-          __x_parent->_M_color = _S_rb_tree_red;
-          _Rb_tree_rotate_right(__x_parent, __root);
+        _Base_ptr __sister = __x_parent->_M_left;
+        if (__sister->_M_get_color() == _S_rb_tree_red) {
+          __sister->_M_set_color(_S_rb_tree_black);
+          __x_parent->_M_set_color(_S_rb_tree_red);
+          _S_rotate_right(__x_parent, __root);
           __sister = __x_parent->_M_left;
         }
         if ((__sister->_M_right == 0 || 
-             __sister->_M_right->_M_color == _S_rb_tree_black) &&
+             __sister->_M_right->_M_get_color() == _S_rb_tree_black) &&
             (__sister->_M_left == 0 || 
-             __sister->_M_left->_M_color == _S_rb_tree_black)) {
-          __sister->_M_color = _S_rb_tree_red;
+             __sister->_M_left->_M_get_color() == _S_rb_tree_black)) {
+          __sister->_M_set_color(_S_rb_tree_red);
           __x = __x_parent;
-          __x_parent = __x_parent->_M_parent;
+          __x_parent = __x_parent->_M_get_parent();
         } else {
           if (__sister->_M_left == 0 || 
-              __sister->_M_left->_M_color == _S_rb_tree_black) {
-            if (__sister->_M_right) __sister->_M_right->_M_color = _S_rb_tree_black;
-            __sister->_M_color = _S_rb_tree_red;
-            _Rb_tree_rotate_left(__sister, __root);
+              __sister->_M_left->_M_get_color() == _S_rb_tree_black) {
+            if (__sister->_M_right) __sister->_M_right->_M_set_color(_S_rb_tree_black);
+            __sister->_M_set_color(_S_rb_tree_red);
+            _S_rotate_left(__sister, __root);
             __sister = __x_parent->_M_left;
           }
-          __sister->_M_color = __x_parent->_M_color;
-          __x_parent->_M_color = _S_rb_tree_black;
-          if (__sister->_M_left) __sister->_M_left->_M_color = _S_rb_tree_black;
-          _Rb_tree_rotate_right(__x_parent, __root);
+          __sister->_M_set_color(__x_parent->_M_get_color());
+          __x_parent->_M_set_color(_S_rb_tree_black);
+          if (__sister->_M_left) __sister->_M_left->_M_set_color(_S_rb_tree_black);
+          _S_rotate_right(__x_parent, __root);
           break;
         }
       }
-    if (__x) __x->_M_color = _S_rb_tree_black;// 루트노드의 색은 언제나 black이다.
+    if (__x) __x->_M_set_color(_S_rb_tree_black);// 루트노드의 색은 언제나 black이다.
   }
   return __target;
 }
 
+// 트리(_Rb_tree_node_base)에서 쓰는 이름
+inline bool _Rb_tree_rebalance_for_insert(_Rb_tree_node_base* __x, _Rb_tree_node_base*& __root)
+{ return _Rb_tree_algorithms<_Rb_tree_node_base>::_S_rebalance_for_insert(__x, __root); }
+
+inline _Rb_tree_node_base*
+_Rb_tree_rebalance_for_erase(_Rb_tree_node_base* __innode, _Rb_tree_node_base*& __root,
+                             _Rb_tree_node_base*& __leftmost, _Rb_tree_node_base*& __rightmost)
+{ return _Rb_tree_algorithms<_Rb_tree_node_base>::_S_rebalance_for_erase(__innode, __root, __leftmost, __rightmost); }
+
+//------------------     utils: split, join에 사용됨     ------------------//
+
+// _Rb_tree_black_height() :
+// root에서 leaf(null)까지의 경로에 있는 black 노드의 수. 모든 경로가 같으므로 왼쪽 끝만 센다.
+inline std::size_t _Rb_tree_black_height(const _Rb_tree_node_base* __x)
+{
+  std::size_t __h = 0;
+  for ( ; __x != 0; __x = __x->_M_left)
+    if (__x->_M_get_color() == _S_rb_tree_black)
+      ++__h;
+  return __h;
+}
+
+// _Rb_tree_join() :
+// __l의 모든 key < __k의 key < __r의 모든 key일 때, 세 개를 하나의 red-black tree로 합치고 그 root를 반환한다.
+// __l과 __r은 root가 black(혹은 null)인 트리이고, __lh와 __rh는 그 black height다. 합친 트리의 black height는 __h에 넣는다.
+// black height가 높은 쪽의 가장자리를 따라 내려가, 높이가 같은 black 노드 자리에 __k를 red로 끼워 넣고 삽입처럼 rebalance한다.
+// 높이 차이만큼만 내려가므로 O(|__lh - __rh| + 1)이다.
+inline _Rb_tree_node_base*
+_Rb_tree_join(_Rb_tree_node_base* __l, std::size_t __lh,
+              _Rb_tree_node_base* __k,
+              _Rb_tree_node_base* __r, std::size_t __rh,
+              std::size_t& __h)
+{
+  _Rb_tree_node_base* __root;
+  _Rb_tree_node_base* __p = 0; // __k의 부모가 될 노드
+  if (__lh >= __rh) {
+    // __l의 오른쪽 가장자리에서 black height가 __rh인 black 노드(혹은 null)를 찾는다.
+    _Rb_tree_node_base* __x = __l;
+    for (std::size_t __xh = __lh; __xh > __rh || (__x && __x->_M_get_color() == _S_rb_tree_red); __x = __x->_M_right) {
+      if (__x->_M_get_color() == _S_rb_tree_black)
+        --__xh;
+      __p = __x;
+    }
+    __k->_M_left = __x;
+    __k->_M_right = __r;
+    if (__p) __p->_M_right = __k;
+    __root = __p ? __l : __k;
+  }
+  else {
+    // (왼쪽 오른쪽이 바뀌어 반복되는 코드)
+    _Rb_tree_node_base* __x = __r;
+    for (std::size_t __xh = __rh; __xh > __lh || (__x && __x->_M_get_color() == _S_rb_tree_red); __x = __x->_M_left) {
+      if (__x->_M_get_color() == _S_rb_tree_black)
+        --__xh;
+      __p = __x;
+    }
+    __k->_M_left = __l;
+    __k->_M_right = __x;
+    if (__p) __p->_M_left = __k;
+    __root = __p ? __r : __k;
+  }
+  __k->_M_set_parent(__p);
+  if (__k->_M_left) __k->_M_left->_M_set_parent(__k);
+  if (__k->_M_right) __k->_M_right->_M_set_parent(__k);
+
+  // __k의 조상은 반대쪽 트리 전체와 __k를 새로 품는다. (__k 자신의 몫인 1은 rebalance가 더한다.)
+  _Rb_tree_add_size_to_path(__k, __root, __lh >= __rh ? _Rb_tree_subtree_size(__r) : _Rb_tree_subtree_size(__l));
+  const bool __grown = _Rb_tree_rebalance_for_insert(__k, __root);
+  __h = (__lh >= __rh ? __lh : __rh) + (__grown ? 1 : 0);
+  return __root;
+}
+
+// _Rb_tree_join2() :
+// 가운데 노드 없이 __l과 __r을 합친다. __r의 가장 작은 노드를 떼어내 가운데 노드로 쓴다.
+inline _Rb_tree_node_base*
+_Rb_tree_join2(_Rb_tree_node_base* __l, std::size_t __lh,
+               _Rb_tree_node_base* __r, std::size_t __rh,
+               std::size_t& __h)
+{
+  if (__r == 0) { __h = __lh; return __l; }
+  if (__l == 0) { __h = __rh; return __r; }
+  _Rb_tree_node_base* __mid = _Rb_tree_node_base::_S_minimum(__r);
+  _Rb_tree_node_base* __leftmost = __mid;
+  _Rb_tree_node_base* __rightmost = 0; // (__r의 끝은 여기서 필요 없다.)
+  _Rb_tree_rebalance_for_erase(__mid, __r, __leftmost, __rightmost);
+  return _Rb_tree_join(__l, __lh, __mid, __r, _Rb_tree_black_height(__r), __h);
+}
+
+// _Rb_tree_expose() :
+// black height가 __h인 트리의 root __x를 떼어내고, 두 자식 __a, __b를 각각 독립된 트리로 만든다.
+// 독립된 트리의 root는 black이어야 하므로, red인 자식은 black으로 칠한다. (그만큼 black height가 는다.)
+inline void
+_Rb_tree_expose(_Rb_tree_node_base* __x, std::size_t __h,
+                _Rb_tree_node_base*& __a, std::size_t& __ah,
+                _Rb_tree_node_base*& __b, std::size_t& __bh)
+{
+  const std::size_t __child_h = __h - (__x->_M_get_color() == _S_rb_tree_black ? 1 : 0);
+  __a = __x->_M_left;
+  __b = __x->_M_right;
+  __ah = __bh = __child_h;
+  if (__a && __a->_M_get_color() == _S_rb_tree_red) { __a->_M_set_color(_S_rb_tree_black); ++__ah; }
+  if (__b && __b->_M_get_color() == _S_rb_tree_red) { __b->_M_set_color(_S_rb_tree_black); ++__bh; }
+}
+
+//------------------     node handle     ------------------//
+
+template <typename _Key, typename _Value, typename _GetKeyOfValue, typename _Compare, typename _Alloc>
+class _Rb_tree;
+
+// _Rb_tree_node_handle :
+// 트리에서 떼어낸 노드 하나를 소유한다. (C++17의 node handle)
+// extract()로 받고 insert()로 다른 트리에 넣으면, 노드를 해제하거나 새로 할당하지 않고 값도 복사하지 않는다.
+// 어느 트리에도 넣지 않고 소멸하면 노드를 해제한다.
+// C++98에는 move가 없으므로 std::auto_ptr처럼 복사하면 소유권이 넘어가고, 원본은 빈 handle이 된다.
+template <typename _Value, typename _Alloc>
+class _Rb_tree_node_handle
+{
+public:
+  typedef _Value value_type;
+  typedef typename _Alloc_traits<_Value, _Alloc>::allocator_type allocator_type;
+
+private:
+  typedef _Alloc_traits<_Rb_tree_node<_Value>, _Alloc> _Node_alloc_traits;
+  typedef typename _Node_alloc_traits::allocator_type _Node_allocator;
+
+  mutable _Rb_tree_node<_Value>* _M_node;
+  _Node_allocator _M_alloc; // 노드를 할당한 할당기 (노드를 해제할 때 쓴다)
+
+  template <typename, typename, typename, typename, typename> friend class _Rb_tree;
+
+  _Rb_tree_node_handle(_Rb_tree_node<_Value>* __n, const _Node_allocator& __a)
+    : _M_node(__n), _M_alloc(__a) {}
+
+  _Rb_tree_node<_Value>* _M_release()
+  {
+    _Rb_tree_node<_Value>* __n = _M_node;
+    _M_node = 0;
+    return __n;
+  }
+
+  void _M_reset()
+  {
+    if (_M_node) {
+      _M_node->_M_value_field.~_Value();
+      _M_alloc.deallocate(_M_node, 1);
+      _M_node = 0;
+    }
+  }
+
+public:
+  _Rb_tree_node_handle() : _M_node(0), _M_alloc() {}
+
+  _Rb_tree_node_handle(const _Rb_tree_node_handle& __x)
+    : _M_node(__x._M_node), _M_alloc(__x._M_alloc) { __x._M_node = 0; }
+
+  _Rb_tree_node_handle& operator=(const _Rb_tree_node_handle& __x)
+  {
+    if (this != &__x) {
+      _M_reset();
+      _M_alloc = __x._M_alloc;
+      _M_node = __x._M_node;
+      __x._M_node = 0;
+    }
+    return *this;
+  }
+
+  ~_Rb_tree_node_handle() { _M_reset(); }
+
+  bool empty() const { return _M_node == 0; }
+  // (empty()가 아닐 때만)
+  value_type& value() const { return _M_node->_M_value_field; }
+  allocator_type get_allocator() const { return _M_alloc; }
+
+  void swap(_Rb_tree_node_handle& __x)
+  {
+    std::swap(_M_node, __x._M_node);
+    _Node_alloc_traits::_S_swap(_M_alloc, __x._M_alloc);
+  }
+};
+
 //------------------     Rb_tree     ------------------//
 
 
@@ -492,7 +793,8 @@ struct _Rb_tree_base
     allocator_type get_allocator() const { return _M_node_allocator; }
 
   protected:
-    typename _Alloc_traits<_Rb_tree_node<_Type>, _Alloc>::allocator_type _M_node_allocator;
+    typedef _Alloc_traits<_Rb_tree_node<_Type>, _Alloc> _Node_alloc_traits;
+    typename _Node_alloc_traits::allocator_type _M_node_allocator;
    
     _Rb_tree_node<_Type>* _M_header; // 메타정보를 저장한다. root, rightmost, leftmost.
 
@@ -502,6 +804,21 @@ struct _Rb_tree_base
     void _M_put_node(_Rb_tree_node<_Type>* __p)
     { _M_node_allocator.deallocate(__p, 1); } // _p에 있는 1개의 노드를 해제한다
 
+    // 노드 할당기가 (slab_allocator처럼) header를 제외한 모든 노드를 한 번에 해제할 수 있는지
+    bool _M_can_put_all_nodes() const
+    { return _Node_alloc_traits::_S_can_release_all(_M_node_allocator); }
+
+    // header를 제외한 모든 노드를 한 번에 해제한다. (_M_can_put_all_nodes()가 true일 때만)
+    void _M_put_all_nodes()
+    { _Node_alloc_traits::_S_release_all(_M_node_allocator, _M_header); }
+
+    void _M_swap_allocator(_Rb_tree_base& __x)
+    { _Node_alloc_traits::_S_swap(_M_node_allocator, __x._M_node_allocator); }
+
+    // 한쪽이 할당한 노드를 다른 쪽이 해제할 수 있는지. (get_allocator()는 rebind한 복사본이라 풀 같은 상태를 잃을 수 있으므로, 노드 할당기끼리 비교한다.)
+    bool _M_same_node_allocator(const _Rb_tree_base& __x) const
+    { return _M_node_allocator == __x._M_node_allocator; }
+
   public:
     // 생성자
     _Rb_tree_base(const allocator_type& __a) 
@@ -514,6 +831,9 @@ struct _Rb_tree_base
 }; // struct _Rb_tree_base
 
 
+template <class _Tree>
+struct _Rb_tree_parallel_copy;
+
 template <typename _Key, typename _Value, typename _GetKeyOfValue, typename _Compare, typename _Alloc = std::allocator<_Value> >
 class _Rb_tree : protected _Rb_tree_base<_Value, _Alloc> {
 
@@ -521,7 +841,7 @@ class _Rb_tree : protected _Rb_tree_base<_Value, _Alloc> {
 
 protected:
   typedef _Rb_tree_node_base* _Base_ptr;
-  typedef _Rb_tree_node<_Value> _Rb_tree_node;
+  typedef ft::_Rb_tree_node<_Value> _Rb_tree_node;
   typedef _Rb_tree_Color_type _Color_type;
 
 public:
@@ -541,33 +861,49 @@ public:
 protected:
   using _Base::_M_get_node;
   using _Base::_M_put_node;
+  using _Base::_M_can_put_all_nodes;
+  using _Base::_M_put_all_nodes;
+  using _Base::_M_same_node_allocator;
   using _Base::_M_header;
 
 protected:
+  typedef typename _Base::_Node_alloc_traits _Node_alloc_traits;
+  typedef typename _Node_alloc_traits::allocator_type _Node_allocator;
 
-  _Link_type _M_create_node(const value_type& __x)
+  // 노드를 만들고 복제하는 함수는 할당기를 인자로 받는 static 버전이 있다.
+  // parallel_assign.hpp에서 스레드마다 다른 할당기(arena)로 복사하기 위해서다.
+  static _Link_type _S_create_node(_Node_allocator& __a, const value_type& __x)
   {
-    _Link_type __tmp = _M_get_node();
+    _Link_type __tmp = __a.allocate(1);
     try {
-      _Construct(&__tmp->_M_value_field, __x);
+      ft::_Construct(&__tmp->_M_value_field, __x);
     }
     catch(...)
       {
-	_M_put_node(__tmp);
+	__a.deallocate(__tmp, 1);
 	throw; 
       }
     return __tmp;
   }
 
-  _Link_type _M_clone_node(_Link_type __x)
+  static _Link_type _S_clone_node(_Node_allocator& __a, _Link_type __x)
   {
-    _Link_type __tmp = _M_create_node(__x->_M_value_field);
-    __tmp->_M_color = __x->_M_color;
+    _Link_type __tmp = _S_create_node(__a, __x->_M_value_field);
+    __tmp->_M_init_parent_color(0, __x->_M_get_color()); // (부모는 호출한 쪽에서 연결한다.)
+#ifdef FT_RB_TREE_ORDER_STATISTICS
+    __tmp->_M_size = __x->_M_size; // _M_copy()는 모양을 그대로 복사한다.
+#endif
     __tmp->_M_left = 0;
     __tmp->_M_right = 0;
     return __tmp;
   }
 
+  _Link_type _M_create_node(const value_type& __x)
+  { return _S_create_node(this->_M_node_allocator, __x); }
+
+  _Link_type _M_clone_node(_Link_type __x)
+  { return _S_clone_node(this->_M_node_allocator, __x); }
+
   void destroy_node(_Link_type __p)
   {
     _Destroy(&__p->_M_value_field);
@@ -582,38 +918,45 @@ protected:
   size_type _M_node_count; // keeps track of size of tree
   _Compare _M_key_compare;
 
-  _Link_type& _M_root() const 
-    { return (_Link_type&) _M_header->_M_parent; }
-  _Link_type& _M_leftmost() const 
-    { return (_Link_type&) _M_header->_M_left; }
-  _Link_type& _M_rightmost() const 
-    { return (_Link_type&) _M_header->_M_right; }
-
-  static _Link_type& _S_left(_Link_type __x)
-    { return (_Link_type&)(__x->_M_left); }
-  static _Link_type& _S_right(_Link_type __x)
-    { return (_Link_type&)(__x->_M_right); }
-  static _Link_type& _S_parent(_Link_type __x)
-    { return (_Link_type&)(__x->_M_parent); }
+  // header의 링크는 _Base_ptr이므로, 그 타입 그대로의 참조를 돌려준다.
+  // (_Link_type&로 캐스팅해서 쓰면 다른 타입으로 같은 메모리를 읽고 쓰게 되어, strict aliasing 규칙을 어긴다.)
+  _Base_ptr& _M_root() const 
+    { return _M_header->_M_parent_slot(); }
+  _Base_ptr& _M_leftmost() const 
+    { return _M_header->_M_left; }
+  _Base_ptr& _M_rightmost() const 
+    { return _M_header->_M_right; }
+
+  // _M_begin() : root를 노드 타입으로 읽는다.
+  _Link_type _M_begin() const
+    { return static_cast<_Link_type>(_M_root()); }
+
+  // 자식은 값으로 읽는다. 고칠 때는 __x->_M_left, __x->_M_right에 직접 쓴다.
+  static _Link_type _S_left(_Link_type __x)
+    { return static_cast<_Link_type>(__x->_M_left); }
+  static _Link_type _S_right(_Link_type __x)
+    { return static_cast<_Link_type>(__x->_M_right); }
+  static _Link_type _S_parent(_Link_type __x)
+    { return (_Link_type)(__x->_M_get_parent()); }
   static reference _S_value(_Link_type __x)
     { return __x->_M_value_field; }
   static const _Key& _S_key(_Link_type __x)
     { return _GetKeyOfValue()(_S_value(__x)); }
-  static _Color_type& _S_color(_Link_type __x)
-    { return (_Color_type&)(__x->_M_color); }
-
-  static _Link_type& _S_left(_Base_ptr __x)
-    { return (_Link_type&)(__x->_M_left); }
-  static _Link_type& _S_right(_Base_ptr __x)
-    { return (_Link_type&)(__x->_M_right); }
-  static _Link_type& _S_parent(_Base_ptr __x)
-    { return (_Link_type&)(__x->_M_parent); }
+  static _Color_type _S_color(_Link_type __x)
+    { return __x->_M_get_color(); }
+
+  static _Link_type _S_left(_Base_ptr __x)
+    { return static_cast<_Link_type>(__x->_M_left); }
+  static _Link_type _S_right(_Base_ptr __x)
+    { return static_cast<_Link_type>(__x->_M_right); }
+  static _Link_type _S_parent(_Base_ptr __x)
+    { return (_Link_type)(__x->_M_get_parent()); }
   static reference _S_value(_Base_ptr __x)
     { return ((_Link_type)__x)->_M_value_field; }
   static const _Key& _S_key(_Base_ptr __x)
     { return _GetKeyOfValue()(_S_value(_Link_type(__x)));} 
-  static _Color_type& _S_color(_Base_ptr __x)
-    { return (_Color_type&)(_Link_type(__x)->_M_color); }
+  static _Color_type _S_color(_Base_ptr __x)
+    { return __x->_M_get_color(); }
 
   static _Link_type _S_minimum(_Link_type __x) 
     { return (_Link_type)  _Rb_tree_node_base::_S_minimum(__x); }
@@ -625,13 +968,43 @@ public:
   typedef _Rb_tree_iterator<value_type, reference, pointer> iterator;
   typedef _Rb_tree_iterator<value_type, const_reference, const_pointer> const_iterator;
 
-  typedef reverse_iterator<const_iterator> const_reverse_iterator;
-  typedef reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
 
 private:
   iterator _M_insert(_Base_ptr __x, _Base_ptr __y, const value_type& __v);
-  _Link_type _M_copy(_Link_type __x, _Link_type __p);
-  void _M_clear(_Link_type __x);
+  iterator _M_insert_node(_Base_ptr __x, _Base_ptr __y, _Link_type __z);
+  pair<_Base_ptr, _Base_ptr> _M_get_insert_unique_pos(const key_type& __k);
+  pair<_Base_ptr, _Base_ptr> _M_get_insert_equal_pos(const key_type& __k);
+  pair<_Base_ptr, _Base_ptr> _M_get_insert_hint_equal_pos(iterator __position, const key_type& __k);
+  pair<_Base_ptr, _Base_ptr> _M_get_insert_hint_unique_pos(iterator __position, const key_type& __k);
+  _Link_type _M_copy(_Link_type __x, _Link_type __p)
+    { return _S_copy(this->_M_node_allocator, __x, __p); }
+  static _Link_type _S_copy(_Node_allocator& __a, _Link_type __x, _Link_type __p);
+  void _M_clear(_Link_type __x) { _S_clear(this->_M_node_allocator, __x); }
+  static void _S_clear(_Node_allocator& __a, _Link_type __x);
+
+  // parallel_assign.hpp의 스레드 복사는 위의 static 함수와 트리의 내부를 직접 쓴다.
+  template <class> friend struct _Rb_tree_parallel_copy;
+
+  void _M_destroy_values(_Link_type __x);
+
+  template <class _II>
+  void _M_insert_unique_range(_II __first, _II __last, std::input_iterator_tag);
+  template <class _FI>
+  void _M_insert_unique_range(_FI __first, _FI __last, std::forward_iterator_tag);
+  template <class _II>
+  void _M_insert_sorted_unique(_II __first, _II __last, std::input_iterator_tag);
+  template <class _FI>
+  void _M_insert_sorted_unique(_FI __first, _FI __last, std::forward_iterator_tag);
+  template <class _II>
+  void _M_insert_equal_range(_II __first, _II __last, std::input_iterator_tag);
+  template <class _FI>
+  void _M_insert_equal_range(_FI __first, _FI __last, std::forward_iterator_tag);
+  template <class _FI>
+  void _M_build_sorted(_FI __first, size_type __n);
+  template <class _FI>
+  _Link_type _M_build_subtree(_FI& __it, size_type __n, size_type __depth, size_type __red_depth, _Link_type __parent);
 
 public:
                                 // allocation/deallocation
@@ -651,13 +1024,13 @@ public:
     : _Base(__x.get_allocator()),
       _M_node_count(0), _M_key_compare(__x._M_key_compare)
   { 
-    if (__x._M_root() == 0)
+    if (__x._M_begin() == 0)
       _M_empty_initialize();
     else {
-      _S_color(_M_header) = _S_rb_tree_red;
-      _M_root() = _M_copy(__x._M_root(), _M_header);
-      _M_leftmost() = _S_minimum(_M_root());
-      _M_rightmost() = _S_maximum(_M_root());
+      _M_header->_M_init_parent_color(0, _S_rb_tree_red);
+      _M_root() = _M_copy(__x._M_begin(), _M_header);
+      _M_leftmost() = _S_minimum(_M_begin());
+      _M_rightmost() = _S_maximum(_M_begin());
     }
     _M_node_count = __x._M_node_count;
   }
@@ -667,8 +1040,7 @@ public:
 
 private:
   void _M_empty_initialize() {
-    _S_color(_M_header) = _S_rb_tree_red;// header의 color는 red, root의 color는 black.
-    _M_root() = 0;
+    _M_header->_M_init_parent_color(0, _S_rb_tree_red);// header의 color는 red, root의 color는 black. (root는 아직 없다.)
     _M_leftmost() = _M_header;
     _M_rightmost() = _M_header;
   }
@@ -679,8 +1051,8 @@ public:
   // key를 비교하는 함수를 반환한다.
   _Compare key_comp() const { return _M_key_compare; }
   
-  iterator begin() { return _M_leftmost(); }
-  const_iterator begin() const { return _M_leftmost(); }
+  iterator begin() { return static_cast<_Link_type>(_M_leftmost()); }
+  const_iterator begin() const { return static_cast<_Link_type>(_M_leftmost()); }
   iterator end() { return _M_header; }
   const_iterator end() const { return _M_header; }
   reverse_iterator rbegin() { return reverse_iterator(end()); }
@@ -695,7 +1067,10 @@ public:
   size_type size() const { return _M_node_count; }
   size_type max_size() const { return size_type(-1); }
 
+  // swap() :
+  // 노드는 그 노드를 할당한 할당기(풀)와 함께 옮겨가야 하므로, 노드 할당기도 바꾼다.
   void swap(_Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>& __t) {
+    this->_M_swap_allocator(__t);
     std::swap(_M_header, __t._M_header);
     std::swap(_M_node_count, __t._M_node_count);
     std::swap(_M_key_compare, __t._M_key_compare);
@@ -707,16 +1082,53 @@ public:
 
   iterator insert_unique(iterator __position, const value_type& __x);
 
+  // 범위 :
+  // 빈 트리에 정렬된 forward iterator 범위가 들어오면, 한 번 훑어 정렬 여부를 확인한 뒤 _M_build_sorted()로 한 번에 만든다.
+  // 그 외에는 end()를 힌트로 하나씩 넣는다. (정렬된 부분은 힌트 덕분에 탐색 없이 맨 끝에 붙는다.)
+  template <class _InputIterator>
+  void insert_unique(_InputIterator __first, _InputIterator __last) {
+    typedef typename iterator_traits<_InputIterator>::iterator_category _IterCategory;
+    _M_insert_unique_range(__first, __last, _IterCategory());
+  }
+
+  // insert_sorted_unique() :
+  // [__first, __last)가 정렬되어 있고 중복이 없다고 믿는다. (아니라면 undefined behavior)
+  // 트리가 비어 있고 forward iterator라면 비교 없이 O(n)에 만든다.
   template <class _InputIterator>
-  void insert_unique(_InputIterator __first, _InputIterator __last);
+  void insert_sorted_unique(_InputIterator __first, _InputIterator __last) {
+    typedef typename iterator_traits<_InputIterator>::iterator_category _IterCategory;
+    _M_insert_sorted_unique(__first, __last, _IterCategory());
+  }
+
+  // insert_equal() :
+  // 같은 key가 있어도 넣는다. 같은 key끼리는 넣은 순서대로 놓인다. (새 요소는 같은 key의 맨 뒤에 들어간다.)
+  // multimap, multiset이 쓴다.
+  iterator insert_equal(const value_type& __x);
+
+  // 힌트와 함께 : __position 바로 앞에 넣어도 순서가 맞으면 탐색 없이 넣는다.
+  iterator insert_equal(iterator __position, const value_type& __x);
+
+  // 범위 : insert_unique()처럼, 빈 트리에 정렬된(같은 key가 이어져도 된다) forward iterator 범위가 들어오면 한 번에 만든다.
+  template <class _InputIterator>
+  void insert_equal(_InputIterator __first, _InputIterator __last) {
+    typedef typename iterator_traits<_InputIterator>::iterator_category _IterCategory;
+    _M_insert_equal_range(__first, __last, _IterCategory());
+  }
 
   void erase(iterator __position);
   size_type erase(const key_type& __x);
   void erase(iterator __first, iterator __last);
 
+  // clear() :
+  // 노드 할당기가 한 번에 해제할 수 있으면, 값만 소멸시킨 뒤 노드는 한꺼번에 돌려준다.
   void clear() {
     if (_M_node_count != 0) {
-      _M_clear(_M_root());
+      if (_M_can_put_all_nodes()) {
+        _M_destroy_values(_M_begin());
+        _M_put_all_nodes();
+      }
+      else
+        _M_clear(_M_begin());
       _M_leftmost() = _M_header;
       _M_root() = 0;
       _M_rightmost() = _M_header;
@@ -736,6 +1148,196 @@ public:
   pair<iterator,iterator> equal_range(const key_type& __x);
   pair<const_iterator, const_iterator> equal_range(const key_type& __x) const;
 
+  // 투명한 비교 (heterogeneous lookup) :
+  // _Compare가 is_transparent를 선언했다면, key_type으로 바꾸지 않고 __x 그대로 비교한다.
+  // (key_type 그대로 넣으면 위의 비템플릿 함수가 선택된다.)
+  template <typename _Kt>
+  typename __enable_if_transparent<_Compare, _Kt, iterator>::type
+  find(const _Kt& __x) { return iterator(_M_find_tr(__x)); }
+  template <typename _Kt>
+  typename __enable_if_transparent<_Compare, _Kt, const_iterator>::type
+  find(const _Kt& __x) const { return const_iterator(_M_find_tr(__x)); }
+
+  template <typename _Kt>
+  typename __enable_if_transparent<_Compare, _Kt, size_type>::type
+  count(const _Kt& __x) const {
+    pair<_Link_type, _Link_type> __p = _M_equal_range_tr(__x);
+    return distance(const_iterator(__p.first), const_iterator(__p.second));
+  }
+
+  template <typename _Kt>
+  typename __enable_if_transparent<_Compare, _Kt, iterator>::type
+  lower_bound(const _Kt& __x) { return iterator(_M_lower_bound_tr(__x)); }
+  template <typename _Kt>
+  typename __enable_if_transparent<_Compare, _Kt, const_iterator>::type
+  lower_bound(const _Kt& __x) const { return const_iterator(_M_lower_bound_tr(__x)); }
+
+  template <typename _Kt>
+  typename __enable_if_transparent<_Compare, _Kt, iterator>::type
+  upper_bound(const _Kt& __x) { return iterator(_M_upper_bound_tr(__x)); }
+  template <typename _Kt>
+  typename __enable_if_transparent<_Compare, _Kt, const_iterator>::type
+  upper_bound(const _Kt& __x) const { return const_iterator(_M_upper_bound_tr(__x)); }
+
+  template <typename _Kt>
+  typename __enable_if_transparent<_Compare, _Kt, pair<iterator, iterator> >::type
+  equal_range(const _Kt& __x) {
+    pair<_Link_type, _Link_type> __p = _M_equal_range_tr(__x);
+    return pair<iterator, iterator>(iterator(__p.first), iterator(__p.second));
+  }
+  template <typename _Kt>
+  typename __enable_if_transparent<_Compare, _Kt, pair<const_iterator, const_iterator> >::type
+  equal_range(const _Kt& __x) const {
+    pair<_Link_type, _Link_type> __p = _M_equal_range_tr(__x);
+    return pair<const_iterator, const_iterator>(const_iterator(__p.first), const_iterator(__p.second));
+  }
+
+private:
+  template <typename _Kt>
+  _Link_type _M_lower_bound_tr(const _Kt& __k) const;
+  template <typename _Kt>
+  _Link_type _M_upper_bound_tr(const _Kt& __k) const;
+  template <typename _Kt>
+  pair<_Link_type, _Link_type> _M_equal_range_tr(const _Kt& __k) const;
+  // __x를 root로 하는 서브트리에서 찾는다. 못 찾으면 __y를 반환한다.
+  template <typename _Kt>
+  _Link_type _M_lower_bound(_Link_type __x, _Link_type __y, const _Kt& __k) const;
+  template <typename _Kt>
+  _Link_type _M_upper_bound(_Link_type __x, _Link_type __y, const _Kt& __k) const;
+  template <typename _Kt>
+  _Link_type _M_find_tr(const _Kt& __k) const;
+
+public:
+  // 여러 key를 한꺼번에 찾기 (batch lookup) :
+  // [__first, __last)의 key마다 find() 또는 lower_bound()의 결과를 순서대로 __out에 쓰고, 끝난 __out을 반환한다.
+  // 검색 _S_batch_group개를 한 단계씩 번갈아 내려가며, 각 검색이 다음에 볼 노드를 미리 prefetch해 둔다.
+  // 한 검색이 노드를 기다리는 동안 다른 검색들이 진행되므로, 큰 tree에서 캐시 미스의 지연이 겹쳐서 숨겨진다.
+  // (key를 여러 번 읽으므로 __first는 forward iterator여야 한다.)
+  template <class _ForwardIter, class _OutputIter>
+  _OutputIter find_batch(_ForwardIter __first, _ForwardIter __last, _OutputIter __out)
+    { return _M_search_batch<iterator>(__first, __last, __out, true); }
+  template <class _ForwardIter, class _OutputIter>
+  _OutputIter find_batch(_ForwardIter __first, _ForwardIter __last, _OutputIter __out) const
+    { return _M_search_batch<const_iterator>(__first, __last, __out, true); }
+
+  template <class _ForwardIter, class _OutputIter>
+  _OutputIter lower_bound_batch(_ForwardIter __first, _ForwardIter __last, _OutputIter __out)
+    { return _M_search_batch<iterator>(__first, __last, __out, false); }
+  template <class _ForwardIter, class _OutputIter>
+  _OutputIter lower_bound_batch(_ForwardIter __first, _ForwardIter __last, _OutputIter __out) const
+    { return _M_search_batch<const_iterator>(__first, __last, __out, false); }
+
+private:
+  // 함께 진행하는 검색의 수. 한 번에 기다릴 수 있는 캐시 미스의 수(line fill buffer)와 비슷하게 둔다.
+  enum { _S_batch_group = 8 };
+
+  template <class _Iter, class _ForwardIter, class _OutputIter>
+  _OutputIter _M_search_batch(_ForwardIter __first, _ForwardIter __last, _OutputIter __out, bool __exact) const;
+
+public:
+                                // order statistics:
+  // (FT_RB_TREE_ORDER_STATISTICS가 정의되어 있으면 O(log n), 아니면 O(n)이다.)
+
+  // nth() :
+  // 정렬 순서로 __k번째(0부터) 요소의 반복자를 반환한다. __k >= size()이면 end().
+  iterator nth(size_type __k) { return iterator(_M_nth(__k)); }
+  const_iterator nth(size_type __k) const { return const_iterator(_M_nth(__k)); }
+
+  // index_of() :
+  // __it가 몇 번째 요소인지 반환한다. end()는 size()다.
+  size_type index_of(const_iterator __it) const;
+
+  // rank() :
+  // key가 __k보다 작은 요소의 개수. (= lower_bound(__k)의 위치)
+  size_type rank(const key_type& __k) const { return index_of(lower_bound(__k)); }
+
+  // distance() :
+  // std::distance(__first, __last)와 같다.
+  difference_type distance(const_iterator __first, const_iterator __last) const {
+#ifdef FT_RB_TREE_ORDER_STATISTICS
+    return difference_type(index_of(__last)) - difference_type(index_of(__first));
+#else
+    return std::distance(__first, __last); // index_of()로 세면 begin()부터 두 번 걷게 된다.
+#endif
+  }
+
+private:
+  _Link_type _M_nth(size_type __k) const;
+
+  // _M_union()은 black height가 이 값 이하인 (노드가 15개 이하인) 트리를 나누지 않고 하나씩 삽입한다.
+  enum { _S_union_insert_height = 2 };
+
+public:
+                                // node handle:
+  typedef _Rb_tree_node_handle<_Value, _Alloc> node_type;
+
+  // extract() :
+  // 노드를 트리에서 떼어내 node handle로 반환한다. 노드는 해제하지 않는다. (key로 찾지 못하면 빈 handle)
+  node_type extract(iterator __position);
+  node_type extract(const key_type& __k) {
+    iterator __i = find(__k);
+    return __i == end() ? node_type() : extract(__i);
+  }
+
+  // insert_unique(node_type&) :
+  // handle의 노드를 그대로 이 트리에 연결하고 handle을 비운다.
+  // 같은 key가 이미 있으면 넣지 않고, 노드는 handle에 남는다.
+  // (노드 할당기가 다르면 이 트리가 해제할 수 없으므로, 값을 복사해서 넣고 handle의 노드는 해제한다.)
+  pair<iterator, bool> insert_unique(node_type& __nh);
+  iterator insert_unique(iterator __position, node_type& __nh);
+
+  // merge_unique() :
+  // __src의 노드 중 이 트리에 없는 key의 노드를 옮겨온다. 겹치는 key의 노드는 __src에 남는다.
+  // __src의 key가 모두 이 트리의 key보다 크거나 작으면, join()으로 O(log n)에 통째로 붙인다.
+  void merge_unique(_Rb_tree& __src);
+
+public:
+                                // split/join:
+  // split() :
+  // key가 __k보다 작지 않은 요소를 모두 __right로 옮긴다. __right에 있던 요소는 먼저 지운다.
+  // join() :
+  // __right의 요소를 모두 이 트리로 옮긴다. __right의 모든 key가 이 트리의 모든 key보다 커야 한다. (아니라면 undefined behavior)
+  //
+  // 두 트리의 할당기가 같으면 노드를 다시 만들지 않고 black height를 이용해 트리를 자르고 붙이므로 O(log n)이다.
+  // (FT_RB_TREE_ORDER_STATISTICS가 없으면 split()은 요소 수를 세느라 O(min(k, n - k))가 든다.)
+  // 할당기가 다르면 노드를 옮길 수 없으므로, 복사하고 지운다.
+  void split(const key_type& __k, _Rb_tree& __right);
+  void join(_Rb_tree& __right);
+
+                                // set operations:
+  // __src의 노드를 이 트리로 옮기거나 지우면서, 결과를 이 트리에 만든다. __src는 비게 된다.
+  // 두 트리를 root에서 나누어 양쪽을 재귀적으로 계산하고 _Rb_tree_join()으로 붙이므로,
+  // 작은 쪽의 크기를 m, 큰 쪽을 n이라 할 때 O(m log(n/m + 1))이다. (결과에서 빠지는 노드를 해제하는 비용은 따로 든다.)
+  // key가 겹치면 이 트리의 노드가 남고, __merge(이 트리의 값, __src의 값)로 값을 합친다. __merge는 예외를 던지면 안 된다.
+  // 노드 할당기가 다르면 노드를 옮길 수 없으므로, 하나씩 찾아 넣고 지운다.
+
+  // union_with() : 이 트리 = 이 트리 ∪ __src
+  template <class _Merge>
+  void union_with(_Rb_tree& __src, _Merge __merge);
+  // intersect_with() : 이 트리 = 이 트리 ∩ __src
+  template <class _Merge>
+  void intersect_with(_Rb_tree& __src, _Merge __merge);
+  // subtract() : 이 트리 = 이 트리 - __src
+  void subtract(_Rb_tree& __src);
+
+private:
+  void _M_split(_Base_ptr __x, size_type __h, const key_type& __k,
+                _Base_ptr& __l, size_type& __lh, _Base_ptr& __mid,
+                _Base_ptr& __r, size_type& __rh);
+  template <class _Merge>
+  _Base_ptr _M_union(_Base_ptr __t1, size_type __h1, _Base_ptr __t2, size_type __h2,
+                     size_type& __h, size_type& __n, _Merge& __merge);
+  template <class _Merge>
+  _Base_ptr _M_union_insert(_Base_ptr __t1, size_type& __h1, _Base_ptr __t2,
+                            size_type& __n, _Merge& __merge);
+  template <class _Merge>
+  _Base_ptr _M_intersect(_Base_ptr __t1, size_type __h1, _Base_ptr __t2, size_type __h2,
+                         size_type& __h, size_type& __n, _Merge& __merge);
+  _Base_ptr _M_subtract(_Base_ptr __t1, size_type __h1, _Base_ptr __t2, size_type __h2,
+                        size_type& __h, size_type& __n);
+  size_type _M_count_before(const_iterator __pos) const;
+  void _M_reset_header(_Base_ptr __root, _Base_ptr __leftmost, _Base_ptr __rightmost, size_type __n);
+
 }; // Rb_tree
 
 
@@ -813,37 +1415,48 @@ _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
     clear();
     _M_node_count = 0;
     _M_key_compare = __x._M_key_compare;        
-    if (__x._M_root() == 0) {
+    if (__x._M_begin() == 0) {
       _M_root() = 0;
       _M_leftmost() = _M_header;
       _M_rightmost() = _M_header;
     }
     else {
-      _M_root() = _M_copy(__x._M_root(), _M_header);
-      _M_leftmost() = _S_minimum(_M_root());
-      _M_rightmost() = _S_maximum(_M_root());
+      _M_root() = _M_copy(__x._M_begin(), _M_header);
+      _M_leftmost() = _S_minimum(_M_begin());
+      _M_rightmost() = _S_maximum(_M_begin());
       _M_node_count = __x._M_node_count;
     }
   }
   return *this;
 }
 
+// _M_insert() :
+// 새 노드를 만들어 (__x, __y)가 가리키는 자리에 넣는다. 자리는 _M_get_insert_unique_pos() 등이 찾는다.
 template <class _Key, class _Value, class _GetKeyOfValue, 
           class _Compare, class _Alloc>
 typename _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::iterator
 _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
-  ::_M_insert(_Base_ptr __x_, _Base_ptr __y_, const _Value& __v)
+  ::_M_insert(_Base_ptr __x, _Base_ptr __y, const _Value& __v)
+{
+  return _M_insert_node(__x, __y, _M_create_node(__v));
+}
+
+// _M_insert_node() :
+// 이미 있는 노드 __z를 __y의 자식으로 연결하고 rebalance한다. (__x가 null이 아니면 왼쪽 자식이 된다.)
+template <class _Key, class _Value, class _GetKeyOfValue, 
+          class _Compare, class _Alloc>
+typename _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::iterator
+_Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
+  ::_M_insert_node(_Base_ptr __x_, _Base_ptr __y_, _Link_type __z)
 {
   _Link_type __x = (_Link_type) __x_;
   _Link_type __y = (_Link_type) __y_;
-  _Link_type __z;
 
   // 1. __y의 왼쪽노드에 insert!
   if (__y == _M_header || __x != 0 || // (*)요소가 없거나
-      _M_key_compare(_GetKeyOfValue()(__v), _S_key(__y))) {
+      _M_key_compare(_S_key(__z), _S_key(__y))) {
          // (*)__y가 _M_header라면 새 노드는 여기서 leftmost가 된다.
-    __z = _M_create_node(__v);
-    _S_left(__y) = __z; 
+    __y->_M_left = __z; 
     // (*)첫 노드일 때 추가설정
     if (__y == _M_header) {
       _M_root() = __z;
@@ -855,33 +1468,34 @@ _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
   }
   // 2. __y의 오른쪽 노드에 insert!
   else {
-    __z = _M_create_node(__v);
-    _S_right(__y) = __z;
+    __y->_M_right = __z;
     // y가 rightmost였다면, rightmost 노드를 갱신해준다
     if (__y == _M_rightmost())
       _M_rightmost() = __z;
   }
-  _S_parent(__z) = __y;
-  _S_left(__z) = 0;
-  _S_right(__z) = 0;
-  _Rb_tree_rebalance_for_insert(__z, _M_header->_M_parent);
+  __z->_M_init_parent_color(__y, _S_rb_tree_red);
+  __z->_M_left = 0;
+  __z->_M_right = 0;
+  _Rb_tree_rebalance_for_insert(__z, _M_header->_M_parent_slot());
   ++_M_node_count;
   return iterator(__z);
 }
 
-// insert_unique() :
-
-// 요소 1개
+// _M_get_insert_unique_pos() :
+// key가 __k인 노드를 넣을 자리 (_M_insert()의 __x, __y)를 반환한다.
+// 이미 같은 key가 있으면 (그 노드, null)을 반환한다.
 template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
-pair<typename _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::iterator, bool> // 리턴값
-_Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::insert_unique(const _Value& __v)
+pair<typename _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_Base_ptr,
+     typename _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_Base_ptr>
+_Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_M_get_insert_unique_pos(const _Key& __k)
 {
+  typedef pair<_Base_ptr, _Base_ptr> _Res;
   _Link_type __y = _M_header;
-  _Link_type __x = _M_root();
+  _Link_type __x = _M_begin();
   bool __comp = true;
   while (__x != 0) {  // 원소가 1개 이상이면 진입
     __y = __x;
-    __comp = _M_key_compare(_GetKeyOfValue()(__v), _S_key(__x));// less일 때, 대소구분이 넣은 순서대로면 true 반환
+    __comp = _M_key_compare(__k, _S_key(__x));// less일 때, 대소구분이 넣은 순서대로면 true 반환
     if (__comp) {
       __x = _S_left(__x); // __v < __x
     } else {
@@ -891,56 +1505,282 @@ _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::insert_unique(const _Value
   iterator __j = iterator(__y);   
   if (__comp) {// __x가 __y의 왼쪽 노드일 때
     if (__j == begin())     
-      {return pair<iterator,bool>(_M_insert(__x, __y, __v), true);}
+      return _Res(__x, __y);
     else
       {--__j;}// 삽입할 위치로 이터레이터 이동
   }
-  if (_M_key_compare(_S_key(__j._M_node), _GetKeyOfValue()(__v)))
-    {return pair<iterator,bool>(_M_insert(__x, __y, __v), true);}
-  return pair<iterator,bool>(__j, false);
+  if (_M_key_compare(_S_key(__j._M_node), __k))
+    return _Res(__x, __y);
+  return _Res(__j._M_node, 0);
 }
 
-// 힌트와 함께
+// _M_get_insert_hint_unique_pos() :
+// __position 바로 앞에 넣을 수 있으면 탐색 없이 그 자리를 반환한다. 아니면 _M_get_insert_unique_pos()와 같다.
 template <class _Key, class _Val, class _GetKeyOfValue, 
           class _Compare, class _Alloc>
-typename _Rb_tree<_Key, _Val, _GetKeyOfValue, _Compare, _Alloc>::iterator 
+pair<typename _Rb_tree<_Key,_Val,_GetKeyOfValue,_Compare,_Alloc>::_Base_ptr,
+     typename _Rb_tree<_Key,_Val,_GetKeyOfValue,_Compare,_Alloc>::_Base_ptr>
 _Rb_tree<_Key, _Val, _GetKeyOfValue, _Compare, _Alloc>
-  ::insert_unique(iterator __position, const _Val& __v)
+  ::_M_get_insert_hint_unique_pos(iterator __position, const _Key& __k)
 {
+  typedef pair<_Base_ptr, _Base_ptr> _Res;
   if (__position._M_node == _M_header->_M_left) { // begin()
     if (size() > 0 && 
-       _M_key_compare(_GetKeyOfValue()(__v), _S_key(__position._M_node)))
-      return _M_insert(__position._M_node, __position._M_node, __v);
+       _M_key_compare(__k, _S_key(__position._M_node)))
+      return _Res(__position._M_node, __position._M_node);
     // first argument just needs to be non-null 
     else
-      return insert_unique(__v).first;
+      return _M_get_insert_unique_pos(__k);
   } else if (__position._M_node == _M_header) { // end()
-    if (_M_key_compare(_S_key(_M_rightmost()), _GetKeyOfValue()(__v)))
-      return _M_insert(0, _M_rightmost(), __v);
+    if (_M_key_compare(_S_key(_M_rightmost()), __k))
+      return _Res(0, _M_rightmost());
     else
-      return insert_unique(__v).first;
+      return _M_get_insert_unique_pos(__k);
   } else {
     iterator __before = __position;
     --__before;
-    if (_M_key_compare(_S_key(__before._M_node), _GetKeyOfValue()(__v)) 
-        && _M_key_compare(_GetKeyOfValue()(__v), _S_key(__position._M_node))) {
+    if (_M_key_compare(_S_key(__before._M_node), __k) 
+        && _M_key_compare(__k, _S_key(__position._M_node))) {
       if (_S_right(__before._M_node) == 0)
-        return _M_insert(0, __before._M_node, __v); 
+        return _Res(0, __before._M_node); 
       else
-        return _M_insert(__position._M_node, __position._M_node, __v);
+        return _Res(__position._M_node, __position._M_node);
     // first argument just needs to be non-null 
     } else
-      return insert_unique(__v).first;
+      return _M_get_insert_unique_pos(__k);
   }
 }
 
+// insert_unique() :
+
+// 요소 1개
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+pair<typename _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::iterator, bool> // 리턴값
+_Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::insert_unique(const _Value& __v)
+{
+  pair<_Base_ptr, _Base_ptr> __p = _M_get_insert_unique_pos(_GetKeyOfValue()(__v));
+  if (__p.second)
+    return pair<iterator,bool>(_M_insert(__p.first, __p.second, __v), true);
+  return pair<iterator,bool>(iterator((_Link_type) __p.first), false);
+}
+
+// 힌트와 함께
+template <class _Key, class _Val, class _GetKeyOfValue, 
+          class _Compare, class _Alloc>
+typename _Rb_tree<_Key, _Val, _GetKeyOfValue, _Compare, _Alloc>::iterator 
+_Rb_tree<_Key, _Val, _GetKeyOfValue, _Compare, _Alloc>
+  ::insert_unique(iterator __position, const _Val& __v)
+{
+  pair<_Base_ptr, _Base_ptr> __p = _M_get_insert_hint_unique_pos(__position, _GetKeyOfValue()(__v));
+  if (__p.second)
+    return _M_insert(__p.first, __p.second, __v);
+  return iterator((_Link_type) __p.first);
+}
+
+// _M_get_insert_equal_pos() :
+// key가 __k인 노드를 넣을 자리. 같은 key를 만나면 오른쪽으로 가므로, 같은 key 중 맨 뒤에 들어간다.
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+pair<typename _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_Base_ptr,
+     typename _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_Base_ptr>
+_Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::_M_get_insert_equal_pos(const _Key& __k)
+{
+  typedef pair<_Base_ptr, _Base_ptr> _Res;
+  _Link_type __y = _M_header;
+  _Link_type __x = _M_begin();
+  while (__x != 0) {
+    __y = __x;
+    __x = _M_key_compare(__k, _S_key(__x)) ? _S_left(__x) : _S_right(__x);
+  }
+  return _Res(__x, __y);
+}
+
+// _M_get_insert_hint_equal_pos() :
+// __position 바로 앞에 넣어도 순서가 맞으면(앞의 요소 <= __k <= __position) 탐색 없이 그 자리를 반환한다.
+template <class _Key, class _Val, class _GetKeyOfValue, 
+          class _Compare, class _Alloc>
+pair<typename _Rb_tree<_Key,_Val,_GetKeyOfValue,_Compare,_Alloc>::_Base_ptr,
+     typename _Rb_tree<_Key,_Val,_GetKeyOfValue,_Compare,_Alloc>::_Base_ptr>
+_Rb_tree<_Key, _Val, _GetKeyOfValue, _Compare, _Alloc>
+  ::_M_get_insert_hint_equal_pos(iterator __position, const _Key& __k)
+{
+  typedef pair<_Base_ptr, _Base_ptr> _Res;
+  if (__position._M_node == _M_header) { // end()
+    if (size() > 0 && !_M_key_compare(__k, _S_key(_M_rightmost())))
+      return _Res(0, _M_rightmost());
+    return _M_get_insert_equal_pos(__k);
+  } else if (__position._M_node == _M_header->_M_left) { // begin()
+    if (!_M_key_compare(_S_key(__position._M_node), __k))
+      return _Res(__position._M_node, __position._M_node);
+    // first argument just needs to be non-null 
+    return _M_get_insert_equal_pos(__k);
+  } else {
+    iterator __before = __position;
+    --__before;
+    if (!_M_key_compare(__k, _S_key(__before._M_node))
+        && !_M_key_compare(_S_key(__position._M_node), __k)) {
+      if (_S_right(__before._M_node) == 0)
+        return _Res(0, __before._M_node);
+      else
+        return _Res(__position._M_node, __position._M_node);
+    // first argument just needs to be non-null 
+    }
+    return _M_get_insert_equal_pos(__k);
+  }
+}
+
+// insert_equal() :
+
+// 요소 1개
+template <class _Key, class _Value, class _GetKeyOfValue, class _Compare, class _Alloc>
+typename _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::iterator
+_Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>::insert_equal(const _Value& __v)
+{
+  pair<_Base_ptr, _Base_ptr> __p = _M_get_insert_equal_pos(_GetKeyOfValue()(__v));
+  return _M_insert(__p.first, __p.second, __v);
+}
+
+// 힌트와 함께
+template <class _Key, class _Val, class _GetKeyOfValue, 
+          class _Compare, class _Alloc>
+typename _Rb_tree<_Key, _Val, _GetKeyOfValue, _Compare, _Alloc>::iterator 
+_Rb_tree<_Key, _Val, _GetKeyOfValue, _Compare, _Alloc>
+  ::insert_equal(iterator __position, const _Val& __v)
+{
+  pair<_Base_ptr, _Base_ptr> __p = _M_get_insert_hint_equal_pos(__position, _GetKeyOfValue()(__v));
+  return _M_insert(__p.first, __p.second, __v);
+}
+
+// 범위
+template <class _Key, class _Val, class _KoV, class _Cmp, class _Alloc> 
+  template<class _II>
+void _Rb_tree<_Key,_Val,_KoV,_Cmp,_Alloc>
+  ::_M_insert_equal_range(_II __first, _II __last, std::input_iterator_tag) {
+  for ( ; __first != __last; ++__first)
+    insert_equal(end(), *__first);
+}
+
+template <class _Key, class _Val, class _KoV, class _Cmp, class _Alloc> 
+  template<class _FI>
+void _Rb_tree<_Key,_Val,_KoV,_Cmp,_Alloc>
+  ::_M_insert_equal_range(_FI __first, _FI __last, std::forward_iterator_tag) {
+  if (_M_node_count == 0) {
+    size_type __n = 0;
+    _FI __prev = __first;
+    _FI __cur = __first;
+    for ( ; __cur != __last; __prev = __cur, ++__cur, ++__n)
+      if (__n != 0 && _M_key_compare(_KoV()(*__cur), _KoV()(*__prev)))
+        break; // 정렬되어 있지 않다.
+    if (__cur == __last) {
+      _M_build_sorted(__first, __n);
+      return;
+    }
+  }
+  _M_insert_equal_range(__first, __last, std::input_iterator_tag());
+}
+
 // 범위
+// input iterator는 한 번밖에 읽을 수 없으므로, end()를 힌트로 하나씩 넣는다.
 template <class _Key, class _Val, class _KoV, class _Cmp, class _Alloc> 
   template<class _II>
 void _Rb_tree<_Key,_Val,_KoV,_Cmp,_Alloc>
-  ::insert_unique(_II __first, _II __last) {
+  ::_M_insert_unique_range(_II __first, _II __last, std::input_iterator_tag) {
   for ( ; __first != __last; ++__first)
-    insert_unique(*__first);
+    insert_unique(end(), *__first);
+}
+
+template <class _Key, class _Val, class _KoV, class _Cmp, class _Alloc> 
+  template<class _FI>
+void _Rb_tree<_Key,_Val,_KoV,_Cmp,_Alloc>
+  ::_M_insert_unique_range(_FI __first, _FI __last, std::forward_iterator_tag) {
+  if (_M_node_count == 0) {
+    size_type __n = 0;
+    _FI __prev = __first;
+    _FI __cur = __first;
+    for ( ; __cur != __last; __prev = __cur, ++__cur, ++__n)
+      if (__n != 0 && !_M_key_compare(_KoV()(*__prev), _KoV()(*__cur)))
+        break; // 정렬되어 있지 않거나 중복이 있다.
+    if (__cur == __last) {
+      _M_build_sorted(__first, __n);
+      return;
+    }
+  }
+  _M_insert_unique_range(__first, __last, std::input_iterator_tag());
+}
+
+template <class _Key, class _Val, class _KoV, class _Cmp, class _Alloc> 
+  template<class _II>
+void _Rb_tree<_Key,_Val,_KoV,_Cmp,_Alloc>
+  ::_M_insert_sorted_unique(_II __first, _II __last, std::input_iterator_tag) {
+  _M_insert_unique_range(__first, __last, std::input_iterator_tag());
+}
+
+template <class _Key, class _Val, class _KoV, class _Cmp, class _Alloc> 
+  template<class _FI>
+void _Rb_tree<_Key,_Val,_KoV,_Cmp,_Alloc>
+  ::_M_insert_sorted_unique(_FI __first, _FI __last, std::forward_iterator_tag) {
+  if (_M_node_count == 0)
+    _M_build_sorted(__first, std::distance(__first, __last));
+  else
+    _M_insert_unique_range(__first, __last, std::input_iterator_tag());
+}
+
+// _M_build_sorted() :
+// 빈 트리를 정렬된 __n개의 요소로 한 번에 만든다. 비교도, 회전도 하지 않는다.
+// 가운데 요소를 루트로 삼는 것을 재귀적으로 반복하므로 (중위순회 순서대로 만들어진다) 왼쪽과 오른쪽의 크기 차이는 1 이하다.
+// 그러면 가장 깊은 층(깊이 floor(log2(n)))을 제외한 모든 층이 꽉 차므로,
+// 가장 깊은 층만 red로, 나머지는 black으로 칠하면 모든 경로의 black 노드 수가 같아진다.
+template <class _Key, class _Val, class _KoV, class _Cmp, class _Alloc> 
+  template<class _FI>
+void _Rb_tree<_Key,_Val,_KoV,_Cmp,_Alloc>
+  ::_M_build_sorted(_FI __first, size_type __n) {
+  if (__n == 0)
+    return;
+  size_type __red_depth = 0;
+  for (size_type __m = __n; __m > 1; __m >>= 1)
+    ++__red_depth;
+  _M_root() = _M_build_subtree(__first, __n, 0, __red_depth, _M_header);
+  _M_leftmost() = _S_minimum(_M_begin());
+  _M_rightmost() = _S_maximum(_M_begin());
+  _M_node_count = __n;
+}
+
+// _M_build_subtree() :
+// __it부터 __n개로 서브트리를 만들고 그 루트를 반환한다. __it은 다 쓴 다음 위치로 옮겨진다.
+// 실패하면 이미 만든 노드를 모두 지우고 다시 던진다.
+template <class _Key, class _Val, class _KoV, class _Cmp, class _Alloc> 
+  template<class _FI>
+typename _Rb_tree<_Key,_Val,_KoV,_Cmp,_Alloc>::_Link_type
+_Rb_tree<_Key,_Val,_KoV,_Cmp,_Alloc>
+  ::_M_build_subtree(_FI& __it, size_type __n, size_type __depth, size_type __red_depth, _Link_type __parent) {
+  if (__n == 0)
+    return 0;
+  const size_type __left_n = __n / 2;
+  _Link_type __left = _M_build_subtree(__it, __left_n, __depth + 1, __red_depth, 0);
+  _Link_type __top;
+  try {
+    __top = _M_create_node(*__it);
+  }
+  catch(...)
+  {
+  _M_clear(__left);
+  throw;
+  }
+  ++__it;
+  __top->_M_init_parent_color(__parent, (__depth == __red_depth && __depth != 0) ? _S_rb_tree_red : _S_rb_tree_black);
+  __top->_M_left = __left;
+  __top->_M_right = 0;
+  if (__left)
+    __left->_M_set_parent(__top);
+  try {
+    __top->_M_right = _M_build_subtree(__it, __n - 1 - __left_n, __depth + 1, __red_depth, __top);
+  }
+  catch(...)
+  {
+  _M_clear(__top); // (오른쪽은 아직 비어 있으므로, __top과 왼쪽 서브트리를 지운다.)
+  throw;
+  }
+  _Rb_tree_reset_size(__top);
+  return __top;
 }
 
 // erase() :
@@ -953,7 +1793,7 @@ void _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
 {
   _Link_type __y = 
     (_Link_type) _Rb_tree_rebalance_for_erase(__position._M_node,
-                                              _M_header->_M_parent,
+                                              _M_header->_M_parent_slot(),
                                               _M_header->_M_left,
                                               _M_header->_M_right);
   destroy_node(__y);
@@ -985,24 +1825,25 @@ void _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
     while (__first != __last) erase(__first++);
 }
 
-// _M_copy() :
-// 재귀를 이용해서 이진탐색트리를 깊은 복사한다.
+// _S_copy() :
+// 재귀를 이용해서 이진탐색트리를 깊은 복사한다. 노드는 __a로 할당한다.
 template <class _Key, class _Val, class _KoV, class _Compare, class _Alloc>
 typename _Rb_tree<_Key, _Val, _KoV, _Compare, _Alloc>::_Link_type 
 _Rb_tree<_Key,_Val,_KoV,_Compare,_Alloc>
-  ::_M_copy(
+  ::_S_copy(
+      _Node_allocator& __a,
       _Link_type __x,  // __x의 복사본을
       _Link_type __p)// __x_parent에 연결하여 반환한다.
 {
     // 1. 오른쪽 서브트리를 해결한다.
   // 1-1. top노드 생성 및 연결
-  _Link_type __top = _M_clone_node(__x); // 복사 후 서브트리의 맨 위 노드를 먼저 만들고
-  __top->_M_parent = __p; // 연결해둔다.
+  _Link_type __top = _S_clone_node(__a, __x); // 복사 후 서브트리의 맨 위 노드를 먼저 만들고
+  __top->_M_set_parent(__p); // 연결해둔다.
  
   try {
      // 1-1. 오른쪽 서브트리 복사
     if (__x->_M_right)
-      __top->_M_right = _M_copy(_S_right(__x), __top);
+      __top->_M_right = _S_copy(__a, _S_right(__x), __top);
     __p = __top;
 
     // 2. 왼쪽 서브트리로 계속 이동하면서 해결해나간다.
@@ -1010,39 +1851,54 @@ _Rb_tree<_Key,_Val,_KoV,_Compare,_Alloc>
 
     while (__x != 0) {
       // 2-1. (sub)top노드 생성 및 연결
-      _Link_type __y = _M_clone_node(__x);
+      _Link_type __y = _S_clone_node(__a, __x);
       __p->_M_left = __y;
-      __y->_M_parent = __p;
+      __y->_M_set_parent(__p);
       // 2-2. 왼쪽 서브트리 복사
       if (__x->_M_right)
-        __y->_M_right = _M_copy(_S_right(__x), __y);
+        __y->_M_right = _S_copy(__a, _S_right(__x), __y);
       __p = __y;
       __x = _S_left(__x);
     }
   }
   catch(...)
     {
-      _M_clear(__top);
+      _S_clear(__a, __top);
       throw; 
     }
   return __top;
 }
 
-// _M_clear() :
-// 전체 서브트리를 지운다. (원래 제목은 _M_erase()였다.)
+// _S_clear() :
+// 전체 서브트리를 지운다. 노드는 __a로 해제한다. (원래 제목은 _M_erase()였다.)
 template <class _Key, class _Value, class _GetKeyOfValue, 
           class _Compare, class _Alloc>
 void _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
-  ::_M_clear(_Link_type __x)
+  ::_S_clear(_Node_allocator& __a, _Link_type __x)
 {
   while (__x != 0) {
-    _M_clear(_S_right(__x)); // __x의 오른쪽 서브트리를 모두 지운다.
+    _S_clear(__a, _S_right(__x)); // __x의 오른쪽 서브트리를 모두 지운다.
     _Link_type __y = _S_left(__x); // __x의 왼쪽 서브트리는 다음에 작업하기 위해 save.
-    destroy_node(__x); // 이제 __x를 지워도 된다.
+    __x->_M_value_field.~value_type(); // 이제 __x를 지워도 된다.
+    __a.deallocate(__x, 1);
     __x = __y;
   }
 }
 
+// _M_destroy_values() :
+// _M_clear()와 같지만, 노드는 해제하지 않고 값만 소멸시킨다. (노드는 clear()가 한 번에 돌려준다.)
+template <class _Key, class _Value, class _GetKeyOfValue, 
+          class _Compare, class _Alloc>
+void _Rb_tree<_Key,_Value,_GetKeyOfValue,_Compare,_Alloc>
+  ::_M_destroy_values(_Link_type __x)
+{
+  while (__x != 0) {
+    _M_destroy_values(_S_right(__x));
+    _Destroy(&__x->_M_value_field);
+    __x = _S_left(__x);
+  }
+}
+
 // find() :
 // __x가 key인 요소가 있으면 그 요소의 반복자를 반환하고, 없으면 end()를 반환한다.
 template <class _Key, class _Value, class _KeyOfValue, 
@@ -1051,7 +1907,7 @@ typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::iterator
 _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::find(const _Key& __k)
 {
   _Link_type __y = _M_header; 
-  _Link_type __x = _M_root(); 
+  _Link_type __x = _M_begin(); 
 
   while (__x != 0) 
     if (!_M_key_compare(_S_key(__x), __k)) { // (*) 같으면 !less()는 true
@@ -1071,7 +1927,7 @@ typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::const_iterator
 _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::find(const _Key& __k) const
 {
   _Link_type __y = _M_header;
-  _Link_type __x = _M_root();
+  _Link_type __x = _M_begin();
   while (__x != 0) {
     if (!_M_key_compare(_S_key(__x), __k))
       __y = __x, __x = _S_left(__x);
@@ -1083,6 +1939,54 @@ _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::find(const _Key& __k) const
     end() : __j;
 }
 
+// _M_search_batch() :
+// key를 _S_batch_group개씩 묶어, 묶음 안의 검색을 lower_bound()와 같은 방식으로 한 단계씩 번갈아 진행한다.
+// 한 단계를 내려갈 때마다 다음 노드를 prefetch하므로, 그 노드는 같은 묶음의 다른 검색들이 한 단계씩 가는 동안 불러와진다.
+// 묶음의 검색이 모두 끝나면 결과를 key 순서대로 쓴다. __exact이면 find()처럼 같은 key가 아닌 결과를 end()로 바꾼다.
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+template <class _Iter, class _ForwardIter, class _OutputIter>
+_OutputIter 
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_search_batch(_ForwardIter __first, _ForwardIter __last, _OutputIter __out, bool __exact) const
+{
+  _ForwardIter __k[_S_batch_group];
+  _Link_type __x[_S_batch_group]; // 지금 보는 노드. 0이면 그 검색은 끝났다.
+  _Link_type __y[_S_batch_group]; // key보다 작지 않은 마지막 노드
+
+  while (__first != __last) {
+    size_type __n = 0;
+    for ( ; __n < _S_batch_group && __first != __last; ++__n, ++__first) {
+      __k[__n] = __first;
+      __x[__n] = _M_begin();
+      __y[__n] = _M_header;
+    }
+    for (size_type __live = __n; __live != 0; ) {
+      __live = 0;
+      for (size_type __i = 0; __i < __n; ++__i) {
+        if (__x[__i] == 0)
+          continue;
+        if (!_M_key_compare(_S_key(__x[__i]), *__k[__i]))
+          __y[__i] = __x[__i], __x[__i] = _S_left(__x[__i]);
+        else
+          __x[__i] = _S_right(__x[__i]);
+        if (__x[__i] != 0) {
+          __builtin_prefetch(__x[__i]);
+          __builtin_prefetch(&__x[__i]->_M_value_field);
+          ++__live;
+        }
+      }
+    }
+    for (size_type __i = 0; __i < __n; ++__i) {
+      if (__exact && __y[__i] != _M_header && _M_key_compare(*__k[__i], _S_key(__y[__i])))
+        __y[__i] = _M_header;
+      *__out = _Iter(__y[__i]);
+      ++__out;
+    }
+  }
+  return __out;
+}
+
 template <class _Key, class _Value, class _KeyOfValue, 
           class _Compare, class _Alloc>
 typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::size_type 
@@ -1090,9 +1994,536 @@ _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
   ::count(const _Key& __k) const
 {
   pair<const_iterator, const_iterator> __p = equal_range(__k);
-  size_type __n = 0;
-  distance(__p.first, __p.second, __n);
-  return __n;
+  return distance(__p.first, __p.second);
+}
+
+// _M_nth() :
+// 왼쪽 서브트리의 크기와 비교하며 내려간다.
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::_Link_type 
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_nth(size_type __k) const
+{
+  if (__k >= _M_node_count)
+    return _M_header;
+#ifdef FT_RB_TREE_ORDER_STATISTICS
+  _Link_type __x = _M_begin();
+  for (;;) {
+    const size_type __left_n = _Rb_tree_subtree_size(__x->_M_left);
+    if (__k < __left_n)
+      __x = _S_left(__x);
+    else if (__k == __left_n)
+      return __x;
+    else {
+      __k -= __left_n + 1;
+      __x = _S_right(__x);
+    }
+  }
+#else
+  const_iterator __it = begin();
+  for ( ; __k != 0; --__k)
+    ++__it;
+  return (_Link_type) __it._M_node;
+#endif
+}
+
+// index_of() :
+// 왼쪽 서브트리의 크기에서 시작해, root까지 올라가며 오른쪽 자식이었을 때마다 부모와 그 왼쪽 서브트리를 더한다.
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::size_type 
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::index_of(const_iterator __it) const
+{
+  if (__it._M_node == _M_header)
+    return _M_node_count;
+#ifdef FT_RB_TREE_ORDER_STATISTICS
+  _Base_ptr __x = __it._M_node;
+  size_type __i = _Rb_tree_subtree_size(__x->_M_left);
+  while (__x != _M_begin()) {
+    _Base_ptr __p = __x->_M_get_parent();
+    if (__x == __p->_M_right)
+      __i += _Rb_tree_subtree_size(__p->_M_left) + 1;
+    __x = __p;
+  }
+  return __i;
+#else
+  return std::distance(begin(), __it);
+#endif
+}
+
+// extract() :
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::node_type 
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::extract(iterator __position)
+{
+  _Link_type __z = 
+    (_Link_type) _Rb_tree_rebalance_for_erase(__position._M_node,
+                                              _M_header->_M_parent_slot(),
+                                              _M_header->_M_left,
+                                              _M_header->_M_right);
+  --_M_node_count;
+  return node_type(__z, this->_M_node_allocator);
+}
+
+// insert_unique(node_type&) :
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+pair<typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::iterator, bool>
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::insert_unique(node_type& __nh)
+{
+  if (__nh.empty())
+    return pair<iterator, bool>(end(), false);
+  if (!(__nh._M_alloc == this->_M_node_allocator)) {
+    pair<iterator, bool> __r = insert_unique(__nh.value());
+    if (__r.second)
+      __nh._M_reset();
+    return __r;
+  }
+  pair<_Base_ptr, _Base_ptr> __p = _M_get_insert_unique_pos(_S_key(__nh._M_node));
+  if (__p.second)
+    return pair<iterator, bool>(_M_insert_node(__p.first, __p.second, __nh._M_release()), true);
+  return pair<iterator, bool>(iterator((_Link_type) __p.first), false);
+}
+
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::iterator
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::insert_unique(iterator __position, node_type& __nh)
+{
+  if (__nh.empty())
+    return end();
+  if (!(__nh._M_alloc == this->_M_node_allocator)) {
+    size_type __before = _M_node_count;
+    iterator __r = insert_unique(__position, __nh.value());
+    if (_M_node_count != __before)
+      __nh._M_reset();
+    return __r;
+  }
+  pair<_Base_ptr, _Base_ptr> __p = _M_get_insert_hint_unique_pos(__position, _S_key(__nh._M_node));
+  if (__p.second)
+    return _M_insert_node(__p.first, __p.second, __nh._M_release());
+  return iterator((_Link_type) __p.first);
+}
+
+// merge_unique() :
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+void _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::merge_unique(_Rb_tree& __src)
+{
+  if (&__src == this || __src._M_node_count == 0)
+    return;
+  if (!_M_same_node_allocator(__src)) {
+    for (iterator __it = __src.begin(); __it != __src.end(); )
+      if (insert_unique(*__it).second)
+        __src.erase(__it++);
+      else
+        ++__it;
+    return;
+  }
+  // 1. 통째로 옮길 수 있을 때
+  if (_M_node_count == 0 || _M_key_compare(_S_key(_M_rightmost()), _S_key(__src._M_leftmost()))) {
+    join(__src);
+    return;
+  }
+  if (_M_key_compare(_S_key(__src._M_rightmost()), _S_key(_M_leftmost()))) {
+    __src.join(*this);
+    std::swap(_M_header, __src._M_header); // (할당기가 같으므로 header도 바꿀 수 있다.)
+    std::swap(_M_node_count, __src._M_node_count);
+    return;
+  }
+  // 2. 노드를 하나씩 떼어 옮긴다. 다른 노드는 움직이지 않으므로 __it는 유효하다.
+  for (iterator __it = __src.begin(); __it != __src.end(); ) {
+    iterator __cur = __it++;
+    pair<_Base_ptr, _Base_ptr> __p = _M_get_insert_unique_pos(_S_key(__cur._M_node));
+    if (__p.second) {
+      _Link_type __z = 
+        (_Link_type) _Rb_tree_rebalance_for_erase(__cur._M_node,
+                                                  __src._M_header->_M_parent_slot(),
+                                                  __src._M_header->_M_left,
+                                                  __src._M_header->_M_right);
+      --__src._M_node_count;
+      _M_insert_node(__p.first, __p.second, __z);
+    }
+  }
+}
+
+// split() :
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+void _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::split(const _Key& __k, _Rb_tree& __right)
+{
+  if (&__right == this)
+    return;
+  __right.clear();
+  iterator __pos = lower_bound(__k);
+  if (__pos == end())
+    return;
+  if (!_M_same_node_allocator(__right)) {
+    __right.insert_sorted_unique(__pos, end()); // (빈 트리에 넣으므로 O(k)에 만든다.)
+    erase(__pos, end());
+    return;
+  }
+
+  // 잘라도 노드는 그대로이므로, 양 끝과 요소 수를 미리 구해둔다.
+  const size_type __left_n = _M_count_before(__pos);
+  _Base_ptr __leftmost = _M_leftmost();
+  _Base_ptr __rightmost = _M_rightmost();
+  iterator __before = __pos;
+  if (__pos != begin())
+    --__before;
+
+  _Base_ptr __l, __mid, __r;
+  size_type __lh, __rh;
+  _M_split(_M_begin(), _Rb_tree_black_height(_M_begin()), __k, __l, __lh, __mid, __r, __rh);
+  if (__mid) // key가 __k인 노드는 오른쪽의 맨 앞에 붙인다.
+    __r = _Rb_tree_join(0, 0, __mid, __r, __rh, __rh);
+
+  __right._M_reset_header(__r, __pos._M_node, __rightmost, _M_node_count - __left_n);
+  _M_reset_header(__l, __leftmost, __before._M_node, __left_n);
+}
+
+// _M_split() :
+// black height가 __h인 서브트리 __x를 key < __k인 트리(__l), key가 __k인 노드(__mid, 없으면 null), key > __k인 트리(__r)로 나눈다.
+// __l과 __r의 root는 black이다.
+// __x를 기준으로 한쪽 자식만 재귀적으로 나누고, 나머지 자식과 __x를 그 결과에 _Rb_tree_join()으로 붙인다.
+// 붙일 때마다 드는 비용(높이 차이)의 합이 트리의 높이를 넘지 않으므로 전체 O(log n)이다.
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+void _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_split(_Base_ptr __x, size_type __h, const _Key& __k,
+             _Base_ptr& __l, size_type& __lh, _Base_ptr& __mid,
+             _Base_ptr& __r, size_type& __rh)
+{
+  if (__x == 0) {
+    __l = __mid = __r = 0;
+    __lh = __rh = 0;
+    return;
+  }
+  _Base_ptr __a, __b, __m;
+  size_type __ah, __bh, __mh;
+  _Rb_tree_expose(__x, __h, __a, __ah, __b, __bh);
+
+  if (_M_key_compare(_S_key(__x), __k)) { // __x는 왼쪽으로 간다
+    _M_split(__b, __bh, __k, __m, __mh, __mid, __r, __rh);
+    __l = _Rb_tree_join(__a, __ah, __x, __m, __mh, __lh);
+  }
+  else if (_M_key_compare(__k, _S_key(__x))) { // __x는 오른쪽으로 간다
+    _M_split(__a, __ah, __k, __l, __lh, __mid, __m, __mh);
+    __r = _Rb_tree_join(__m, __mh, __x, __b, __bh, __rh);
+  }
+  else { // 찾았다
+    __l = __a; __lh = __ah;
+    __r = __b; __rh = __bh;
+    __mid = __x;
+  }
+}
+
+// join() :
+// __right의 가장 작은 노드를 떼어내 가운데 노드로 삼는다.
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+void _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::join(_Rb_tree& __right)
+{
+  if (&__right == this || __right._M_node_count == 0)
+    return;
+  if (!_M_same_node_allocator(__right)) {
+    insert_unique(__right.begin(), __right.end()); // (모두 맨 끝에 붙는다.)
+    __right.clear();
+    return;
+  }
+  if (_M_node_count == 0) {
+    std::swap(_M_header, __right._M_header);
+    std::swap(_M_node_count, __right._M_node_count);
+    return;
+  }
+
+  const size_type __n = _M_node_count + __right._M_node_count;
+  _Base_ptr __mid = __right._M_leftmost();
+  _Rb_tree_rebalance_for_erase(__mid, __right._M_header->_M_parent_slot(),
+                               __right._M_header->_M_left, __right._M_header->_M_right);
+  _Base_ptr __rightmost = (__right._M_begin() == 0) ? __mid : (_Base_ptr) __right._M_rightmost();
+  _Base_ptr __leftmost = _M_leftmost();
+
+  size_type __h;
+  _Base_ptr __root = _Rb_tree_join(_M_begin(), _Rb_tree_black_height(_M_begin()), __mid,
+                                   __right._M_begin(), _Rb_tree_black_height(__right._M_begin()), __h);
+  _M_reset_header(__root, __leftmost, __rightmost, __n);
+  __right._M_reset_header(0, 0, 0, 0);
+}
+
+// union_with() :
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+  template <class _Merge>
+void _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::union_with(_Rb_tree& __src, _Merge __merge)
+{
+  if (&__src == this || __src._M_node_count == 0)
+    return;
+  if (!_M_same_node_allocator(__src)) {
+    for (iterator __it = __src.begin(); __it != __src.end(); ++__it) {
+      pair<iterator, bool> __p = insert_unique(*__it);
+      if (!__p.second)
+        __merge(*__p.first, *__it);
+    }
+    __src.clear();
+    return;
+  }
+  size_type __h, __dup = 0;
+  _Base_ptr __root = _M_union(_M_begin(), _Rb_tree_black_height(_M_begin()),
+                              __src._M_begin(), _Rb_tree_black_height(__src._M_begin()),
+                              __h, __dup, __merge);
+  const size_type __n = _M_node_count + __src._M_node_count - __dup;
+  __src._M_reset_header(0, 0, 0, 0);
+  _M_reset_header(__root, __root ? _Rb_tree_node_base::_S_minimum(__root) : 0,
+                  __root ? _Rb_tree_node_base::_S_maximum(__root) : 0, __n);
+}
+
+// _M_union() :
+// __t2의 root를 떼어내고 그 key로 __t1을 나눈 뒤, 왼쪽끼리 오른쪽끼리 합치고 root를 가운데에 두어 붙인다.
+// 겹친 key의 수는 __n에 더한다.
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+  template <class _Merge>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::_Base_ptr
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_union(_Base_ptr __t1, size_type __h1, _Base_ptr __t2, size_type __h2,
+             size_type& __h, size_type& __n, _Merge& __merge)
+{
+  if (__t1 == 0) { __h = __h2; return __t2; }
+  if (__t2 == 0) { __h = __h1; return __t1; }
+  if (__h2 <= _S_union_insert_height) { // __t2가 아주 작으면 나누는 것보다 하나씩 넣는 것이 싸다.
+    __h = __h1;
+    return _M_union_insert(__t1, __h, __t2, __n, __merge);
+  }
+  _Base_ptr __l2, __r2, __l1, __mid, __r1;
+  size_type __l2h, __r2h, __l1h, __r1h, __lh, __rh;
+  _Rb_tree_expose(__t2, __h2, __l2, __l2h, __r2, __r2h);
+  _M_split(__t1, __h1, _S_key(__t2), __l1, __l1h, __mid, __r1, __r1h);
+  _Base_ptr __l = _M_union(__l1, __l1h, __l2, __l2h, __lh, __n, __merge);
+  _Base_ptr __r = _M_union(__r1, __r1h, __r2, __r2h, __rh, __n, __merge);
+  if (__mid) { // 겹쳤다: 이 트리의 노드를 남긴다.
+    __merge(_S_value(__mid), _S_value(__t2));
+    destroy_node((_Link_type) __t2);
+    ++__n;
+  }
+  else
+    __mid = __t2;
+  return _Rb_tree_join(__l, __lh, __mid, __r, __rh, __h);
+}
+
+// _M_union_insert() :
+// __t2의 노드를 순서대로 하나씩 떼어 __t1에 삽입하고, 새 root를 반환한다. __t1의 black height(__h1)도 갱신한다.
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+  template <class _Merge>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::_Base_ptr
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_union_insert(_Base_ptr __t1, size_type& __h1, _Base_ptr __t2,
+                    size_type& __n, _Merge& __merge)
+{
+  if (__t2 == 0)
+    return __t1;
+  _Base_ptr __right = __t2->_M_right;
+  __t1 = _M_union_insert(__t1, __h1, __t2->_M_left, __n, __merge);
+
+  _Base_ptr __y = 0;
+  _Base_ptr __x = __t1;
+  bool __left = true;
+  while (__x != 0) {
+    __y = __x;
+    if (_M_key_compare(_S_key(__t2), _S_key(__x)))
+      __x = __x->_M_left, __left = true;
+    else if (_M_key_compare(_S_key(__x), _S_key(__t2)))
+      __x = __x->_M_right, __left = false;
+    else
+      break;
+  }
+  if (__x != 0) { // 겹쳤다
+    __merge(_S_value(__x), _S_value(__t2));
+    destroy_node((_Link_type) __t2);
+    ++__n;
+  }
+  else {
+    __t2->_M_left = 0;
+    __t2->_M_right = 0;
+    __t2->_M_set_parent(__y);
+    if (__y == 0)
+      __t1 = __t2;
+    else if (__left)
+      __y->_M_left = __t2;
+    else
+      __y->_M_right = __t2;
+    if (_Rb_tree_rebalance_for_insert(__t2, __t1))
+      ++__h1;
+  }
+  return _M_union_insert(__t1, __h1, __right, __n, __merge);
+}
+
+// intersect_with() :
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+  template <class _Merge>
+void _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::intersect_with(_Rb_tree& __src, _Merge __merge)
+{
+  if (&__src == this)
+    return;
+  if (!_M_same_node_allocator(__src)) {
+    for (iterator __it = begin(); __it != end(); ) {
+      iterator __found = __src.find(_KeyOfValue()(*__it));
+      if (__found == __src.end())
+        erase(__it++);
+      else
+        __merge(*__it++, *__found);
+    }
+    __src.clear();
+    return;
+  }
+  size_type __h, __n = 0;
+  _Base_ptr __root = _M_intersect(_M_begin(), _Rb_tree_black_height(_M_begin()),
+                                  __src._M_begin(), _Rb_tree_black_height(__src._M_begin()),
+                                  __h, __n, __merge);
+  __src._M_reset_header(0, 0, 0, 0);
+  _M_reset_header(__root, __root ? _Rb_tree_node_base::_S_minimum(__root) : 0,
+                  __root ? _Rb_tree_node_base::_S_maximum(__root) : 0, __n);
+}
+
+// _M_intersect() :
+// _M_union()과 같이 나누고, 양쪽에 모두 있는 key의 노드만 남긴다. 남긴 노드의 수는 __n에 더한다.
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+  template <class _Merge>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::_Base_ptr
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_intersect(_Base_ptr __t1, size_type __h1, _Base_ptr __t2, size_type __h2,
+                 size_type& __h, size_type& __n, _Merge& __merge)
+{
+  if (__t1 == 0 || __t2 == 0) {
+    _M_clear((_Link_type) __t1);
+    _M_clear((_Link_type) __t2);
+    __h = 0;
+    return 0;
+  }
+  _Base_ptr __l2, __r2, __l1, __mid, __r1;
+  size_type __l2h, __r2h, __l1h, __r1h, __lh, __rh;
+  _Rb_tree_expose(__t2, __h2, __l2, __l2h, __r2, __r2h);
+  _M_split(__t1, __h1, _S_key(__t2), __l1, __l1h, __mid, __r1, __r1h);
+  _Base_ptr __l = _M_intersect(__l1, __l1h, __l2, __l2h, __lh, __n, __merge);
+  _Base_ptr __r = _M_intersect(__r1, __r1h, __r2, __r2h, __rh, __n, __merge);
+  if (__mid) {
+    __merge(_S_value(__mid), _S_value(__t2));
+    destroy_node((_Link_type) __t2);
+    ++__n;
+    return _Rb_tree_join(__l, __lh, __mid, __r, __rh, __h);
+  }
+  destroy_node((_Link_type) __t2);
+  return _Rb_tree_join2(__l, __lh, __r, __rh, __h);
+}
+
+// subtract() :
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+void _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::subtract(_Rb_tree& __src)
+{
+  if (&__src == this) {
+    clear();
+    return;
+  }
+  if (!_M_same_node_allocator(__src)) {
+    for (iterator __it = __src.begin(); __it != __src.end(); ++__it)
+      erase(_KeyOfValue()(*__it));
+    __src.clear();
+    return;
+  }
+  size_type __h, __removed = 0;
+  _Base_ptr __root = _M_subtract(_M_begin(), _Rb_tree_black_height(_M_begin()),
+                                 __src._M_begin(), _Rb_tree_black_height(__src._M_begin()),
+                                 __h, __removed);
+  const size_type __n = _M_node_count - __removed;
+  __src._M_reset_header(0, 0, 0, 0);
+  _M_reset_header(__root, __root ? _Rb_tree_node_base::_S_minimum(__root) : 0,
+                  __root ? _Rb_tree_node_base::_S_maximum(__root) : 0, __n);
+}
+
+// _M_subtract() :
+// _M_union()과 같이 나누고, __t2에 있는 key의 노드를 지운다. 지운 이 트리의 노드 수는 __n에 더한다.
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::_Base_ptr
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_subtract(_Base_ptr __t1, size_type __h1, _Base_ptr __t2, size_type __h2,
+                size_type& __h, size_type& __n)
+{
+  if (__t1 == 0 || __t2 == 0) {
+    _M_clear((_Link_type) __t2);
+    __h = __h1;
+    return __t1;
+  }
+  _Base_ptr __l2, __r2, __l1, __mid, __r1;
+  size_type __l2h, __r2h, __l1h, __r1h, __lh, __rh;
+  _Rb_tree_expose(__t2, __h2, __l2, __l2h, __r2, __r2h);
+  _M_split(__t1, __h1, _S_key(__t2), __l1, __l1h, __mid, __r1, __r1h);
+  destroy_node((_Link_type) __t2);
+  _Base_ptr __l = _M_subtract(__l1, __l1h, __l2, __l2h, __lh, __n);
+  _Base_ptr __r = _M_subtract(__r1, __r1h, __r2, __r2h, __rh, __n);
+  if (__mid) {
+    destroy_node((_Link_type) __mid);
+    ++__n;
+  }
+  return _Rb_tree_join2(__l, __lh, __r, __rh, __h);
+}
+
+// _M_count_before() :
+// __pos 앞에 있는 요소의 수.
+// FT_RB_TREE_ORDER_STATISTICS가 없으면, 앞에서부터와 __pos에서부터 동시에 세어 먼저 끝나는 쪽으로 계산한다.
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::size_type 
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_count_before(const_iterator __pos) const
+{
+#ifdef FT_RB_TREE_ORDER_STATISTICS
+  return index_of(__pos);
+#else
+  const_iterator __front = begin();
+  const_iterator __back = __pos;
+  for (size_type __n = 0; ; ++__n, ++__front, ++__back) {
+    if (__front == __pos)
+      return __n;
+    if (__back == end())
+      return _M_node_count - __n;
+  }
+#endif
+}
+
+// _M_reset_header() :
+// header를 root가 __root인 (요소가 __n개인) 트리로 다시 연결한다. __root가 null이면 빈 트리로 만든다.
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+void _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_reset_header(_Base_ptr __root, _Base_ptr __leftmost, _Base_ptr __rightmost, size_type __n)
+{
+  if (__root == 0) {
+    _M_empty_initialize();
+    _M_node_count = 0;
+    return;
+  }
+  __root->_M_set_parent(_M_header);
+  _M_root() = (_Link_type) __root;
+  _M_leftmost() = (_Link_type) __leftmost;
+  _M_rightmost() = (_Link_type) __rightmost;
+  _M_node_count = __n;
 }
 
 // lower_bound() :
@@ -1105,7 +2536,7 @@ _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
   ::lower_bound(const _Key& __k)
 {
   _Link_type __y = _M_header;
-  _Link_type __x = _M_root();
+  _Link_type __x = _M_begin();
   while (__x != 0) 
     if (!_M_key_compare(_S_key(__x), __k))
       __y = __x, __x = _S_left(__x);
@@ -1122,7 +2553,7 @@ _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
   ::lower_bound(const _Key& __k) const
 {
   _Link_type __y = _M_header;
-  _Link_type __x = _M_root();
+  _Link_type __x = _M_begin();
   while (__x != 0) 
     if (!_M_key_compare(_S_key(__x), __k))
       __y = __x, __x = _S_left(__x);
@@ -1142,7 +2573,7 @@ _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
   ::upper_bound(const _Key& __k)
 {
   _Link_type __y = _M_header;
-  _Link_type __x = _M_root();
+  _Link_type __x = _M_begin();
    while (__x != 0) 
      if (_M_key_compare(__k, _S_key(__x)))
        __y = __x, __x = _S_left(__x);
@@ -1159,7 +2590,7 @@ _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
   ::upper_bound(const _Key& __k) const
 {
   _Link_type __y = _M_header;
-  _Link_type __x = _M_root();
+  _Link_type __x = _M_begin();
    while (__x != 0) 
      if (_M_key_compare(__k, _S_key(__x)))
        __y = __x, __x = _S_left(__x);
@@ -1169,9 +2600,102 @@ _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
    return const_iterator(__y);
 }
 
+// _M_lower_bound_tr(), _M_upper_bound_tr(), _M_find_tr() :
+// 투명한 비교용. 위의 lower_bound(), upper_bound(), find()와 같지만 __k의 타입이 key_type이 아니어도 된다.
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+  template <typename _Kt>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::_Link_type 
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_lower_bound_tr(const _Kt& __k) const
+{
+  return _M_lower_bound(_M_begin(), _M_header, __k);
+}
+
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+  template <typename _Kt>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::_Link_type 
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_upper_bound_tr(const _Kt& __k) const
+{
+  return _M_upper_bound(_M_begin(), _M_header, __k);
+}
+
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+  template <typename _Kt>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::_Link_type 
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_lower_bound(_Link_type __x, _Link_type __y, const _Kt& __k) const
+{
+  while (__x != 0) 
+    if (!_M_key_compare(_S_key(__x), __k))
+      __y = __x, __x = _S_left(__x);
+    else
+      __x = _S_right(__x);
+
+  return __y;
+}
+
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+  template <typename _Kt>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::_Link_type 
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_upper_bound(_Link_type __x, _Link_type __y, const _Kt& __k) const
+{
+  while (__x != 0) 
+    if (_M_key_compare(__k, _S_key(__x)))
+      __y = __x, __x = _S_left(__x);
+    else
+      __x = _S_right(__x);
+
+  return __y;
+}
+
+// _M_equal_range_tr() :
+// lower_bound와 upper_bound는 __k와 같은 key를 처음 만나는 노드까지 같은 길을 간다.
+// 그래서 그 노드까지 한 번 내려간 뒤에, 왼쪽 서브트리에서 lower_bound를, 오른쪽 서브트리에서 upper_bound를 찾는다.
+// (같은 key가 없으면 두 결과는 같은 노드다.)
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+  template <typename _Kt>
+pair<typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::_Link_type,
+     typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::_Link_type>
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_equal_range_tr(const _Kt& __k) const
+{
+  typedef pair<_Link_type, _Link_type> _Res;
+  _Link_type __y = _M_header;
+  _Link_type __x = _M_begin();
+  while (__x != 0) {
+    if (_M_key_compare(_S_key(__x), __k))
+      __x = _S_right(__x);
+    else if (_M_key_compare(__k, _S_key(__x)))
+      __y = __x, __x = _S_left(__x);
+    else
+      return _Res(_M_lower_bound(_S_left(__x), __x, __k),
+                  _M_upper_bound(_S_right(__x), __y, __k));
+  }
+  return _Res(__y, __y);
+}
+
+template <class _Key, class _Value, class _KeyOfValue, 
+          class _Compare, class _Alloc>
+  template <typename _Kt>
+typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::_Link_type 
+_Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
+  ::_M_find_tr(const _Kt& __k) const
+{
+  _Link_type __y = _M_lower_bound_tr(__k);
+  return (__y == _M_header || _M_key_compare(__k, _S_key(__y))) ? 
+    _M_header : __y;
+}
+
 // equal_range() :
-// __x가 키인 모든 요소를 포함하는 범위를 반환환다.
-// map은 키가 고유하므로 -> 반환되는 범위에는 요소가 1이거나 0개가 포함된다.
+// __x가 키인 모든 요소를 포함하는 범위를 반환환다. 한 번 내려가면서 구한다. (_M_equal_range_tr() 참고)
+// map은 키가 고유하므로 -> 반환되는 범위에는 요소가 1이거나 0개가 포함된다. multimap은 여러 개일 수 있다.
 template <class _Key, class _Value, class _KeyOfValue, 
           class _Compare, class _Alloc>
 
@@ -1180,7 +2704,8 @@ pair<typename _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>::iterator,
 _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
   ::equal_range(const _Key& __k)
 {
-  return pair<iterator, iterator>(lower_bound(__k), upper_bound(__k));
+  pair<_Link_type, _Link_type> __p = _M_equal_range_tr(__k);
+  return pair<iterator, iterator>(iterator(__p.first), iterator(__p.second));
 }
 
 template <class _Key, class _Value, class _KoV, class _Compare, class _Alloc>
@@ -1190,8 +2715,8 @@ pair<typename _Rb_tree<_Key, _Value, _KoV, _Compare, _Alloc>::const_iterator,
 _Rb_tree<_Key, _Value, _KoV, _Compare, _Alloc>
   ::equal_range(const _Key& __k) const
 {
-  return pair<const_iterator,const_iterator>(lower_bound(__k),
-                                             upper_bound(__k));
+  pair<_Link_type, _Link_type> __p = _M_equal_range_tr(__k);
+  return pair<const_iterator,const_iterator>(const_iterator(__p.first), const_iterator(__p.second));
 }
 
 } // namespace ft
@@ -39,6 +39,11 @@ struct integral_constant {
   operator _Type() { return v; } // struct 안에 정의되었으므로 inline된다.
 };
 
+// true_type, false_type
+// : 오버로딩으로 분기할 때 태그로 사용한다. (예: 내 vector.hpp의 _M_relocate())
+typedef integral_constant<bool, true> true_type;
+typedef integral_constant<bool, false> false_type;
+
 // is_integral
 // Q. 왜 integral_constant를 상속받아야 할까?
 // A. 이 템플릿은 내 vector.hpp의 enable_if에서 사용된다.
@@ -61,11 +66,14 @@ struct is_integral<bool> : public integral_constant<bool, true> {};
 template <>
 struct is_integral<char> : public integral_constant<bool, true> {};
 
+// char16_t, char32_t는 C++11부터 추가된 타입이므로, --std=c++98에서는 특수화하지 않는다.
+#if __cplusplus >= 201103L
 template <>
 struct is_integral<char16_t> : public integral_constant<bool, true> {};
 
 template <>
 struct is_integral<char32_t> : public integral_constant<bool, true> {};
+#endif
 
 template <>
 struct is_integral<wchar_t> : public integral_constant<bool, true> {};
@@ -100,6 +108,44 @@ struct is_integral<unsigned long int> : public integral_constant<bool, true> {};
 template <>
 struct is_integral<unsigned long long int> : public integral_constant<bool, true> {};
 
+
+/*********************    has_cheap_swap    *********************/
+
+// : 멤버함수 swap()이 O(1)인 타입이면 value가 true다.
+//
+// C++98에는 move가 없으므로, vector가 재할당할 때 요소를 복사생성하고 원본을 소멸시킨다.
+// 요소가 vector, map처럼 내부에 메모리를 가진 컨테이너라면, 이 복사는 요소의 크기만큼 비싸다.
+// 이 trait가 true인 타입은 복사 대신 '빈 객체를 기본생성하고 swap'하는 방식으로 옮길 수 있다.
+// (요소 하나당 O(1))
+//
+// 기본값은 false이고, 각 컨테이너 헤더에서 자기 자신에 대해 특수화한다. (vector.hpp, map.hpp, stack.hpp)
+// 사용자 타입도 기본생성자와 멤버함수 swap()이 있다면 특수화할 수 있다.
+
+template <typename _Type>
+struct has_cheap_swap : public false_type {};
+
+
+/*********************    __enable_if_transparent    *********************/
+
+// : 비교 함수 객체 _Compare가 is_transparent 타입을 선언했을 때만 공개멤버 type(= _Result)이 있다.
+//
+// 연관 컨테이너의 find() 같은 함수는 key_type이 아닌 타입(_Kt)으로도 찾을 수 있도록 템플릿 오버로드를 가진다.
+// (예: map<std::string, V>를 const char*로 찾으면 임시 std::string을 만들지 않는다.)
+// 비교 함수가 _Kt와 key_type을 섞어 비교할 수 있다는 표시가 is_transparent다. (C++14의 std::less<>가 이것을 선언한다. C++98에서는 비교 함수 객체가 직접 typedef해야 한다.)
+//
+// _Kt는 쓰이지 않지만, 반환 타입이 함수 템플릿의 매개변수에 의존해야 SFINAE가 된다.
+
+template <typename _Type>
+struct __void_type { typedef void type; };
+
+template <typename _Compare, typename _Kt, typename _Result, typename _Check = void>
+struct __enable_if_transparent {};
+
+template <typename _Compare, typename _Kt, typename _Result>
+struct __enable_if_transparent<_Compare, _Kt, _Result,
+                               typename __void_type<typename _Compare::is_transparent>::type>
+{ typedef _Result type; };
+
 }
 
 #endif // TYPE_TRAITS_HPP
\ No newline at end of file
@@ -0,0 +1,221 @@
+#ifndef UNORDERED_MAP_HPP
+#define UNORDERED_MAP_HPP
+
+#include <functional>
+  // std::equal_to
+
+#include <stdexcept>
+  // std::out_of_range
+
+#include "hashtable.hpp"
+  // ft::_Hashtable
+
+#include "hash.hpp"
+  // ft::hash
+
+#include "function.hpp"
+  // ft::_Select1st
+
+#include "type_traits.hpp"
+  // ft::has_cheap_swap
+
+namespace ft
+{
+// unordered_map
+// 순서 없이 key로만 찾는 연관 컨테이너. open addressing 해시 테이블(_Hashtable) 기반이다. (hashtable.hpp 참고)
+// 찾기, 넣기, 지우기가 평균 O(1)이다. 순회 순서는 정해져 있지 않다.
+// 요소가 노드가 아니라 배열 안에 있으므로, 다시 해시하면(넣다가 용량이 모자랄 때, rehash(), reserve())
+// 모든 반복자, 참조, 포인터가 무효화된다. 넣을 개수를 알면 reserve()로 미리 용량을 잡아 두자.
+template <
+  typename _KeyType,
+  typename _MappedType,
+  typename _Hash = hash<_KeyType>,
+  typename _KeyEqual = std::equal_to<_KeyType>,
+  typename _Alloc = std::allocator<pair<const _KeyType, _MappedType> >
+> class unordered_map {
+public:
+  typedef _KeyType key_type;
+  typedef _MappedType data_type;
+  typedef _MappedType mapped_type;
+  typedef pair<const _KeyType, _MappedType> value_type;
+  typedef _Hash hasher;
+  typedef _KeyEqual key_equal;
+
+private:
+  typedef _Hashtable<key_type, value_type, _Select1st<value_type>, hasher, key_equal, _Alloc>
+    _Hashtable_type;
+  _Hashtable_type _M_ht; // 이것이 실제 unordered_map
+public:
+  typedef typename _Hashtable_type::pointer pointer;
+  typedef typename _Hashtable_type::const_pointer const_pointer;
+  typedef typename _Hashtable_type::reference reference;
+  typedef typename _Hashtable_type::const_reference const_reference;
+  typedef typename _Hashtable_type::iterator iterator;
+  typedef typename _Hashtable_type::const_iterator const_iterator;
+  typedef typename _Hashtable_type::size_type size_type;
+  typedef typename _Hashtable_type::difference_type difference_type;
+  typedef typename _Hashtable_type::allocator_type allocator_type;
+
+  // allocation/deallocation
+
+  unordered_map() : _M_ht(0, hasher(), key_equal(), allocator_type()) {}
+
+  // __n : 다시 해시하지 않고 넣을 수 있는 요소 수
+  explicit unordered_map(size_type __n, const hasher& __hf = hasher(),
+                         const key_equal& __eql = key_equal(),
+                         const allocator_type& __a = allocator_type())
+    : _M_ht(__n, __hf, __eql, __a) {}
+
+  template <class _InputIterator>
+  unordered_map(_InputIterator __first, _InputIterator __last)
+    : _M_ht(0, hasher(), key_equal(), allocator_type())
+    { _M_ht.insert_unique(__first, __last); }
+
+  template <class _InputIterator>
+  unordered_map(_InputIterator __first, _InputIterator __last, size_type __n,
+                const hasher& __hf = hasher(), const key_equal& __eql = key_equal(),
+                const allocator_type& __a = allocator_type())
+    : _M_ht(__n, __hf, __eql, __a) { _M_ht.insert_unique(__first, __last); }
+
+  unordered_map(const unordered_map<_KeyType, _MappedType, _Hash, _KeyEqual, _Alloc>& __x) : _M_ht(__x._M_ht) {}
+
+  unordered_map<_KeyType, _MappedType, _Hash, _KeyEqual, _Alloc>&
+  operator=(const unordered_map<_KeyType, _MappedType, _Hash, _KeyEqual, _Alloc>& __x)
+  {
+    _M_ht = __x._M_ht;
+    return *this;
+  }
+
+  // accessors:
+
+  hasher hash_function() const { return _M_ht.hash_function(); }
+  key_equal key_eq() const { return _M_ht.key_eq(); }
+  allocator_type get_allocator() const { return _M_ht.get_allocator(); }
+
+  iterator begin() { return _M_ht.begin(); }
+  const_iterator begin() const { return _M_ht.begin(); }
+  iterator end() { return _M_ht.end(); }
+  const_iterator end() const { return _M_ht.end(); }
+  bool empty() const { return _M_ht.empty(); }
+  size_type size() const { return _M_ht.size(); }
+  size_type max_size() const { return _M_ht.max_size(); }
+
+  // opearator[] :
+  // 해당 키를 이용하여 직접 접근할 수 있다. 키가 없으면 기본값으로 넣는다.
+  _MappedType& operator[](const key_type& __k) {
+    iterator __i = find(__k);
+    if (__i == end())
+      __i = insert(value_type(__k, _MappedType())).first;
+    return (*__i).second;
+  }
+
+  // at():
+  // 해당 키의 값. 키가 없으면 std::out_of_range를 던진다.
+  _MappedType& at(const key_type& __k) {
+    iterator __i = find(__k);
+    if (__i == end())
+      throw std::out_of_range("unordered_map");
+    return (*__i).second;
+  }
+  const _MappedType& at(const key_type& __k) const {
+    const_iterator __i = find(__k);
+    if (__i == end())
+      throw std::out_of_range("unordered_map");
+    return (*__i).second;
+  }
+
+  // swap() :
+  void swap(unordered_map<_KeyType, _MappedType, _Hash, _KeyEqual, _Alloc>& __x) { _M_ht.swap(__x._M_ht); }
+
+  // insert() :
+  // 1. 단일요소
+  pair<iterator, bool> insert(const value_type& __x)
+    { return _M_ht.insert_unique(__x); }
+
+  // 2. 힌트 (map과 같은 모양을 위해 받지만, 해시 테이블에서는 쓸 데가 없다.)
+  iterator insert(const_iterator, const value_type& __x)
+    { return _M_ht.insert_unique(__x).first; }
+
+  // 3. 범위
+  template <class _InputIterator>
+  void insert(_InputIterator __first, _InputIterator __last) {
+    _M_ht.insert_unique(__first, __last);
+  }
+
+  // erase() :
+  // 요소를 옮기지 않으므로, 지운 요소 말고 다른 반복자는 그대로 쓸 수 있다.
+  // 1. 단일 요소 (반복자로)
+  void erase(const_iterator __position)
+    { _M_ht.erase(__position); }
+
+  // 2. 단일 요소 (키로)
+  // 지운 요소의 개수를 반환한다.
+  size_type erase(const key_type& __x)
+    { return _M_ht.erase(__x); }
+
+  // 3. 범위
+  void erase(const_iterator __first, const_iterator __last)
+    { _M_ht.erase(__first, __last); }
+
+  void clear() { _M_ht.clear(); }
+
+  // map operations:
+
+  iterator find(const key_type& __x) { return _M_ht.find(__x); }
+  const_iterator find(const key_type& __x) const { return _M_ht.find(__x); }
+
+  // count() :
+  // 1과 0 중에서만 반환한다.
+  size_type count(const key_type& __x) const { return _M_ht.count(__x); }
+
+  pair<iterator,iterator> equal_range(const key_type& __x) {
+    return _M_ht.equal_range(__x);
+  }
+  pair<const_iterator,const_iterator> equal_range(const key_type& __x) const {
+    return _M_ht.equal_range(__x);
+  }
+
+  // bucket interface / hash policy:
+  // slot 하나가 bucket 하나다. 요소는 용량의 7/8까지만 채우고, max_load_factor()는 바꿀 수 없다.
+
+  size_type bucket_count() const { return _M_ht.bucket_count(); }
+  float load_factor() const { return _M_ht.load_factor(); }
+  float max_load_factor() const { return _M_ht.max_load_factor(); }
+
+  // rehash() : 용량을 __n 이상으로 바꾼다. (요소를 담을 수 있으면 줄이기도 한다.)
+  void rehash(size_type __n) { _M_ht.rehash(__n); }
+
+  // reserve() : 다시 해시하지 않고 요소 __n개를 넣을 수 있게 한다.
+  void reserve(size_type __n) { _M_ht.reserve(__n); }
+
+  template <class _K1, class _T1, class _H1, class _E1, class _A1>
+  friend bool operator== (const unordered_map<_K1, _T1, _H1, _E1, _A1>&,
+                          const unordered_map<_K1, _T1, _H1, _E1, _A1>&);
+};
+
+// 순서와 상관없이 같은 요소를 가지고 있으면 같다.
+template <class _Key, class _MappedType, class _Hash, class _KeyEqual, class _Alloc>
+bool operator==(const unordered_map<_Key,_MappedType,_Hash,_KeyEqual,_Alloc>& __x,
+                const unordered_map<_Key,_MappedType,_Hash,_KeyEqual,_Alloc>& __y) {
+  return __x._M_ht._M_equal_elements(__y._M_ht);
+}
+
+template <class _Key, class _MappedType, class _Hash, class _KeyEqual, class _Alloc>
+bool operator!=(const unordered_map<_Key,_MappedType,_Hash,_KeyEqual,_Alloc>& __x,
+                const unordered_map<_Key,_MappedType,_Hash,_KeyEqual,_Alloc>& __y) {
+  return !(__x == __y);
+}
+
+template <class _Key, class _MappedType, class _Hash, class _KeyEqual, class _Alloc>
+void swap(unordered_map<_Key,_MappedType,_Hash,_KeyEqual,_Alloc>& __x,
+          unordered_map<_Key,_MappedType,_Hash,_KeyEqual,_Alloc>& __y) {
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 :
+template <class _Key, class _MappedType, class _Hash, class _KeyEqual, class _Alloc>
+struct has_cheap_swap<unordered_map<_Key,_MappedType,_Hash,_KeyEqual,_Alloc> > : public true_type {};
+
+} // namespace ft
+
+#endif /* UNORDERED_MAP_HPP */
@@ -0,0 +1,179 @@
+#ifndef UNORDERED_SET_HPP
+#define UNORDERED_SET_HPP
+
+#include <functional>
+  // std::equal_to
+
+#include "hashtable.hpp"
+  // ft::_Hashtable
+
+#include "hash.hpp"
+  // ft::hash
+
+#include "function.hpp"
+  // ft::_Identity
+
+#include "type_traits.hpp"
+  // ft::has_cheap_swap
+
+namespace ft
+{
+// unordered_set
+// 고유한 key만 저장하는, open addressing 해시 테이블(_Hashtable) 기반의 컨테이너.
+// unordered_map과 같은 테이블을 쓰고, value가 곧 key다. key를 바꾸면 해시가 달라지므로 반복자는 모두 const_iterator다.
+template <
+  typename _KeyType,
+  typename _Hash = hash<_KeyType>,
+  typename _KeyEqual = std::equal_to<_KeyType>,
+  typename _Alloc = std::allocator<_KeyType>
+> class unordered_set {
+public:
+  typedef _KeyType key_type;
+  typedef _KeyType value_type;
+  typedef _Hash hasher;
+  typedef _KeyEqual key_equal;
+
+private:
+  typedef _Hashtable<key_type, value_type, _Identity<value_type>, hasher, key_equal, _Alloc>
+    _Hashtable_type;
+  _Hashtable_type _M_ht; // 이것이 실제 unordered_set
+public:
+  typedef typename _Hashtable_type::const_pointer pointer;
+  typedef typename _Hashtable_type::const_pointer const_pointer;
+  typedef typename _Hashtable_type::const_reference reference;
+  typedef typename _Hashtable_type::const_reference const_reference;
+  typedef typename _Hashtable_type::const_iterator iterator;
+  typedef typename _Hashtable_type::const_iterator const_iterator;
+  typedef typename _Hashtable_type::size_type size_type;
+  typedef typename _Hashtable_type::difference_type difference_type;
+  typedef typename _Hashtable_type::allocator_type allocator_type;
+
+  // allocation/deallocation
+
+  unordered_set() : _M_ht(0, hasher(), key_equal(), allocator_type()) {}
+
+  // __n : 다시 해시하지 않고 넣을 수 있는 요소 수
+  explicit unordered_set(size_type __n, const hasher& __hf = hasher(),
+                         const key_equal& __eql = key_equal(),
+                         const allocator_type& __a = allocator_type())
+    : _M_ht(__n, __hf, __eql, __a) {}
+
+  template <class _InputIterator>
+  unordered_set(_InputIterator __first, _InputIterator __last)
+    : _M_ht(0, hasher(), key_equal(), allocator_type())
+    { _M_ht.insert_unique(__first, __last); }
+
+  template <class _InputIterator>
+  unordered_set(_InputIterator __first, _InputIterator __last, size_type __n,
+                const hasher& __hf = hasher(), const key_equal& __eql = key_equal(),
+                const allocator_type& __a = allocator_type())
+    : _M_ht(__n, __hf, __eql, __a) { _M_ht.insert_unique(__first, __last); }
+
+  unordered_set(const unordered_set<_KeyType, _Hash, _KeyEqual, _Alloc>& __x) : _M_ht(__x._M_ht) {}
+
+  unordered_set<_KeyType, _Hash, _KeyEqual, _Alloc>&
+  operator=(const unordered_set<_KeyType, _Hash, _KeyEqual, _Alloc>& __x)
+  {
+    _M_ht = __x._M_ht;
+    return *this;
+  }
+
+  // accessors:
+
+  hasher hash_function() const { return _M_ht.hash_function(); }
+  key_equal key_eq() const { return _M_ht.key_eq(); }
+  allocator_type get_allocator() const { return _M_ht.get_allocator(); }
+
+  const_iterator begin() const { return _M_ht.begin(); }
+  const_iterator end() const { return _M_ht.end(); }
+  bool empty() const { return _M_ht.empty(); }
+  size_type size() const { return _M_ht.size(); }
+  size_type max_size() const { return _M_ht.max_size(); }
+
+  // swap() :
+  void swap(unordered_set<_KeyType, _Hash, _KeyEqual, _Alloc>& __x) { _M_ht.swap(__x._M_ht); }
+
+  // insert() :
+  // 1. 단일요소
+  pair<iterator, bool> insert(const value_type& __x) {
+    pair<typename _Hashtable_type::iterator, bool> __p = _M_ht.insert_unique(__x);
+    return pair<iterator, bool>(__p.first, __p.second);
+  }
+
+  // 2. 힌트 (쓰지 않는다.)
+  iterator insert(const_iterator, const value_type& __x)
+    { return _M_ht.insert_unique(__x).first; }
+
+  // 3. 범위
+  template <class _InputIterator>
+  void insert(_InputIterator __first, _InputIterator __last) {
+    _M_ht.insert_unique(__first, __last);
+  }
+
+  // erase() :
+  // 1. 단일 요소 (반복자로)
+  void erase(const_iterator __position)
+    { _M_ht.erase(__position); }
+
+  // 2. 단일 요소 (키로)
+  // 지운 요소의 개수를 반환한다.
+  size_type erase(const key_type& __x)
+    { return _M_ht.erase(__x); }
+
+  // 3. 범위
+  void erase(const_iterator __first, const_iterator __last)
+    { _M_ht.erase(__first, __last); }
+
+  void clear() { _M_ht.clear(); }
+
+  // set operations:
+
+  const_iterator find(const key_type& __x) const { return _M_ht.find(__x); }
+
+  // count() :
+  // 1과 0 중에서만 반환한다.
+  size_type count(const key_type& __x) const { return _M_ht.count(__x); }
+
+  pair<const_iterator,const_iterator> equal_range(const key_type& __x) const {
+    return _M_ht.equal_range(__x);
+  }
+
+  // bucket interface / hash policy: (unordered_map과 같다.)
+
+  size_type bucket_count() const { return _M_ht.bucket_count(); }
+  float load_factor() const { return _M_ht.load_factor(); }
+  float max_load_factor() const { return _M_ht.max_load_factor(); }
+  void rehash(size_type __n) { _M_ht.rehash(__n); }
+  void reserve(size_type __n) { _M_ht.reserve(__n); }
+
+  template <class _K1, class _H1, class _E1, class _A1>
+  friend bool operator== (const unordered_set<_K1, _H1, _E1, _A1>&,
+                          const unordered_set<_K1, _H1, _E1, _A1>&);
+};
+
+// 순서와 상관없이 같은 요소를 가지고 있으면 같다.
+template <class _Key, class _Hash, class _KeyEqual, class _Alloc>
+bool operator==(const unordered_set<_Key,_Hash,_KeyEqual,_Alloc>& __x,
+                const unordered_set<_Key,_Hash,_KeyEqual,_Alloc>& __y) {
+  return __x._M_ht._M_equal_elements(__y._M_ht);
+}
+
+template <class _Key, class _Hash, class _KeyEqual, class _Alloc>
+bool operator!=(const unordered_set<_Key,_Hash,_KeyEqual,_Alloc>& __x,
+                const unordered_set<_Key,_Hash,_KeyEqual,_Alloc>& __y) {
+  return !(__x == __y);
+}
+
+template <class _Key, class _Hash, class _KeyEqual, class _Alloc>
+void swap(unordered_set<_Key,_Hash,_KeyEqual,_Alloc>& __x,
+          unordered_set<_Key,_Hash,_KeyEqual,_Alloc>& __y) {
+  __x.swap(__y);
+}
+
+// has_cheap_swap 특수화 :
+template <class _Key, class _Hash, class _KeyEqual, class _Alloc>
+struct has_cheap_swap<unordered_set<_Key,_Hash,_KeyEqual,_Alloc> > : public true_type {};
+
+} // namespace ft
+
+#endif /* UNORDERED_SET_HPP */
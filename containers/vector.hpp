@@ -62,6 +62,13 @@
 #include "type_traits.hpp"
   // ft::enable_if
   // ft::is_integral
+  // ft::has_cheap_swap: 요소를 swap으로 옮길 수 있는지 (_M_relocate()에서 사용)
+
+#include "construct.hpp"
+  // ft::_Construct(메모리 주소): 빈 객체를 기본생성한다.
+
+#include "alloc.hpp"
+  // _Alloc_traits::_S_swap(): swap()에서 할당기를 맞바꾼다. (slab_allocator는 풀 포인터만 바꾼다.)
 
 namespace ft
 {
@@ -94,6 +101,29 @@ protected:
   void _M_deallocate(_Type* __p, size_t __n) 
   { if (__p) _M_data_allocator.deallocate(__p, __n); }
 
+  // _M_extend_storage() :
+  // 재할당 없이 지금 공간을 제자리에서 __n개 이상으로 늘려본다. 성공하면 true.
+  // 일반 할당기로는 늘릴 수 없으므로 항상 false다. (vm_storage.hpp의 특수화는 주소를 옮기지 않고 늘린다.)
+  bool _M_extend_storage(size_t) { return false; }
+
+  // _M_shrink_storage() :
+  // 제자리에서 __n개만 남기고 나머지 공간을 돌려준다. 성공하면 true. (shrink_to_fit()에서 사용)
+  bool _M_shrink_storage(size_t) { return false; }
+
+  // _M_trim_storage() :
+  // size가 줄어든 뒤에 불린다. 남는 공간을 제자리에서 돌려줄 수 있으면 돌려준다.
+  // 일반 할당기로는 할 일이 없다. (vm_storage.hpp의 특수화는 남는 페이지를 운영체제에 돌려준다.)
+  void _M_trim_storage() {}
+
+  // _M_swap_storage() :
+  // 공간은 그것을 할당한 할당기가 해제해야 하므로, 할당기도 함께 바꾼다. (slab_allocator처럼 상태가 있는 할당기)
+  void _M_swap_storage(_Vector_base& __x) {
+    _Alloc_traits<_Type, _AllocatorType>::_S_swap(_M_data_allocator, __x._M_data_allocator);
+    std::swap(_M_start, __x._M_start);
+    std::swap(_M_finish, __x._M_finish);
+    std::swap(_M_end_of_storage, __x._M_end_of_storage);
+  }
+
 public:
   // CONSTRUCTOR
   _Vector_base(const allocator_type& __a)
@@ -143,12 +173,18 @@ public:
   typedef __normal_iterator<pointer, vector_type>  iterator; // 임의접근반복자. const iterator로 변형이 가능하다.
   typedef __normal_iterator<const_pointer, vector_type>  const_iterator; //임의접근반복자.
 
-  typedef reverse_iterator<const_iterator>  const_reverse_iterator;
-  typedef reverse_iterator<iterator>  reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator>  const_reverse_iterator;
+  typedef ft::reverse_iterator<iterator>  reverse_iterator;
+
+  // append_from_fd() (vector_fd.hpp)는 초기화되지 않은 끝부분에 바로 읽어 넣고 _M_finish를 옮긴다
+  friend struct _Vector_fd_io;
 
 protected:
   using _Base::_M_allocate;
   using _Base::_M_deallocate;
+  using _Base::_M_extend_storage;
+  using _Base::_M_shrink_storage;
+  using _Base::_M_trim_storage;
   using _Base::_M_start;
   using _Base::_M_finish;
   using _Base::_M_end_of_storage;
@@ -237,11 +273,19 @@ public:
   size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(_Type); }
 
   // reserve() :
-  // 동작순서: 새 메모리를 할당 → 원래 내용을 새 메모리에 복사 → 원래 메모리를 destroy, deallocate → 새로운 메모리를 start, finish, end_of_storage에 저장
+  // 동작순서: 새 메모리를 할당 → 원래 내용을 새 메모리로 옮김(_M_relocate) → 원래 메모리를 destroy, deallocate → 새로운 메모리를 start, finish, end_of_storage에 저장
   void reserve(size_type __n) {
-    if (capacity() < __n) {
+    if (capacity() < __n && !_M_extend_storage(__n)) {
       const size_type __old_size = size();
-      pointer __tmp = _M_allocate_and_copy(__n, _M_start, _M_finish);
+      pointer __tmp = _M_allocate(__n);
+      try {
+        _M_relocate(_M_start, _M_finish, __tmp);
+      }
+      catch(...)
+      {
+    _M_deallocate(__tmp, __n);
+    throw;
+      }
       _M_destroy(begin(), end());
       _M_deallocate(_M_start, _M_end_of_storage - _M_start);
       _M_start = __tmp;
@@ -260,6 +304,7 @@ public:
   // clear() :
   // vector에서 (이미 destroy된) 원소를 모두 제거하고, size를 0으로 만든다.
   // 재할당, capacity의 변경은 이 함수에서 일어나지 않는다. 할당을 해제하고 capacity를 0으로 만들고 싶다면 임시객체와의 swap을 활용한다. ( x에 대해: vector<T>().swap(x) )
+  // (vm_allocator를 쓰는 vector는 예외로, 페이지를 모두 운영체제에 돌려주고 capacity가 0이 된다.)
   void clear() { erase(begin(), end()); }
 
   // insert() :
@@ -320,6 +365,7 @@ public:
       std::copy(__position + 1, end(), __position); // 앞으로 한 칸 당긴다 [12344]
     --_M_finish; // [1234]4
     _M_destroy(end()); // 마지막 4 삭제
+    _M_trim_storage();
     return __position; // __position: [2]를 가리키는 반복자
   }
 
@@ -329,6 +375,7 @@ public:
     iterator __i(std::copy(__last, end(), __first)); // [12323]: 지울 범위의 뒷부분 데이터를 앞으로 옮긴다.
     _M_destroy(__i, end()); // [12300]: 복사된 구간 다음부터 destroy
     _M_finish = _M_finish - (__last - __first); // [123]: 지운 구간(__last - __first)만큼 줄인다.
+    _M_trim_storage();
     return __first;
   }
 
@@ -349,7 +396,7 @@ public:
 // push_back2. 빈 객체 삽입
   void push_back() {
     if (_M_finish != _M_end_of_storage) { // case1: 빈 공간이 있는 경우
-      get_allocator().construct(_M_finish);
+      ft::_Construct(_M_finish);
       ++_M_finish;
     }
     else // case2: 재할당이 필요한 경우
@@ -361,6 +408,7 @@ public:
   void pop_back() {
     --_M_finish;
     _M_destroy(end());
+    _M_trim_storage();
   }
 
   // resize() :
@@ -376,10 +424,16 @@ public:
   // swap() :
   // 인자로 들어온 (타입이 같은) 또다른 vector와 가지고 있던 메모리를 바꾸어 가진다.
   // 비멤버함수 swap이 vector에 대해 사용될 경우 이 swap을 쓰도록 오버로딩되어 있다.
-  void swap(vector<_Type, _AllocatorType>& __x) {
-    std::swap(_M_start, __x._M_start);
-    std::swap(_M_finish, __x._M_finish);
-    std::swap(_M_end_of_storage, __x._M_end_of_storage);
+  void swap(vector<_Type, _AllocatorType>& __x) { this->_M_swap_storage(__x); }
+
+  // shrink_to_fit() :
+  // capacity를 size에 맞게 줄여, 남는 공간을 돌려준다. (C++11)
+  // 제자리에서 줄일 수 없으면, 딱 맞는 크기의 복사본과 swap한다.
+  void shrink_to_fit() {
+    if (capacity() != size() && !_M_shrink_storage(size())) {
+      vector<_Type, _AllocatorType> __tmp(*this);
+      swap(__tmp);
+    }
   }
 
 public:
@@ -431,7 +485,7 @@ public:
 
     const size_type __xlen = __x.size();
 
-    if (__xlen > capacity()) {  // case1: capacity가 모자라 재할당이 필요한 경우
+    if (__xlen > capacity() && !_M_extend_storage(__xlen)) {  // case1: capacity가 모자라 재할당이 필요한 경우
       pointer __tmp = _M_allocate_and_copy(__xlen, __x.begin(), __x.end()); // __tmp: __x의 사본
       
       // 기존 메모리 삭제
@@ -446,6 +500,8 @@ public:
     else if (size() >= __xlen) { // case2: 덮어쓰고 남는 뒷부분을 destroy해야 하는 경우
       iterator __i(std::copy(__x.begin(), __x.end(), begin()));
       _M_destroy(__i, end());
+      _M_finish = _M_start + __xlen;
+      _M_trim_storage();
     }
     
     else { // case3: size가 작아서 덮어쓰고 일부 생성해야 하는 경우
@@ -465,7 +521,7 @@ public:
   // __n개의 요소를 __val의 복사본으로 초기화한다.
   // (대입연산자, assign2-forward iterator와 분기가 거의 비슷하다.)
   void assign(size_type __n, const _Type& __val) {
-    if (__n > capacity()) { // case1: capacity가 모자라 재할당이 필요한 경우
+    if (__n > capacity() && !_M_extend_storage(__n)) { // case1: capacity가 모자라 재할당이 필요한 경우
       vector<_Type, _AllocatorType> __tmp(__n, __val, get_allocator());
       __tmp.swap(*this);
     }
@@ -541,14 +597,11 @@ protected:
   template <typename _ForwardIterator>
   void _M_range_initialize(_ForwardIterator __first, _ForwardIterator __last, std::forward_iterator_tag) {
     size_type __n = std::distance(__first, __last);
-    _M_start = _M_allocate(__n);
-    _M_end_of_storage = _M_start + __n;
-    try {
-      _M_finish = std::uninitialized_copy(__first, __last, _M_start);
-    } catch(...) { // 할당을 몸통해서 하는 3.range 생성자에서 사용되므로, 예외안정성 보장을 위해 추가했다.
-  _M_deallocate(_M_start, __n);
-  throw;
+    if (!_M_extend_storage(__n)) {
+      _M_start = _M_allocate(__n);
+      _M_end_of_storage = _M_start + __n;
     }
+    _M_finish = std::uninitialized_copy(__first, __last, _M_start); // (실패하면 base의 소멸자가 공간을 해제한다.)
   }
 
   // _M_range_insert() :
@@ -572,114 +625,131 @@ protected:
     if (__first != __last) { // (유효하지 않은 범위는 undefined behavior이나, 이 경우에 한하여 막아주기로 한다.)
       size_type __n = std::abs(std::distance(__first, __last));
 
-      if (size_type(_M_end_of_storage - _M_finish) >= __n) { // case1: 빈 공간이 충분할 때
+      const size_type __idx = __position - begin(); // (vm_allocator는 처음 늘어날 때 주소 공간을 예약하므로, 위치를 인덱스로 기억해둔다.)
+      if (size_type(_M_end_of_storage - _M_finish) >= __n || _M_extend_storage(size() + __n)) // case1: 빈 공간이 충분할 때 (또는 제자리에서 늘렸을 때)
+        _M_range_insert_in_place(begin() + __idx, __first, __last, __n, typename has_cheap_swap<_Type>::type());
 
-        const size_type __elems_after = end() - __position;
-        iterator __old_finish(_M_finish);
-        
-        if (__elems_after > __n) { // case1-1. 새로 넣는 요소가 기존에 생성되어 있는 요소에 복사될 수 있을 때
-        // 예) vector: [12345], *__position == 2, [first, last) == [AB]
-
-          std::uninitialized_copy(_M_finish - __n, _M_finish, _M_finish); // [1234545] : 45를 **생성**
-          _M_finish += __n;
-          std::copy_backward(__position, __old_finish - __n, __old_finish); // [1232345] : 23을 복사
-          std::copy(__first, __last, __position); // [1AB2345] : AB를 복사
-        }
-        
-        else { // case1-2. 새로 넣는 요소가 기존에 생성되어 있는 요소들을 넘어선 위치에 들어가야 할 때
-        // 예) vector: [123], *__position == 2, [first, last) == [ABCD]
-          _ForwardIterator __mid = __first;
-          std::advance(__mid, __elems_after); // (__mid += __elems_after와 동일하게 동작)
-          std::uninitialized_copy(__mid, __last, _M_finish); // [123CD] : CD를 **생성**
-          _M_finish += __n - __elems_after;
-          std::uninitialized_copy(__position, __old_finish, _M_finish); // [123CD23]: 23을 **생성**
-          _M_finish += __elems_after;
-          std::copy(__first, __mid, __position); // [1ABCD23]: AB를 복사
-        }
-      }
       else { // case2: 빈 공간이 부족할 때 (재할당이 필요할 때)
         const size_type __old_capacity = capacity();
         const size_type __len = __old_capacity +
           std::max(__old_capacity, __n); // __old_capacity: 메모리할당 정책에 따라 기존의 2배 / __n: 그보다 더 필요할 경우 __n만큼
         
-        iterator __new_start(_M_allocate(__len));
-        iterator __new_finish(__new_start);
+        pointer __new_start = _M_allocate(__len);
+        pointer __new_pos = __new_start + (__position - begin());
         
-        try {
-          __new_finish = std::uninitialized_copy(iterator(_M_start), __position, __new_start);
-          __new_finish = std::uninitialized_copy(__first, __last, __new_finish);
-          __new_finish = std::uninitialized_copy(__position, iterator(_M_finish), __new_finish);
+        try { // 새 요소를 먼저 제자리에 생성한다.
+          std::uninitialized_copy(__first, __last, __new_pos);
         }
         catch(...) // (insert()는 재할당이 필요한 경우에 한하여 strong gurantee)
         {
-      _M_destroy(__new_start,__new_finish);
-      _M_deallocate(__new_start.base(), __len);
+      _M_deallocate(__new_start, __len);
       throw; // (발생한 예외를 다시 던진다.) 
         }
-        _M_destroy(begin(), end());
-        _M_deallocate(_M_start, _M_end_of_storage - _M_start);
-        _M_start = __new_start.base();
-        _M_finish = __new_finish.base();
-        _M_end_of_storage = __new_start.base() + __len;
+        _M_relocate_around(__position.base(), __new_start, __new_pos, __new_pos + __n, __len);
       }
     }
   }
 
+  // _M_range_insert_in_place1. 복사 방식
+  template <typename _ForwardIterator>
+  void _M_range_insert_in_place(iterator __position, _ForwardIterator __first, _ForwardIterator __last, size_type __n, false_type)
+  {
+    const size_type __elems_after = end() - __position;
+    iterator __old_finish(_M_finish);
+    
+    if (__elems_after > __n) { // case1-1. 새로 넣는 요소가 기존에 생성되어 있는 요소에 복사될 수 있을 때
+    // 예) vector: [12345], *__position == 2, [first, last) == [AB]
+
+      std::uninitialized_copy(_M_finish - __n, _M_finish, _M_finish); // [1234545] : 45를 **생성**
+      _M_finish += __n;
+      std::copy_backward(__position, __old_finish - __n, __old_finish); // [1232345] : 23을 복사
+      std::copy(__first, __last, __position); // [1AB2345] : AB를 복사
+    }
+    
+    else { // case1-2. 새로 넣는 요소가 기존에 생성되어 있는 요소들을 넘어선 위치에 들어가야 할 때
+    // 예) vector: [123], *__position == 2, [first, last) == [ABCD]
+      _ForwardIterator __mid = __first;
+      std::advance(__mid, __elems_after); // (__mid += __elems_after와 동일하게 동작)
+      std::uninitialized_copy(__mid, __last, _M_finish); // [123CD] : CD를 **생성**
+      _M_finish += __n - __elems_after;
+      std::uninitialized_copy(__position, __old_finish, _M_finish); // [123CD23]: 23을 **생성**
+      _M_finish += __elems_after;
+      std::copy(__first, __mid, __position); // [1ABCD23]: AB를 복사
+    }
+  }
+
+  // _M_range_insert_in_place2. swap 방식
+  // 예) vector: [12345], *__position == 2, [first, last) == [AB]
+  template <typename _ForwardIterator>
+  void _M_range_insert_in_place(iterator __position, _ForwardIterator __first, _ForwardIterator __last, size_type __n, true_type)
+  {
+    _M_open_gap(__position.base(), __n); // [1__2345] : 빈 객체 2개를 끝에 만들고, swap으로 뒤로 민다
+    std::copy(__first, __last, __position); // [1AB2345] : AB를 복사
+  }
+
   // _M_fill_insert() :
   // _M_range_insert()와 비슷하게 작동한다.
   void _M_fill_insert(iterator __position, size_type __n, const _Type& __x)
   {
     if (__n != 0) {
 
-      if (size_type(_M_end_of_storage - _M_finish) >= __n) { // case1: 넣을 공간이 충분한 경우
-        _Type __x_copy = __x;
-        const size_type __elems_after = end() - __position;
-        iterator __old_finish(_M_finish);
-
-        if (__elems_after > __n) {
-          // 예) old: [12345], x: [AA], *position == 2
-          std::uninitialized_copy(_M_finish - __n, _M_finish, _M_finish); // [1234545]: 생성
-          _M_finish += __n;
-          std::copy_backward(__position, __old_finish - __n, __old_finish); // [1232345]: 복사
-          std::fill(__position, __position + __n, __x_copy); // [1AA2345]: 복사
-        }
-
-        else {
-          // 예) old: [123], x: [AAA], *position == 2
-          std::uninitialized_fill_n(_M_finish, __n - __elems_after, __x_copy); // [123A]: 생성
-          _M_finish += __n - __elems_after;
-          std::uninitialized_copy(__position, __old_finish, _M_finish); // [123A23]: 생성
-          _M_finish += __elems_after;
-          std::fill(__position, __old_finish, __x_copy); // [1AAA23]: 복사
-        }
-      }
+      const size_type __idx = __position - begin(); // (_M_range_insert()와 같이 위치를 인덱스로 기억해둔다.)
+      if (size_type(_M_end_of_storage - _M_finish) >= __n || _M_extend_storage(size() + __n)) // case1: 넣을 공간이 충분한 경우 (또는 제자리에서 늘렸을 때)
+        _M_fill_insert_in_place(begin() + __idx, __n, __x, typename has_cheap_swap<_Type>::type());
 
       else { // case2: 넣을 공간이 부족해 재할당이 필요한 경우
         const size_type __old_capacity = capacity();
         const size_type __len = __old_capacity +
            std::max(__old_capacity, __n); // 나의 메모리 할당 정책: 기존 capacity의 2배, 그보다 더 필요할 경우 __n만큼
-        iterator __new_start(_M_allocate(__len));
-        iterator __new_finish(__new_start);
-        try {
-          __new_finish = std::uninitialized_copy(begin(), __position, __new_start);
-          __new_finish = std::uninitialized_fill_n(__new_finish, __n, __x);
-          __new_finish = std::uninitialized_copy(__position, end(), __new_finish);
+        pointer __new_start = _M_allocate(__len);
+        pointer __new_pos = __new_start + (__position - begin());
+        try { // __x가 이 vector의 요소일 수도 있으므로, 기존 요소를 옮기기 전에 먼저 채운다.
+          std::uninitialized_fill_n(__new_pos, __n, __x);
         }
         catch(...) // (insert()는 재할당이 필요한 경우에 한하여 strong gurantee)
         {
-      _M_destroy(__new_start, __new_finish);
-      _M_deallocate(__new_start.base(),__len);
+      _M_deallocate(__new_start, __len);
       throw; // (발생한 예외를 다시 던진다.)
         }
-        _M_destroy(begin(), end());
-        _M_deallocate(_M_start, _M_end_of_storage - _M_start);
-        _M_start = __new_start.base();
-        _M_finish = __new_finish.base();
-        _M_end_of_storage = __new_start.base() + __len;
+        _M_relocate_around(__position.base(), __new_start, __new_pos, __new_pos + __n, __len);
       }
     }
   }
 
+  // _M_fill_insert_in_place1. 복사 방식
+  void _M_fill_insert_in_place(iterator __position, size_type __n, const _Type& __x, false_type)
+  {
+    _Type __x_copy = __x;
+    const size_type __elems_after = end() - __position;
+    iterator __old_finish(_M_finish);
+
+    if (__elems_after > __n) {
+      // 예) old: [12345], x: [AA], *position == 2
+      std::uninitialized_copy(_M_finish - __n, _M_finish, _M_finish); // [1234545]: 생성
+      _M_finish += __n;
+      std::copy_backward(__position, __old_finish - __n, __old_finish); // [1232345]: 복사
+      std::fill(__position, __position + __n, __x_copy); // [1AA2345]: 복사
+    }
+
+    else {
+      // 예) old: [123], x: [AAA], *position == 2
+      std::uninitialized_fill_n(_M_finish, __n - __elems_after, __x_copy); // [123A]: 생성
+      _M_finish += __n - __elems_after;
+      std::uninitialized_copy(__position, __old_finish, _M_finish); // [123A23]: 생성
+      _M_finish += __elems_after;
+      std::fill(__position, __old_finish, __x_copy); // [1AAA23]: 복사
+    }
+  }
+
+  // _M_fill_insert_in_place2. swap 방식
+  // 예) old: [12345], x: [AA], *position == 2
+  void _M_fill_insert_in_place(iterator __position, size_type __n, const _Type& __x, true_type)
+  {
+    _Type __x_copy = __x; // (__x가 밀려나는 요소일 수도 있으므로 먼저 복사한다.)
+    _M_open_gap(__position.base(), __n); // [1__2345]: 빈 객체를 만들어 뒤로 민다
+    std::fill(__position, __position + __n, __x_copy); // [1AA2345]: 복사
+  }
+
   // _M_assign_aux() :
   // assign()에서 사용된다.
 
@@ -701,7 +771,7 @@ protected:
   void _M_assign_aux(_ForwardIter __first, _ForwardIter __last, std::forward_iterator_tag) {
     size_type __len = std::distance(__first, __last);
 
-    if (__len > capacity()) { // case1: capacity가 모자라 재할당이 필요한 경우
+    if (__len > capacity() && !_M_extend_storage(__len)) { // case1: capacity가 모자라 재할당이 필요한 경우
       pointer __tmp(_M_allocate_and_copy(__len, __first, __last));
 
       _M_destroy(begin(), end());
@@ -715,6 +785,7 @@ protected:
       iterator __new_finish(std::copy(__first, __last, _M_start));
       _M_destroy(__new_finish, end());
       _M_finish = __new_finish.base();
+      _M_trim_storage();
     }
 
     else { // case3: size가 작아서 덮어쓰고 일부 생성이 필요한 경우
@@ -747,14 +818,14 @@ protected:
   // __position에 __x의 복사본을 넣는다.
   void _M_insert_aux(iterator __position, const _Type& __x)
   {
-    if (_M_finish != _M_end_of_storage) { // case1: 아직 빈 자리가 있는 경우
-      // if, old: [12340], *position == 2, x == A (0 represents empty space)
-
-      get_allocator().construct(_M_finish, *(_M_finish - 1)); // [12344]
-      ++_M_finish;
-      std::copy_backward(__position, iterator(_M_finish - 2), iterator(_M_finish - 1)); // [12234] (값만 복사하므로 destroy는 필요없다.)
-      _Type __x_copy = __x; // 지역변수로 복사생성
-      *__position = __x_copy; // [1A234]
+    const size_type __idx = __position - begin(); // (_M_range_insert()와 같이 위치를 인덱스로 기억해둔다.)
+    if (_M_finish != _M_end_of_storage || _M_extend_storage(size() + 1)) { // case1: 아직 빈 자리가 있는 경우 (또는 제자리에서 늘렸을 때)
+      if (__idx == size()) { // (제자리에서 늘린 뒤의 push_back)
+        get_allocator().construct(_M_finish, __x);
+        ++_M_finish;
+      }
+      else
+        _M_insert_in_place(begin() + __idx, __x, typename has_cheap_swap<_Type>::type());
     }
 
     else { // case2: 재할당이 필요한 경우
@@ -767,63 +838,179 @@ protected:
       } else { // 첫 삽입일 때
         __len = 1;
       }
-      iterator __new_start(_M_allocate(__len)); // new: [00000000] (0 represents empty space)
-      iterator __new_finish(__new_start);
-      try {
-        __new_finish = std::uninitialized_copy(iterator(_M_start), __position, __new_start); // new: [10000000]
-        get_allocator().construct(__new_finish.base(), __x); // new: [1A000000]
-        ++__new_finish;
-        __new_finish = std::uninitialized_copy(__position, iterator(_M_finish), __new_finish); // new: [1A234000]
+      pointer __new_start = _M_allocate(__len); // new: [00000000] (0 represents empty space)
+      pointer __new_pos = __new_start + (__position - begin());
+      try { // (push_back(v[0])처럼 __x가 이 vector의 요소일 수 있으므로, 기존 요소를 옮기기 전에 먼저 생성한다.)
+        get_allocator().construct(__new_pos, __x); // new: [0A000000]
       }
       catch(...)
       {
-    _M_destroy(__new_start,__new_finish);
-    _M_deallocate(__new_start.base(),__len);
+    _M_deallocate(__new_start, __len);
     throw;
       }
-      _M_destroy(begin(), end());
-      _M_deallocate(_M_start, _M_end_of_storage - _M_start);
-      _M_start = __new_start.base();
-      _M_finish = __new_finish.base();
-      _M_end_of_storage = __new_start.base() + __len;
+      _M_relocate_around(__position.base(), __new_start, __new_pos, __new_pos + 1, __len); // new: [1A234000]
     }
   }
 
+  // _M_insert_in_place1. 복사 방식
+  void _M_insert_in_place(iterator __position, const _Type& __x, false_type)
+  {
+    // if, old: [12340], *position == 2, x == A (0 represents empty space)
+
+    _Type __x_copy = __x; // 지역변수로 복사생성 (__x가 밀려나는 요소일 수도 있으므로 먼저 복사한다.)
+    get_allocator().construct(_M_finish, *(_M_finish - 1)); // [12344]
+    ++_M_finish;
+    std::copy_backward(__position, iterator(_M_finish - 2), iterator(_M_finish - 1)); // [12234] (값만 복사하므로 destroy는 필요없다.)
+    *__position = __x_copy; // [1A234]
+  }
+
+  // _M_insert_in_place2. swap 방식
+  // 복사본을 한 번만 만들고, 그것을 자리에 swap해 넣는다.
+  void _M_insert_in_place(iterator __position, const _Type& __x, true_type)
+  {
+    _Type __x_copy = __x;
+    _M_open_gap(__position.base(), 1); // [1_234]
+    __position->swap(__x_copy); // [1A234]
+  }
+
   // _M_insert_aux2. 빈 객체 삽입
   // _M_insert_aux1과 동일하게 작동하되, __position에 빈 객체를 생성한다.
   void _M_insert_aux(iterator __position)
   {
-    if (_M_finish != _M_end_of_storage) {
-      get_allocator().construct(_M_finish, *(_M_finish - 1));
-      ++_M_finish;
-      copy_backward(__position, iterator(_M_finish - 2),
-      iterator(_M_finish - 1));
-      *__position = _Type();
+    const size_type __idx = __position - begin();
+    if (_M_finish != _M_end_of_storage || _M_extend_storage(size() + 1)) {
+      if (__idx == size()) {
+        ft::_Construct(_M_finish);
+        ++_M_finish;
+      }
+      else
+        _M_insert_in_place(begin() + __idx, typename has_cheap_swap<_Type>::type());
     }
     else {
       const size_type __old_size = size();
       const size_type __len = __old_size != 0 ? 2 * __old_size : 1;
       pointer __new_start = _M_allocate(__len);
-      pointer __new_finish = __new_start;
+      pointer __new_pos = __new_start + (__position - begin());
       try {
-        __new_finish = std::uninitialized_copy(iterator(_M_start), __position,
-          __new_start);
-        get_allocator().construct(__new_finish);
-        ++__new_finish;
-        __new_finish = std::uninitialized_copy(__position, iterator(_M_finish),
-          __new_finish);
+        ft::_Construct(__new_pos);
       }
       catch(...)
       {
-    _M_destroy(__new_start,__new_finish);
     _M_deallocate(__new_start,__len);
     throw;
       }
-      _M_destroy(begin(), end());
-      _M_deallocate(_M_start, _M_end_of_storage - _M_start);
-      _M_start = __new_start;
-      _M_finish = __new_finish;
-      _M_end_of_storage = __new_start + __len;
+      _M_relocate_around(__position.base(), __new_start, __new_pos, __new_pos + 1, __len);
+    }
+  }
+
+  void _M_insert_in_place(iterator __position, false_type)
+  {
+    get_allocator().construct(_M_finish, *(_M_finish - 1));
+    ++_M_finish;
+    std::copy_backward(__position, iterator(_M_finish - 2),
+    iterator(_M_finish - 1));
+    *__position = _Type();
+  }
+
+  void _M_insert_in_place(iterator __position, true_type)
+    { _M_open_gap(__position.base(), 1); } // (비워진 자리에는 이미 빈 객체가 있다.)
+
+  // _M_relocate() :
+  // 재할당할 때, [__first, __last)의 요소를 초기화되지 않은 __result로 옮긴다. 옮긴 범위의 끝을 반환한다.
+  // 원본은 곧 소멸될 것이므로, 원본의 값이 남아있을 필요는 없다.
+  // 실패하면 __result에 생성한 것을 정리하고, 원본을 원래대로 돌려놓은 뒤 다시 던진다.
+  pointer _M_relocate(pointer __first, pointer __last, pointer __result)
+    { return _M_relocate(__first, __last, __result, typename has_cheap_swap<_Type>::type()); }
+
+  // _M_relocate1. 복사 방식 : 요소마다 복사생성한다. (요소가 컨테이너라면 그 크기만큼 비싸다.)
+  pointer _M_relocate(pointer __first, pointer __last, pointer __result, false_type)
+    { return std::uninitialized_copy(__first, __last, __result); }
+
+  // _M_relocate2. swap 방식 : 빈 객체를 기본생성하고 원본과 swap한다. (요소마다 O(1))
+  pointer _M_relocate(pointer __first, pointer __last, pointer __result, true_type)
+  {
+    pointer __cur = __result;
+    try {
+      for (; __first != __last; ++__first, ++__cur) {
+        ft::_Construct(__cur);
+        __cur->swap(*__first);
+      }
+    }
+    catch(...)
+    {
+  _M_relocate_undo(__result, __cur, __first - (__cur - __result));
+  throw;
+    }
+    return __cur;
+  }
+
+  // _M_relocate_undo() :
+  // _M_relocate()로 [__new_first, __new_last)에 옮겨온 요소를 원본(__old_first부터)으로 되돌리고, 새 쪽을 소멸시킨다.
+  void _M_relocate_undo(pointer __new_first, pointer __new_last, pointer __old_first)
+    { _M_relocate_undo(__new_first, __new_last, __old_first, typename has_cheap_swap<_Type>::type()); }
+
+  void _M_relocate_undo(pointer __new_first, pointer __new_last, pointer, false_type)
+    { _M_destroy(iterator(__new_first), iterator(__new_last)); } // (원본은 건드리지 않았다.)
+
+  void _M_relocate_undo(pointer __new_first, pointer __new_last, pointer __old_first, true_type)
+  {
+    for (; __new_first != __new_last; ++__new_first, ++__old_first) {
+      __new_first->swap(*__old_first);
+      get_allocator().destroy(__new_first);
+    }
+  }
+
+  // _M_relocate_around() :
+  // 재할당의 마무리. 새로 넣을 요소가 이미 새 공간의 [__new_pos, __new_mid)에 생성되어 있을 때,
+  // 기존 요소 중 __position의 앞부분은 __new_pos 앞으로, 뒷부분은 __new_mid 뒤로 옮기고 새 공간으로 갈아탄다.
+  // 실패하면 새로 생성한 요소까지 정리하고 새 공간을 해제한 뒤 다시 던진다. (기존 vector는 그대로 남는다.)
+  void _M_relocate_around(pointer __position, pointer __new_start, pointer __new_pos, pointer __new_mid, size_type __len)
+  {
+    pointer __new_finish = __new_mid;
+    try {
+      _M_relocate(_M_start, __position, __new_start);
+      try {
+        __new_finish = _M_relocate(__position, _M_finish, __new_mid);
+      }
+      catch(...)
+      {
+    _M_relocate_undo(__new_start, __new_pos, _M_start);
+    throw;
+      }
+    }
+    catch(...)
+    {
+  _M_destroy(iterator(__new_pos), iterator(__new_mid));
+  _M_deallocate(__new_start, __len);
+  throw;
+    }
+    _M_destroy(begin(), end());
+    _M_deallocate(_M_start, _M_end_of_storage - _M_start);
+    _M_start = __new_start;
+    _M_finish = __new_finish;
+    _M_end_of_storage = __new_start + __len;
+  }
+
+  // _M_open_gap() :
+  // (swap 방식) 빈 공간이 충분할 때, __position부터 __n칸을 비운다.
+  // 끝에 빈 객체 __n개를 기본생성한 다음, 뒤쪽 요소들을 swap으로 __n칸씩 민다.
+  // 결과적으로 [__position, __position + __n)에는 빈 객체가 남는다.
+  void _M_open_gap(pointer __position, size_type __n)
+  {
+    pointer __old_finish = _M_finish;
+    try {
+      for (; _M_finish != __old_finish + __n; ++_M_finish)
+        ft::_Construct(_M_finish);
+    }
+    catch(...)
+    {
+  _M_destroy(iterator(__old_finish), iterator(_M_finish));
+  _M_finish = __old_finish;
+  throw;
+    }
+    for (pointer __p = __old_finish; __p != __position; ) {
+      --__p;
+      __p->swap(*(__p + __n));
     }
   }
 
@@ -877,6 +1064,13 @@ protected:
     __x.swap(__y);
   }
 
+  // has_cheap_swap 특수화 :
+  // vector의 swap()은 포인터 3개만 바꾸므로, vector<vector<T> >는 재할당할 때 요소를 swap으로 옮긴다.
+  // swap으로 옮기려면 빈 vector를 기본생성해야 하므로, 할당기를 기본생성할 수 있고 상태가 없는 std::allocator일 때만 특수화한다.
+  // (다른 할당기는 복사로 옮긴다. shm_allocator처럼 기본생성자가 없는 할당기도 쓸 수 있다.)
+  template <typename _Type>
+  struct has_cheap_swap<vector<_Type, std::allocator<_Type> > > : public true_type {};
+
 } // namespace ft
 
 #endif // VECTOR_HPP
\ No newline at end of file
@@ -0,0 +1,148 @@
+#ifndef VECTOR_FD_HPP
+#define VECTOR_FD_HPP
+
+#include <cstring>
+  // std::memcpy(): 재할당할 때 끝 뒤에 남은 잘린 요소의 바이트를 옮긴다.
+
+#include <cerrno>
+  // errno, EINTR
+
+#include <climits>
+  // IOV_MAX: readv()가 한 번에 받을 수 있는 iovec의 최대 개수
+
+#include <unistd.h>
+  // read(fd, 버퍼, 바이트 수): 읽은 바이트 수를 반환한다. 0은 EOF, -1은 에러(errno).
+
+#include <sys/uio.h>
+  // readv(fd, iovec 배열, 개수): 한 번의 시스템콜로 여러 버퍼에 나누어 읽는다.
+
+#include "vector.hpp"
+  // ft::vector
+
+namespace ft
+{
+
+// 파일 디스크립터 입력 (ft 확장)
+// 소켓이나 파일에서 읽은 데이터를 임시 버퍼를 거치지 않고, vector의 초기화되지 않은 끝부분(capacity)에 바로 읽어 넣는다.
+// 요소는 바이트를 그대로 써넣어도 되는 POD 타입이어야 한다. (ft::vector<char>, ft::vector<Buffer> 등)
+//
+// 시스템콜은 한 번만 한다. EINTR만 재시도하고, 기다리지 않는다.
+// non-blocking fd의 EAGAIN은 -1과 errno로 그대로 돌려주므로, poll() 등으로 기다렸다가 다시 호출하면 된다.
+//
+// 요소 하나가 read() 도중에 잘리면, 온전한 요소만 vector에 붙이고 잘린 바이트는 끝(end()) 바로 뒤의 빈 공간에 남긴다.
+// 그 바이트 수를 __pending에 돌려주고, 다음 호출은 그 뒤부터 이어서 읽어 요소를 완성한다.
+// EOF(0)인데 __pending이 0이 아니면, 마지막 요소가 잘린 것이다. 잘린 바이트는 data() + size()부터 __pending바이트다.
+// 호출 사이에 vector를 바꾸면 남은 바이트는 덮어써질 수 있으므로, 그때는 __pending을 0으로 되돌려야 한다.
+
+// _Vector_fd_pod_check :
+// C++98에서는 생성자, 소멸자, 대입연산자가 trivial하지 않은 타입을 union의 멤버로 둘 수 없다.
+// POD가 아닌 요소 타입이면 sizeof()로 이 union을 인스턴스화할 때 컴파일 에러가 난다.
+template <typename _Type>
+union _Vector_fd_pod_check {
+  _Type _M_value;
+  char _M_byte;
+};
+
+// _Vector_fd_io :
+// vector의 friend. _M_finish를 직접 옮겨, 읽은 바이트를 생성자 호출 없이 요소로 붙인다.
+struct _Vector_fd_io
+{
+  // _S_reserve_tail() :
+  // 끝에 __n개(잘린 요소 포함)가 들어갈 빈 공간을 확보한다. 모자라면 capacity의 2배와 필요한 크기 중 큰 쪽으로 reserve한다.
+  // (조금씩 반복 호출해도 재할당이 기하급수적으로만 일어나도록)
+  // reserve()는 [begin, end)만 옮기므로, 끝 뒤에 남은 잘린 바이트는 따로 옮긴다.
+  template <typename _Type, typename _AllocatorType>
+  static void _S_reserve_tail(vector<_Type, _AllocatorType>& __v, std::size_t __n, std::size_t __pending)
+  {
+    if (__v.capacity() - __v.size() >= __n)
+      return;
+    char __tail[sizeof(_Type)];
+    if (__pending != 0)
+      std::memcpy(__tail, __v._M_finish, __pending);
+    __v.reserve(std::max(__v.size() + __n, 2 * __v.capacity()));
+    if (__pending != 0)
+      std::memcpy(__v._M_finish, __tail, __pending);
+  }
+
+  // _S_commit() :
+  // 끝 뒤에 __bytes바이트가 채워져 있을 때, 온전한 요소들을 vector에 붙인다.
+  // 반환값: 붙이지 못하고 남은 잘린 요소의 바이트 수
+  template <typename _Type, typename _AllocatorType>
+  static std::size_t _S_commit(vector<_Type, _AllocatorType>& __v, std::size_t __bytes)
+  {
+    __v._M_finish += __bytes / sizeof(_Type);
+    return __bytes % sizeof(_Type);
+  }
+
+  template <typename _Type, typename _AllocatorType>
+  static char* _S_tail(vector<_Type, _AllocatorType>& __v, std::size_t __pending)
+  {
+    return reinterpret_cast<char*>(__v._M_finish) + __pending;
+  }
+};
+
+// append_from_fd1. read() :
+// 잘린 요소를 포함해 최대 __max개의 요소만큼 read() 한 번으로 읽어 끝에 붙인다. (재할당이 필요하면 먼저 기하급수적으로 reserve한다.)
+// __pending: 처음에는 0. 끝 뒤에 남은 잘린 요소의 바이트 수를 주고받는다.
+// 반환값: 이번에 읽은 바이트 수. EOF면 0, 에러면 -1 (errno 설정, vector와 __pending은 변하지 않는다.)
+template <typename _Type, typename _AllocatorType>
+ssize_t append_from_fd(vector<_Type, _AllocatorType>& __v, int __fd, std::size_t __max, std::size_t& __pending)
+{
+  (void)sizeof(_Vector_fd_pod_check<_Type>);
+  if (__max == 0)
+    return 0;
+  _Vector_fd_io::_S_reserve_tail(__v, __max, __pending);
+  ssize_t __got;
+  do
+    __got = ::read(__fd, _Vector_fd_io::_S_tail(__v, __pending), __max * sizeof(_Type) - __pending);
+  while (__got < 0 && errno == EINTR);
+  if (__got > 0)
+    __pending = _Vector_fd_io::_S_commit(__v, __pending + __got);
+  return __got;
+}
+
+// append_from_fd2. readv() :
+// __vecs[0], __vecs[1], ... 각각의 끝에 (잘린 요소를 포함해) 최대 __max_each개씩, readv() 한 번으로 차례대로 읽어 붙인다.
+// (메시지 단위로 vector를 나누어 받을 때 사용한다. 같은 vector가 두 번 들어오면 안 된다.)
+// __pending[i]는 __vecs[i]의 끝 뒤에 남은 잘린 요소의 바이트 수다. (append_from_fd1과 같다.)
+// IOV_MAX개를 넘는 vector는 이번 호출에서 채우지 않는다.
+// 반환값: 이번에 읽은 바이트 수의 합. EOF면 0, 에러면 -1 (errno 설정, 어떤 vector도 변하지 않는다.)
+template <typename _Type, typename _AllocatorType>
+ssize_t append_from_fd(
+  vector<_Type, _AllocatorType>* const* __vecs,
+  std::size_t* __pending,
+  std::size_t __count,
+  int __fd,
+  std::size_t __max_each)
+{
+  (void)sizeof(_Vector_fd_pod_check<_Type>);
+#ifdef IOV_MAX
+  if (__count > IOV_MAX)
+    __count = IOV_MAX;
+#endif
+  if (__count == 0 || __max_each == 0)
+    return 0;
+  vector<struct iovec> __iov(__count);
+  for (std::size_t __i = 0; __i < __count; ++__i) {
+    _Vector_fd_io::_S_reserve_tail(*__vecs[__i], __max_each, __pending[__i]);
+    __iov[__i].iov_base = _Vector_fd_io::_S_tail(*__vecs[__i], __pending[__i]);
+    __iov[__i].iov_len = __max_each * sizeof(_Type) - __pending[__i];
+  }
+  ssize_t __got;
+  do
+    __got = ::readv(__fd, __iov.data(), __count);
+  while (__got < 0 && errno == EINTR);
+
+  // 앞의 vector부터 iov_len바이트씩 채워졌다. 마지막으로 채워진 vector에만 잘린 요소가 새로 생길 수 있다.
+  std::size_t __left = __got > 0 ? __got : 0;
+  for (std::size_t __i = 0; __left != 0; ++__i) {
+    std::size_t __bytes = std::min(__left, __iov[__i].iov_len);
+    __left -= __bytes;
+    __pending[__i] = _Vector_fd_io::_S_commit(*__vecs[__i], __pending[__i] + __bytes);
+  }
+  return __got;
+}
+
+} // namespace ft
+
+#endif // VECTOR_FD_HPP
@@ -0,0 +1,197 @@
+#ifndef VM_STORAGE_HPP
+#define VM_STORAGE_HPP
+
+#include <memory>
+  // std::allocator
+
+#include <new>
+  // std::bad_alloc
+
+#include <stdexcept>
+  // std::length_error
+
+#include <algorithm>
+  // std::max(), std::min(), std::swap()
+
+#include <unistd.h>
+  // sysconf(_SC_PAGESIZE): 페이지 크기
+
+#include <sys/mman.h>
+  // mmap(PROT_NONE): 주소 공간만 예약하고, 실제 메모리는 쓰지 않는다.
+  // mprotect(PROT_READ | PROT_WRITE): 예약한 공간 중 앞부분을 쓸 수 있게 한다. (페이지는 처음 쓸 때 할당된다.)
+  // madvise(MADV_DONTNEED): 페이지를 운영체제에 돌려준다.
+  // munmap(): 예약을 해제한다.
+
+#include "vector.hpp"
+  // ft::vector
+  // ft::_Vector_base: 아래에서 vm_allocator에 대해 특수화한다.
+
+namespace ft
+{
+
+// vm_allocator
+// : vector<_Type, vm_allocator<_Type> >로 쓰면, vector가 주소가 변하지 않는 저장공간을 사용하게 된다.
+//
+// 처음 요소가 들어올 때 가상 주소 공간을 통째로 예약해두고(mmap, PROT_NONE),
+// size가 늘어나는 만큼만 앞에서부터 페이지를 쓸 수 있게 바꾼다(mprotect).
+// 따라서 재할당이 일어나지 않는다. _M_start는 움직이지 않고, 늘어날 때 요소를 복사하지 않으며,
+// 요소를 가리키는 포인터, 참조, 반복자는 그 요소가 지워지기 전까지 유효하다.
+//
+// 예약하는 크기는 할당기마다 정한다. 기본값은 _ReserveBytes(1GB)이고, vm_allocator(바이트 수)로 vector마다 바꿀 수 있다.
+// (예약은 주소 공간만 차지하지만, 작은 vector를 많이 만든다면 작게 잡는다.)
+// 빈 vector는 아무것도 예약하지 않으므로, 기본생성한 임시객체나 빈 vector의 복사본은 mmap()을 하지 않는다.
+// 예약한 범위를 넘어서 늘어나려 하면 std::length_error를 던진다.
+//
+// 페이지는 madvise(MADV_DONTNEED)로 운영체제에 돌려준다.
+// shrink_to_fit()은 size 뒤의 페이지를 모두, clear()는 모든 페이지를 돌려준다.
+// erase(), pop_back(), resize() 등으로 size가 commit한 공간의 1/4 이하로 줄면, size의 2배만 남기고 돌려준다.
+// (돌려준 만큼 capacity도 줄어든다.)
+//
+// 할당기 자체는 std::allocator와 같다. 요소의 생성/소멸에만 사용되고, 공간은 아래의 _Vector_base 특수화가 관리한다.
+template <typename _Type, std::size_t _ReserveBytes = (std::size_t(1) << 30)>
+class vm_allocator : public std::allocator<_Type>
+{
+public:
+  template <typename _Other>
+  struct rebind { typedef vm_allocator<_Other, _ReserveBytes> other; };
+
+  vm_allocator() : _M_reserve_bytes(_ReserveBytes) {}
+  explicit vm_allocator(std::size_t __reserve_bytes) : _M_reserve_bytes(__reserve_bytes) {}
+  vm_allocator(const vm_allocator& __a) : std::allocator<_Type>(__a), _M_reserve_bytes(__a._M_reserve_bytes) {}
+  template <typename _Other>
+  vm_allocator(const vm_allocator<_Other, _ReserveBytes>& __a) : _M_reserve_bytes(__a.reserve_bytes()) {}
+
+  // reserve_bytes() :
+  // vector 하나가 예약하는 주소 공간의 크기
+  std::size_t reserve_bytes() const { return _M_reserve_bytes; }
+
+private:
+  std::size_t _M_reserve_bytes;
+};
+
+template <typename _Type, std::size_t _ReserveBytes>
+class _Vector_base<_Type, vm_allocator<_Type, _ReserveBytes> > {
+
+public:
+  typedef vm_allocator<_Type, _ReserveBytes> allocator_type;
+
+  allocator_type get_allocator() const { return _M_data_allocator; }
+
+protected:
+  allocator_type _M_data_allocator;
+  _Type* _M_start; // 예약한 공간의 시작. 예약한 뒤로는 움직이지 않는다. (예약 전에는 0)
+  _Type* _M_finish;
+  _Type* _M_end_of_storage; // 쓸 수 있게 된(commit) 공간의 끝
+  std::size_t _M_reserved; // 예약한 주소 공간의 크기 (예약 전에는 0)
+
+  static std::size_t _S_page_size() { return ::sysconf(_SC_PAGESIZE); }
+
+  static std::size_t _S_round_up(std::size_t __bytes)
+  {
+    const std::size_t __page = _S_page_size();
+    return (__bytes + __page - 1) / __page * __page;
+  }
+
+  std::size_t _M_committed_bytes() const
+  { return _S_round_up((_M_end_of_storage - _M_start) * sizeof(_Type)); }
+
+  // 공간은 제자리에서만 늘어나므로, vector가 새 공간을 할당하려 하는 일은 없다.
+  // (_M_extend_storage()가 실패하면 그 전에 예외를 던진다.)
+  _Type* _M_allocate(std::size_t) { throw std::bad_alloc(); }
+
+  void _M_deallocate(_Type*, std::size_t) {}
+
+  // _M_extend_storage() :
+  // __n개가 들어갈 만큼의 페이지를 쓸 수 있게 한다. 시스템콜 횟수를 줄이기 위해 commit한 크기의 2배씩 늘린다.
+  // 아직 예약하지 않았으면 여기서 할당기가 정한 크기만큼 예약한다.
+  bool _M_extend_storage(std::size_t __n)
+  {
+    const std::size_t __reserved = _M_reserved != 0 ? _M_reserved : _S_round_up(_M_data_allocator.reserve_bytes());
+    if (__n > __reserved / sizeof(_Type))
+      throw std::length_error("vm_allocator: reserved address space exhausted");
+    if (_M_reserved == 0)
+      _M_reserve_address_space(__reserved);
+    const std::size_t __old_bytes = _M_committed_bytes();
+    const std::size_t __new_bytes = std::min(__reserved,
+      _S_round_up(std::max(__n * sizeof(_Type), 2 * __old_bytes)));
+    if (__new_bytes > __old_bytes) {
+      char* __base = reinterpret_cast<char*>(_M_start);
+      if (::mprotect(__base + __old_bytes, __new_bytes - __old_bytes, PROT_READ | PROT_WRITE) != 0)
+        throw std::bad_alloc();
+    }
+    _M_end_of_storage = _M_start + __new_bytes / sizeof(_Type);
+    return true;
+  }
+
+  // _M_shrink_storage() :
+  // __n개를 담는 페이지만 남기고, 그 뒤의 페이지는 운영체제에 돌려주고 다시 접근할 수 없게 한다.
+  bool _M_shrink_storage(std::size_t __n)
+  {
+    const std::size_t __keep = _S_round_up(__n * sizeof(_Type));
+    const std::size_t __old_bytes = _M_committed_bytes();
+    if (__keep < __old_bytes) {
+      char* __base = reinterpret_cast<char*>(_M_start);
+      ::madvise(__base + __keep, __old_bytes - __keep, MADV_DONTNEED);
+      ::mprotect(__base + __keep, __old_bytes - __keep, PROT_NONE);
+      _M_end_of_storage = _M_start + __keep / sizeof(_Type);
+    }
+    return true;
+  }
+
+  // _M_trim_storage() :
+  // size가 줄어든 뒤에 불린다. 비었으면 모든 페이지를, commit한 공간의 1/4 이하만 쓰면 size의 2배만 남기고 돌려준다.
+  // (늘릴 때 2배씩 늘리므로, 줄었다 늘었다 해도 시스템콜이 매번 일어나지 않는다.)
+  void _M_trim_storage()
+  {
+    const std::size_t __used = (_M_finish - _M_start) * sizeof(_Type);
+    const std::size_t __committed = _M_committed_bytes();
+    if (__committed != 0 && (__used == 0 || (__used <= __committed / 4 && _S_round_up(2 * __used) < __committed)))
+      _M_shrink_storage(2 * (_M_finish - _M_start));
+  }
+
+  void _M_swap_storage(_Vector_base& __x) {
+    std::swap(_M_data_allocator, __x._M_data_allocator);
+    std::swap(_M_start, __x._M_start);
+    std::swap(_M_finish, __x._M_finish);
+    std::swap(_M_end_of_storage, __x._M_end_of_storage);
+    std::swap(_M_reserved, __x._M_reserved);
+  }
+
+  void _M_reserve_address_space(std::size_t __bytes)
+  {
+    void* __p = ::mmap(0, __bytes, PROT_NONE, MAP_PRIVATE | MAP_ANON | MAP_NORESERVE, -1, 0);
+    if (__p == MAP_FAILED)
+      throw std::bad_alloc();
+    _M_start = _M_finish = _M_end_of_storage = static_cast<_Type*>(__p);
+    _M_reserved = __bytes;
+  }
+
+public:
+  // CONSTRUCTOR
+  // 주소 공간은 처음 늘어날 때 예약한다.
+  _Vector_base(const allocator_type& __a)
+    : _M_data_allocator(__a), _M_start(0), _M_finish(0), _M_end_of_storage(0), _M_reserved(0) {}
+
+  _Vector_base(std::size_t __n, const allocator_type& __a)
+    : _M_data_allocator(__a), _M_start(0), _M_finish(0), _M_end_of_storage(0), _M_reserved(0)
+  {
+    if (__n == 0)
+      return;
+    try {
+      _M_extend_storage(__n);
+    }
+    catch(...)
+    {
+      if (_M_reserved != 0)
+        ::munmap(_M_start, _M_reserved);
+      throw;
+    }
+  }
+
+  // DESTRUCTOR
+  ~_Vector_base() { if (_M_reserved != 0) ::munmap(_M_start, _M_reserved); }
+}; // class _Vector_base<_Type, vm_allocator>
+
+} // namespace ft
+
+#endif // VM_STORAGE_HPP
@@ -7,6 +7,244 @@ bool mypredicate (int i, int j) {
 bool mycomp (char c1, char c2)
 { return std::tolower(c1)<std::tolower(c2); }
 
+#ifdef FT_TESTER_STD
+// append_ints() : ft::append_from_fd()와 같은 일을 read()와 std::vector로 한다
+ssize_t append_ints(std::vector<int>& v, int fd, size_t max, size_t& pending, char* tail) {
+  std::vector<char> buf(max * sizeof(int));
+  memcpy(&buf[0], tail, pending);
+  ssize_t got = read(fd, &buf[pending], buf.size() - pending);
+  if (got > 0)
+  {
+    size_t bytes = pending + got;
+    for (size_t i = 0; i + sizeof(int) <= bytes; i += sizeof(int))
+    {
+      int x;
+      memcpy(&x, &buf[i], sizeof(int));
+      v.push_back(x);
+    }
+    pending = bytes % sizeof(int);
+    memcpy(tail, &buf[bytes - pending], pending);
+  }
+  return got;
+}
+#else
+ssize_t append_ints(ft::vector<int>& v, int fd, size_t max, size_t& pending, char* tail) {
+  ssize_t got = ft::append_from_fd(v, fd, max, pending);
+  memcpy(tail, v.data() + v.size(), pending); // 잘린 바이트는 끝 바로 뒤에 남아 있다
+  return got;
+}
+#endif
+
+int StrLess::mixed_calls = 0;
+
+// split_map(), join_map() : ft::map::split(), join()과 같은 일을 std::map의 범위 insert, erase로 한다
+template <typename Map>
+void split_map(Map& m, const typename Map::key_type& k, Map& right) {
+#ifdef FT_TESTER_STD
+  right.clear();
+  right.insert(m.lower_bound(k), m.end());
+  m.erase(m.lower_bound(k), m.end());
+#else
+  m.split(k, right);
+#endif
+}
+
+// AddMerge : 집합 연산에서 key가 겹칠 때 두 값을 더한다
+struct AddMerge {
+  void operator()(int& x, int& y) const { x += y; }
+};
+
+// set_op() : ft::map_union(), map_intersection(), map_difference()와 같은 일을 std::map의 find, insert, erase로 한다
+// op: 'u'(합집합), 'i'(교집합), 'd'(차집합). 결과는 x에 남고 y는 비게 된다.
+template <typename Map>
+void set_op(char op, Map& x, Map& y, bool merge) {
+#ifdef FT_TESTER_STD
+  if (op == 'u')
+  {
+    for (typename Map::iterator it = y.begin(); it != y.end(); ++it)
+    {
+      typename Map::iterator found = x.find(it->first);
+      if (found == x.end())
+        x.insert(*it);
+      else if (merge)
+        AddMerge()(found->second, it->second);
+    }
+  }
+  else
+  {
+    for (typename Map::iterator it = x.begin(); it != x.end(); )
+    {
+      typename Map::iterator found = y.find(it->first);
+      if ((found == y.end()) == (op == 'i'))
+        x.erase(it++);
+      else
+      {
+        if (op == 'i' && merge)
+          AddMerge()(it->second, found->second);
+        ++it;
+      }
+    }
+  }
+  y.clear();
+#else
+  if (op == 'u')
+    merge ? ft::map_union(x, y, AddMerge()) : ft::map_union(x, y);
+  else if (op == 'i')
+    merge ? ft::map_intersection(x, y, AddMerge()) : ft::map_intersection(x, y);
+  else
+    ft::map_difference(x, y);
+#endif
+}
+
+// merge_map() : ft::map::merge()와 같은 일을 std::map의 insert, erase로 한다 (겹치는 key는 src에 남는다)
+template <typename Map>
+void merge_map(Map& m, Map& src) {
+#ifdef FT_TESTER_STD
+  for (typename Map::iterator it = src.begin(); it != src.end(); )
+  {
+    if (m.insert(*it).second)
+      src.erase(it++);
+    else
+      ++it;
+  }
+#else
+  m.merge(src);
+#endif
+}
+
+// Collect : for_each()가 넘기는 요소를 (key, value)로 모은다
+struct Collect {
+  std::vector<std::pair<int, int> >* out;
+  explicit Collect(std::vector<std::pair<int, int> >* o) : out(o) {}
+  template <typename Pair>
+  void operator()(const Pair& p) const { out->push_back(std::make_pair(p.first, p.second)); }
+};
+
+// AddTen : update()로 값에 10을 더한다
+struct AddTen {
+  void operator()(int& v) const { v += 10; }
+};
+
+// EraseOdd : 순회하며 홀수 key를 지우고, 남은 값에 1을 더한다 (rcu_map::update()에 넘긴다)
+struct EraseOdd {
+  template <typename Map>
+  void operator()(Map& m) const {
+    for (typename Map::iterator it = m.begin(); it != m.end(); )
+    {
+      if (it->first % 2 != 0)
+        m.erase(it++);
+      else
+        ++(it++)->second;
+    }
+  }
+};
+
+#ifndef FT_TESTER_STD
+// RcuReader : 쓰는 스레드가 발행하는 동안 읽는다. 한 버전의 값은 모두 같아야 한다.
+struct RcuReader {
+  ft::rcu_map<int, int>* m;
+  int torn;
+};
+
+void* rcu_reader(void* arg) {
+  RcuReader* r = static_cast<RcuReader*>(arg);
+  ft::rcu_map<int, int>::reader reader(*r->m);
+  for (int i = 0; i < 2000; ++i)
+  {
+    ft::rcu_map<int, int>::read_guard g(reader);
+    if (!g->empty() && g->begin()->second != g->rbegin()->second)
+      ++r->torn;
+  }
+  return 0;
+}
+#endif
+
+#ifndef FT_TESTER_STD
+// ShardedWriter : 스레드 하나가 [begin, end)의 key를 sharded_map에 넣고, 짝수 key는 다시 지운다
+struct ShardedWriter {
+  ft::sharded_map<int, int>* m;
+  int begin;
+  int end;
+};
+
+void* sharded_writer(void* arg) {
+  ShardedWriter* w = static_cast<ShardedWriter*>(arg);
+  for (int k = w->begin; k < w->end; ++k)
+    w->m->insert(ft::make_pair(k * 7 % 1000, k));
+  for (int k = w->begin; k < w->end; ++k)
+    if (k % 2 == 0)
+      w->m->erase(k * 7 % 1000);
+  return 0;
+}
+#endif
+
+// copy_map() : ft::parallel_assign()과 같은 일을 std::map의 operator=로 한다
+template <typename Map>
+void copy_map(Map& dst, const Map& src, unsigned threads) {
+#ifdef FT_TESTER_STD
+  (void)threads;
+  dst = src;
+#else
+  ft::parallel_assign(dst, src, threads);
+#endif
+}
+
+// find_all(), lower_bound_all() : ft::map::find_batch(), lower_bound_batch()와 같은 일을 key마다 find(), lower_bound()로 한다
+template <typename Map, typename It, typename Out>
+Out find_all(Map& m, It first, It last, Out out) {
+#ifdef FT_TESTER_STD
+  for (; first != last; ++first)
+    *out++ = m.find(*first);
+  return out;
+#else
+  return m.find_batch(first, last, out);
+#endif
+}
+
+template <typename Map, typename It, typename Out>
+Out lower_bound_all(Map& m, It first, It last, Out out) {
+#ifdef FT_TESTER_STD
+  for (; first != last; ++first)
+    *out++ = m.lower_bound(*first);
+  return out;
+#else
+  return m.lower_bound_batch(first, last, out);
+#endif
+}
+
+// Job : intrusive_map에 거는 사용자 객체 (std는 id -> Job*인 std::map으로 같은 일을 한다)
+struct Job {
+  int id;
+  int cost;
+#ifndef FT_TESTER_STD
+  ft::intrusive_map_hook by_id;
+#endif
+};
+
+struct JobId {
+  const int& operator()(const Job& j) const { return j.id; }
+};
+
+#ifdef FT_TESTER_STD
+typedef std::map<int, Job*> job_map;
+Job& job_of(job_map::iterator it) { return *it->second; }
+bool link_job(job_map& m, Job& j) { return m.insert(std::make_pair(j.id, &j)).second; }
+#else
+typedef ft::intrusive_map<int, Job, &Job::by_id, JobId> job_map;
+Job& job_of(job_map::iterator it) { return *it; }
+bool link_job(job_map& m, Job& j) { return m.insert(j).second; }
+#endif
+
+template <typename Map>
+void join_map(Map& m, Map& right) {
+#ifdef FT_TESTER_STD
+  m.insert(right.begin(), right.end());
+  right.clear();
+#else
+  m.join(right);
+#endif
+}
+
 
 
 int main(int argc, char** argv) {
@@ -214,6 +452,311 @@ int main(int argc, char** argv) {
 //  myvector contains: 5 4 3 2 1
 }
 
+{/* vector<vector>: 재할당과 insert()에서 요소를 swap으로 옮긴다 */
+  ft::vector<ft::vector<int> > outer;
+  ft::vector<ft::vector<int> > empty_outer;
+  outer.insert(outer.end(), empty_outer.begin(), empty_outer.end());
+  std::cout << "vector<vector> empty: " << outer.size() << '\n';
+
+  outer.push_back(ft::vector<int>(1, 0));
+  const int* inner = outer[0].data();
+  for (int i = 1; i < 20; ++i)
+    outer.push_back(ft::vector<int>(i + 1, i));
+#ifndef FT_TESTER_STD
+  CHECK(ft::has_cheap_swap<ft::vector<int> >::value);
+  CHECK(outer[0].data() == inner);    // 재할당해도 안쪽 버퍼는 복사되지 않는다
+#else
+  (void)inner;
+#endif
+  outer.insert(outer.begin() + 1, 2, ft::vector<int>(1, -1));
+  ft::vector<ft::vector<int> > tail(outer.begin() + 19, outer.end());
+  outer.insert(outer.begin(), tail.begin(), tail.end());
+  outer.erase(outer.begin() + 2, outer.begin() + 5);
+
+  std::cout << "vector<vector>:";
+  for (ft::vector<ft::vector<int> >::iterator it = outer.begin(); it != outer.end(); ++it)
+    std::cout << ' ' << it->size() << 'x' << (it->empty() ? 0 : it->front());
+  std::cout << '\n';
+
+  ft::stack<ft::vector<int> > s1, s2;
+  s1.push(ft::vector<int>(3, 1));
+  using std::swap;
+  swap(s1, s2);                       // ft에서는 ft::swap(stack&, stack&)을 찾는다
+  std::cout << "stack swap: " << s1.size() << ' ' << s2.size() << ' ' << s2.top().size() << '\n';
+}
+
+{/* vector<int, slab_allocator>: 상태가 있는 할당기는 swap()에서 공간과 함께 바뀌고, 재할당할 때 요소는 복사로 옮겨진다 */
+#ifdef FT_TESTER_STD
+  typedef std::vector<int> slab_vector;
+#else
+  typedef ft::vector<int, ft::slab_allocator<int> > slab_vector;
+  CHECK(!ft::has_cheap_swap<slab_vector>::value);
+#endif
+  slab_vector a, b;
+  a.push_back(1);                                 // allocate(1)은 a의 풀에서 받는다
+  a.swap(b);
+  std::cout << "slab vector swap: " << a.size() << ' ' << b.size() << ' ' << b[0] << '\n';
+  b.push_back(2);                                 // 옛 버퍼는 함께 넘어온 할당기로 해제된다
+  b.swap(a);
+  a.swap(a);
+  std::cout << "slab vector swap back: " << a.size() << ' ' << a[1] << ' ' << b.empty() << '\n';
+
+  ft::vector<slab_vector> outer;
+  for (int i = 0; i < 5; ++i)
+  {
+    slab_vector v;
+    v.push_back(i);
+    outer.push_back(v);
+  }
+  outer.insert(outer.begin() + 2, 3, a);
+  outer.erase(outer.begin(), outer.begin() + 1);
+  outer[0].swap(outer.back());
+  std::cout << "vector<slab vector>:";
+  for (ft::vector<slab_vector>::iterator it = outer.begin(); it != outer.end(); ++it)
+    std::cout << ' ' << it->size() << 'x' << it->front();
+  std::cout << '\n';
+}
+
+{/* append_from_fd(): 요소가 잘려도 바이트를 잃지 않고, non-blocking fd에서 기다리지 않는다 */
+  int fds[2];
+  if (pipe(fds) == 0)
+  {
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    const int src[6] = {1, 2, 3, 4, 5, 6};
+    const char* bytes = reinterpret_cast<const char*>(src);
+    ft::vector<int> v;
+    size_t pending = 0;
+    char tail[sizeof(int)];
+
+    std::cout << "append_from_fd:";
+    std::cout << ' ' << write(fds[1], bytes, 6) << '/' << append_ints(v, fds[0], 4, pending, tail) << '/' << pending;
+    ssize_t again = append_ints(v, fds[0], 4, pending, tail);
+    std::cout << ' ' << again << (again < 0 && errno == EAGAIN ? " EAGAIN" : " ?") << '/' << pending;
+    std::cout << ' ' << write(fds[1], bytes + 6, 15) << '/' << append_ints(v, fds[0], 100, pending, tail) << '/' << pending;
+    close(fds[1]);
+    std::cout << ' ' << append_ints(v, fds[0], 100, pending, tail) << '/' << pending;
+    std::cout << " tail=" << (tail[0] == bytes[20]) << '\n';
+    print("append_from_fd", v.begin(), v.end());
+    close(fds[0]);
+  }
+#ifndef FT_TESTER_STD
+  if (pipe(fds) == 0) // readv(): 여러 vector에 차례대로
+  {
+    const int src[5] = {10, 20, 30, 40, 50};
+    ft::vector<int> a(1, 0), b;
+    ft::vector<int>* vecs[2] = {&a, &b};
+    size_t pending[2] = {0, 0};
+    CHECK(write(fds[1], src, 14) == 14);
+    CHECK(ft::append_from_fd(vecs, pending, 2, fds[0], 2) == 14);
+    CHECK(a.size() == 3 && a[1] == 10 && a[2] == 20 && b.size() == 1 && b[0] == 30);
+    CHECK(pending[0] == 0 && pending[1] == 2);
+    CHECK(write(fds[1], reinterpret_cast<const char*>(src) + 14, 6) == 6);
+    close(fds[1]);
+    CHECK(ft::append_from_fd(vecs + 1, pending + 1, 1, fds[0], 1) == 2); // 잘린 40만 완성한다
+    CHECK(b.size() == 2 && b[1] == 40 && pending[1] == 0);
+    CHECK(ft::append_from_fd(vecs, pending, 2, fds[0], 2) == 4);  // a에만 들어간다
+    CHECK(a.size() == 4 && a[3] == 50 && b.size() == 2);
+    CHECK(ft::append_from_fd(vecs, pending, 2, fds[0], 2) == 0);
+    CHECK(ft::append_from_fd(vecs, pending, 2, -1, 2) == -1 && errno == EBADF);
+    close(fds[0]);
+  }
+#endif
+}
+
+/********************************    stable_vector    *****************************************/
+
+{/* stable_vector: 요소 주소 유지, 순회하며 erase() */
+#ifdef FT_TESTER_STD
+  typedef std::vector<int> stable_vector_type;
+#else
+  typedef ft::stable_vector<int> stable_vector_type;
+#endif
+  stable_vector_type empty;
+  std::cout << "stable_vector empty: " << empty.size() << ' ' << (empty.begin() == empty.end()) << '\n';
+  empty.clear();
+  print("stable_vector cleared", empty.begin(), empty.end());
+
+  stable_vector_type sv;
+  for (int i = 0; i < 10; ++i)
+    sv.push_back(i);
+  const int* five = &sv[5];
+  sv.insert(sv.begin(), 3, -1);
+  sv.erase(sv.begin() + 4);           // 1을 지운다
+#ifndef FT_TESTER_STD
+  CHECK(five == &sv[7]);              // 앞에서 넣고 빼도 요소는 제자리에 있다
+#else
+  (void)five;
+#endif
+
+  for (stable_vector_type::iterator it = sv.begin(); it != sv.end(); )
+  {
+    if (*it % 2 == 0)
+      it = sv.erase(it);
+    else
+      ++it;
+  }
+  print("stable_vector odd", sv.begin(), sv.end());
+  print("stable_vector reverse", sv.rbegin(), sv.rend());
+
+  stable_vector_type one(1, 42);
+  stable_vector_type copy(one);
+  copy.resize(3, 7);
+  one.swap(copy);
+  print("stable_vector one", one.begin(), one.end());
+  print("stable_vector copy", copy.begin(), copy.end());
+  std::cout << "stable_vector compare: " << (one < copy) << (one == one) << '\n';
+//stable_vector odd: -1 -1 -1 3 5 7 9
+}
+
+{/* stable_vector<int, slab_allocator>: swap()은 할당기도 바꾼다 */
+#ifdef FT_TESTER_STD
+  typedef std::vector<int> slab_stable_vector;
+#else
+  typedef ft::stable_vector<int, ft::slab_allocator<int> > slab_stable_vector;
+  CHECK(!ft::has_cheap_swap<slab_stable_vector>::value);
+#endif
+  slab_stable_vector a, b;
+  a.push_back(1);                                 // 첫 청크는 allocate(1)로 a의 풀에서 받는다
+  a.swap(b);
+  for (int i = 2; i < 10; ++i)
+    b.push_back(i);
+  b.erase(b.begin() + 1);
+  b.swap(a);
+  print("slab stable_vector swap", a.begin(), a.end());
+  std::cout << "slab stable_vector swap sizes: " << a.size() << ' ' << b.size() << '\n';
+  ft::vector<slab_stable_vector> outer(2, a);
+  outer.push_back(b);
+  outer.insert(outer.begin() + 1, a);
+  std::cout << "vector<slab stable_vector>: " << outer.size() << ' ' << outer[1].size() << ' ' << outer.back().size() << '\n';
+}
+
+/********************************    vm_storage    *****************************************/
+
+{/* vector<T, vm_allocator>: 주소가 변하지 않고, 줄어들면 페이지를 돌려준다 */
+#ifdef FT_TESTER_STD
+  typedef std::vector<int> vm_vector;
+#else
+  typedef ft::vector<int, ft::vm_allocator<int> > vm_vector;
+#endif
+  vm_vector empty;
+  vm_vector empty_copy(empty);
+  std::cout << "vm_vector empty: " << empty.size() << ' ' << empty_copy.size() << '\n';
+#ifndef FT_TESTER_STD
+  CHECK(empty.capacity() == 0 && empty_copy.data() == 0);  // 빈 vector는 주소 공간을 예약하지 않는다
+#endif
+
+  vm_vector v;
+  v.push_back(0);
+  const int* first = &v[0];
+  for (int i = 1; i < 100000; ++i)
+    v.push_back(i);
+#ifndef FT_TESTER_STD
+  CHECK(&v[0] == first);
+  const size_t grown = v.capacity();
+#else
+  (void)first;
+#endif
+  v.erase(v.begin() + 10, v.end());
+#ifndef FT_TESTER_STD
+  CHECK(v.capacity() < grown);  // 1/4 이하로 줄면 남는 페이지를 돌려준다
+#endif
+  for (vm_vector::iterator it = v.begin(); it != v.end(); )
+  {
+    if (*it % 2 == 0)
+      it = v.erase(it);
+    else
+      ++it;
+  }
+  print("vm_vector", v.begin(), v.end());
+  vm_vector copy(v);
+  v.clear();
+  std::cout << "vm_vector clear: " << v.size() << ' ' << copy.size() << '\n';
+#ifndef FT_TESTER_STD
+  CHECK(v.capacity() == 0 && v.data() == first);  // 페이지는 모두 돌려주고, 예약한 주소는 그대로다
+  v.push_back(7);
+  CHECK(&v[0] == first && v[0] == 7);
+
+  ft::vector<int, ft::vm_allocator<int> > small((ft::vm_allocator<int>(4096)));
+  small.assign(1024, 1);
+  bool threw = false;
+  try { small.push_back(2); }
+  catch (const std::length_error&) { threw = true; }
+  CHECK(threw && small.size() == 1024);  // 예약 크기는 vector마다 정할 수 있다
+  ft::vector<int, ft::vm_allocator<int> > small_copy(small);
+  CHECK(small_copy.get_allocator().reserve_bytes() == 4096);
+#endif
+}
+
+/********************************    devector    *****************************************/
+
+{/* devector: 양쪽 끝 push/pop, 가운데 insert/erase (std::deque와 비교) */
+#ifdef FT_TESTER_STD
+  typedef std::deque<int> devector_type;
+#else
+  typedef ft::devector<int> devector_type;
+#endif
+  devector_type dv;
+  std::cout << "devector empty: " << dv.size() << ' ' << dv.empty() << '\n';
+  dv.erase(dv.begin(), dv.end());
+  dv.push_front(1);
+  dv.pop_back();
+  std::cout << "devector one push/pop: " << dv.size() << '\n';
+
+  for (int i = 0; i < 40; ++i)
+  {
+    if (rand() % 3 == 0)
+      dv.push_back(i);
+    else
+      dv.push_front(i);
+    if (i % 7 == 6)
+      dv.pop_front();
+  }
+#ifndef FT_TESTER_STD
+  CHECK(dv.data() == &dv.front());
+  CHECK(&dv.back() - &dv.front() == (long)dv.size() - 1);  // 요소는 연속으로 놓인다
+#endif
+  dv.insert(dv.begin() + 3, 2, -7);
+  dv.insert(dv.end() - 2, 100);
+  int more[] = {200, 201, 202};
+  dv.insert(dv.begin() + dv.size() / 2, more, more + 3);
+
+  for (devector_type::iterator it = dv.begin(); it != dv.end(); )
+  {
+    if (*it % 3 == 0)
+      it = dv.erase(it);
+    else
+      ++it;
+  }
+  print("devector", dv.begin(), dv.end());
+
+  devector_type copy(dv);
+  copy.resize(5);
+  copy.erase(copy.begin() + 1, copy.begin() + 3);
+  print("devector copy", copy.rbegin(), copy.rend());
+  std::cout << "devector compare: " << (copy < dv) << (copy == copy) << '\n';
+}
+
+{/* devector<int, slab_allocator>: swap()은 할당기도 바꾼다 */
+#ifdef FT_TESTER_STD
+  typedef std::deque<int> slab_devector;
+#else
+  typedef ft::devector<int, ft::slab_allocator<int> > slab_devector;
+  CHECK(!ft::has_cheap_swap<slab_devector>::value);
+#endif
+  slab_devector a, b;
+  a.push_front(1);                                // 처음 공간은 allocate(1)로 a의 풀에서 받는다
+  a.swap(b);
+  b.push_front(0);
+  for (int i = 2; i < 10; ++i)
+    b.push_back(i);
+  b.swap(a);
+  std::cout << "slab devector swap: " << a.size() << ' ' << b.size() << ' ' << a.front() << ' ' << a.back() << '\n';
+  ft::vector<slab_devector> outer(3, a);
+  outer.push_back(b);
+  outer.insert(outer.begin(), a);
+  std::cout << "vector<slab devector>: " << outer.size() << ' ' << outer[0].size() << ' ' << outer.back().size() << '\n';
+}
+
 /********************************    stack    *****************************************/
 
 {/* push(), empty(), top(), pop() */
@@ -405,6 +948,1131 @@ int main(int argc, char** argv) {
 //  [20, 30)
 }
 
+{/* 투명한 비교 함수 객체: map<std::string, int, StrLess>를 const char*로 찾기 */
+  ft::map<std::string, int, StrLess> m;
+  const char* words[] = { "pear", "apple", "fig", "kiwi", "apple", "date" };
+  for (int i = 0; i < 6; ++i)
+    m.insert(ft::make_pair(std::string(words[i]), i));
+  print_map("transparent", m.begin(), m.end());
+
+  StrLess::mixed_calls = 0;
+  const char* keys[] = { "apple", "banana", "kiwi", "zzz", "" };
+  for (int i = 0; i < 5; ++i)
+  {
+    ft::map<std::string, int, StrLess>::iterator it = m.find(keys[i]);
+    std::cout << '"' << keys[i] << "\" find=" << (it == m.end() ? "end" : it->first)
+              << " count=" << m.count(keys[i])
+              << " lower=" << (m.lower_bound(keys[i]) == m.end() ? "end" : m.lower_bound(keys[i])->first)
+              << " upper=" << (m.upper_bound(keys[i]) == m.end() ? "end" : m.upper_bound(keys[i])->first)
+              << " range=" << std::distance(m.equal_range(keys[i]).first, m.equal_range(keys[i]).second) << '\n';
+  }
+#ifndef FT_TESTER_STD
+  CHECK(StrLess::mixed_calls > 0);                 // const char* 그대로 비교했다
+
+  const ft::map<std::string, int, StrLess>& cm = m;
+  CHECK(cm.find("fig") != cm.end() && cm.find("fig")->second == 2);
+  CHECK(cm.find("grape") == cm.end());
+#endif
+
+  ft::map<std::string, int, StrLess> empty;
+  std::cout << "empty: " << (empty.find("apple") == empty.end()) << empty.count("apple") << '\n';
+}
+
+{/* map<..., slab_allocator>: 중복 키, 순회하며 erase(), clear() 후 재사용 */
+#ifdef FT_TESTER_STD
+  typedef std::map<int, std::string> slab_map;
+#else
+  typedef ft::map<int, std::string, std::less<int>, ft::slab_allocator<ft::pair<const int, std::string> > > slab_map;
+#endif
+  slab_map m;
+  m.clear();
+  std::cout << "slab map empty: " << m.size() << ' ' << (m.begin() == m.end()) << '\n';
+
+  for (int i = 0; i < 1000; ++i)
+    m.insert(ft::make_pair(rand() % 300, std::string(1, 'a' + i % 26)));  // 중복 키는 무시된다
+  std::cout << "slab map size: " << m.size() << '\n';
+  for (slab_map::iterator it = m.begin(); it != m.end(); )
+  {
+    if (it->first % 5 != 0)
+      m.erase(it++);
+    else
+      ++it;
+  }
+  print_map("slab map", m.begin(), m.end());
+
+  slab_map copy(m);
+#ifndef FT_TESTER_STD
+  CHECK(copy.get_allocator() == m.get_allocator());  // 복사본은 풀을 나누어 쓴다 (그래서 clear()는 노드를 하나씩 돌려준다)
+#endif
+  m.clear();
+  m[1] = "one";
+  m.swap(copy);
+  std::cout << "slab map swap: " << m.size() << ' ' << copy.size() << ' ' << copy[1] << '\n';
+
+  slab_map own;
+  for (int i = 0; i < 100; ++i)
+    own[i] = "x";
+  own.clear();                                   // 풀을 혼자 쓰면 slab을 한꺼번에 돌려준다
+  own.insert(ft::make_pair(2, std::string("two")));
+  own.insert(ft::make_pair(2, std::string("dup")));
+  print_map("slab map reuse", own.begin(), own.end());
+}
+
+{/* vector<int, slab_allocator>: 크기가 1인 공간만 풀에서 받는다. 대입, ft::swap(), 빈 vector와의 swap */
+#ifdef FT_TESTER_STD
+  typedef std::vector<int> slab_vector;
+#else
+  typedef ft::vector<int, ft::slab_allocator<int> > slab_vector;
+#endif
+  slab_vector a, b, empty;
+  a.push_back(7);                                 // allocate(1): a의 풀
+  b = a;                                          // b는 a의 할당기를 복사하지 않고 자기 할당기로 받는다
+  using std::swap;
+  swap(a, empty);                                 // ft에서는 ft::swap(vector&, vector&)을 찾는다
+  a.push_back(8);
+  for (int i = 0; i < 20; ++i)                    // 2개 이상은 ::operator new
+    empty.push_back(i);
+  b.swap(empty);
+  a.clear();
+  a.swap(b);
+  std::cout << "slab vector assign/swap: " << a.size() << ' ' << b.size() << ' ' << empty.size() << ' ' << a.back() << ' ' << empty[0] << '\n';
+}
+
+{/* map(first, last): 정렬된 입력은 한 번에 만든다 (빈 범위, 한 개, 중복 키, 정렬되지 않은 입력) */
+  const int sizes[] = {0, 1, 2, 3, 7, 100};
+  for (int s = 0; s < 6; ++s)
+  {
+    std::vector<ft::pair<int, int> > sorted;
+    for (int i = 0; i < sizes[s]; ++i)
+      sorted.push_back(ft::make_pair(i * 2, i));
+    ft::map<int, int> m(sorted.begin(), sorted.end());
+    for (int i = 1; i < sizes[s] * 2; i += 4)
+      m.insert(ft::make_pair(i, -i));             // 만든 뒤에도 균형이 맞아야 한다
+    for (ft::map<int, int>::iterator it = m.begin(); it != m.end(); )
+    {
+      if (it->first % 3 == 0)
+        m.erase(it++);
+      else
+        ++it;
+    }
+    std::cout << "sorted build " << sizes[s] << ": " << m.size();
+    if (!m.empty())
+      std::cout << ' ' << m.begin()->first << ' ' << (--m.end())->first << ' ' << m.count(4) << m.count(5);
+    std::cout << '\n';
+  }
+
+  std::vector<ft::pair<int, char> > dup;
+  dup.push_back(ft::make_pair(1, 'a'));
+  dup.push_back(ft::make_pair(2, 'b'));
+  dup.push_back(ft::make_pair(2, 'c'));             // 중복 키: 처음 것만 남는다
+  dup.push_back(ft::make_pair(3, 'd'));
+  dup.push_back(ft::make_pair(0, 'e'));             // 정렬되지 않은 입력
+  ft::map<int, char> d(dup.begin(), dup.end());
+  print_map("sorted build dup", d.begin(), d.end());
+  d.insert(dup.begin(), dup.begin() + 2);         // 비어 있지 않은 map에 넣기
+  print_map("sorted build insert", d.begin(), d.end());
+#ifndef FT_TESTER_STD
+  std::vector<ft::pair<int, char> > unique(dup.begin(), dup.begin() + 2);
+  ft::map<int, char> tagged(ft::sorted_unique, unique.begin(), unique.end());
+  CHECK(tagged.size() == 2 && tagged[2] == 'b');
+#endif
+}
+
+{/* 노드 모양 매크로 (FT_RB_TREE_COMPACT_NODE, FT_RB_TREE_ORDER_STATISTICS): 무작위 삽입/삭제, 복사 */
+#ifndef FT_TESTER_STD
+  const size_t words = 3
+# ifndef FT_RB_TREE_COMPACT_NODE
+    + 1                                             // 색이 따로 있으면 패딩까지 한 워드
+# endif
+# ifdef FT_RB_TREE_ORDER_STATISTICS
+    + 1                                             // _M_size
+# endif
+    ;
+  CHECK(sizeof(ft::_Rb_tree_node_base) == words * sizeof(void*));
+#endif
+  ft::map<int, int> m;
+  ft::map<int, int> empty_copy(m);
+  std::cout << "layout empty copy: " << empty_copy.size() << ' ' << (empty_copy.begin() == empty_copy.end()) << '\n';
+  long sum = 0;
+  for (int i = 0; i < 20000; ++i)
+  {
+    const int k = rand() % 2000;
+    if (rand() % 3 == 0)
+      sum += m.erase(k);
+    else
+      m[k] += i;
+  }
+  ft::map<int, int> copy(m);                          // 노드를 복제한다
+  for (ft::map<int, int>::iterator it = copy.begin(); it != copy.end(); )
+  {
+    if (it->first % 2 != 0)
+      copy.erase(it++);
+    else
+      ++it;
+  }
+  for (ft::map<int, int>::const_iterator it = copy.begin(); it != copy.end(); ++it)
+    sum += it->first ^ it->second;
+  ft::map<int, int> one;
+  one[1] = 1;
+  one.erase(one.begin());
+  std::cout << "layout: " << m.size() << ' ' << copy.size() << ' ' << sum << ' ' << one.size() << '\n';
+}
+
+{/* nth(), rank(), index_of(), distance(), at() (std에서는 반복자를 세어서 구한다) */
+  ft::map<int, int> m;
+#ifndef FT_TESTER_STD
+  CHECK(m.nth(0) == m.end() && m.rank(5) == 0 && m.index_of(m.end()) == 0);
+#endif
+  for (int i = 0; i < 3000; ++i)
+  {
+    const int k = rand() % 1000;
+    if (rand() % 4 == 0)
+      m.erase(k);
+    else
+      m[k] = i;
+  }
+  std::cout << "order statistics:";
+  for (size_t k = 0; k < m.size(); k += m.size() / 7)
+  {
+#ifdef FT_TESTER_STD
+    ft::map<int, int>::iterator it = m.begin();
+    std::advance(it, k);
+    std::cout << ' ' << it->first << '/' << std::distance(m.begin(), m.lower_bound(it->first + 1));
+#else
+    ft::map<int, int>::iterator it = m.nth(k);
+    CHECK(m.index_of(it) == k);
+    std::cout << ' ' << it->first << '/' << m.rank(it->first + 1);
+#endif
+  }
+  std::cout << '\n';
+#ifndef FT_TESTER_STD
+  size_t i = 0;
+  for (ft::map<int, int>::iterator it = m.begin(); it != m.end(); ++it, ++i)
+    CHECK(m.nth(i) == it);
+  CHECK(m.nth(m.size()) == m.end() && m.index_of(m.end()) == m.size());
+  CHECK(m.distance(m.lower_bound(100), m.lower_bound(900)) == std::distance(m.lower_bound(100), m.lower_bound(900)));
+#endif
+  try
+  {
+    m.at(-1);                                     // at()은 key로 찾는다
+    std::cout << "at: no throw\n";
+  }
+  catch (const std::out_of_range&)
+  {
+    std::cout << "at: out_of_range\n";
+  }
+  std::cout << "at: " << m.at(m.begin()->first) << '\n';
+}
+
+{/* split(), join(): 빈 map, 한 개, 경계의 key, 오른쪽에 있던 요소 */
+  ft::map<int, int> m, right;
+  split_map(m, 5, right);
+  join_map(m, right);
+  std::cout << "split/join empty: " << m.size() << right.size() << '\n';
+
+  m[5] = 50;
+  split_map(m, 6, right);                         // 모두 왼쪽
+  std::cout << "split one: " << m.size() << right.size();
+  split_map(m, 5, right);                         // 모두 오른쪽 (같은 key는 오른쪽)
+  std::cout << ' ' << m.size() << right.size();
+  join_map(m, right);                             // 빈 map에 붙이기
+  std::cout << ' ' << m.size() << right.size() << ' ' << m.begin()->first << '\n';
+  join_map(m, right);                             // 빈 map을 붙이기
+  std::cout << "join empty: " << m.size() << right.size() << '\n';
+
+  for (int i = 0; i < 200; ++i)
+    m[rand() % 500] = i;
+  for (int i = 0; i < 5; ++i)
+    right[1000 + i] = i;                          // split()은 오른쪽에 있던 요소를 먼저 지운다
+  split_map(m, 250, right);
+  std::cout << "split 250: " << m.size() << ' ' << right.size() << ' ' << m.rbegin()->first << ' ' << right.begin()->first << '\n';
+#ifndef FT_TESTER_STD
+  const int* moved = &right.begin()->second;
+#endif
+  for (ft::map<int, int>::iterator it = m.begin(); it != m.end(); )
+  {
+    if (it->first % 3 == 0)
+      m.erase(it++);
+    else
+      ++it;
+  }
+  join_map(m, right);
+  std::cout << "join: " << m.size() << ' ' << right.size() << '\n';
+  print_map("joined", m.begin(), m.end());
+#ifndef FT_TESTER_STD
+  CHECK(&m.lower_bound(250)->second == moved);   // 노드를 옮기기만 한다
+  CHECK(m.size() == (size_t)std::distance(m.begin(), m.end()));
+#endif
+  for (int k = -1; k < 502; k += 101)
+  {
+    ft::map<int, int> copy(m);
+    split_map(copy, k, right);
+    std::cout << k << ": " << copy.size() << '/' << right.size();
+    join_map(copy, right);
+    std::cout << ' ' << (copy == m) << '\n';
+  }
+}
+
+{/* map_union(), map_intersection(), map_difference(): 빈 map, 한 개, 겹치는 key, 작은 변경분과 큰 map */
+  const char ops[] = "uid";
+  for (int o = 0; o < 3; ++o)
+  {
+    std::cout << "set op " << ops[o] << ':';
+    for (int sx = 0; sx < 4; ++sx)
+      for (int sy = 0; sy < 4; ++sy)
+      {
+        const int sizes[] = { 0, 1, 10, 2000 };
+        ft::map<int, int> x, y;
+        for (int i = 0; i < sizes[sx]; ++i)
+          x[rand() % (2 * sizes[sx] + 1)] = i;
+        for (int i = 0; i < sizes[sy]; ++i)
+          y[rand() % (2 * sizes[sx] + 3)] = 1000 * i;   // x와 key가 겹치게 한다
+        set_op(ops[o], x, y, (sx + sy) % 2 == 0);
+        int sum = 0;
+        for (ft::map<int, int>::iterator it = x.begin(); it != x.end(); ++it)
+          sum = (sum * 31 + it->first * 7 + it->second) % 1000003;
+        std::cout << ' ' << x.size() << '/' << y.size() << '/' << sum;
+#ifndef FT_TESTER_STD
+        CHECK(x.size() == (size_t)std::distance(x.begin(), x.end()));
+#endif
+      }
+    std::cout << '\n';
+  }
+
+  ft::map<int, int> x, y;
+  for (int i = 0; i < 10; ++i)
+  {
+    x[i * 2] = i;
+    y[i * 3] = 100;
+  }
+#ifndef FT_TESTER_STD
+  const int* kept = &x.find(6)->second;
+  const int* moved = &y.find(9)->second;
+#endif
+  set_op('u', x, y, true);
+  print_map("map_union", x.begin(), x.end());
+#ifndef FT_TESTER_STD
+  CHECK(&x.find(6)->second == kept);              // 겹치면 x의 노드가 남는다
+  CHECK(&x.find(9)->second == moved);             // y의 노드는 옮기기만 한다
+#endif
+  for (ft::map<int, int>::iterator it = x.begin(); it != x.end(); )
+  {
+    if (it->second >= 100)
+      y.insert(*it++);
+    else
+      ++it;
+  }
+  set_op('d', x, y, false);
+  print_map("map_difference", x.begin(), x.end());
+}
+
+{/* extract(), insert(node_type&), merge(): 없는 key, 한 개, 겹치는 key, 순회하며 extract() */
+  typedef ft::map<int, std::string> map_type;
+  map_type a, b;
+#ifndef FT_TESTER_STD
+  map_type::node_type empty = a.extract(1);
+  CHECK(empty.empty());
+  CHECK(a.insert(empty).second == false && a.empty());
+#endif
+  a[1] = "one";
+#ifdef FT_TESTER_STD
+  std::pair<int, std::string> nh = *a.find(1);
+  a.erase(1);
+  b.insert(nh);
+#else
+  const std::string* node = &a.find(1)->second;
+  map_type::node_type nh = a.extract(1);
+  CHECK(!nh.empty() && nh.value().second == "one");
+  CHECK(b.insert(nh).second && nh.empty());
+  CHECK(&b.find(1)->second == node);              // 같은 노드를 다시 연결한다
+#endif
+  std::cout << "extract one: " << a.size() << b.size() << '\n';
+
+  a[1] = "uno";                                  // 겹치는 key는 넣지 않는다
+#ifdef FT_TESTER_STD
+  nh = *a.find(1);
+  a.erase(1);
+  std::cout << "insert dup: " << b.insert(nh).second << '\n';
+#else
+  nh = a.extract(a.find(1));
+  std::cout << "insert dup: " << b.insert(nh).second << '\n';
+  CHECK(!nh.empty() && nh.value().second == "uno");  // 노드는 handle에 남는다
+#endif
+
+  for (int i = 0; i < 40; ++i)
+    a[i * 3] = std::string(1, 'a' + i % 26);
+  for (map_type::iterator it = a.begin(); it != a.end(); )   // 순회하며 extract()해서 b로 옮기기
+  {
+    if (it->first % 2 == 0)
+    {
+#ifdef FT_TESTER_STD
+      b.insert(b.end(), *it);
+      a.erase(it++);
+#else
+      map_type::node_type moved = a.extract(it++);
+      b.insert(b.end(), moved);
+#endif
+    }
+    else
+      ++it;
+  }
+  print_map("extract a", a.begin(), a.end());
+  print_map("extract b", b.begin(), b.end());
+
+  map_type c;
+  merge_map(c, c);                               // 빈 map끼리
+  merge_map(a, c);
+  merge_map(c, b);                               // 빈 map으로
+  std::cout << "merge empty: " << a.size() << ' ' << b.size() << ' ' << c.size() << '\n';
+  for (int i = 0; i < 40; ++i)
+    b[i * 3] = "b";                              // 겹치는 key는 b에 남는다
+  merge_map(a, b);
+  print_map("merge a", a.begin(), a.end());
+  print_map("merge b", b.begin(), b.end());
+  for (int i = 0; i < 10; ++i)
+    b[1000 + i] = "tail";                        // 모든 key가 a보다 크다
+  merge_map(a, b);
+  std::cout << "merge tail: " << a.size() << ' ' << b.size() << ' ' << a.rbegin()->first << '\n';
+}
+
+{/* parallel_assign(): 빈 map, 한 개, 스레드를 쓰는 큰 map (std::allocator, slab_allocator) */
+  ft::map<int, int> src, dst;
+  dst[1] = 1;
+  copy_map(dst, src, 4);
+  std::cout << "parallel empty: " << dst.size() << '\n';
+  src[7] = 70;
+  copy_map(dst, src, 4);
+  copy_map(dst, dst, 4);                          // 자기 자신
+  std::cout << "parallel one: " << dst.size() << ' ' << dst.begin()->first << '\n';
+
+  for (int i = 0; i < 100000; ++i)
+    src[rand() % 200000] = i;
+  copy_map(dst, src, 4);
+  std::cout << "parallel big: " << dst.size() << ' ' << (dst == src) << ' ' << dst.begin()->first << ' ' << dst.rbegin()->first << '\n';
+  for (ft::map<int, int>::iterator it = dst.begin(); it != dst.end(); )
+  {
+    if (it->second % 2 == 0)
+      dst.erase(it++);
+    else
+      ++it;
+  }
+  std::cout << "parallel erase: " << dst.size() << ' ' << src.size() << '\n';
+#ifndef FT_TESTER_STD
+  CHECK(dst.size() == (size_t)std::distance(dst.begin(), dst.end()));
+#endif
+
+#ifdef FT_TESTER_STD
+  typedef std::map<int, int> slab_map;
+#else
+  typedef ft::map<int, int, std::less<int>, ft::slab_allocator<ft::pair<const int, int> > > slab_map;
+#endif
+  slab_map slab_src, slab_dst;
+  for (int i = 0; i < 70000; ++i)
+    slab_src[i * 3] = i;
+  copy_map(slab_dst, slab_src, 8);                // 스레드마다 따로 만든 풀은 slab_dst의 풀로 합쳐진다
+  slab_dst.erase(slab_dst.begin(), slab_dst.lower_bound(30000));
+  for (int i = 0; i < 100; ++i)
+    slab_dst[i] = -i;
+  std::cout << "parallel slab: " << slab_dst.size() << ' ' << slab_dst.begin()->second << ' ' << (slab_dst == slab_src) << '\n';
+  slab_dst.clear();
+  copy_map(slab_dst, slab_src, 8);
+  std::cout << "parallel slab again: " << (slab_dst == slab_src) << '\n';
+}
+
+{/* find_batch(), lower_bound_batch(): 빈 map, 한 개, 묶음(8개)의 경계, 없는 key, 중복된 key */
+  typedef ft::map<int, int> map_type;
+  map_type m;
+  std::vector<int> keys;
+  std::vector<map_type::iterator> found;
+  find_all(m, keys.begin(), keys.end(), std::back_inserter(found));
+  keys.push_back(3);
+  find_all(m, keys.begin(), keys.end(), std::back_inserter(found));
+  std::cout << "batch empty: " << found.size() << ' ' << (found[0] == m.end()) << '\n';
+
+  for (int i = 0; i < 500; ++i)
+    m[rand() % 1000 * 2] = i;                    // 짝수 key만 있다
+  const size_t sizes[] = { 1, 7, 8, 9, 17, 100 };
+  for (int t = 0; t < 6; ++t)
+  {
+    keys.clear();
+    for (size_t i = 0; i < sizes[t]; ++i)
+      keys.push_back(rand() % 2003 - 1);        // 홀수는 없는 key, -1과 2001은 양 끝 밖
+    keys.push_back(keys[0]);                      // 중복된 key
+    std::vector<map_type::iterator> f, lb;
+    find_all(m, keys.begin(), keys.end(), std::back_inserter(f));
+    lower_bound_all(m, keys.begin(), keys.end(), std::back_inserter(lb));
+    std::cout << "batch " << sizes[t] << ':';
+    for (size_t i = 0; i < keys.size(); ++i)
+      std::cout << ' ' << keys[i] << '>' << (f[i] == m.end() ? -1 : f[i]->second) << '/' << (lb[i] == m.end() ? -1 : lb[i]->first);
+    std::cout << '\n';
+  }
+
+  const map_type& cm = m;
+  int probes[] = { -5, 0, 1, 2, 1998, 1999, 2000, 5000 };
+  map_type::const_iterator out[8];
+  map_type::const_iterator* end = lower_bound_all(cm, probes, probes + 8, out);
+  std::cout << "batch const: " << (end - out);
+  for (int i = 0; i < 8; ++i)
+    std::cout << ' ' << (out[i] == cm.end() ? -1 : out[i]->first);
+  std::cout << '\n';
+}
+
+{/* multimap, multiset: 같은 key는 넣은 순서대로, equal_range(), count(), 순회하며 erase(), 정렬된 범위 */
+  ft::multimap<int, int> m;
+  std::cout << "multimap empty: " << m.count(1) << (m.equal_range(1).first == m.end()) << m.erase(1) << '\n';
+  m.insert(ft::make_pair(1, 10));
+  m.insert(ft::make_pair(1, 11));
+  m.insert(m.end(), ft::make_pair(1, 12));       // end() 힌트도 같은 key의 뒤에 들어간다
+  print_map("multimap one key", m.begin(), m.end());
+  std::cout << "multimap erase key: " << m.erase(1) << m.size() << '\n';
+
+  for (int i = 0; i < 500; ++i)
+    m.insert(ft::make_pair(rand() % 60, i));
+  std::cout << "multimap count:";
+  for (int k = -1; k <= 60; k += 4)
+  {
+    ft::pair<ft::multimap<int, int>::iterator, ft::multimap<int, int>::iterator> r = m.equal_range(k);
+    std::cout << ' ' << m.count(k) << '/' << std::distance(r.first, r.second) << '/'
+              << (r.first == m.end() ? -1 : r.first->second) << '/' << (r.second == m.end() ? -1 : r.second->first);
+  }
+  std::cout << '\n';
+  for (ft::multimap<int, int>::iterator it = m.begin(); it != m.end(); )
+  {
+    if (it->second % 3 == 0)
+      m.erase(it++);
+    else
+      ++it;
+  }
+  m.erase(m.lower_bound(10), m.upper_bound(20));
+  print_map("multimap erase", m.begin(), m.end());
+  ft::multimap<int, int> copy(m.begin(), m.end()); // 정렬된 범위
+  std::cout << "multimap copy: " << (copy == m) << ' ' << copy.size() << ' ';
+  copy.insert(ft::make_pair(5, -1));
+  std::cout << (copy == m) << (m < copy) << ' ';
+  copy.swap(m);
+  std::cout << m.size() - copy.size() << '\n';
+
+  std::vector<int> v;
+  for (int i = 0; i < 300; ++i)
+    v.push_back(rand() % 40);
+  ft::multiset<int> s(v.begin(), v.end()), e;
+  std::sort(v.begin(), v.end());
+  ft::multiset<int> sorted(v.begin(), v.end());
+  std::cout << "multiset: " << s.size() << ' ' << e.count(0) << ' ' << (s == sorted) << ' ' << s.count(v[0]) << ' ' << s.count(40) << '\n';
+  for (ft::multiset<int>::iterator it = s.begin(); it != s.end(); )
+  {
+    if (*it % 2 == 0)
+      s.erase(it++);
+    else
+      ++it;
+  }
+  s.insert(7);
+  print("multiset odd", s.begin(), s.end());
+  s.erase(7);
+  std::cout << "multiset erase: " << s.count(7) << ' ' << s.size() << ' ' << *s.lower_bound(8) << ' ' << *s.upper_bound(8) << '\n';
+}
+
+{/* intrusive_map: 초기화되지 않은 훅, 중복 키, 순회하며 erase(), clear() 뒤에 다시 걸기, swap() (std::map<int, Job*>와 비교) */
+  const int n = 200;
+  std::vector<char> raw(n * sizeof(Job), (char)0xff); // 훅에 쓰레기 값이 있어도 insert()는 부모와 색을 새로 쓴다
+  Job* jobs = reinterpret_cast<Job*>(&raw[0]);
+  for (int i = 0; i < n; ++i)
+  {
+    jobs[i].id = rand() % 150;
+    jobs[i].cost = i;
+  }
+  job_map m, other;
+  std::cout << "intrusive empty: " << m.size() << (m.begin() == m.end()) << m.count(0) << m.erase(0) << '\n';
+  int linked = 0;
+  for (int i = 0; i < n; ++i)
+    linked += link_job(m, jobs[i]);              // 같은 id는 걸지 않는다
+  std::cout << "intrusive insert: " << linked << ' ' << m.size() << ' ' << job_of(m.begin()).id << ' ' << job_of(--m.end()).id << '\n';
+#ifndef FT_TESTER_STD
+  CHECK(m.iterator_to(*m.find(jobs[0].id)) == m.find(jobs[0].id));
+  CHECK(m.size() == (size_t)std::distance(m.begin(), m.end()));
+#endif
+  for (job_map::iterator it = m.begin(); it != m.end(); )
+  {
+    if (job_of(it).cost % 2 == 0)
+      m.erase(it++);
+    else
+      ++it;
+  }
+  m.erase(m.lower_bound(50), m.upper_bound(99));
+  std::cout << "intrusive erase:";
+  for (job_map::iterator it = m.begin(); it != m.end(); ++it)
+    std::cout << ' ' << job_of(it).id << '=' << job_of(it).cost;
+  std::cout << '\n';
+
+  m.swap(other);
+  std::cout << "intrusive swap: " << m.size() << ' ' << other.size() << (m.begin() == m.end()) << '\n';
+  other.clear();
+  for (int i = n - 1; i >= 0; --i)                // 떼어낸 객체를 다시 건다
+    link_job(m, jobs[i]);
+  std::cout << "intrusive relink: " << m.size() << ' ' << job_of(m.find(jobs[0].id)).cost << ' ' << (m.find(150) == m.end()) << '\n';
+  m.clear();
+}
+
+/********************************    btree_map    *****************************************/
+
+{/* btree_map, btree_set: 중복 키, it = erase(it), 범위 erase (std::map, std::set과 비교) */
+#ifdef FT_TESTER_STD
+  typedef std::map<int, int> btree_map_type;
+  typedef std::set<int> btree_set_type;
+#else
+  typedef ft::btree_map<int, int> btree_map_type;
+  typedef ft::btree_set<int> btree_set_type;
+#endif
+  btree_map_type m;
+  m.erase(m.begin(), m.end());
+  std::cout << "btree_map empty: " << m.size() << ' ' << (m.begin() == m.end()) << ' ' << m.count(0) << '\n';
+  m[5] = 5;
+  m.erase(5);
+  std::cout << "btree_map one: " << m.size() << ' ' << (m.find(5) == m.end()) << '\n';
+
+  for (int i = 0; i < 5000; ++i)
+    m.insert(ft::make_pair(rand() % 2000, i));      // 중복 키는 무시된다
+  for (btree_map_type::iterator it = m.begin(); it != m.end(); )
+  {
+    if (it->first % 3 == 0)
+#ifdef FT_TESTER_STD
+      m.erase(it++);
+#else
+      it = m.erase(it);                               // btree_map에서는 반환값을 받는 방법만 된다
+#endif
+    else
+      ++it;
+  }
+  m.erase(m.lower_bound(100), m.lower_bound(1500));  // 여러 leaf에 걸친 범위
+  m.erase(m.lower_bound(1600), m.lower_bound(1610));  // leaf 하나 안의 범위
+  print_map("btree_map", m.begin(), m.lower_bound(30));
+  std::cout << "btree_map size: " << m.size() << ' ' << m.lower_bound(100)->first << ' ' << m.rbegin()->first << '\n';
+
+  btree_set_type s;
+  for (int i = 0; i < 1000; ++i)
+    s.insert(i % 700);
+  s.erase(s.find(10), s.find(690));
+  print("btree_set", s.begin(), s.end());
+}
+
+/********************************    flat_map    *****************************************/
+
+{/* flat_map, flat_set: 범위 insert의 중복 키, 순회하며 erase() (std::map, std::set과 비교) */
+#ifdef FT_TESTER_STD
+  typedef std::map<int, char> flat_map_type;
+  typedef std::set<int> flat_set_type;
+#else
+  typedef ft::flat_map<int, char> flat_map_type;
+  typedef ft::flat_set<int> flat_set_type;
+#endif
+  flat_map_type m;
+  std::vector<ft::pair<int, char> > none;
+  m.insert(none.begin(), none.end());
+  std::cout << "flat_map empty: " << m.size() << ' ' << (m.begin() == m.end()) << ' ' << (m.lower_bound(3) == m.end()) << '\n';
+
+  std::vector<ft::pair<int, char> > input;
+  for (int i = 0; i < 60; ++i)
+    input.push_back(ft::make_pair((i * 37) % 41, char('a' + i % 26)));  // 키가 겹친다
+  m.insert(input.begin(), input.begin() + 30);
+  m.insert(input.begin() + 30, input.end());      // 이미 있는 키는 그대로 둔다
+  m.insert(ft::make_pair(7, 'Z'));
+  m[100] = 'X';
+  for (flat_map_type::iterator it = m.begin(); it != m.end(); )
+  {
+    if (it->first % 4 == 0)
+#ifdef FT_TESTER_STD
+      m.erase(it++);
+#else
+      it = m.erase(it);
+#endif
+    else
+      ++it;
+  }
+  m.erase(m.lower_bound(20), m.lower_bound(30));
+  print_map("flat_map", m.begin(), m.end());
+
+  flat_set_type s;
+  s.insert(3);
+  s.erase(s.begin());
+  s.insert(input.size());
+  s.insert(1);
+  s.insert(1);
+  print("flat_set", s.begin(), s.end());
+#ifndef FT_TESTER_STD
+  ft::flat_map<int, char>::sequence_type seq;
+  seq.push_back(ft::make_pair(1, 'a'));
+  seq.push_back(ft::make_pair(2, 'b'));
+  const ft::pair<int, char>* storage = seq.data();
+  ft::flat_map<int, char> adopted(ft::sorted_unique, seq);
+  CHECK(seq.empty() && adopted.size() == 2 && &*adopted.begin() == storage);  // 복사하지 않고 넘겨받는다
+#endif
+}
+
+/********************************    persistent_map    *****************************************/
+
+{/* persistent_map: 스냅샷은 변하지 않는다 (std::map의 복사와 비교), 빈 map, 한 개, 중복 키, 스냅샷을 순회하며 erase() */
+#ifdef FT_TESTER_STD
+  typedef std::map<int, int> map_type;
+#else
+  typedef ft::persistent_map<int, int> map_type;
+#endif
+  map_type m;
+  map_type s0 = m;
+#ifndef FT_TESTER_STD
+  CHECK(m.shares_root_with(s0));
+#endif
+  m.insert(ft::make_pair(1, 10));
+  map_type s1 = m;
+  std::cout << "persistent one: " << s0.size() << s1.size() << (s0 == m) << (s1 == m) << '\n';
+  std::cout << "insert dup: " << m.insert(ft::make_pair(1, 11)).second << ' ' << m.at(1) << '\n';
+#ifdef FT_TESTER_STD
+  m[1] = 12;
+#else
+  CHECK(!m.insert_or_assign(1, 12));
+  CHECK(!m.shares_root_with(s1));
+#endif
+  std::cout << "assign: " << m.at(1) << ' ' << s1.at(1) << '\n';
+  m.erase(1);
+  std::cout << "erase one: " << m.size() << ' ' << s1.size() << ' ' << m.erase(1) << '\n';
+
+  std::vector<map_type> versions;
+  for (int i = 0; i < 500; ++i)
+  {
+    const int k = rand() % 200;
+    if (rand() % 3 == 0)
+      m.erase(k);
+    else
+    {
+#ifdef FT_TESTER_STD
+      m[k] = i;
+#else
+      m.insert_or_assign(k, i);
+#endif
+    }
+    if (i % 100 == 0)
+      versions.push_back(m);
+  }
+  map_type snap = m;
+  for (map_type::const_iterator it = snap.begin(); it != snap.end(); ++it)   // 스냅샷을 순회하며 m에서 지운다
+    if (it->second % 2 == 0)
+      m.erase(it->first);
+  print_map("persistent m", m.begin(), m.end());
+  print_map("persistent snap", snap.begin(), snap.end());
+  for (size_t i = 0; i < versions.size(); ++i)
+    std::cout << "version " << i << ": " << versions[i].size() << ' '
+              << (versions[i].empty() ? -1 : versions[i].begin()->second) << ' ' << (versions[i] < snap) << '\n';
+  m.clear();
+  std::cout << "clear: " << m.size() << ' ' << snap.size() << ' ' << (m == s0) << '\n';
+  try
+  {
+    m.at(5);
+    std::cout << "at: no throw\n";
+  }
+  catch (const std::out_of_range&)
+  {
+    std::cout << "at: out_of_range\n";
+  }
+}
+
+/********************************    sharded_map    *****************************************/
+
+{/* sharded_map: 경계의 key, 빈 shard, 중복 키, lookup(), update(), 범위 for_each() (std::map과 비교) */
+  const int bounds[] = { 100, 200, 500 };
+#ifdef FT_TESTER_STD
+  typedef std::map<int, int> map_type;
+  map_type one, m;
+#else
+  typedef ft::sharded_map<int, int> map_type;
+  map_type one;
+  map_type m(bounds, bounds + 3);
+  CHECK(one.shard_count() == 1 && m.shard_count() == 4);
+  CHECK(m.shard_of(99) == 0 && m.shard_of(100) == 1 && m.shard_of(499) == 2 && m.shard_of(500) == 3);
+#endif
+  std::cout << "sharded empty: " << one.empty() << m.size() << one.count(0) << one.erase(0) << '\n';
+#ifdef FT_TESTER_STD
+  const bool first = one.insert(ft::make_pair(5, 50)).second;
+  const bool second = one.insert(ft::make_pair(5, 51)).second;
+#else
+  const bool first = one.insert(ft::make_pair(5, 50));
+  const bool second = one.insert(ft::make_pair(5, 51));
+#endif
+  std::cout << "sharded one: " << first << second << one.size();
+  int v = 0;
+#ifdef FT_TESTER_STD
+  std::cout << !one.count(5) << ' ';
+  one[5] = 52;
+  const bool found = one.count(5);
+  if (found)
+    v = one[5];
+  std::cout << found << ' ' << v;
+#else
+  std::cout << one.insert_or_assign(5, 52) << ' ';
+  std::cout << one.lookup(5, v) << ' ' << v;
+  CHECK(!one.lookup(6, v));
+#endif
+  std::cout << ' ' << one.erase(5) << one.size() << '\n';
+
+  for (int i = 0; i < 300; ++i)
+    m.insert(ft::make_pair(rand() % 700, i));
+  for (int i = 0; i < 3; ++i)                     // 경계의 key
+    m.insert(ft::make_pair(bounds[i], -1));
+  for (int k = 0; k < 700; k += 3)
+  {
+#ifdef FT_TESTER_STD
+    if (m.count(k))
+      m[k] += 10;
+#else
+    m.update(k, AddTen());
+#endif
+  }
+  m.erase(150);
+  std::vector<std::pair<int, int> > all, range;
+#ifdef FT_TESTER_STD
+  std::for_each(m.begin(), m.end(), Collect(&all));
+  std::for_each(m.lower_bound(90), m.lower_bound(510), Collect(&range));
+#else
+  m.for_each(Collect(&all));
+  m.for_each(90, 510, Collect(&range));
+  std::vector<std::pair<int, int> > none;
+  m.for_each(300, 300, Collect(&none));
+  CHECK(none.empty());
+#endif
+  std::cout << "sharded size: " << m.size() << ' ' << all.size() << ' ' << range.size() << '\n';
+  for (size_t i = 0; i < all.size(); i += 7)
+    std::cout << all[i].first << '=' << all[i].second << ' ';
+  std::cout << '\n';
+  std::cout << "range: " << range.front().first << ' ' << range.back().first << '\n';
+  m.clear();
+  std::cout << "clear: " << m.size() << m.empty() << '\n';
+
+  // 스레드 4개가 함께 넣고 지운다. (std는 한 스레드로 같은 일을 한다)
+#ifdef FT_TESTER_STD
+  for (int t = 0; t < 4; ++t)
+  {
+    for (int k = t * 250; k < (t + 1) * 250; ++k)
+      m.insert(ft::make_pair(k * 7 % 1000, k));
+    for (int k = t * 250; k < (t + 1) * 250; ++k)
+      if (k % 2 == 0)
+        m.erase(k * 7 % 1000);
+  }
+#else
+  pthread_t threads[4];
+  ShardedWriter writers[4];
+  for (int t = 0; t < 4; ++t)
+  {
+    writers[t].m = &m;
+    writers[t].begin = t * 250;
+    writers[t].end = (t + 1) * 250;
+    pthread_create(&threads[t], 0, sharded_writer, &writers[t]);
+  }
+  for (int t = 0; t < 4; ++t)
+    pthread_join(threads[t], 0);
+#endif
+  all.clear();
+#ifdef FT_TESTER_STD
+  std::for_each(m.begin(), m.end(), Collect(&all));
+#else
+  m.for_each(Collect(&all));
+#endif
+  std::cout << "threads: " << all.size() << ' ' << all.front().first << ' ' << all.back().first << '\n';
+}
+
+/********************************    rcu_map    *****************************************/
+
+{/* rcu_map: 발행한 버전은 변하지 않는다 (std::map의 복사와 비교), 빈 map, 중복 키, update()에서 순회하며 erase() */
+  typedef ft::map<int, int> version_type;
+#ifdef FT_TESTER_STD
+  version_type m;
+  const version_type& current = m;
+#else
+  ft::rcu_map<int, int> m;
+  ft::rcu_map<int, int>::reader reader(m);
+  int v = -1;
+  CHECK(!reader.lookup(1, v) && v == -1);
+  CHECK(m.snapshot().empty());
+#endif
+  std::cout << "rcu empty: " << m.erase(1) << '\n';
+#ifdef FT_TESTER_STD
+  const bool first = m.insert(ft::make_pair(1, 10)).second;
+  const bool second = m.insert(ft::make_pair(1, 11)).second;
+  const bool assigned = !m.count(2);
+  m[2] = 20;
+#else
+  const bool first = m.insert(ft::make_pair(1, 10));
+  const bool second = m.insert(ft::make_pair(1, 11));
+  const bool assigned = m.insert_or_assign(2, 20);
+  CHECK(reader.lookup(1, v) && v == 10);
+#endif
+  std::cout << "rcu insert: " << first << second << assigned << '\n';
+
+  version_type old;
+  for (int i = 0; i < 50; ++i)
+    old[i] = i;
+#ifdef FT_TESTER_STD
+  m = old;
+  version_type held = m;                          // 잡고 있는 동안 이 버전은 변하지 않는다
+  EraseOdd()(m);
+  m.erase(4);
+  print_map("rcu held", held.begin(), held.end());
+  print_map("rcu current", current.begin(), current.end());
+#else
+  m.assign(old);
+  {
+    ft::rcu_map<int, int>::read_guard g(reader);
+    m.update(EraseOdd());
+    m.erase(4);
+    CHECK(m.retired_count() >= 1 && m.reclaim() == 0);  // 읽고 있는 버전은 지우지 않는다
+    print_map("rcu held", g->begin(), g->end());
+    version_type current = m.snapshot();
+    print_map("rcu current", current.begin(), current.end());
+  }
+  m.reclaim();
+  CHECK(m.retired_count() == 0);
+
+  m.assign(version_type());                       // 읽는 스레드는 값이 모두 같은 버전만 보아야 한다
+  RcuReader r = { &m, 0 };
+  pthread_t thread;
+  pthread_create(&thread, 0, rcu_reader, &r);
+  for (int i = 0; i < 200; ++i)
+  {
+    version_type next;
+    for (int k = 0; k < 20; ++k)
+      next[k] = i;
+    m.assign(next);
+  }
+  pthread_join(thread, 0);
+  CHECK(r.torn == 0);
+#endif
+}
+
+/********************************    frozen_map    *****************************************/
+
+{/* frozen_map: 여러 크기의 Eytzinger 배열에서 find(), lower_bound(), upper_bound(), 양방향 순회 (std::map과 비교) */
+#ifdef FT_TESTER_STD
+  typedef std::map<int, int> frozen_type;
+#else
+  typedef ft::frozen_map<int, int> frozen_type;
+#endif
+  const size_t sizes[] = { 0, 1, 2, 3, 7, 8, 15, 16, 17, 100, 1000 };
+  for (int t = 0; t < 11; ++t)
+  {
+    ft::map<int, int> m;
+    while (m.size() < sizes[t])
+      m.insert(ft::make_pair(rand() % (int)(4 * sizes[t]) * 2, (int)m.size()));  // 짝수 key만, 중복 key는 넣지 않는다
+    const frozen_type f(m);
+    long sum = 0;
+    for (int x = -1; x <= (int)(8 * sizes[t]) + 1; ++x)   // 모든 자리와 양 끝 밖을 찾는다
+    {
+      frozen_type::const_iterator lb = f.lower_bound(x), ub = f.upper_bound(x), fd = f.find(x);
+      sum = sum * 3 % 1000003 + (lb == f.end() ? -1 : lb->first) + (ub == f.end() ? -2 : ub->first)
+            + (fd == f.end() ? -3 : fd->second) + (long)f.count(x);
+    }
+    std::cout << "frozen " << sizes[t] << ": " << f.size() << f.empty() << ' ' << sum << ' '
+              << (f.empty() ? -1 : f.begin()->first) << ' ' << (f.empty() ? -1 : f.rbegin()->first) << ' '
+              << std::distance(f.begin(), f.end()) << ' ' << std::distance(f.rbegin(), f.rend()) << '\n';
+#ifndef FT_TESTER_STD
+    CHECK(std::equal(f.begin(), f.end(), m.begin()));
+#endif
+  }
+
+  std::vector<ft::pair<int, int> > sorted;
+  for (int i = 0; i < 10; ++i)
+    sorted.push_back(ft::make_pair(i * 10, i));
+#ifdef FT_TESTER_STD
+  frozen_type a(sorted.begin(), sorted.end());
+#else
+  frozen_type a(ft::sorted_unique, sorted.begin(), sorted.end());
+#endif
+  frozen_type b(a), c;
+  c = b;
+  c.swap(b);
+  print_map("frozen sorted", a.begin(), a.end());
+  std::cout << "frozen copy: " << b.size() << ' ' << c.size() << ' ' << c.at(90) << '\n';
+  try
+  {
+    c.at(5);
+    std::cout << "at: no throw\n";
+  }
+  catch (const std::out_of_range&)
+  {
+    std::cout << "at: out_of_range\n";
+  }
+}
+
+/********************************    unordered_map    *****************************************/
+
+{/* unordered_map: 빈 map, 한 개, 중복 키, 순회하며 erase(), 다시 해시하기 (순서가 다르므로 정렬해서 std::map과 비교) */
+#ifdef FT_TESTER_STD
+  typedef std::map<int, int> hash_map;
+  typedef std::map<std::string, int> string_map;
+#else
+  typedef ft::unordered_map<int, int> hash_map;
+  typedef ft::unordered_map<std::string, int> string_map;
+#endif
+  hash_map m;
+  std::cout << "unordered empty: " << m.size() << m.empty() << (m.begin() == m.end()) << m.count(0) << m.erase(0) << '\n';
+  m[5] = 50;
+  std::cout << "unordered one: " << m.insert(ft::make_pair(5, 51)).second << ' ' << m[5] << ' ' << m.begin()->first << '\n';
+  m.erase(m.begin());
+  std::cout << "unordered erase one: " << m.size() << (m.begin() == m.end()) << '\n';
+
+  for (int i = 0; i < 3000; ++i)
+  {
+    const int k = rand() % 2000 - 1000;
+    if (rand() % 4 == 0)
+      m.erase(k);                                 // 지운 자리에 다시 넣기
+    else
+      m[k] += i;
+  }
+  print_sorted_map("unordered", m);
+  for (hash_map::iterator it = m.begin(); it != m.end(); )
+  {
+    if (it->second % 3 == 0)
+      m.erase(it++);
+    else
+      ++it;
+  }
+  print_sorted_map("unordered erase", m);
+#ifndef FT_TESTER_STD
+  CHECK(m.size() == (size_t)std::distance(m.begin(), m.end()));
+  CHECK(m.load_factor() <= m.max_load_factor());
+  const size_t buckets = m.bucket_count();
+  m.reserve(10000);
+  CHECK(m.bucket_count() > buckets);
+  m.rehash(0);                                    // 요소를 담을 수 있는 만큼 줄인다
+  CHECK(m.bucket_count() <= buckets && m.load_factor() <= m.max_load_factor());
+#endif
+  print_sorted_map("unordered rehash", m);
+
+  hash_map copy(m), other;
+  other[1] = 1;
+  std::cout << "unordered copy: " << (copy == m) << ' ';
+  copy.erase(copy.find(m.begin()->first));
+  std::cout << (copy == m) << ' ';
+  copy.swap(other);
+  std::cout << copy.size() << ' ' << (other.size() + 1 == m.size()) << '\n';
+  try
+  {
+    m.at(5000);
+    std::cout << "at: no throw\n";
+  }
+  catch (const std::out_of_range&)
+  {
+    std::cout << "at: out_of_range\n";
+  }
+  m.clear();
+  m[7] = 7;
+  std::cout << "unordered clear: " << m.size() << ' ' << m.at(7) << '\n';
+
+  string_map words;
+  const char* text[] = { "to", "be", "or", "not", "to", "be", "that", "is", "the", "question", "" };
+  for (int i = 0; i < 11; ++i)
+    ++words[text[i]];
+  print_sorted_map("unordered words", words);
+}
+
+{/* unordered_set: 범위 insert의 중복 키, 순회하며 erase(), 범위 erase() (정렬해서 std::set과 비교) */
+#ifdef FT_TESTER_STD
+  typedef std::set<int> hash_set;
+#else
+  typedef ft::unordered_set<int> hash_set;
+#endif
+  std::vector<int> v;
+  for (int i = 0; i < 1000; ++i)
+    v.push_back(rand() % 700);
+  hash_set s(v.begin(), v.end()), e;
+  std::cout << "unordered_set: " << s.size() << ' ' << e.size() << e.count(1) << ' ' << s.insert(v[0]).second << '\n';
+  for (hash_set::const_iterator it = s.begin(); it != s.end(); )
+  {
+    if (*it % 2 == 0)
+      s.erase(it++);
+    else
+      ++it;
+  }
+  print_sorted_set("unordered_set odd", s);
+  hash_set copy(s);
+  copy.erase(copy.begin(), copy.end());
+  std::cout << "unordered_set erase all: " << copy.size() << (copy.begin() == copy.end()) << ' ' << (copy == e) << '\n';
+  copy.insert(v.begin(), v.begin() + 10);
+  print_sorted_set("unordered_set reuse", copy);
+}
+
+/********************************    offset_map    *****************************************/
+
+{/* offset_map: shm_segment에 만들고, 같은 파일을 다른 주소에 한 번 더 붙여서 고치고 읽는다 (std::map과 비교) */
+#ifdef FT_TESTER_STD
+  typedef std::map<int, int> shm_map;
+  shm_map owner;
+  shm_map* m = &owner;
+  shm_map* view = &owner;
+#else
+  typedef ft::offset_map<int, int> shm_map;
+  char path[] = "/tmp/ft_tester_shm_XXXXXX";
+  const int fd = mkstemp(path);                   // 빈 파일이므로 shm_segment가 새로 초기화한다
+  CHECK(fd >= 0);
+  close(fd);
+  ft::shm_segment* seg = new ft::shm_segment(path, 8 << 20);
+  shm_map* m = seg->find_or_construct<shm_map>();
+  CHECK(seg->find_or_construct<shm_map>() == m);
+#endif
+  std::cout << "offset empty: " << m->size() << m->empty() << (m->begin() == m->end()) << m->count(0) << m->erase(0) << '\n';
+  try { m->at(0); std::cout << "offset at: no throw\n"; }
+  catch (std::out_of_range&) { std::cout << "offset at: out_of_range\n"; }
+  (*m)[7] = 70;
+  std::cout << "offset one: " << m->insert(ft::make_pair(7, 71)).second << ' ' << m->at(7) << ' ' << m->begin()->first << ' ' << (--m->end())->first << '\n';
+  m->erase(m->begin());
+  std::cout << "offset erase one: " << m->size() << (m->begin() == m->end()) << '\n';
+
+  for (int i = 0; i < 5000; ++i)
+  {
+    const int k = rand() % 3000;
+    if (rand() % 4 == 0)
+      m->erase(k);
+    else
+      (*m)[k] += i;
+  }
+  print_map("offset build", m->begin(), m->end());
+
+#ifndef FT_TESTER_STD
+  ft::shm_segment* view_seg = new ft::shm_segment(path);  // 다른 프로세스가 붙는 것과 같다: 주소만 다르다
+  shm_map* view = view_seg->find<shm_map>();
+  CHECK(view_seg->base() != seg->base());
+  CHECK(view != m && view->size() == m->size());
+  bool mismatch = false;
+  try { view_seg->find<ft::offset_map<int, char> >(); }
+  catch (std::runtime_error&) { mismatch = true; }
+  CHECK(mismatch);
+#endif
+  for (shm_map::iterator it = view->begin(); it != view->end(); )  // 두 번째 주소에서 고친다
+  {
+    if (it->second % 3 == 0)
+      view->erase(it++);
+    else
+      ++it;
+  }
+  view->erase(view->lower_bound(1000), view->upper_bound(1999));
+  for (int k = 0; k < 3000; k += 7)
+    view->insert(ft::make_pair(k, -k));
+  print_map("offset view", m->begin(), m->end());  // 첫 번째 주소에서 본다
+  std::cout << "offset bounds: " << m->lower_bound(1000)->first << ' ' << (m->upper_bound(2999) == m->end())
+            << ' ' << m->equal_range(7).first->second << ' ' << m->count(1001) << '\n';
+  for (shm_map::reverse_iterator it = m->rbegin(); it != m->rend() && it->first > 2950; ++it)
+    std::cout << it->first << ' ';
+  std::cout << '\n';
+
+  m->clear();
+  std::cout << "offset clear: " << view->size() << (view->begin() == view->end()) << '\n';
+  (*view)[1] = 1;
+  std::cout << "offset reuse: " << m->size() << ' ' << m->at(1) << '\n';
+#ifndef FT_TESTER_STD
+  delete view_seg;
+  seg->destroy<shm_map>();
+  CHECK(seg->find<shm_map>() == 0);
+  delete seg;
+  CHECK(ft::shm_segment::remove(path));
+#endif
+}
+
 /********************************    utils    *****************************************/
 
 {// equal()
@@ -1,17 +1,50 @@
 #include <iostream>
 
-#if 1 //CREATE A REAL STL EXAMPLE
+#ifndef FT_TESTER_FT //CREATE A REAL STL EXAMPLE (-DFT_TESTER_FT로 ft를 테스트한다)
 	#include <map>
 	#include <stack>
 	#include <vector>
 	namespace ft = std;
+	#define FT_TESTER_STD
 #else
 	#include "../containers/map.hpp"
 	#include "../containers/stack.hpp"
 	#include "../containers/vector.hpp"
+	#include "../containers/stable_vector.hpp"
+	#include "../containers/vector_fd.hpp"
+	#include "../containers/devector.hpp"
+	#include "../containers/vm_storage.hpp"
+	#include "../containers/slab_allocator.hpp"
+	#include "../containers/btree_map.hpp"
+	#include "../containers/btree_set.hpp"
+	#include "../containers/flat_map.hpp"
+	#include "../containers/flat_set.hpp"
+	#include "../containers/persistent_map.hpp"
+	#include "../containers/sharded_map.hpp"
+	#include "../containers/rcu_map.hpp"
+	#include "../containers/parallel_assign.hpp"
+	#include "../containers/frozen_map.hpp"
+	#include "../containers/unordered_map.hpp"
+	#include "../containers/unordered_set.hpp"
+	#include "../containers/multimap.hpp"
+	#include "../containers/multiset.hpp"
+	#include "../containers/intrusive_map.hpp"
+	#include "../containers/offset_map.hpp"
 #endif
 
+// ft에만 있는 컨테이너의 결과를 std로 다시 계산해 비교할 때 쓴다
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #define MAX_RAM 4294967296
 #define BUFFER_SIZE 4096
@@ -41,4 +74,79 @@ public:
 
 	iterator begin() { return this->c.begin(); }
 	iterator end() { return this->c.end(); }
-};
\ No newline at end of file
+};
+
+// print() :
+// [first, last)를 한 줄로 출력한다. make check는 std와 ft의 출력을 비교한다.
+template <typename It>
+void print(const char* name, It first, It last)
+{
+	std::cout << name << ":";
+	for (; first != last; ++first)
+		std::cout << ' ' << *first;
+	std::cout << std::endl;
+}
+
+// print_map() :
+// 맵의 (key, value)를 한 줄로 출력한다
+template <typename It>
+void print_map(const char* name, It first, It last)
+{
+	std::cout << name << ":";
+	for (; first != last; ++first)
+		std::cout << ' ' << first->first << '=' << first->second;
+	std::cout << std::endl;
+}
+
+// print_sorted_map(), print_sorted_set() :
+// 순서가 구현마다 다른 컨테이너(unordered_map 등)를 정렬한 복사본으로 출력한다
+template <typename Map>
+void print_sorted_map(const char* name, const Map& m)
+{
+	std::vector<std::pair<typename Map::key_type, typename Map::mapped_type> > v;
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+		v.push_back(std::make_pair(it->first, it->second));
+	std::sort(v.begin(), v.end());
+	std::cout << name << ":";
+	for (size_t i = 0; i < v.size(); ++i)
+		std::cout << ' ' << v[i].first << '=' << v[i].second;
+	std::cout << std::endl;
+}
+
+template <typename Set>
+void print_sorted_set(const char* name, const Set& s)
+{
+	std::vector<typename Set::value_type> v(s.begin(), s.end());
+	std::sort(v.begin(), v.end());
+	print(name, v.begin(), v.end());
+}
+
+// CHECK() :
+// 실패할 때만 출력한다. ft에만 있는 기능은 std 모드에서 같은 줄을 만들 수 없으므로,
+// 성공하면 아무것도 출력하지 않게 해서 make check의 비교에 걸리게 한다.
+#define CHECK(cond) \
+	do { if (!(cond)) std::cout << "KO " << __LINE__ << ": " #cond << std::endl; } while (0)
+
+// StrLess :
+// C++98의 투명한 비교 함수 객체. (std::less<>는 C++14부터 있다.)
+// is_transparent를 선언하고 operator()를 템플릿으로 두면, ft::map<std::string, V, StrLess>를 const char*로 바로 찾는다.
+// std::map은 is_transparent를 모르므로 const char*를 std::string으로 바꿔서 찾는다. (결과는 같다.)
+struct StrLess
+{
+	typedef void is_transparent;
+
+	static int mixed_calls; // std::string이 아닌 인자로 불린 횟수
+
+	template <typename A, typename B>
+	bool operator()(const A& a, const B& b) const
+	{
+		if (!is_string(a) || !is_string(b))
+			++mixed_calls;
+		return strcmp(c_str(a), c_str(b)) < 0;
+	}
+
+	static const char* c_str(const std::string& s) { return s.c_str(); }
+	static const char* c_str(const char* s) { return s; }
+	static bool is_string(const std::string&) { return true; }
+	static bool is_string(const char*) { return false; }
+};
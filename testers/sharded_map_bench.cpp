@@ -0,0 +1,122 @@
+// sharded_map 확장성 벤치마크
+// 스레드 1 ~ 64개가 같은 map에 읽기 90%, 쓰기 10%의 연산을 나누어 한다.
+// mutex 하나로 감싼 ft::map과 shard 64개짜리 ft::sharded_map의 초당 연산 수를 비교한다.
+//
+// make bench && ./sharded_map_bench
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <pthread.h>
+
+#include "../containers/map.hpp"
+#include "../containers/sharded_map.hpp"
+#include "../containers/vector.hpp"
+
+#define KEYS 1000000
+#define OPS_PER_THREAD 400000
+#define SHARDS 64
+#define MAX_THREADS 64
+
+static double now()
+{
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// mutex 하나로 감싼 map
+struct LockedMap
+{
+	pthread_mutex_t lock;
+	ft::map<int, int> m;
+
+	LockedMap() { pthread_mutex_init(&lock, 0); }
+	~LockedMap() { pthread_mutex_destroy(&lock); }
+
+	bool lookup(int k, int& out)
+	{
+		pthread_mutex_lock(&lock);
+		ft::map<int, int>::iterator i = m.find(k);
+		bool found = i != m.end();
+		if (found)
+			out = i->second;
+		pthread_mutex_unlock(&lock);
+		return found;
+	}
+	void insert_or_assign(int k, int v)
+	{
+		pthread_mutex_lock(&lock);
+		m[k] = v;
+		pthread_mutex_unlock(&lock);
+	}
+};
+
+template <class Map>
+struct Job
+{
+	Map* map;
+	unsigned seed;
+	long hits;
+};
+
+template <class Map>
+void* run(void* arg)
+{
+	Job<Map>* job = static_cast<Job<Map>*>(arg);
+	long hits = 0;
+	int out;
+	for (int i = 0; i < OPS_PER_THREAD; ++i)
+	{
+		int k = rand_r(&job->seed) % KEYS;
+		if (i % 10 == 0)
+			job->map->insert_or_assign(k, i);
+		else
+			hits += job->map->lookup(k, out);
+	}
+	job->hits = hits;
+	return 0;
+}
+
+// 초당 연산 수 (백만 단위)
+template <class Map>
+double measure(Map& map, int threads)
+{
+	pthread_t th[MAX_THREADS];
+	Job<Map> jobs[MAX_THREADS];
+	double start = now();
+	for (int i = 0; i < threads; ++i)
+	{
+		jobs[i].map = &map;
+		jobs[i].seed = i + 1;
+		pthread_create(&th[i], 0, run<Map>, &jobs[i]);
+	}
+	for (int i = 0; i < threads; ++i)
+		pthread_join(th[i], 0);
+	return (double)threads * OPS_PER_THREAD / (now() - start) / 1e6;
+}
+
+int main()
+{
+	LockedMap locked;
+	ft::vector<int> bounds;
+	for (int i = 1; i < SHARDS; ++i)
+		bounds.push_back(KEYS / SHARDS * i);
+	ft::sharded_map<int, int> sharded(bounds.begin(), bounds.end());
+
+	// 절반을 미리 채워 둔다.
+	for (int k = 0; k < KEYS; k += 2)
+	{
+		locked.m.insert(ft::make_pair(k, k));
+		sharded.insert(ft::make_pair(k, k));
+	}
+
+	printf("%8s %16s %16s\n", "threads", "map+mutex Mops", "sharded Mops");
+	for (int threads = 1; threads <= MAX_THREADS; threads *= 2)
+	{
+		double a = measure(locked, threads);
+		double b = measure(sharded, threads);
+		printf("%8d %16.2f %16.2f\n", threads, a, b);
+	}
+	return 0;
+}